@@ -1137,9 +1137,9 @@ void ComponentSerializer::RenderPhysicalObjectComponent(GameObject *go)
 
                 // Shape Type
                 ShapeType currentShapeType = physicalObject->getShapeType();
-                const char *shapeTypes[] = {"Box", "Sphere", "Capsule", "Plane"};
+                const char *shapeTypes[] = {"Box", "Sphere", "Capsule", "Plane", "Triangle Mesh", "Convex Mesh"};
                 int currentShapeItem = static_cast<int>(currentShapeType);
-                if (ImGui::Combo("Shape Type", &currentShapeItem, shapeTypes, 4))
+                if (ImGui::Combo("Shape Type", &currentShapeItem, shapeTypes, 6))
                 {
                     physicalObject->setShapeType(static_cast<ShapeType>(currentShapeItem));
                 }
@@ -1206,6 +1206,24 @@ void ComponentSerializer::RenderPhysicalObjectComponent(GameObject *go)
                     ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Plane shape - no additional properties");
                     break;
                 }
+                case ShapeType::TriangleMesh:
+                {
+                    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Uses the object's model (static only)");
+                    break;
+                }
+                case ShapeType::ConvexMesh:
+                {
+                    int hullCount = physicalObject->getConvexHullCount();
+                    if (ImGui::DragInt("Convex Hulls", &hullCount, 0.1f, 1, 64))
+                    {
+                        physicalObject->setConvexHullCount(hullCount);
+                    }
+                    if (ImGui::IsItemHovered())
+                    {
+                        ImGui::SetTooltip("Number of convex pieces the model is split into (1 = single hull)");
+                    }
+                    break;
+                }
                 }
 
                 ImGui::Separator();
@@ -1724,6 +1742,11 @@ void ComponentSerializer::RenderCharacterControllerComponent(GameObject *go)
                 if (ImGui::DragFloat("Air Control", &air, 0.01f, 0.0f, 1.0f))
                     cc->setAirControl(air);
 
+                // Para NPCs: se mueve en paralelo con el resto de la multitud
+                bool crowd = cc->isCrowdMode();
+                if (ImGui::Checkbox("Crowd Mode", &crowd))
+                    cc->setCrowdMode(crowd);
+
                 ImGui::Separator();
                 ImGui::Text("State");
                 ImGui::Text("Grounded: %s", cc->isGroundedState() ? "Yes" : "No");
@@ -1995,9 +2018,9 @@ void ComponentSerializer::RenderColliderComponent(GameObject *go)
 
                 // Shape Type
                 ShapeType currentShapeType = collider->getShapeType();
-                const char *shapeTypes[] = {"Box", "Sphere", "Capsule", "Plane"};
+                const char *shapeTypes[] = {"Box", "Sphere", "Capsule", "Plane", "Triangle Mesh", "Convex Mesh"};
                 int currentShapeItem = static_cast<int>(currentShapeType);
-                if (ImGui::Combo("Shape Type", &currentShapeItem, shapeTypes, 4))
+                if (ImGui::Combo("Shape Type", &currentShapeItem, shapeTypes, 6))
                 {
                     collider->setShapeType(static_cast<ShapeType>(currentShapeItem));
                 }
@@ -2064,6 +2087,12 @@ void ComponentSerializer::RenderColliderComponent(GameObject *go)
                     ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Plane shape - no additional properties");
                     break;
                 }
+                case ShapeType::TriangleMesh:
+                case ShapeType::ConvexMesh:
+                {
+                    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Uses the object's model");
+                    break;
+                }
                 }
 
                 ImGui::Separator();
@@ -12,3 +12,5 @@ std::string EditorInfo::currentScenePath;
 std::string EditorInfo::SelectedProject = "";
 std::string EditorInfo::SelectedProjectPath = "";
 bool EditorInfo::IsPlaying = false;
+float EditorInfo::AutosaveInterval = 60.0f;
+float EditorInfo::WorldCellSize = 64.0f;
@@ -12,4 +12,6 @@ public:
 	static std::string SelectedProjectPath;
 	static RenderPipeline* pipeline;
 	static std::string currentScenePath;
+	static float AutosaveInterval; // Segundos; 0 desactiva el autoguardado
+	static float WorldCellSize; // Tamaño de celda al exportar con "Export World Partition Cells"
 };
\ No newline at end of file
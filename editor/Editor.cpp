@@ -23,6 +23,8 @@
 #include "components/ModelScene.h"
 #include "input/InputSystem.h"
 #include "core/Time.h"
+#include "core/FrameAllocator.h"
+#include "core/PhysicsManager.h"
 
 #include "EUI/EditorInfo.h"
 
@@ -309,6 +311,9 @@ int main()
     {
         Time::update();
 
+        // Vacia el scratch de hace dos frames y cierra el recuento de reservas del anterior
+        FrameAllocator::getInstance().beginFrame();
+
         // Actualizar FMOD
         audioManager.update();
 
@@ -378,6 +383,11 @@ int main()
         {
             sceneManager.update(Time::getDeltaTime());
         }
+        else
+        {
+            // Autoguardado incremental en segundo plano
+            SceneSaver::UpdateAutosave(sceneManager.getActiveScene(), EditorInfo::currentScenePath, Time::getDeltaTime());
+        }
 
         // Update active scene pointer if it changed
         Scene *newActiveScene = sceneManager.getActiveScene();
@@ -413,6 +423,9 @@ int main()
         pipeline.renderFrame();
         // pipeline.renderToScreen();
 
+        // El paso de fisica ha corrido junto al render; el inspector y los paneles pueden tocar actores
+        PhysicsManager::getInstance().fetchResults();
+
         // ==== ImGui Frame Begin ====
         ImGuiLoader::MakeFrame();
 
@@ -669,10 +682,12 @@ int main()
         title << "MantraxEngine - " << std::fixed << std::setprecision(1) << Time::getFPS() << " FPS";
         title << " | Objects: " << pipeline.getVisibleObjectsCount() << "/" << pipeline.getTotalObjectsCount();
         title << " | Scene: " << activeScene->getName();
+        title << " | Heap allocs/frame: " << FrameAllocator::getInstance().getLastFrameHeapAllocations();
         config.setWindowTitle(title.str());
     }
 
     // Cleanup
+    SceneSaver::WaitForSave();
     try
     {
         SceneManager::getInstance().cleanupPhysics();
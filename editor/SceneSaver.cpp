@@ -9,6 +9,9 @@
 #include <components/ScriptExecutor.h>
 #include <components/Collider.h>
 #include <components/Rigidbody.h>
+#include <components/SceneObjectLoader.h>
+#include <components/WorldPartition.h>
+#include <components/Prefab.h>
 #include "windows/Selection.h"
 #include <render/RenderPipeline.h>
 #include "EUI/EditorInfo.h"
@@ -17,12 +20,310 @@
 #include "Windows/FileExplorer.h"
 #include "Windows/TileEditor.h"
 #include "Windows/RenderWindows.h"
+#include <core/BinaryScene.h>
+#include <core/JobSystem.h>
+#include <mpak/CorePackCodec.h>
 #include <glm/glm.hpp>
 #include <cmath>
+#include <algorithm>
+#include <future>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
 
 using namespace nlohmann;
 
+namespace
+{
+    // Cache del guardado incremental: datos ya codificados de cada objeto, su revision y el hash del
+    // estado de sus componentes al guardarlo
+    struct SaveCacheEntry
+    {
+        const GameObject *object = nullptr;
+        uint64_t revision = 0;
+        uint64_t componentsHash = 0;
+        std::shared_ptr<EncodedSceneObject> encoded;
+    };
+
+    uint64_t combineComponentHashes(const std::vector<uint64_t> &hashes)
+    {
+        return CorePackCodec::Hash64(hashes.data(), hashes.size() * sizeof(uint64_t));
+    }
+
+    // Muchos setters de componentes no llaman a markDirty, asi que la revision no basta: el estado
+    // serializado de los componentes se compara siempre
+    uint64_t hashComponents(const GameObject *obj)
+    {
+        std::vector<uint64_t> hashes;
+        for (const Component *comp : obj->getAllComponents())
+        {
+            hashes.push_back(SceneSaver::HashComponentState(comp, comp->serializeComponent()));
+        }
+        return combineComponentHashes(hashes);
+    }
+
+    struct SaveState
+    {
+        const Scene *scene = nullptr;
+        std::unordered_map<std::string, SaveCacheEntry> cache;
+        json metadata;
+        std::string path;
+        std::future<bool> pending;
+        bool lastResult = true;
+        float autosaveTimer = 0.0f;
+    };
+
+    SaveState saveState;
+}
+
 bool SceneSaver::SaveScene(const Scene *scene, const std::string &filepath)
+{
+    return SaveSceneAsync(scene, filepath) && WaitForSave();
+}
+
+bool SceneSaver::SaveSceneAsync(const Scene *scene, const std::string &filepath, bool onlyIfChanged)
+{
+    // Nunca dos guardados a la vez: el anterior todavia puede estar rellenando entradas de la cache
+    WaitForSave();
+
+    json metadata;
+    if (!BuildSceneMetadata(scene, filepath, metadata))
+    {
+        return false;
+    }
+
+    // La cache es de una sola escena: guardar otra la empieza de cero
+    if (scene != saveState.scene)
+    {
+        ResetSaveCache();
+        saveState.scene = scene;
+    }
+
+    // Copia consistente tomada en el hilo principal: los objetos sin cambios reutilizan sus datos ya
+    // codificados y solo los modificados se vuelven a serializar
+    const auto &gameObjects = scene->getGameObjects();
+    std::unordered_map<std::string, SaveCacheEntry> cache;
+    cache.reserve(gameObjects.size());
+    std::vector<std::shared_ptr<const EncodedSceneObject>> objects;
+    objects.reserve(gameObjects.size());
+    std::vector<std::pair<std::shared_ptr<EncodedSceneObject>, SceneObjectData>> pending;
+
+    for (GameObject *obj : gameObjects)
+    {
+        if (!obj || !obj->isValid())
+        {
+            continue;
+        }
+
+        auto it = saveState.cache.find(obj->ObjectID);
+        if (it != saveState.cache.end() && it->second.object == obj && it->second.revision == obj->getRevision() &&
+            it->second.componentsHash == hashComponents(obj))
+        {
+            objects.push_back(it->second.encoded);
+            cache.emplace(obj->ObjectID, std::move(it->second));
+            continue;
+        }
+
+        SceneObjectData objectData;
+        std::vector<uint64_t> componentHashes;
+        if (!CaptureObject(obj, objectData, &componentHashes))
+        {
+            continue;
+        }
+
+        auto encoded = std::make_shared<EncodedSceneObject>();
+        objects.push_back(encoded);
+        cache[obj->ObjectID] = SaveCacheEntry{obj, obj->getRevision(), combineComponentHashes(componentHashes), encoded};
+        pending.emplace_back(std::move(encoded), std::move(objectData));
+    }
+
+    // Sin pendientes todas las entradas vienen de la cache anterior; si hay menos, se borro algun objeto
+    bool unchanged = pending.empty() && cache.size() == saveState.cache.size() &&
+                     metadata == saveState.metadata && filepath == saveState.path;
+    saveState.cache = std::move(cache);
+
+    if (onlyIfChanged && unchanged)
+    {
+        return false;
+    }
+
+    saveState.metadata = metadata;
+    saveState.path = filepath;
+
+    std::cout << "SceneSaver: Saving " << objects.size() << " objects (" << pending.size() << " modified) to " << filepath << std::endl;
+
+    // Codificar y escribir en segundo plano
+    saveState.pending = std::async(std::launch::async,
+                                   [metadata = std::move(metadata), objects = std::move(objects), pending = std::move(pending), filepath]() mutable
+                                   {
+                                       try
+                                       {
+                                           for (auto &item : pending)
+                                           {
+                                               *item.first = EncodedSceneObject::encode(item.second);
+                                           }
+
+                                           BinarySceneWriter writer;
+                                           writer.setMetadata(metadata);
+                                           writer.reserveObjects(objects.size());
+                                           for (auto &object : objects)
+                                           {
+                                               writer.addObject(std::move(object));
+                                           }
+                                           return writer.writeToFile(filepath);
+                                       }
+                                       catch (const std::exception &e)
+                                       {
+                                           std::cerr << "SceneSaver: Error saving scene: " << e.what() << std::endl;
+                                           return false;
+                                       }
+                                   });
+    return true;
+}
+
+bool SceneSaver::IsSaving()
+{
+    return saveState.pending.valid() &&
+           saveState.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+bool SceneSaver::WaitForSave()
+{
+    if (!saveState.pending.valid())
+    {
+        return saveState.lastResult;
+    }
+
+    saveState.lastResult = saveState.pending.get();
+    if (saveState.lastResult)
+    {
+        std::cout << "Scene saved successfully to: " << saveState.path << std::endl;
+    }
+    else
+    {
+        // La cache puede tener entradas sin codificar: el siguiente guardado lo reserializa todo
+        std::cerr << "Failed to save scene to: " << saveState.path << std::endl;
+        ResetSaveCache();
+    }
+    return saveState.lastResult;
+}
+
+void SceneSaver::UpdateAutosave(const Scene *scene, const std::string &filepath, float deltaTime)
+{
+    if (EditorInfo::AutosaveInterval <= 0.0f || !scene || filepath.empty())
+    {
+        return;
+    }
+
+    saveState.autosaveTimer += deltaTime;
+    if (saveState.autosaveTimer < EditorInfo::AutosaveInterval || IsSaving())
+    {
+        return;
+    }
+
+    saveState.autosaveTimer = 0.0f;
+    if (SaveSceneAsync(scene, filepath, true))
+    {
+        std::cout << "SceneSaver: Autosave started" << std::endl;
+    }
+}
+
+void SceneSaver::ResetSaveCache()
+{
+    saveState.cache.clear();
+    saveState.metadata = json();
+    saveState.path.clear();
+}
+
+bool SceneSaver::ExportSceneJson(const Scene *scene, const std::string &filepath)
+{
+    json MainJson;
+    if (!BuildSceneJson(scene, filepath, MainJson))
+    {
+        return false;
+    }
+
+    bool success = FileSystem::writeString(filepath, MainJson.dump(4));
+    if (success)
+    {
+        std::cout << "Scene exported to JSON: " << filepath << std::endl;
+    }
+    else
+    {
+        std::cerr << "Failed to export scene to: " << filepath << std::endl;
+    }
+
+    return success;
+}
+
+bool SceneSaver::ExportWorldCells(const Scene *scene, const std::string &directory, float cellSize)
+{
+    if (!scene)
+    {
+        return false;
+    }
+
+    std::vector<SceneObjectData> objects;
+    objects.reserve(scene->getGameObjects().size());
+    for (const GameObject *obj : scene->getGameObjects())
+    {
+        SceneObjectData objectData;
+        if (obj && CaptureObject(obj, objectData))
+        {
+            objects.push_back(std::move(objectData));
+        }
+    }
+
+    return WorldPartition::writeCells(objects, cellSize, directory);
+}
+
+bool SceneSaver::ExportPrefab(const GameObject *root, const std::string &filepath)
+{
+    if (!root)
+    {
+        return false;
+    }
+
+    // Raiz primero y cada padre antes que sus hijos
+    std::vector<SceneObjectData> objects;
+    std::vector<const GameObject *> stack{root};
+    while (!stack.empty())
+    {
+        const GameObject *obj = stack.back();
+        stack.pop_back();
+
+        SceneObjectData objectData;
+        if (!CaptureObject(obj, objectData))
+        {
+            continue;
+        }
+        if (obj == root)
+        {
+            objectData.parentID.clear();
+        }
+        objects.push_back(std::move(objectData));
+
+        const auto &children = obj->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            if (*it)
+            {
+                stack.push_back(*it);
+            }
+        }
+    }
+
+    if (!Prefab::save(objects, filepath))
+    {
+        std::cerr << "Failed to save prefab: " << filepath << std::endl;
+        return false;
+    }
+
+    std::cout << "Prefab saved: " << filepath << " (" << objects.size() << " objects)" << std::endl;
+    return true;
+}
+
+bool SceneSaver::BuildSceneMetadata(const Scene *scene, const std::string &filepath, json &MainJson)
 {
     if (!scene)
     {
@@ -30,10 +331,13 @@ bool SceneSaver::SaveScene(const Scene *scene, const std::string &filepath)
         return false;
     }
 
-    json MainJson;
 
-    Scene *activeScene = SceneManager::getInstance().getActiveScene();
-    RenderPipeline *pipeline = activeScene->getRenderPipeline();
+    RenderPipeline *pipeline = scene->getRenderPipeline();
+    if (!pipeline)
+    {
+        std::cerr << "Error: Scene has no render pipeline" << std::endl;
+        return false;
+    }
 
     MainJson["name"] = FileSystem::getFileNameWithoutExtension(filepath);
 
@@ -79,12 +383,6 @@ bool SceneSaver::SaveScene(const Scene *scene, const std::string &filepath)
                   << ", Smoothness: " << smoothness << std::endl;
     }
 
-    if (!activeScene)
-    {
-        std::cerr << "Error: No active scene" << std::endl;
-        return false;
-    }
-
     try
     {
         TileEditor *tileEditor = RenderWindows::getInstance().GetWindow<TileEditor>();
@@ -104,46 +402,64 @@ bool SceneSaver::SaveScene(const Scene *scene, const std::string &filepath)
         MainJson["TileData"] = json::array();
     }
 
-    const auto &gameObjects = activeScene->getGameObjects();
+    return true;
+}
+
+bool SceneSaver::BuildSceneJson(const Scene *scene, const std::string &filepath, json &MainJson)
+{
+    if (!BuildSceneMetadata(scene, filepath, MainJson))
+    {
+        return false;
+    }
+
+    const auto &gameObjects = scene->getGameObjects();
     for (size_t i = 0; i < gameObjects.size(); i++)
     {
-        GameObject *obj = gameObjects[i];
-        if (!obj || !obj->isValid())
+        SceneObjectData objectData;
+        if (CaptureObject(gameObjects[i], objectData))
         {
-            continue;
+            MainJson["objects"].push_back(SceneConverter::objectDataToJson(objectData));
         }
+    }
 
-        json subObject;
+    return true;
+}
 
-        // Datos básicos del objeto
-        subObject["Name"] = obj->Name;
-        subObject["Tag"] = obj->Tag;
-        subObject["ObjectID"] = obj->ObjectID;
-        subObject["position"] = {obj->getWorldPosition().x, obj->getWorldPosition().y, obj->getWorldPosition().z};
-        subObject["rotation"] = {obj->getWorldRotationEuler().x, obj->getWorldRotationEuler().y, obj->getWorldRotationEuler().z};
-        subObject["scale"] = {obj->getLocalScale().x, obj->getLocalScale().y, obj->getLocalScale().z};
+bool SceneSaver::CaptureObject(const GameObject *obj, SceneObjectData &outData,
+                               std::vector<uint64_t> *componentHashes, std::vector<int> *componentSlots)
+{
+    if (!obj || !obj->isValid())
+    {
+        return false;
+    }
 
-        // Guardar información del padre si existe
-        if (obj->hasParent())
-        {
-            GameObject *parent = obj->getParent();
-            if (parent && parent->isValid())
-            {
-                subObject["parentID"] = parent->ObjectID;
-            }
-        }
+    outData = SceneObjectData();
 
-        json components;
+    // Datos básicos del objeto
+    outData.name = obj->Name;
+    outData.tag = obj->Tag;
+    outData.objectID = obj->ObjectID;
+    outData.position = obj->getWorldPosition();
+    outData.rotation = obj->getWorldRotationEuler();
+    outData.scale = obj->getLocalScale();
 
-        auto saveComponent = [](const Component *comp, json &salida)
+    // Guardar información del padre si existe
+    if (obj->hasParent())
+    {
+        GameObject *parent = obj->getParent();
+        if (parent && parent->isValid())
         {
-            if (!comp)
-                return;
+            outData.parentID = parent->ObjectID;
+        }
+    }
 
-            std::string serialized = comp->serializeComponent();
-            if (serialized.find_first_not_of(" \t\n\r") == std::string::npos)
-                return;
+    for (const Component *comp : obj->getAllComponents())
+    {
+        std::string serialized = comp->serializeComponent();
+        int slot = -1;
 
+        if (serialized.find_first_not_of(" \t\n\r") != std::string::npos)
+        {
             try
             {
                 json data = json::parse(serialized);
@@ -167,73 +483,56 @@ bool SceneSaver::SaveScene(const Scene *scene, const std::string &filepath)
                     data["type"] = rawType;
                 }
 
-                salida["component"].push_back(data);
+                slot = static_cast<int>(outData.components.size());
+                outData.components.push_back(std::move(data));
             }
             catch (const json::parse_error &e)
             {
                 std::cerr << "Error al parsear JSON del componente (" << typeid(*comp).name() << "): " << e.what() << "\n";
             }
-        };
-
-        for (auto &get : obj->getAllComponents())
-        {
-            saveComponent(get, components);
         }
 
-        // Mesh/Geometry
-        if (obj->hasGeometry())
+        if (componentHashes)
         {
-            try
-            {
-                auto *geometry = obj->getGeometry();
-                if (geometry != nullptr)
-                {
-                    const std::string &modelPath = obj->getModelPath();
-                    if (!modelPath.empty())
-                    {
-                        json geometryData;
-                        geometryData["modelPath"] = modelPath;
-                        components["Geometry"] = geometryData;
-                    }
-                }
-            }
-            catch (const std::exception &e)
-            {
-                std::cerr << "Error saving geometry component: " << e.what() << std::endl;
-            }
+            componentHashes->push_back(HashComponentState(comp, serialized));
         }
-
-        // Material
-        if (obj && obj->getMaterial())
+        if (componentSlots)
         {
-            json materialData;
-            materialData["exists"] = true;
-            components["Material"] = materialData;
-            components["MaterialName"] = obj->getMaterial().get()->getName();
+            componentSlots->push_back(slot);
         }
-
-        // Añadir componentes al objeto
-        subObject["components"] = components;
-        MainJson["objects"].push_back(subObject);
     }
 
-    bool success = FileSystem::writeString(filepath, MainJson.dump(4));
-    if (success)
+    // Mesh/Geometry
+    if (obj->hasGeometry() && obj->getGeometry() != nullptr)
     {
-        std::cout << "Scene saved successfully to: " << filepath << std::endl;
+        outData.modelPath = obj->getModelPath();
     }
-    else
+
+    // Material
+    if (obj->getMaterial())
     {
-        std::cerr << "Failed to save scene to: " << filepath << std::endl;
+        outData.hasMaterial = true;
+        outData.materialName = obj->getMaterial()->getName();
     }
 
-    return success;
+    return true;
+}
+
+uint64_t SceneSaver::HashComponentState(const Component *comp, const std::string &serialized)
+{
+    uint64_t hash = CorePackCodec::Hash64(serialized.data(), serialized.size());
+    bool active = comp->isActive();
+    return CorePackCodec::Hash64(&active, sizeof(active), hash);
 }
 
 bool SceneSaver::LoadScene(const std::string &filepath)
 {
     auto &sceneManager = SceneManager::getInstance();
 
+    // Un guardado en curso puede estar escribiendo este mismo archivo
+    WaitForSave();
+    ResetSaveCache();
+
     // 1. Limpiar completamente la escena anterior si existe
     Scene *currentScene = sceneManager.getActiveScene();
     if (currentScene)
@@ -243,7 +542,8 @@ bool SceneSaver::LoadScene(const std::string &filepath)
         // Limpiar componentes de física de la escena anterior
         sceneManager.cleanupPhysicsComponents(currentScene);
 
-        // Limpiar completamente la escena anterior
+        // Limpiar completamente la escena anterior (borra sus objetos)
+        Selection::GameObjectSelect = nullptr;
         currentScene->cleanup();
 
         // Limpiar el TileEditor si existe
@@ -266,25 +566,60 @@ bool SceneSaver::LoadScene(const std::string &filepath)
         std::cout << "SceneSaver: Previous scene cleaned up successfully" << std::endl;
     }
 
-    // 2. Leer el archivo JSON de escena
-    std::string jsonStr;
-    if (!FileSystem::readString(filepath, jsonStr))
-    {
-        std::cerr << "Error: No se pudo leer el archivo " << filepath << std::endl;
-        return false;
-    }
-
+    // 2. Leer la escena: binaria (mapeada, los objetos se leen registro a registro) o JSON
+    BinarySceneReader binaryScene;
     json MainJson;
-    try
+    json objectsJson = json::array();
+    bool isBinary = BinarySceneReader::isBinaryScene(filepath);
+
+    if (isBinary)
     {
-        MainJson = json::parse(jsonStr);
+        if (!binaryScene.open(filepath) || !binaryScene.readMetadata(MainJson))
+        {
+            std::cerr << "Error: No se pudo leer el archivo " << filepath << std::endl;
+            return false;
+        }
     }
-    catch (const json::parse_error &e)
+    else
     {
-        std::cerr << "Error al parsear JSON: " << e.what() << std::endl;
-        return false;
+        std::string jsonStr;
+        if (!FileSystem::readString(filepath, jsonStr))
+        {
+            std::cerr << "Error: No se pudo leer el archivo " << filepath << std::endl;
+            return false;
+        }
+
+        try
+        {
+            MainJson = json::parse(jsonStr);
+        }
+        catch (const json::parse_error &e)
+        {
+            std::cerr << "Error al parsear JSON: " << e.what() << std::endl;
+            return false;
+        }
+
+        if (!MainJson.contains("objects"))
+        {
+            std::cerr << "No hay 'objects' en el archivo de escena." << std::endl;
+            return false;
+        }
+        objectsJson = std::move(MainJson["objects"]);
+        MainJson.erase("objects");
     }
 
+    // Se llama desde varios hilos: el reader y el array de objetos solo se leen
+    size_t objectCount = isBinary ? binaryScene.getObjectCount() : objectsJson.size();
+    const json &objectsArray = objectsJson;
+    auto readObjectData = [&](size_t index, SceneObjectData &outData, bool includeComponents)
+    {
+        if (isBinary)
+        {
+            return binaryScene.readObject(index, outData, includeComponents);
+        }
+        return SceneConverter::jsonToObjectData(objectsArray[index], outData);
+    };
+
     std::string sceneName = FileSystem::getFileNameWithoutExtension(filepath);
     auto newScene = std::make_unique<Scene>(sceneName);
 
@@ -463,67 +798,65 @@ bool SceneSaver::LoadScene(const std::string &filepath)
         std::cout << "No tile data found in scene file" << std::endl;
     }
 
-    if (!MainJson.contains("objects"))
+    // Primera pasada (en paralelo): decodificar cada objeto, componentes incluidos, y construir su
+    // GameObject. Cada hilo solo toca su propio objeto; registrarlo en la escena, el render y la
+    // fisica se hace despues en el hilo principal.
+    std::vector<SceneObjectData> objectsData(objectCount);
+    std::vector<GameObject *> loadedObjects(objectCount, nullptr);
+
+    // GameObjects y componentes en los pools de la nueva escena, tambien desde los hilos de carga
+    SceneAllocator *sceneAllocator = newScene->getAllocator();
+    SceneAllocator::Scope allocatorScope(sceneAllocator);
+    newScene->reserveGameObjects(objectCount);
+
+    JobSystem::getInstance().parallelFor(objectCount, 1, [&](size_t begin, size_t end)
+                                         {
+                                             SceneAllocator::Scope workerScope(sceneAllocator);
+                                             for (size_t i = begin; i < end; i++)
+                                             {
+                                                 SceneObjectData &objectData = objectsData[i];
+                                                 if (readObjectData(i, objectData, true))
+                                                 {
+                                                     loadedObjects[i] = SceneObjectLoader::createObject(objectData);
+                                                 }
+                                             }
+                                         });
+
+    // Registrar en la escena en el orden del archivo
+    std::unordered_map<std::string, GameObject *> objectsByID;
+    objectsByID.reserve(objectCount);
+    for (GameObject *obj : loadedObjects)
     {
-        std::cerr << "No hay 'objects' en el archivo de escena." << std::endl;
-        return false;
-    }
-
-    // Primera pasada: crear todos los objetos y almacenar información de parent-child
-    std::vector<std::pair<GameObject *, std::string>> parentChildPairs; // pair<child, parentID>
-
-    for (const auto &subObject : MainJson["objects"])
-    {
-        GameObject *obj = new GameObject();
-        obj->Name = subObject.value("Name", "New Object");
-        obj->Tag = subObject.value("Tag", "");
-
-        // Cargar ObjectID si existe, sino mantener el generado automáticamente
-        if (subObject.contains("ObjectID"))
+        if (obj)
         {
-            obj->ObjectID = subObject["ObjectID"].get<std::string>();
+            newScene->addGameObject(obj);
+            objectsByID[obj->ObjectID] = obj;
         }
-
-        if (subObject.contains("position"))
-        {
-            auto pos = subObject["position"];
-            obj->setWorldPosition(glm::vec3(pos[0], pos[1], pos[2]));
-        }
-        if (subObject.contains("rotation"))
-        {
-            auto rot = subObject["rotation"];
-            obj->setWorldRotationEuler(glm::vec3(rot[0], rot[1], rot[2]));
-        }
-        if (subObject.contains("scale"))
-        {
-            auto scl = subObject["scale"];
-            obj->setLocalScale(glm::vec3(scl[0], scl[1], scl[2]));
-        }
-
-        // Almacenar información de parent-child para procesar después
-        if (subObject.contains("parentID"))
-        {
-            std::string parentID = subObject["parentID"].get<std::string>();
-            parentChildPairs.push_back({obj, parentID});
-        }
-
-        newScene->addGameObject(obj);
     }
 
     // Segunda pasada: establecer parent-child relationships
-    for (const auto &pair : parentChildPairs)
+    for (size_t i = 0; i < objectCount; i++)
     {
-        GameObject *child = pair.first;
-        const std::string &parentID = pair.second;
+        GameObject *child = loadedObjects[i];
+        const std::string &parentID = objectsData[i].parentID;
+        if (!child || parentID.empty())
+        {
+            continue;
+        }
 
-        // Buscar el padre en la escena por ID
+        // Las escenas binarias guardan el indice del padre; las JSON se buscan por ID
         GameObject *parent = nullptr;
-        for (GameObject *obj : newScene->getGameObjects())
+        int parentIndex = objectsData[i].parentIndex;
+        if (parentIndex >= 0 && parentIndex < static_cast<int>(loadedObjects.size()))
         {
-            if (obj->ObjectID == parentID)
+            parent = loadedObjects[parentIndex];
+        }
+        else
+        {
+            auto it = objectsByID.find(parentID);
+            if (it != objectsByID.end())
             {
-                parent = obj;
-                break;
+                parent = it->second;
             }
         }
 
@@ -538,174 +871,29 @@ bool SceneSaver::LoadScene(const std::string &filepath)
         }
     }
 
-    // Tercera pasada: cargar componentes para todos los objetos
-    for (size_t i = 0; i < MainJson["objects"].size(); i++)
+    // Tercera pasada: añadir componentes (start() crea actores de fisica, scripts, sonidos...) a
+    // partir de los nodos ya decodificados
+    for (size_t i = 0; i < objectCount; i++)
     {
-        const auto &subObject = MainJson["objects"][i];
-        GameObject *obj = newScene->getGameObjects()[i];
-
-        if (subObject.contains("components"))
+        GameObject *obj = loadedObjects[i];
+        const SceneObjectData &objectData = objectsData[i];
+        if (!obj)
         {
-            const json &components = subObject["components"];
-            if (components.contains("component"))
-            {
-                for (const auto &compData : components["component"])
-                {
-                    if (compData.contains("type"))
-                    {
-                        try
-                        {
-                            std::string type = compData.at("type").get<std::string>();
-
-                            if (type == "ScriptExecutor")
-                            {
-                                auto *scriptComp = obj->addComponent<ScriptExecutor>();
-                                scriptComp->deserialize(compData.dump());
-
-                                if (compData.at("enabled").get<bool>() == true)
-                                {
-                                    scriptComp->enable();
-                                }
-                                else
-                                {
-                                    scriptComp->disable();
-                                }
-                            }
-                            else if (type == "LightComponent")
-                            {
-                                auto *lightComp = obj->addComponent<LightComponent>();
-                                lightComp->deserialize(compData.dump());
-
-                                if (compData.at("enabled").get<bool>() == true)
-                                {
-                                    lightComp->enable();
-                                }
-                                else
-                                {
-                                    lightComp->disable();
-                                }
-                            }
-                            else if (type == "AudioSource")
-                            {
-                                auto *audioComp = obj->addComponent<AudioSource>();
-                                audioComp->deserialize(compData.dump());
-
-                                if (compData.at("enabled").get<bool>() == true)
-                                {
-                                    audioComp->enable();
-                                }
-                                else
-                                {
-                                    audioComp->disable();
-                                }
-                            }
-                            else if (type == "PhysicalObject")
-                            {
-                                auto *physComp = obj->addComponent<PhysicalObject>(obj);
-                                physComp->initializePhysics();
-                                physComp->deserialize(compData.dump());
-
-                                if (compData.at("enabled").get<bool>() == true)
-                                {
-                                    physComp->enable();
-                                }
-                                else
-                                {
-                                    physComp->disable();
-                                }
-                            }
-                            else if (type == "CharacterController")
-                            {
-                                auto *ccComp = obj->addComponent<CharacterController>();
-                                ccComp->deserialize(compData.dump());
-
-                                if (compData.at("enabled").get<bool>() == true)
-                                {
-                                    ccComp->enable();
-                                }
-                                else
-                                {
-                                    ccComp->disable();
-                                }
-                            }
-                            else if (type == "SpriteAnimator")
-                            {
-                                auto *spaComp = obj->addComponent<SpriteAnimator>();
-                                spaComp->deserialize(compData.dump());
-
-                                if (compData.at("enabled").get<bool>() == true)
-                                {
-                                    spaComp->enable();
-                                }
-                                else
-                                {
-                                    spaComp->disable();
-                                }
-                            }
-                            else if (type == "Collider")
-                            {
-                                auto *clComp = obj->addComponent<Collider>(obj);
-                                clComp->deserialize(compData.dump());
-
-                                if (compData.at("enabled").get<bool>() == true)
-                                {
-                                    clComp->enable();
-                                }
-                                else
-                                {
-                                    clComp->disable();
-                                }
-                            }
-                            else if (type == "Rigidbody")
-                            {
-                                auto *rgComp = obj->addComponent<Rigidbody>(obj);
-                                rgComp->deserialize(compData.dump());
-
-                                if (compData.at("enabled").get<bool>() == true)
-                                {
-                                    rgComp->enable();
-                                }
-                                else
-                                {
-                                    rgComp->disable();
-                                }
-                            }
-                        }
-                        catch (const nlohmann::json::exception &e)
-                        {
-                            std::cerr << "Error al cargar componente: " << e.what() << std::endl;
-                            std::cerr << "CompData problemático:\n"
-                                      << compData.dump(4) << std::endl;
-                        }
-                    }
-                }
-            }
-
-            if (components.contains("Geometry"))
-            {
-                const std::string &modelPath = components["Geometry"]["modelPath"].get<std::string>();
-                obj->setModelPath(modelPath);
-                obj->loadModelFromPath();
-
-                std::cout << "Loading Model: " << modelPath << std::endl;
-            }
+            continue;
+        }
 
-            EditorInfo::pipeline->listMaterials();
+        for (const auto &compData : objectData.components)
+        {
+            SceneObjectLoader::addComponentFromData(obj, compData);
+        }
 
-            if (components.contains("MaterialName"))
-            {
-                std::string matName = components["MaterialName"].get<std::string>();
+        EditorInfo::pipeline->listMaterials();
 
-                auto material = newScene.get()->getRenderPipeline()->getMaterial(matName);
-                if (material)
-                {
-                    obj->setMaterial(material);
-                    std::cout << "MaterialSetup" << std::endl;
-                }
-            }
-        }
+        SceneObjectLoader::applyModelAndMaterial(newScene.get(), obj, objectData);
     }
 
+    sceneAllocator->logStats(sceneName + " after load");
+
     newScene->initialize();
     newScene->setInitialized(true);
 
@@ -4,11 +4,42 @@
 #include "core/CoreExporter.h"
 #include <components/SceneManager.h>
 #include <nlohmann/json.hpp>
+#include <core/BinaryScene.h>
+#include <vector>
 
 class SceneSaver {
 public:
+    // Guarda en formato binario (ver core/SceneFormat.h). Solo se reserializan los objetos modificados
+    // desde el ultimo guardado (GameObject::getRevision o el hash del estado de sus componentes); el
+    // resto reutiliza sus datos ya codificados.
     static bool SaveScene(const Scene* scene, const std::string& filepath);
+    // Toma la copia de la escena en el hilo principal y codifica/escribe en segundo plano.
+    // Devuelve false si no se inicio (error, o sin cambios con onlyIfChanged)
+    static bool SaveSceneAsync(const Scene* scene, const std::string& filepath, bool onlyIfChanged = false);
+    static bool IsSaving();
+    // Espera al guardado en curso y devuelve su resultado
+    static bool WaitForSave();
+    // Llamar cada frame fuera de Play; guarda cada EditorInfo::AutosaveInterval segundos si hubo cambios
+    static void UpdateAutosave(const Scene* scene, const std::string& filepath, float deltaTime);
+    // JSON legible, para intercambio/control de versiones
+    static bool ExportSceneJson(const Scene* scene, const std::string& filepath);
+    // Divide los objetos en celdas para WorldPartition (world.json + una escena por celda)
+    static bool ExportWorldCells(const Scene* scene, const std::string& directory, float cellSize);
+    // Guarda root y sus descendientes como prefab (ver components/Prefab.h)
+    static bool ExportPrefab(const GameObject* root, const std::string& filepath);
+    // Acepta escenas binarias y JSON
     static bool LoadScene(const std::string& filepath);
 
     static Scene* MakeNewScene(std::string sceneName);
+
+    // Datos de un objeto tal como se guardan en la escena. Opcionalmente devuelve, por cada componente
+    // del objeto, el hash de su estado y su indice en outData.components (-1 si no se pudo guardar)
+    static bool CaptureObject(const GameObject* obj, SceneObjectData& outData,
+                              std::vector<uint64_t>* componentHashes = nullptr, std::vector<int>* componentSlots = nullptr);
+    static uint64_t HashComponentState(const Component* comp, const std::string& serialized);
+
+private:
+    static void ResetSaveCache();
+    static bool BuildSceneMetadata(const Scene* scene, const std::string& filepath, nlohmann::json& MainJson);
+    static bool BuildSceneJson(const Scene* scene, const std::string& filepath, nlohmann::json& MainJson);
 };
\ No newline at end of file
@@ -0,0 +1,471 @@
+#include "SceneSnapshot.h"
+#include "SceneSaver.h"
+#include <components/Scene.h>
+#include <components/GameObject.h>
+#include <components/ScriptExecutor.h>
+#include <components/PhysicalObject.h>
+#include <components/Rigidbody.h>
+#include <components/Collider.h>
+#include <components/CharacterController.h>
+#include <components/SceneObjectLoader.h>
+#include <render/Camera.h>
+#include "Windows/Selection.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    glm::vec3 toVec3(const float (&v)[3])
+    {
+        return glm::vec3(v[0], v[1], v[2]);
+    }
+
+    bool nearlyEqual(const glm::vec3 &a, const glm::vec3 &b, float epsilon)
+    {
+        return std::fabs(a.x - b.x) <= epsilon && std::fabs(a.y - b.y) <= epsilon && std::fabs(a.z - b.z) <= epsilon;
+    }
+
+    // Lleva los actores de PhysX a la posicion restaurada y los deja parados
+    void syncPhysics(GameObject *obj)
+    {
+        if (auto *physical = obj->getComponent<PhysicalObject>())
+        {
+            physical->syncTransformToPhysX();
+            if (physical->getBodyType() == BodyType::Dynamic)
+            {
+                physical->setVelocity(glm::vec3(0.0f));
+            }
+        }
+        if (auto *rigidbody = obj->getComponent<Rigidbody>())
+        {
+            rigidbody->syncTransformToPhysX();
+            rigidbody->setVelocity(glm::vec3(0.0f));
+        }
+        if (auto *collider = obj->getComponent<Collider>())
+        {
+            collider->syncTransformToPhysX();
+        }
+        if (auto *controller = obj->getComponent<CharacterController>())
+        {
+            controller->teleport(obj->getWorldPosition());
+        }
+    }
+}
+
+bool SceneSnapshot::capture(Scene *scene)
+{
+    clear();
+    if (!scene)
+    {
+        std::cerr << "SceneSnapshot: No active scene to capture" << std::endl;
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    BinarySceneWriter writer;
+    for (GameObject *obj : scene->getGameObjects())
+    {
+        SceneObjectData objectData;
+        ObjectState state;
+        if (!SceneSaver::CaptureObject(obj, objectData, &state.componentHashes, &state.componentSlots))
+        {
+            continue;
+        }
+
+        for (const Component *comp : obj->getAllComponents())
+        {
+            state.componentTypes.push_back(&typeid(*comp));
+        }
+        state.material = obj->getMaterial();
+        state.active = obj->isActive();
+
+        writer.addObject(objectData);
+        objects.push_back(std::move(state));
+    }
+
+    if (!writer.writeToBuffer(buffer) || !reader.openMemory(buffer.data(), buffer.size()))
+    {
+        std::cerr << "SceneSnapshot: Failed to capture scene " << scene->getName() << std::endl;
+        clear();
+        return false;
+    }
+
+    if (Camera *camera = scene->getCamera())
+    {
+        cameraPosition = camera->getPosition();
+        cameraForward = camera->getForward();
+    }
+
+    sceneName = scene->getName();
+    valid = true;
+
+    stats.objectCount = objects.size();
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "SceneSnapshot: Captured " << stats.objectCount << " objects (" << buffer.size() / 1024 << " KB) in "
+              << stats.milliseconds << " ms" << std::endl;
+    return true;
+}
+
+bool SceneSnapshot::restore(Scene *scene)
+{
+    if (!valid || !scene)
+    {
+        return false;
+    }
+    if (scene->getName() != sceneName)
+    {
+        std::cerr << "SceneSnapshot: Active scene changed during play (" << sceneName << " -> " << scene->getName() << ")" << std::endl;
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    SceneAllocator::Scope allocatorScope(scene->getAllocator());
+    stats = SceneSnapshotStats();
+    stats.objectCount = objects.size();
+
+    size_t count = reader.getObjectCount();
+
+    std::unordered_map<std::string, GameObject *> liveObjects;
+    liveObjects.reserve(scene->getGameObjects().size());
+    for (GameObject *obj : scene->getGameObjects())
+    {
+        if (obj && obj->isValid())
+        {
+            liveObjects[obj->ObjectID] = obj;
+        }
+    }
+
+    // Un objeto se reutiliza si sigue vivo con los mismos tipos de componente; si no, se recrea
+    std::vector<GameObject *> targets(count, nullptr);
+    std::vector<char> recreate(count, 0);
+    std::unordered_set<GameObject *> kept;
+    kept.reserve(count);
+    size_t replacedCount = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const SceneObjectRecord &record = reader.getObjectRecord(i);
+        auto it = liveObjects.find(std::string(reader.getString(record.objectID)));
+        if (it != liveObjects.end())
+        {
+            std::vector<const Component *> components = it->second->getAllComponents();
+            const ObjectState &state = objects[i];
+            bool sameComponents = components.size() == state.componentTypes.size();
+            for (size_t k = 0; sameComponents && k < components.size(); k++)
+            {
+                sameComponents = typeid(*components[k]) == *state.componentTypes[k];
+            }
+
+            if (sameComponents)
+            {
+                targets[i] = it->second;
+                kept.insert(it->second);
+                continue;
+            }
+            replacedCount++;
+        }
+        recreate[i] = 1;
+    }
+
+    // Quitar los objetos creados durante el juego y los que se van a recrear. Antes se desvinculan
+    // todos: al borrar un objeto se destruyen sus hijos, que pueden ser objetos que se conservan.
+    std::vector<GameObject *> toRemove;
+    for (GameObject *obj : scene->getGameObjects())
+    {
+        if (obj && kept.find(obj) == kept.end())
+        {
+            toRemove.push_back(obj);
+        }
+    }
+
+    for (GameObject *obj : toRemove)
+    {
+        std::vector<GameObject *> children = obj->getChildren();
+        for (GameObject *child : children)
+        {
+            if (child)
+            {
+                child->setParentNoWorldPreserve(nullptr);
+            }
+        }
+        obj->setParentNoWorldPreserve(nullptr);
+    }
+
+    for (GameObject *obj : toRemove)
+    {
+        if (Selection::GameObjectSelect == obj)
+        {
+            Selection::GameObjectSelect = nullptr;
+        }
+        scene->removeGameObject(obj);
+    }
+
+    // Recrear (sin componentes todavia: necesitan el transform y la jerarquia ya restaurados)
+    std::unordered_map<size_t, SceneObjectData> recreatedData;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!recreate[i])
+        {
+            continue;
+        }
+
+        SceneObjectData objectData;
+        if (!reader.readObject(i, objectData, true))
+        {
+            continue;
+        }
+
+        GameObject *obj = new GameObject();
+        obj->setName(objectData.name);
+        obj->setTag(objectData.tag);
+        if (!objectData.objectID.empty())
+        {
+            obj->setObjectID(objectData.objectID);
+        }
+
+        scene->addGameObject(obj);
+        targets[i] = obj;
+        recreatedData.emplace(i, std::move(objectData));
+    }
+    stats.removedCount = toRemove.size() - replacedCount;
+
+    // Jerarquia: primero se sueltan los que cambiaron de padre para que una jerarquia invertida
+    // durante el juego no bloquee el setParent (no se puede colgar un objeto de su propio hijo)
+    std::vector<size_t> reparent;
+    for (size_t i = 0; i < count; i++)
+    {
+        GameObject *obj = targets[i];
+        if (!obj)
+        {
+            continue;
+        }
+
+        int32_t parentIndex = reader.getObjectRecord(i).parentIndex;
+        GameObject *parent = parentIndex >= 0 ? targets[parentIndex] : nullptr;
+        if (obj->getParent() != parent)
+        {
+            obj->setParentNoWorldPreserve(nullptr);
+            reparent.push_back(i);
+        }
+    }
+
+    for (size_t i : reparent)
+    {
+        int32_t parentIndex = reader.getObjectRecord(i).parentIndex;
+        if (parentIndex >= 0 && targets[parentIndex])
+        {
+            targets[i]->setParentNoWorldPreserve(targets[parentIndex]);
+        }
+    }
+
+    // Transform, de padres a hijos: el transform guardado es de mundo
+    std::vector<int> depth(count, -1);
+    for (size_t i = 0; i < count; i++)
+    {
+        int d = 0;
+        for (int32_t p = reader.getObjectRecord(i).parentIndex; p >= 0 && d <= static_cast<int>(count); p = reader.getObjectRecord(p).parentIndex)
+        {
+            d++;
+        }
+        depth[i] = d;
+    }
+
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                     { return depth[a] < depth[b]; });
+
+    std::vector<char> moved(count, 0);
+    for (size_t i : order)
+    {
+        GameObject *obj = targets[i];
+        if (!obj)
+        {
+            continue;
+        }
+
+        const SceneObjectRecord &record = reader.getObjectRecord(i);
+        glm::vec3 position = toVec3(record.position);
+        glm::vec3 rotation = toVec3(record.rotation);
+        glm::vec3 scale = toVec3(record.scale);
+
+        // Un hijo se mueve con su padre, asi que sus actores de fisica tambien hay que recolocarlos
+        bool parentMoved = record.parentIndex >= 0 && moved[record.parentIndex];
+        bool changed = recreate[i] ||
+                       !nearlyEqual(obj->getWorldPosition(), position, 1e-4f) ||
+                       !nearlyEqual(obj->getWorldRotationEuler(), rotation, 1e-3f) ||
+                       !nearlyEqual(obj->getLocalScale(), scale, 1e-4f);
+
+        if (changed)
+        {
+            obj->setWorldPosition(position);
+            obj->setWorldRotationEuler(rotation);
+            obj->setLocalScale(scale);
+        }
+        moved[i] = changed || parentMoved;
+    }
+
+    // Componentes: solo los que cambiaron. Los scripts siempre, su estado Lua no se ve en el hash.
+    for (size_t i = 0; i < count; i++)
+    {
+        GameObject *obj = targets[i];
+        if (!obj)
+        {
+            continue;
+        }
+
+        auto recreated = recreatedData.find(i);
+        if (recreated != recreatedData.end())
+        {
+            for (const auto &compData : recreated->second.components)
+            {
+                SceneObjectLoader::addComponentFromData(obj, compData);
+            }
+            SceneObjectLoader::applyModelAndMaterial(scene, obj, recreated->second);
+            stats.recreatedCount++;
+            continue;
+        }
+
+        const ObjectState &state = objects[i];
+        const SceneObjectRecord &record = reader.getObjectRecord(i);
+        bool propertiesChanged = false;
+
+        std::string name(reader.getString(record.name));
+        if (obj->Name != name)
+        {
+            obj->setName(name);
+            propertiesChanged = true;
+        }
+
+        std::string tag(reader.getString(record.tag));
+        if (obj->Tag != tag)
+        {
+            obj->setTag(tag);
+            propertiesChanged = true;
+        }
+
+        std::string modelPath(reader.getString(record.modelPath));
+        if (obj->getModelPath() != modelPath)
+        {
+            obj->setModelPath(modelPath);
+            if (!modelPath.empty())
+            {
+                obj->loadModelFromPath();
+            }
+            else
+            {
+                obj->setGeometry(nullptr);
+            }
+            propertiesChanged = true;
+        }
+
+        if (state.material && obj->getMaterial() != state.material)
+        {
+            obj->setMaterial(state.material);
+            propertiesChanged = true;
+        }
+
+        size_t recordCount = 0;
+        const SceneComponentRecord *records = reader.getComponentRecords(i, recordCount);
+        std::vector<const Component *> components = obj->getAllComponents();
+        bool componentsChanged = false;
+
+        for (size_t k = 0; k < components.size(); k++)
+        {
+            Component *comp = const_cast<Component *>(components[k]);
+            int slot = state.componentSlots[k];
+            if (slot < 0 || static_cast<size_t>(slot) >= recordCount)
+            {
+                continue;
+            }
+
+            bool isScript = dynamic_cast<ScriptExecutor *>(comp) != nullptr;
+            if (!isScript && SceneSaver::HashComponentState(comp, comp->serializeComponent()) == state.componentHashes[k])
+            {
+                continue;
+            }
+
+            nlohmann::json compData;
+            if (!reader.readComponent(records[slot], compData))
+            {
+                continue;
+            }
+
+            comp->deserializeJson(compData);
+            if (compData.value("enabled", true))
+            {
+                comp->enable();
+            }
+            else
+            {
+                comp->disable();
+            }
+            componentsChanged = true;
+            stats.componentCount++;
+        }
+
+        if (moved[i])
+        {
+            syncPhysics(obj);
+        }
+
+        if (propertiesChanged)
+        {
+            stats.propertyCount++;
+        }
+
+        if (!moved[i] && !componentsChanged && !propertiesChanged)
+        {
+            stats.unchangedCount++;
+        }
+        else if (moved[i] && !componentsChanged && !propertiesChanged)
+        {
+            stats.transformCount++;
+        }
+    }
+
+    // Activo al final y de padres a hijos: setActive se propaga a los hijos y avisa a los componentes
+    for (size_t i : order)
+    {
+        GameObject *obj = targets[i];
+        if (obj && obj->isActive() != objects[i].active)
+        {
+            obj->setActive(objects[i].active);
+        }
+    }
+
+    if (Camera *camera = scene->getCamera())
+    {
+        camera->setPosition(cameraPosition);
+        float yaw = atan2(cameraForward.x, cameraForward.z);
+        float pitch = asin(-cameraForward.y);
+        camera->setRotation(yaw, pitch);
+    }
+
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "SceneSnapshot: Restored " << stats.objectCount << " objects in " << stats.milliseconds << " ms ("
+              << stats.unchangedCount << " unchanged, " << stats.transformCount << " transform only, "
+              << stats.componentCount << " components, " << stats.propertyCount << " properties, " << stats.recreatedCount << " recreated, "
+              << stats.removedCount << " removed)" << std::endl;
+    return true;
+}
+
+void SceneSnapshot::clear()
+{
+    reader.close();
+    buffer.clear();
+    buffer.shrink_to_fit();
+    objects.clear();
+    sceneName.clear();
+    stats = SceneSnapshotStats();
+    valid = false;
+}
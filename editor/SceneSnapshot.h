@@ -0,0 +1,57 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <glm/glm.hpp>
+#include <core/BinaryScene.h>
+
+class Scene;
+class GameObject;
+class Material;
+
+struct SceneSnapshotStats {
+    size_t objectCount = 0;
+    size_t unchangedCount = 0;          // Sin cambios: no se toca nada
+    size_t transformCount = 0;          // Solo se restauro el transform
+    size_t componentCount = 0;          // Componentes restaurados (estado distinto o scripts)
+    size_t propertyCount = 0;           // Objetos con nombre, tag, activo, modelo o material restaurados
+    size_t recreatedCount = 0;          // Destruidos o con otros componentes durante el juego
+    size_t removedCount = 0;            // Creados durante el juego
+    double milliseconds = 0.0;
+};
+
+// Copia en memoria de la escena al pulsar Play, restaurada al pulsar Stop sin pasar por disco.
+// Los objetos se guardan en el formato binario de escena (transform + componentes en CBOR) junto con
+// un hash del estado de cada componente; al restaurar solo se tocan los objetos que cambiaron.
+// Los ScriptExecutor se deserializan siempre: el estado de su VM de Lua no entra en el hash, asi que
+// no hay forma barata de saber si el script cambio algo durante el juego.
+class SceneSnapshot {
+public:
+    bool capture(Scene* scene);
+    bool restore(Scene* scene);
+    void clear();
+
+    bool isValid() const { return valid; }
+    const SceneSnapshotStats& getLastStats() const { return stats; }
+
+private:
+    struct ObjectState {
+        std::vector<uint64_t> componentHashes;  // Uno por componente vivo al capturar
+        std::vector<int> componentSlots;        // Indice del componente en el registro, -1 si no se guardo
+        std::vector<const std::type_info*> componentTypes;
+        std::shared_ptr<Material> material;     // El formato solo guarda el nombre; aqui el puntero exacto
+        bool active = true;                     // El formato de escena no guarda si esta activo
+    };
+
+    std::string sceneName;
+    std::vector<char> buffer;
+    BinarySceneReader reader;
+    std::vector<ObjectState> objects;           // Mismo orden que los registros del buffer
+
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    glm::vec3 cameraForward = glm::vec3(0.0f, 0.0f, -1.0f);
+
+    SceneSnapshotStats stats;
+    bool valid = false;
+};
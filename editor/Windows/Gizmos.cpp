@@ -1,6 +1,7 @@
 #include "Gizmos.h"
 #include "components/SceneManager.h"
 #include "components/GameObject.h"
+#include "components/ObjectPool.h"
 #include "render/Camera.h"
 #include "render/Framebuffer.h"
 #include "Selection.h"
@@ -14,37 +15,44 @@ void Gizmos::OnRenderGUI() {
     // Botón de Play/Stop
     if (EditorInfo::IsPlaying) {
         if (ImGui::Button("Stop")) {
-            std::cout << "Gizmos: Stop button pressed - Reloading scene..." << std::endl;
-            
-            // Verificar que tenemos una ruta de escena válida
-            if (EditorInfo::currentScenePath.empty()) {
-                std::cerr << "Gizmos: ERROR - No current scene path available for reload!" << std::endl;
-                std::cerr << "Gizmos: Please save the scene first or load a scene file" << std::endl;
-                return;
-            }
-            
-            std::cout << "Gizmos: Current scene path: " << EditorInfo::currentScenePath << std::endl;
+            std::cout << "Gizmos: Stop button pressed - Restoring scene..." << std::endl;
             
             // Detener el modo de juego PRIMERO
             EditorInfo::IsPlaying = false;
             std::cout << "Gizmos: Game mode stopped" << std::endl;
             
-            // Recargar la escena usando SceneSaver (que ya incluye limpieza automática)
-            std::cout << "Gizmos: Starting scene reload..." << std::endl;
-            bool success = SceneSaver::LoadScene(EditorInfo::currentScenePath);
-            
-            if (success) {
-                std::cout << "Gizmos: Scene reloaded successfully!" << std::endl;
-                std::cout << "Gizmos: Scene is now ready for editing" << std::endl;
-            } else {
-                std::cerr << "Gizmos: ERROR - Failed to reload scene!" << std::endl;
-                std::cerr << "Gizmos: The scene may be in an inconsistent state" << std::endl;
+            // Las celdas cargadas durante el juego no forman parte de la copia
+            SceneManager::getInstance().getWorldPartition().close();
+            // Los objetos de los pools desaparecen con la restauracion
+            ObjectPoolManager::getInstance().clear(false);
+
+            // Restaurar desde la copia en memoria tomada al pulsar Play (sin releer el archivo)
+            Scene* activeScene = SceneManager::getInstance().getActiveScene();
+            if (playSnapshot.isValid() && playSnapshot.restore(activeScene)) {
+                std::cout << "Gizmos: Scene restored from play snapshot" << std::endl;
+            }
+            else if (!EditorInfo::currentScenePath.empty()) {
+                // Si el juego cambio de escena o no se pudo capturar, se recarga desde disco
+                std::cout << "Gizmos: Reloading scene from: " << EditorInfo::currentScenePath << std::endl;
+                if (SceneSaver::LoadScene(EditorInfo::currentScenePath)) {
+                    std::cout << "Gizmos: Scene reloaded successfully!" << std::endl;
+                } else {
+                    std::cerr << "Gizmos: ERROR - Failed to reload scene!" << std::endl;
+                    std::cerr << "Gizmos: The scene may be in an inconsistent state" << std::endl;
+                }
             }
+            else {
+                std::cerr << "Gizmos: ERROR - No snapshot or scene path available to restore the scene" << std::endl;
+            }
+            playSnapshot.clear();
         }
     }
     else {
         if (ImGui::Button("Play")) {
             std::cout << "Gizmos: Play button pressed - Starting game mode" << std::endl;
+            if (!playSnapshot.capture(SceneManager::getInstance().getActiveScene())) {
+                std::cerr << "Gizmos: Warning - Could not capture the scene, Stop will reload it from disk" << std::endl;
+            }
             EditorInfo::IsPlaying = true;
         }
     }
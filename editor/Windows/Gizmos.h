@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "../SceneSnapshot.h"
 
 // Forward declarations
 class GameObject;
@@ -19,4 +20,8 @@ public:
         static const std::string name = "Gizmos";
         return name;
     }
+
+private:
+    // Estado de la escena al pulsar Play; se restaura al pulsar Stop
+    SceneSnapshot playSnapshot;
 };
\ No newline at end of file
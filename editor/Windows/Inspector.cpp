@@ -367,6 +367,14 @@ void Inspector::OnRenderGUI()
     if (go != nullptr && go->isValid())
     {
         RenderGameObjectInspector(go);
+
+        // Pista para el guardado incremental; los cambios de componentes que no pasen por aqui los
+        // detecta igualmente el hash de su estado (SceneSaver::SaveSceneAsync)
+        if (Selection::GameObjectSelect == go && ImGui::IsAnyItemActive() &&
+            ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows))
+        {
+            go->markDirty();
+        }
     }
     else
     {
@@ -389,7 +397,7 @@ void Inspector::RenderGameObjectInspector(GameObject *go)
     strncpy_s(nameBuffer, sizeof(nameBuffer), go->Name.c_str(), _TRUNCATE);
     if (ImGui::InputText("Name", nameBuffer, sizeof(nameBuffer)))
     {
-        go->Name = std::string(nameBuffer);
+        go->setName(std::string(nameBuffer));
     }
 
     RenderRenderingOptions(go);
@@ -13,6 +13,8 @@
 #include <iostream>
 #include "../Windows/FileExplorer.h"
 #include <mpak/MantraxCorePackBuilder.h>
+#include <mpak/MantraxCorePackBenchmark.h>
+#include <core/PhysicsBroadPhaseBenchmark.h>
 #include "CanvasManager.h"
 
 // Declaración de la variable externa
@@ -51,6 +53,28 @@ void MainBar::OnRenderGUI() {
 			boolOpenedPopup = true;
 		}
 
+		if (ImGui::MenuItem("Export Scene as JSON")) {
+			// Las escenas se guardan en binario; el JSON queda junto a ella para intercambio/diff
+			Scene* activeScene = SceneManager::getInstance().getActiveScene();
+			if (activeScene && !EditorInfo::currentScenePath.empty()) {
+				SceneSaver::ExportSceneJson(activeScene, EditorInfo::currentScenePath + ".json");
+			}
+		}
+
+		if (ImGui::MenuItem("Save Selected as Prefab", nullptr, false, Selection::GameObjectSelect != nullptr)) {
+			// Content/Prefabs/<nombre>.prefab, con sus hijos
+			GameObject* selected = Selection::GameObjectSelect;
+			SceneSaver::ExportPrefab(selected, FileSystem::getContentPath("Prefabs/" + selected->Name + ".prefab"));
+		}
+
+		if (ImGui::MenuItem("Export World Partition Cells")) {
+			// Carpeta "<escena>.world" con una escena por celda, para cargarla con WorldPartition
+			Scene* activeScene = SceneManager::getInstance().getActiveScene();
+			if (activeScene && !EditorInfo::currentScenePath.empty()) {
+				SceneSaver::ExportWorldCells(activeScene, EditorInfo::currentScenePath + ".world", EditorInfo::WorldCellSize);
+			}
+		}
+
 		ImGui::Separator();
 
 		if (ImGui::MenuItem("Exit")) {
@@ -92,7 +116,7 @@ void MainBar::OnRenderGUI() {
 			if (pipeline) {
 				// Crear el objeto
 				GameObject* NewObject = new GameObject("Cube.fbx");
-				NewObject->Name = "New Object";
+				NewObject->setName("New Object");
 				NewObject->setLocalScale({ 0.010f, 0.010f, 0.010f });
 				NewObject->setLocalPosition({ 0.0f, 0.0f, 0.0f });
 				NewObject->setMaterial(pipeline->getMaterial("Default_Material"));
@@ -113,7 +137,7 @@ void MainBar::OnRenderGUI() {
 			
 			// Crear objeto vacío
 			GameObject* NewObject = new GameObject();
-			NewObject->Name = "Empty Object";
+			NewObject->setName("Empty Object");
 			NewObject->setLocalPosition({ 2.0f, 0.0f, 0.0f });
 			
 			// Agregar a la escena
@@ -132,8 +156,8 @@ void MainBar::OnRenderGUI() {
 			RenderPipeline* pipeline = activeScene->getRenderPipeline();
 			
 			if (pipeline) {
-				pipeline->clearGameObjects();
-				
+				// cleanup() quita cada objeto del pipeline y lo borra
+				Selection::GameObjectSelect = nullptr;
 				activeScene->cleanup();
 				
 				activeScene->initialize();
@@ -404,6 +428,41 @@ void MainBar::OnRenderGUI() {
 		ImGui::EndMenu();
 	}
 
+	if (ImGui::BeginMenu("Tools")) {
+		if (ImGui::MenuItem("Build Content CorePack")) {
+			// Incremental: solo se releen los archivos de Content que cambiaron desde el ultimo build
+			std::string contentDir = FileSystem::getProjectPath() + "\\Content";
+			std::string outPack = FileSystem::getProjectPackPath(FileSystem::getProjectPath());
+			FileSystem::createDirectory(FileSystem::getDirectoryPath(outPack));
+
+			// El pack montado tiene el archivo mapeado: fuera mientras se reescribe y despues se
+			// vuelve a montar el nuevo
+			FileSystem::unmount(outPack);
+			CorePackBuildOptions options;
+			options.compression = CorePackCompression::LZ4;
+			options.baseDirectory = contentDir;
+			options.verbose = false;
+			CorePackBuildStats stats;
+			if (MantraxCorePackBuilder::Build(MantraxCorePackBuilder::CollectFiles(contentDir), outPack, options, stats)) {
+				std::cout << "CorePack: " << outPack << " (" << stats.entryCount << " entradas, " << stats.reusedCount << " reutilizadas)" << std::endl;
+			}
+			else {
+				std::cerr << "CorePack: fallo al construir " << outPack << std::endl;
+			}
+			FileSystem::mountProject(FileSystem::getProjectPath(), true);
+		}
+		if (ImGui::MenuItem("CorePack Benchmark (v1 vs v2)")) {
+			std::string workDir = FileSystem::getProjectPath() + "\\Temp\\CorePackBenchmark";
+			CorePackBenchmarkResult result = MantraxCorePackBenchmark::Run(workDir);
+			MantraxCorePackBenchmark::Print(result);
+		}
+		if (ImGui::MenuItem("Physics BroadPhase Benchmark")) {
+			// Escenas temporales con cada broadphase; la de juego no se toca
+			PhysicsBroadPhaseBenchmark::Print(PhysicsBroadPhaseBenchmark::Run());
+		}
+		ImGui::EndMenu();
+	}
+
 	// ==== POPUP DE CREAR/EDITAR MATERIAL ====
 	static bool materialesCargados = false;
 	static std::vector<std::string> materialNames;
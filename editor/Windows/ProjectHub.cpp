@@ -132,6 +132,8 @@ void ProjectHub::render() {
 
             EditorInfo::SelectedProjectPath = fs::absolute(projects[i].path).string();
             FileSystem::projectPath = fs::absolute(projects[i].path).string();
+            // En el editor manda el Content suelto; el pack solo cubre lo que falte en disco
+            FileSystem::mountProject(FileSystem::projectPath, true);
 
             MaterialManager::getInstance().clearMaterials();
             MaterialManager::getInstance().loadMaterialsFromConfig("config/materials_config.json");
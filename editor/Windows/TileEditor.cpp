@@ -70,6 +70,7 @@ bool TileEditor::loadTilesFromJson(const nlohmann::json& tileDataArray) {
     try {
         // Limpiar tiles existentes
         savedTiles.clear();
+        tilePrefabs.clear();
         selectedTileIndex = -1;
         cleanupTextureCache();
         
@@ -363,25 +364,20 @@ void TileEditor::OnRenderGUI() {
             
             if (ImGui::Button("Instantiate Selected Tile")) {
                 // Crear objeto con el tile seleccionado
-                GameObject* newObject = new GameObject("Cube.fbx");
-                newObject->Name = savedTiles[selectedTileIndex].name + "_Instance";
-                
-                // Aplicar grid snap si está habilitado
-                glm::vec3 position = { 0.0f, 0.0f, 0.0f };
+                PrefabTransform transform;
                 if (gridSnapEnabled) {
-                    position = applyGridSnap(position);
+                    transform.position = applyGridSnap(transform.position);
+                }
+
+                if (auto prefab = getTilePrefab(savedTiles[selectedTileIndex])) {
+                    prefab->instantiate(SceneManager::getInstance().getActiveScene(), transform);
                 }
-                
-                newObject->setLocalPosition(position);
-                newObject->setMaterial(savedTiles[selectedTileIndex].material);
-                newObject->setLocalScale({ 0.010f, 0.010f, 0.010f });
-                
-                SceneManager::getInstance().getActiveScene()->addGameObject(newObject);
             }
             
             if (ImGui::Button("Delete Selected Tile")) {
                 // Remover material del MaterialManager antes de eliminar el tile
                 std::string materialName = savedTiles[selectedTileIndex].material->getName();
+                tilePrefabs.erase(materialName);
                 savedTiles.erase(savedTiles.begin() + selectedTileIndex);
                 selectedTileIndex = -1;
                 std::cout << "Removed tile and its material: " << materialName << std::endl;
@@ -426,21 +422,17 @@ void TileEditor::OnRenderGUI() {
         ImGui::Text("Texture Cache: %d valid, %d invalid", validTextures, invalidTextures);
         
         if (ImGui::Button("Instantiate All Tile")) {
+            PrefabTransform transform;
+            if (gridSnapEnabled) {
+                transform.position = applyGridSnap(transform.position);
+            }
+
+            Scene* activeScene = SceneManager::getInstance().getActiveScene();
+            activeScene->reserveGameObjects(savedTiles.size());
             for (const auto& tile : savedTiles) {
-                GameObject* newObject = new GameObject("Cube.fbx");
-                newObject->Name = tile.name + "_Instance";
-                
-                // Aplicar grid snap si está habilitado
-                glm::vec3 position = { 0.0f, 0.0f, 0.0f };
-                if (gridSnapEnabled) {
-                    position = applyGridSnap(position);
+                if (auto prefab = getTilePrefab(tile)) {
+                    prefab->instantiate(activeScene, transform);
                 }
-                
-                newObject->setLocalPosition(position);
-                newObject->setMaterial(tile.material);
-                newObject->setLocalScale({ 0.010f, 0.010f, 0.010f });
-
-                SceneManager::getInstance().getActiveScene()->addGameObject(newObject);
             }
         }
 
@@ -448,20 +440,16 @@ void TileEditor::OnRenderGUI() {
         if (ImGui::IsMouseClicked(0) && EditorInfo::IsHoveringScene && selectedTileIndex != -1 && !ImGui::IsKeyDown(ImGuiKey_LeftCtrl)) {
             glm::vec2 _P = EventSystem::get_mouse_position_in_viewport(glm::vec2(0.0f), glm::vec2(0.0f));
 
-            GameObject* newObject = new GameObject("Cube.fbx");
-            newObject->Name = savedTiles[selectedTileIndex].name + "_Instance";
-            
             // Aplicar grid snap si está habilitado
-            glm::vec3 position = { _P.x, _P.y, 0.0f };
+            PrefabTransform transform;
+            transform.position = { _P.x, _P.y, 0.0f };
             if (gridSnapEnabled) {
-                position = applyGridSnap(position);
+                transform.position = applyGridSnap(transform.position);
             }
-            
-            newObject->setLocalPosition(position);
-            newObject->setMaterial(savedTiles[selectedTileIndex].material);
-            newObject->setLocalScale({ 0.010f, 0.010f, 0.010f });
 
-            SceneManager::getInstance().getActiveScene()->addGameObject(newObject);
+            if (auto prefab = getTilePrefab(savedTiles[selectedTileIndex])) {
+                prefab->instantiate(SceneManager::getInstance().getActiveScene(), transform);
+            }
         }
         
         // Ctrl + clic para borrar objetos
@@ -581,6 +569,7 @@ void TileEditor::clearAllTiles() {
     
     // Limpiar todos los tiles
     savedTiles.clear();
+    tilePrefabs.clear();
     
     // Resetear el índice seleccionado
     selectedTileIndex = -1;
@@ -593,4 +582,25 @@ void TileEditor::clearAllTiles() {
     newTexturePath = "";
     
     std::cout << "TileEditor: All tiles cleared successfully" << std::endl;
-}
\ No newline at end of file
+}
+
+std::shared_ptr<const Prefab> TileEditor::getTilePrefab(const TileData& tile) {
+    const std::string& materialName = tile.material->getName();
+    auto it = tilePrefabs.find(materialName);
+    if (it != tilePrefabs.end()) {
+        return it->second;
+    }
+
+    SceneObjectData object;
+    object.name = tile.name + "_Instance";
+    object.modelPath = "Cube.fbx";
+    object.hasMaterial = true;
+    object.materialName = materialName;
+    object.scale = glm::vec3(0.010f);
+
+    // El prefab resuelve el material por nombre
+    MaterialManager::getInstance().addMaterial(materialName, tile.material);
+    auto prefab = Prefab::fromObjects(object.name, { object });
+    tilePrefabs[materialName] = prefab;
+    return prefab;
+}
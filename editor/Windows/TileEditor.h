@@ -14,6 +14,7 @@
 #include <render/RenderPipeline.h>
 #include <components/GameObject.h>
 #include <components/SceneManager.h>
+#include <components/Prefab.h>
 
 // Estructura para almacenar datos de un tile
 struct TileData {
@@ -78,6 +79,10 @@ public:
     
     // Clear all tiles and reset the editor
     void clearAllTiles();
+
+    // Prefab de un solo cubo con el material del tile; se cocina la primera vez que se coloca
+    std::shared_ptr<const Prefab> getTilePrefab(const TileData& tile);
+    std::unordered_map<std::string, std::shared_ptr<const Prefab>> tilePrefabs;
     
     // Variables para el popup de preview
     bool showTilePreview = false;
@@ -217,8 +217,18 @@ std::string AudioSource::serializeComponent() const
 
 void AudioSource::deserialize(const std::string &data)
 {
-    json j = json::parse(data);
+    try
+    {
+        deserializeJson(json::parse(data));
+    }
+    catch (const json::parse_error &e)
+    {
+        std::cerr << "[AudioSource] Deserialization error: " << e.what() << std::endl;
+    }
+}
 
+void AudioSource::deserializeJson(const json &j)
+{
     // Extrae y aplica todo usando setters
     std::string path = j.value("soundPath", "");
     bool _is3D = j.value("is3D", true);
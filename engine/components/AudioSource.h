@@ -41,8 +41,15 @@ public:
     // Actualización del componente
     void defines() override;
     void update() override;
+    // Posicion 3D de los canales; las llamadas de canal de FMOD son thread-safe
+    ComponentUpdateInfo getUpdateInfo() const override {
+        return { UpdatePhase::Late, ACCESS_TRANSFORM, ACCESS_AUDIO, true };
+    }
+    // play() pasa por AudioManager
+    bool needsMainThreadUpdate() const override { return shouldPlay; }
     void destroy() override;
     void deserialize(const std::string& data) override;
+    void deserializeJson(const nlohmann::json& data) override;
     std::string serializeComponent() const override;
 
 private:
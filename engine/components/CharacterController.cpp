@@ -1,4 +1,5 @@
 #include "CharacterController.h"
+#include "CharacterCrowd.h"
 #include "GameObject.h"
 #include "../core/PhysicsManager.h"
 #include "../core/Time.h"
@@ -8,6 +9,25 @@
 
 using json = nlohmann::json;
 
+// Guarda la normal mas vertical que toca cada move; sin estado propio, vale para todos los
+// controllers y para moves en paralelo (cada uno escribe solo en el suyo)
+class ControllerGroundReport : public physx::PxUserControllerHitReport {
+public:
+    void onShapeHit(const physx::PxControllerShapeHit& hit) override { record(hit); }
+    void onControllerHit(const physx::PxControllersHit& hit) override { record(hit); }
+    void onObstacleHit(const physx::PxControllerObstacleHit& hit) override { record(hit); }
+
+private:
+    static void record(const physx::PxControllerHit& hit) {
+        auto* owner = hit.controller ? static_cast<CharacterController*>(hit.controller->getUserData()) : nullptr;
+        if (owner && hit.worldNormal.y > owner->moveGroundNormal.y) {
+            owner->moveGroundNormal = hit.worldNormal;
+        }
+    }
+};
+
+static ControllerGroundReport groundReport;
+
 CharacterController::CharacterController(GameObject* obj) {
     setOwner(obj);
 
@@ -53,23 +73,30 @@ void CharacterController::start() {
     initializeController();
 }
 
-void CharacterController::update() {
+void CharacterController::fixedUpdate(float fixedDeltaTime) {
     if (!initialized || !controller) return;
 
-    float deltaTime = Time::getDeltaTime();
-
-    // Update gravity first
-    updateGravity(deltaTime);
-
-    // Then update movement
-    updateMovement(deltaTime);
-
-    // Sync transform from controller to GameObject
-    syncTransformFromController();
+    // El movimiento va con el paso fijo de la fisica; la pose la lleva al GameObject
+    // PhysicsManager::syncTransforms(), interpolada
+    updateGravity(fixedDeltaTime);
+    if (crowdMode) {
+        // Lo ejecuta CharacterCrowd::flush() con el resto de la multitud
+        CharacterCrowd::getInstance().queueMove(this, computeDisplacement(fixedDeltaTime), fixedDeltaTime);
+    }
+    else {
+        updateMovement(fixedDeltaTime);
+    }
 }
 
 void CharacterController::destroy() {
+    stopInterpolation();
+    CharacterCrowd::getInstance().cancel(this);
+    PhysicsManager::getInstance().fetchResults();
+
     if (controller) {
+        if (PhysicsEventHandler* eventHandler = PhysicsManager::getInstance().getEventHandler()) {
+            eventHandler->discardActorEvents(controller->getActor());
+        }
         controller->release();
         controller = nullptr;
         capsuleController = nullptr;
@@ -133,6 +160,7 @@ void CharacterController::initializeController() {
 
         // Set user data
         desc.userData = this;
+        desc.reportCallback = &groundReport;
 
         // Validate descriptor before creating controller
         if (!desc.isValid()) {
@@ -174,6 +202,7 @@ void CharacterController::initializeController() {
 
         // Set user data
         desc.userData = this;
+        desc.reportCallback = &groundReport;
 
         // Validate descriptor before creating controller
         if (!desc.isValid()) {
@@ -190,6 +219,9 @@ void CharacterController::initializeController() {
 
     if (controller) {
         initialized = true;
+        // Como en Rigidbody y Collider: userData del actor = GameObject (consultas, eventos)
+        controller->getActor()->userData = owner;
+        bindPhysicsActor(controller->getActor());
         std::cout << "CharacterController initialized successfully at position ("
             << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
     }
@@ -212,6 +244,10 @@ void CharacterController::move(const glm::vec3& direction) {
 void CharacterController::updateMovement(float deltaTime) {
     if (!initialized || !controller) return;
 
+    applyMoveResult(executeMove(computeDisplacement(deltaTime), deltaTime, nullptr));
+}
+
+physx::PxVec3 CharacterController::computeDisplacement(float deltaTime) const {
     // Calculate horizontal movement based on input
     glm::vec3 horizontalMovement(0.0f);
 
@@ -241,18 +277,32 @@ void CharacterController::updateMovement(float deltaTime) {
     glm::vec3 totalMovement = horizontalMovement;
     totalMovement.y = velocity.y; // Keep vertical velocity from gravity/jump
 
-    // Apply movement to controller
-    physx::PxVec3 moveVec(totalMovement.x * deltaTime,
+    return physx::PxVec3(totalMovement.x * deltaTime,
         totalMovement.y * deltaTime,
         totalMovement.z * deltaTime);
+}
+
+physx::PxControllerCollisionFlags CharacterController::executeMove(const physx::PxVec3& displacement, float deltaTime, const physx::PxObstacleContext* obstacles) {
+    // groundReport la rellena durante el move
+    moveGroundNormal = physx::PxVec3(0.0f);
 
     physx::PxControllerFilters filters;
-    physx::PxControllerCollisionFlags flags = controller->move(moveVec, 0.0f, deltaTime, filters);
+    return controller->move(displacement, 0.0f, deltaTime, filters, obstacles);
+}
 
+void CharacterController::applyMoveResult(physx::PxControllerCollisionFlags flags) {
     // Update grounded state correctly - check if collision flags contain the down collision flag
     bool wasGrounded = isGrounded;
     isGrounded = flags.isSet(physx::PxControllerCollisionFlag::eCOLLISION_DOWN);
 
+    // Si el barrido hacia abajo no dio normal se mantiene la anterior
+    if (!isGrounded) {
+        groundNormal = physx::PxVec3(0.0f, 1.0f, 0.0f);
+    }
+    else if (moveGroundNormal.y > 0.0f) {
+        groundNormal = moveGroundNormal;
+    }
+
     // If we hit the ground, reset vertical velocity
     if (isGrounded && velocity.y <= 0.0f) {
         velocity.y = 0.0f;
@@ -334,12 +384,15 @@ void CharacterController::setMovementMode(MovementMode mode) {
 void CharacterController::syncTransformFromController() {
     if (!controller || !owner) return;
 
-    physx::PxExtendedVec3 position = controller->getPosition();
-    glm::vec3 glmPosition(static_cast<float>(position.x),
-        static_cast<float>(position.y),
-        static_cast<float>(position.z));
+    glm::vec3 position;
+    glm::quat rotation;
+    if (readPhysicsPose(position, rotation)) {
+        writePhysicsPose(position, rotation);
+    }
+}
 
-    owner->setWorldPosition(glmPosition);
+void CharacterController::writePhysicsPose(const glm::vec3& position, const glm::quat& rotation) {
+    owner->setWorldPosition(position);
     // Note: Character controllers don't have rotation, so we keep the GameObject's rotation
 }
 
@@ -348,8 +401,21 @@ void CharacterController::syncTransformToController() {
 
     glm::vec3 position = owner->getWorldPosition();
 
+    PhysicsManager::getInstance().fetchResults();
     physx::PxExtendedVec3 pxPosition(position.x, position.y, position.z);
     controller->setPosition(pxPosition);
+    resetInterpolation(position, owner->getWorldRotationQuat());
+}
+
+bool CharacterController::readPhysicsPose(glm::vec3& position, glm::quat& rotation) const {
+    if (!controller || !owner) return false;
+
+    physx::PxExtendedVec3 pxPosition = controller->getPosition();
+    position = glm::vec3(static_cast<float>(pxPosition.x),
+        static_cast<float>(pxPosition.y),
+        static_cast<float>(pxPosition.z));
+    rotation = owner->getWorldRotationQuat();
+    return true;
 }
 
 // Character controller properties
@@ -422,83 +488,49 @@ void CharacterController::addForce(const glm::vec3& force) {
     velocity += force;
 }
 
+void CharacterController::setCrowdMode(bool enabled) {
+    if (crowdMode && !enabled) {
+        CharacterCrowd::getInstance().cancel(this);
+    }
+    crowdMode = enabled;
+}
+
 // Collision detection
 bool CharacterController::isOnGround() const {
     return isGrounded;
 }
 
 bool CharacterController::isOnSlope() const {
-    if (!controller || !isGrounded) return false;
-
-    // Use raycast for more precise slope detection
-    auto& physicsManager = PhysicsManager::getInstance();
-    physx::PxScene* scene = physicsManager.getScene();
-
-    if (!scene) return false;
-
-    // Raycast downward from controller position
-    physx::PxExtendedVec3 pos = controller->getPosition();
-    physx::PxVec3 origin(static_cast<float>(pos.x),
-        static_cast<float>(pos.y) + 0.1f,
-        static_cast<float>(pos.z));
-    physx::PxVec3 direction(0, -1, 0);
-    float maxDistance = 0.5f;
-
-    physx::PxRaycastBuffer hit;
-    bool hasHit = scene->raycast(origin, direction, maxDistance, hit);
-
-    if (hasHit && hit.hasBlock) {
-        physx::PxVec3 normal = hit.block.normal;
-        float angle = std::acos(normal.dot(physx::PxVec3(0, 1, 0)));
-        return angle > 0.1f; // More than ~5.7 degrees
-    }
-
-    return false;
+    return getSlopeAngle() > 5.7f; // ~0.1 rad
 }
 
 float CharacterController::getSlopeAngle() const {
     if (!controller || !isGrounded) return 0.0f;
 
-    auto& physicsManager = PhysicsManager::getInstance();
-    physx::PxScene* scene = physicsManager.getScene();
-
-    if (!scene) return 0.0f;
-
-    // Raycast downward
-    physx::PxExtendedVec3 pos = controller->getPosition();
-    physx::PxVec3 origin(static_cast<float>(pos.x),
-        static_cast<float>(pos.y) + 0.1f,
-        static_cast<float>(pos.z));
-    physx::PxVec3 direction(0, -1, 0);
-    float maxDistance = 0.5f;
-
-    physx::PxRaycastBuffer hit;
-    bool hasHit = scene->raycast(origin, direction, maxDistance, hit);
-
-    if (hasHit && hit.hasBlock) {
-        physx::PxVec3 normal = hit.block.normal;
-        float angle = std::acos(normal.dot(physx::PxVec3(0, 1, 0)));
-        return angle * 180.0f / 3.14159f; // Convert radians to degrees
-    }
-
-    return 0.0f;
+    // Normal cacheada del ultimo move (ver ControllerGroundReport)
+    float cosine = std::clamp(groundNormal.y, -1.0f, 1.0f);
+    return std::acos(cosine) * 180.0f / 3.14159f; // Convert radians to degrees
 }
 
 // Teleportation
 void CharacterController::teleport(const glm::vec3& position) {
     if (!controller) return;
 
+    PhysicsManager::getInstance().fetchResults();
     physx::PxExtendedVec3 pxPosition(position.x, position.y, position.z);
     controller->setPosition(pxPosition);
 
     // Reset velocity
     velocity = glm::vec3(0.0f);
     inputDirection = glm::vec3(0.0f);
+
+    resetInterpolation(position, owner ? owner->getWorldRotationQuat() : glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
 }
 
 void CharacterController::teleport(const glm::vec3& position, const glm::quat& rotation) {
     if (!controller) return;
 
+    PhysicsManager::getInstance().fetchResults();
     physx::PxExtendedVec3 pxPosition(position.x, position.y, position.z);
     controller->setPosition(pxPosition);
 
@@ -510,6 +542,7 @@ void CharacterController::teleport(const glm::vec3& position, const glm::quat& r
     if (owner) {
         owner->setWorldRotationQuat(rotation);
     }
+    resetInterpolation(position, rotation);
 }
 
 
@@ -528,6 +561,7 @@ std::string CharacterController::serializeComponent() const {
     j["jumpForce"] = jumpForce;
     j["gravity"] = gravity;
     j["airControl"] = airControl;
+    j["crowdMode"] = crowdMode;
 
     j["currentMovementMode"] = static_cast<int>(currentMovementMode);
     j["isGrounded"] = isGrounded;
@@ -544,8 +578,15 @@ std::string CharacterController::serializeComponent() const {
 
 
 void CharacterController::deserialize(const std::string& data) {
-    json j = json::parse(data);
+    try {
+        deserializeJson(json::parse(data));
+    }
+    catch (const json::parse_error& e) {
+        std::cerr << "[CharacterController] Deserialization error: " << e.what() << std::endl;
+    }
+}
 
+void CharacterController::deserializeJson(const json& j) {
     // Primero, el tipo de controller (si es necesario)
     controllerType = static_cast<CharacterControllerType>(j.value("controllerType", 0));
 
@@ -561,6 +602,7 @@ void CharacterController::deserialize(const std::string& data) {
     setJumpForce(j.value("jumpForce", 5.0f));
     setGravity(j.value("gravity", 9.8f));
     setAirControl(j.value("airControl", 0.5f));
+    setCrowdMode(j.value("crowdMode", false));
 
     // Estado lgico (flags internos)
     currentMovementMode = static_cast<MovementMode>(j.value("currentMovementMode", 0));
@@ -589,3 +631,18 @@ void CharacterController::deserialize(const std::string& data) {
     // Si tu controlador y GameObject ya estn vivos, puedes sincronizar transform:
     syncTransformToController();
 }
+
+void CharacterController::onActiveChanged(bool active) {
+    // El actor del controller pertenece al PxControllerManager; se desactiva sin sacarlo de la escena
+    if (!controller || !controller->getActor()) return;
+
+    controller->getActor()->setActorFlag(physx::PxActorFlag::eDISABLE_SIMULATION, !active);
+    if (!active) {
+        CharacterCrowd::getInstance().cancel(this);
+    }
+    if (active) {
+        syncTransformToController();
+        velocity = glm::vec3(0.0f);
+        inputDirection = glm::vec3(0.0f);
+    }
+}
@@ -9,6 +9,7 @@
 #include "Component.h"
 #include "../core/CoreExporter.h"
 #include "../core/PhysicsManager.h"
+#include "../core/PhysicsInterpolation.h"
 #include <functional>
 
 enum class MANTRAXCORE_API CharacterControllerType {
@@ -26,11 +27,16 @@ enum class MANTRAXCORE_API MovementMode {
 
 class MANTRAXCORE_API GameObject;
 
-class MANTRAXCORE_API CharacterController : public Component {
+class MANTRAXCORE_API CharacterController : public Component, public InterpolatedBody {
 private:
     std::string getComponentName() const override {
         return "Character Controller";
     }
+    // Se mueve en fixedUpdate; update() no hace nada
+    ComponentUpdateInfo getUpdateInfo() const override {
+        return { UpdatePhase::PostPhysics, ACCESS_NONE, ACCESS_NONE, true };
+    }
+    bool needsMainThreadUpdate() const override { return false; }
 
     // PhysX Character Controller
     physx::PxController* controller;
@@ -71,12 +77,32 @@ private:
     // Internal state
     bool initialized;
     
+    // Multitud: el move del paso lo ejecuta CharacterCrowd junto al del resto de controllers
+    bool crowdMode = false;
+    
+    // Normal del suelo del ultimo move que toco abajo; la rellena el hit report durante el move,
+    // sin rayos extra (isOnSlope, getSlopeAngle)
+    physx::PxVec3 groundNormal{0.0f, 1.0f, 0.0f};
+    physx::PxVec3 moveGroundNormal{0.0f};
+    
     // Helper methods
     void updateMovement(float deltaTime);
     void updateGravity(float deltaTime);
+    // updateMovement en tres partes para CharacterCrowd: executeMove puede ir en un hilo del
+    // dispatcher (solo toca este controller); el resultado se aplica despues en el principal
+    physx::PxVec3 computeDisplacement(float deltaTime) const;
+    physx::PxControllerCollisionFlags executeMove(const physx::PxVec3& displacement, float deltaTime, const physx::PxObstacleContext* obstacles);
+    void applyMoveResult(physx::PxControllerCollisionFlags flags);
     void syncTransformFromController();
     void syncTransformToController();
 
+    friend class CharacterCrowd;
+    friend class ControllerGroundReport;
+
+protected:
+    bool readPhysicsPose(glm::vec3& position, glm::quat& rotation) const override;
+    void writePhysicsPose(const glm::vec3& position, const glm::quat& rotation) override;
+
 public:
     CharacterController() = default;
     CharacterController(GameObject* obj);
@@ -84,10 +110,12 @@ public:
     
     // Component overrides
     void start() override;
-    void update() override;
+    void fixedUpdate(float fixedDeltaTime) override;
     void destroy() override;
+    void onActiveChanged(bool active) override;
     std::string serializeComponent() const override;
     void deserialize(const std::string& data) override;
+    void deserializeJson(const nlohmann::json& data) override;
 
 
     // Initialization
@@ -133,6 +161,9 @@ public:
     void setAirControl(float control);
     float getAirControl() const { return airControl; }
     
+    void setCrowdMode(bool enabled);
+    bool isCrowdMode() const { return crowdMode; }
+    
     // State getters
     bool isGroundedState() const { return isGrounded; }
     bool isCrouchingState() const { return isCrouching; }
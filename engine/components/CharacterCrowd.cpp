@@ -0,0 +1,141 @@
+#include "CharacterCrowd.h"
+#include "CharacterController.h"
+#include "../core/PhysicsManager.h"
+#include <algorithm>
+#include <cmath>
+
+CharacterCrowd& CharacterCrowd::getInstance() {
+    static CharacterCrowd* instance = new CharacterCrowd();
+    return *instance;
+}
+
+void CharacterCrowd::queueMove(CharacterController* controller, const physx::PxVec3& displacement, float deltaTime) {
+    if (!controller || !controller->getController()) return;
+
+    PendingMove move;
+    move.controller = controller;
+    move.displacement = displacement;
+    move.deltaTime = deltaTime;
+    moves.push_back(move);
+}
+
+void CharacterCrowd::cancel(CharacterController* controller) {
+    // Se anula en vez de borrar: puede llegar desde un callback en mitad de flush()
+    for (PendingMove& move : moves) {
+        if (move.controller == controller) move.controller = nullptr;
+    }
+}
+
+physx::PxObstacleContext* CharacterCrowd::getObstacleContext() {
+    physx::PxControllerManager* manager = PhysicsManager::getInstance().getControllerManager();
+    if (!manager) return nullptr;
+
+    // Si el manager es otro, el contexto anterior se libero con el suyo
+    if (!obstacles || obstacleOwner != manager) {
+        obstacles = manager->createObstacleContext();
+        obstacleOwner = manager;
+    }
+    return obstacles;
+}
+
+void CharacterCrowd::reset() {
+    moves.clear();
+    cellStarts.clear();
+    obstacles = nullptr;
+    obstacleOwner = nullptr;
+}
+
+void CharacterCrowd::buildCells() {
+    // Alcance horizontal de un controller en este paso; el 1.5 cubre la diagonal de los de caja
+    float maxReach = 0.0f;
+    for (const PendingMove& move : moves) {
+        if (!move.controller) continue;
+        float step = std::sqrt(move.displacement.x * move.displacement.x + move.displacement.z * move.displacement.z);
+        float reach = move.controller->getRadius() * 1.5f + move.controller->getContactOffset() + step;
+        maxReach = std::max(maxReach, reach);
+    }
+
+    // Dos celdas de la misma pasada estan separadas por al menos una celda entera
+    float cellSize = std::max(2.0f * maxReach, 1.0f);
+    for (PendingMove& move : moves) {
+        if (!move.controller) continue;
+
+        physx::PxExtendedVec3 position = move.controller->getController()->getPosition();
+        int64_t cellX = static_cast<int64_t>(std::floor(position.x / cellSize));
+        int64_t cellZ = static_cast<int64_t>(std::floor(position.z / cellSize));
+        uint64_t pass = static_cast<uint64_t>((cellX & 1) | ((cellZ & 1) << 1));
+        move.cellKey = (pass << 62)
+            | ((static_cast<uint64_t>(cellX) & 0x7fffffffull) << 31)
+            | (static_cast<uint64_t>(cellZ) & 0x7fffffffull);
+    }
+
+    std::sort(moves.begin(), moves.end(), [](const PendingMove& a, const PendingMove& b) {
+        return a.cellKey < b.cellKey;
+    });
+
+    cellStarts.clear();
+    size_t pass = 0;
+    for (size_t i = 0; i < moves.size(); i++) {
+        if (i > 0 && moves[i].cellKey == moves[i - 1].cellKey) continue;
+
+        size_t movePass = static_cast<size_t>(moves[i].cellKey >> 62);
+        while (pass <= movePass) passStarts[pass++] = cellStarts.size();
+        cellStarts.push_back(i);
+    }
+    while (pass < 5) passStarts[pass++] = cellStarts.size();
+    cellStarts.push_back(moves.size());
+}
+
+void CharacterCrowd::executeRange(size_t firstMove, size_t lastMove, const physx::PxObstacleContext* sharedObstacles) {
+    for (size_t i = firstMove; i < lastMove; i++) {
+        PendingMove& move = moves[i];
+        if (move.controller) {
+            move.flags = move.controller->executeMove(move.displacement, move.deltaTime, sharedObstacles);
+        }
+    }
+}
+
+void CharacterCrowd::flush(float fixedDeltaTime) {
+    lastMoveCount = moves.size();
+    lastCellCount = 0;
+    if (moves.empty()) return;
+
+    PhysicsManager& physicsManager = PhysicsManager::getInstance();
+    physx::PxControllerManager* manager = physicsManager.getControllerManager();
+    if (!manager) {
+        moves.clear();
+        return;
+    }
+    physicsManager.fetchResults();
+
+    // Solapes entre controllers una vez para todos; durante los moves solo se leen
+    manager->computeInteractions(fixedDeltaTime);
+    const physx::PxObstacleContext* sharedObstacles = getObstacleContext();
+
+    if (!parallel || moves.size() < parallelThreshold) {
+        executeRange(0, moves.size(), sharedObstacles);
+    }
+    else {
+        buildCells();
+        lastCellCount = cellStarts.size() - 1;
+
+        // Las pasadas van una tras otra; dentro de cada una, una celda por tarea
+        for (size_t pass = 0; pass < 4; pass++) {
+            size_t firstCell = passStarts[pass];
+            size_t cellCount = passStarts[pass + 1] - firstCell;
+            if (cellCount == 0) continue;
+
+            physicsManager.parallelFor(cellCount, 1, [&](size_t begin, size_t end) {
+                executeRange(cellStarts[firstCell + begin], cellStarts[firstCell + end], sharedObstacles);
+            });
+        }
+    }
+
+    // Estado y callbacks en el hilo principal, cuando ya se han movido todos
+    for (size_t i = 0; i < moves.size(); i++) {
+        if (moves[i].controller) {
+            moves[i].controller->applyMoveResult(moves[i].flags);
+        }
+    }
+    moves.clear();
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <physx/PxPhysicsAPI.h>
+#include <physx/characterkinematic/PxControllerManager.h>
+#include <physx/characterkinematic/PxControllerObstacles.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../core/CoreExporter.h"
+
+class CharacterController;
+
+// Multitudes de CharacterController (NPCs). En modo multitud cada controller deja aqui el move
+// del paso en vez de llamar a PxController::move, y flush() los ejecuta todos tras la fase
+// fixedUpdate. Los moves se agrupan en celdas XZ mas grandes que lo que un controller alcanza en
+// un paso; en cuatro pasadas (paridad de la celda en X y en Z) las celdas de una pasada no se
+// tocan entre si y se mueven en paralelo en los hilos del dispatcher de PhysX. Todos comparten
+// un PxObstacleContext; el PxControllerManager se crea con locking para que los moves concurrentes
+// sean seguros (PhysicsManager::initialize). Solo hilo principal
+class MANTRAXCORE_API CharacterCrowd {
+public:
+    static CharacterCrowd& getInstance();
+
+    CharacterCrowd(const CharacterCrowd&) = delete;
+    CharacterCrowd& operator=(const CharacterCrowd&) = delete;
+
+    void queueMove(CharacterController* controller, const physx::PxVec3& displacement, float deltaTime);
+    // El controller se destruye o se desactiva: su move pendiente se descarta
+    void cancel(CharacterController* controller);
+    // Interacciones entre controllers y todos los moves pendientes. La llama SceneManager en cada
+    // paso fijo, despues de Scene::fixedUpdateNative y antes de simulate
+    void flush(float fixedDeltaTime);
+
+    // Obstaculos (cajas, capsulas) que ven todos los moves de la multitud; se crea al pedirlo
+    physx::PxObstacleContext* getObstacleContext();
+    // El contexto muere con el PxControllerManager: SceneManager la llama antes de limpiar la fisica
+    void reset();
+
+    void setParallel(bool enabled) { parallel = enabled; }
+    bool isParallel() const { return parallel; }
+    // Con menos moves que esto van en serie; repartirlos no compensa
+    void setParallelThreshold(size_t count) { parallelThreshold = count; }
+    size_t getParallelThreshold() const { return parallelThreshold; }
+
+    size_t getLastMoveCount() const { return lastMoveCount; }
+    size_t getLastCellCount() const { return lastCellCount; }
+
+private:
+    CharacterCrowd() = default;
+
+    struct PendingMove {
+        CharacterController* controller = nullptr;
+        physx::PxVec3 displacement{0.0f};
+        float deltaTime = 0.0f;
+        uint64_t cellKey = 0;    // Pasada en los 2 bits altos y despues la celda
+        physx::PxControllerCollisionFlags flags;
+    };
+
+    // Ordena moves por celda y rellena cellStarts/passStarts
+    void buildCells();
+    void executeRange(size_t firstMove, size_t lastMove, const physx::PxObstacleContext* sharedObstacles);
+
+    std::vector<PendingMove> moves;
+    std::vector<size_t> cellStarts;    // Primer move de cada celda; el ultimo es moves.size()
+    size_t passStarts[5] = {};         // Primera celda de cada pasada; el ultimo es el total
+
+    physx::PxObstacleContext* obstacles = nullptr;
+    physx::PxControllerManager* obstacleOwner = nullptr;
+
+    bool parallel = true;
+    size_t parallelThreshold = 32;
+    size_t lastMoveCount = 0;
+    size_t lastCellCount = 0;
+};
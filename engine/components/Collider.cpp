@@ -3,6 +3,8 @@
 #include "GameObject.h"
 #include "../core/PhysicsManager.h"
 #include "../core/PhysicsEventHandler.h"
+#include "../core/MeshCooker.h"
+#include "../render/AssimpGeometry.h"
 #include <iostream>
 #include <nlohmann/json.hpp>
 
@@ -55,6 +57,7 @@ void Collider::update() {
 
 void Collider::destroy() {
     std::cout << "[Collider] Starting cleanup for " << (owner ? owner->Name : "Unknown") << std::endl;
+    PhysicsManager::getInstance().fetchResults();
     
     // Detach from rigidbody first if attached
     detachFromRigidbody();
@@ -70,8 +73,8 @@ void Collider::destroy() {
     if (staticActor) {
         std::cout << "[Collider] Removing static actor from scene..." << std::endl;
         auto& physicsManager = PhysicsManager::getInstance();
-        if (physicsManager.getScene()) {
-            physicsManager.getScene()->removeActor(*staticActor);
+        if (physicsManager.getScene() && staticActor->getScene()) {
+            physicsManager.removeActor(*staticActor);
         }
         staticActor->release();
         staticActor = nullptr;
@@ -141,6 +144,33 @@ void Collider::createShape() {
             planeGeom = new physx::PxPlaneGeometry();
             geometry = planeGeom;
             break;
+        case ShapeType::TriangleMesh:
+        case ShapeType::ConvexMesh: {
+            AssimpGeometry* model = owner->getGeometry();
+            if (!model || !model->isLoaded()) {
+                std::cerr << "[Collider] " << getShapeTypeString() << " needs a model on " << owner->Name << std::endl;
+                break;
+            }
+            
+            glm::vec3 scale = owner->getWorldScale();
+            physx::PxMeshScale meshScale(physx::PxVec3(scale.x, scale.y, scale.z));
+            
+            // Mallas triangulares solo sin Rigidbody dinamico; un Collider es una sola shape,
+            // asi que el convexo es la envolvente completa (la descomposicion es de PhysicalObject)
+            auto rigidbody = owner->getComponent<Rigidbody>();
+            bool dynamicBody = rigidbody && rigidbody->getBodyType() == BodyType::Dynamic;
+            if (shapeType == ShapeType::TriangleMesh && !dynamicBody) {
+                if (physx::PxTriangleMesh* mesh = MeshCooker::getInstance().getTriangleMesh(*model)) {
+                    geometry = new physx::PxTriangleMeshGeometry(mesh, meshScale);
+                }
+            } else {
+                const std::vector<physx::PxConvexMesh*>& hulls = MeshCooker::getInstance().getConvexMeshes(*model);
+                if (!hulls.empty()) {
+                    geometry = new physx::PxConvexMeshGeometry(hulls[0], meshScale);
+                }
+            }
+            break;
+        }
     }
     
     if (geometry) {
@@ -278,8 +308,8 @@ void Collider::createIndependentActorIfNeeded() {
         // Attach our shape
         staticActor->attachShape(*shape);
         
-        // Add to scene
-        scene->addActor(*staticActor);
+        // Add to scene (en un lote de carga entra con el resto de estaticos)
+        physicsManager.addActor(*staticActor);
         
         // Ensure initial position is correct
         syncTransformToPhysX();
@@ -540,6 +570,8 @@ std::string Collider::getShapeTypeString() const {
         case ShapeType::Sphere: return "Sphere";
         case ShapeType::Capsule: return "Capsule";
         case ShapeType::Plane: return "Plane";
+        case ShapeType::TriangleMesh: return "Triangle Mesh";
+        case ShapeType::ConvexMesh: return "Convex Mesh";
         default: return "Unknown";
     }
 }
@@ -590,8 +622,8 @@ void Collider::attachToRigidbody(Rigidbody* rigidbody) {
     // If we have our own static actor, remove it first
     if (staticActor) {
         auto& physicsManager = PhysicsManager::getInstance();
-        if (physicsManager.getScene()) {
-            physicsManager.getScene()->removeActor(*staticActor);
+        if (physicsManager.getScene() && staticActor->getScene()) {
+            physicsManager.removeActor(*staticActor);
         }
         staticActor->release();
         staticActor = nullptr;
@@ -639,8 +671,15 @@ std::string Collider::serializeComponent() const {
 
 void Collider::deserialize(const std::string& data) {
     try {
-        json j = json::parse(data);
-        
+        deserializeJson(json::parse(data));
+    }
+    catch (const json::parse_error& e) {
+        std::cerr << "[Collider] Deserialization error: " << e.what() << std::endl;
+    }
+}
+
+void Collider::deserializeJson(const json& j) {
+    try {
         if (j.contains("shapeType")) {
             shapeType = static_cast<ShapeType>(j["shapeType"]);
         }
@@ -682,6 +721,7 @@ void Collider::deserialize(const std::string& data) {
 // Transform synchronization methods
 void Collider::syncTransformToPhysX() {
     if (!staticActor) return;
+    PhysicsManager::getInstance().fetchResults();
     
     // Get current transform from GameObject
     glm::vec3 position = owner->getWorldPosition();
@@ -774,4 +814,22 @@ void Collider::recreateShapeSafely() {
     } else {
         std::cout << "[Collider] ERROR: Failed to recreate shape!" << std::endl;
     }
-}
\ No newline at end of file
+}
+
+void Collider::onActiveChanged(bool active) {
+    // Solo el actor independiente; con Rigidbody el shape va en el actor de este
+    auto& physicsManager = PhysicsManager::getInstance();
+    if (!staticActor || !physicsManager.getScene()) return;
+
+    if (!active) {
+        if (staticActor->getScene()) {
+            physicsManager.removeActor(*staticActor);
+        }
+        return;
+    }
+
+    if (!staticActor->getScene()) {
+        syncTransformToPhysX();
+        physicsManager.addActor(*staticActor);
+    }
+}
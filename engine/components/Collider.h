@@ -57,8 +57,14 @@ public:
     void defines() override;
     void start() override;
     void update() override;
+    // Mueve el actor estatico a la transform del owner; PhysicsManager solo desde el principal
+    ComponentUpdateInfo getUpdateInfo() const override {
+        return { UpdatePhase::PrePhysics, ACCESS_TRANSFORM, ACCESS_PHYSICS, false };
+    }
     void destroy() override;
+    void onActiveChanged(bool active) override;
     void deserialize(const std::string& data) override;
+    void deserializeJson(const nlohmann::json& data) override;
     std::string serializeComponent() const override;
 
     // Manual initialization
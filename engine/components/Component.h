@@ -1,18 +1,57 @@
 #pragma once
 #include "../core/CoreExporter.h"
 #include <map>
+#include <cstdint>
 #include <string>
 #include <any>
 #include <nlohmann/json.hpp>
 #include <glm/glm.hpp>
 #include <iostream>
 #include "../core/UIDGenerator.h"
+#include "../core/SceneAllocator.h"
 
 class GameObject;
 
+// Fases de update() dentro de Scene::updateNative, en este orden. PostPhysics ya ve las poses y
+// eventos del paso recogido al empezar el frame; PrePhysics prepara el que se lanza al acabarlo
+enum class UpdatePhase : uint8_t {
+    PostPhysics,
+    PrePhysics,
+    Animation,
+    Late,
+    Count
+};
+
+// Estado compartido que lee o escribe update(). Lo propio del componente no cuenta
+enum UpdateAccess : uint32_t {
+    ACCESS_NONE = 0,
+    ACCESS_TRANSFORM = 1u << 0,       // Transform de cualquier objeto
+    ACCESS_PHYSICS = 1u << 1,         // PhysicsManager y la escena de PhysX
+    ACCESS_AUDIO = 1u << 2,           // AudioManager y canales de FMOD
+    ACCESS_RENDER_STATE = 1u << 3,    // Materiales, luces y lo que lee RenderPipeline
+    ACCESS_SCRIPT = 1u << 4,          // Estado de Lua y grafos de Glyphs
+    ACCESS_ALL = 0xffffffffu
+};
+
+// Lo que declara cada tipo de componente para ComponentScheduler. Por defecto lee y escribe todo:
+// cada tipo sin declarar corre solo y en serie, como antes
+struct ComponentUpdateInfo {
+    UpdatePhase phase = UpdatePhase::PrePhysics;
+    uint32_t reads = ACCESS_ALL;
+    uint32_t writes = ACCESS_ALL;
+    // Las instancias de objetos distintos no comparten nada de lo escrito: se reparten entre hilos
+    bool perObject = false;
+};
+
 class MANTRAXCORE_API Component {
 public:
     Component() : owner(nullptr), isDestroyed(false), isEnabled(true) {}
+
+    // Memoria en los pools de la escena que se esta cargando o actualizando (ver SceneAllocator)
+    static void* operator new(std::size_t size) { return SceneAllocator::allocate(size); }
+    static void operator delete(void* ptr) { SceneAllocator::deallocate(ptr); }
+    static void* operator new(std::size_t, void* place) { return place; }
+    static void operator delete(void*, void*) {}
     std::unordered_map<std::string, std::any> variableMap;
 
     // Para punteros de tipos básicos
@@ -73,12 +112,23 @@ public:
     virtual void defines() {}
     virtual void start() {}
     virtual void update() {}
+    // Fase y accesos de update(); igual para todas las instancias del tipo (ver ComponentScheduler)
+    virtual ComponentUpdateInfo getUpdateInfo() const { return {}; }
+    // Esta instancia necesita este frame el hilo principal (GL, SDL, Lua); se pregunta antes de cada fase
+    virtual bool needsMainThreadUpdate() const { return true; }
+    // Una vez por paso fijo de fisica, justo antes de simular (ver PhysicsManager::update)
+    virtual void fixedUpdate(float fixedDeltaTime) {}
     virtual std::string serializeComponent() const { return "{ }"; }
     virtual void deserialize(const std::string& data) {}
+    // Igual que deserialize pero desde un nodo ya parseado (sin volver a pasar por texto)
+    virtual void deserializeJson(const nlohmann::json& data) { deserialize(data.dump()); }
 
     virtual void setOwner(GameObject* owner) { this->owner = owner; }
     GameObject* getOwner() const { return owner; }
 
+    // Marca al dueño como modificado (ver GameObject::markDirty)
+    void markDirty();
+
     // Sistema de estado del componente
     virtual bool isValid() const { return !isDestroyed && owner != nullptr; }
     virtual void destroy() {
@@ -86,6 +136,12 @@ public:
         isDestroyed = true;
         owner = nullptr;
     }
+    // El owner se activa o desactiva (GameObject::setActive); los componentes con actores de
+    // fisica los sacan de la escena de PhysX sin liberarlos
+    virtual void onActiveChanged(bool active) {}
+    // Cambio de Layer o LayerMask del owner (GameObject::setLayer/setLayerMask)
+    virtual void onLayerChanged() {}
+
     virtual void enable() { isEnabled = true; }
     virtual void disable() { isEnabled = false; }
     bool isActive() const { return isEnabled && !isDestroyed; }
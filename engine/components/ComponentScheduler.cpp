@@ -0,0 +1,143 @@
+#include "ComponentScheduler.h"
+#include "GameObject.h"
+#include "../core/JobSystem.h"
+#include <algorithm>
+
+bool ComponentScheduler::conflicts(const ComponentUpdateInfo& a, const ComponentUpdateInfo& b) {
+    // Sin declarar puede tocar cualquier cosa, tambien el estado propio de otros componentes
+    if (a.writes == ACCESS_ALL || b.writes == ACCESS_ALL) return true;
+    return (a.writes & (b.reads | b.writes)) != 0 || (b.writes & a.reads) != 0;
+}
+
+void ComponentScheduler::collect(const std::vector<GameObject*>& sceneObjects) {
+    objects = &sceneObjects;
+    for (PhaseBuckets& phase : phases) {
+        for (TypeBucket& bucket : phase.buckets) {
+            bucket.components.clear();
+        }
+    }
+
+    for (GameObject* obj : sceneObjects) {
+        if (!obj || !obj->isActive() || !obj->isValid()) continue;
+
+        for (const auto& comp : obj->getComponents()) {
+            if (!comp) continue;
+
+            Component* component = comp.get();
+            std::type_index type(typeid(*component));
+            auto it = slots.find(type);
+            if (it == slots.end()) {
+                // La declaracion es del tipo: se pregunta a la primera instancia y se guarda
+                ComponentUpdateInfo info = component->getUpdateInfo();
+                BucketSlot slot;
+                slot.phase = std::min(static_cast<size_t>(info.phase), static_cast<size_t>(UpdatePhase::Late));
+                slot.index = phases[slot.phase].buckets.size();
+                phases[slot.phase].buckets.emplace_back();
+                phases[slot.phase].buckets.back().info = info;
+                it = slots.emplace(type, slot).first;
+            }
+            phases[it->second.phase].buckets[it->second.index].components.push_back(component);
+        }
+    }
+
+    for (PhaseBuckets& phase : phases) {
+        buildWaves(phase);
+    }
+}
+
+void ComponentScheduler::buildWaves(PhaseBuckets& phase) {
+    phase.waveCount = 0;
+    for (size_t i = 0; i < phase.buckets.size(); i++) {
+        TypeBucket& bucket = phase.buckets[i];
+        if (bucket.components.empty()) continue;
+
+        // Justo despues de la ultima oleada con un tipo anterior que choque con este
+        bucket.wave = 0;
+        for (size_t j = 0; j < i; j++) {
+            const TypeBucket& earlier = phase.buckets[j];
+            if (!earlier.components.empty() && conflicts(bucket.info, earlier.info)) {
+                bucket.wave = std::max(bucket.wave, earlier.wave + 1);
+            }
+        }
+        phase.waveCount = std::max(phase.waveCount, bucket.wave + 1);
+    }
+}
+
+void ComponentScheduler::runBucket(TypeBucket& bucket, JobCounter& counter) {
+    JobSystem& jobs = JobSystem::getInstance();
+    bucket.workerComponents.clear();
+    bucket.mainThreadComponents.clear();
+
+    if (bucket.info.perObject) {
+        for (Component* component : bucket.components) {
+            if (component->needsMainThreadUpdate()) {
+                bucket.mainThreadComponents.push_back(component);
+            }
+            else {
+                bucket.workerComponents.push_back(component);
+            }
+        }
+
+        for (size_t begin = 0; begin < bucket.workerComponents.size(); begin += grain) {
+            size_t end = std::min(begin + grain, bucket.workerComponents.size());
+            jobs.schedule([&bucket, begin, end]() {
+                for (size_t i = begin; i < end; i++) {
+                    bucket.workerComponents[i]->update();
+                }
+            }, &counter);
+        }
+        return;
+    }
+
+    // En serie y en orden: si alguna instancia necesita el principal, van todas alli
+    bool mainThread = std::any_of(bucket.components.begin(), bucket.components.end(), [](const Component* component) {
+        return component->needsMainThreadUpdate();
+    });
+    if (mainThread) {
+        bucket.mainThreadComponents = bucket.components;
+        return;
+    }
+
+    bucket.workerComponents = bucket.components;
+    jobs.schedule([&bucket]() {
+        for (Component* component : bucket.workerComponents) {
+            component->update();
+        }
+    }, &counter);
+}
+
+void ComponentScheduler::run(UpdatePhase phaseId) {
+    PhaseBuckets& phase = phases[static_cast<size_t>(phaseId)];
+    JobSystem& jobs = JobSystem::getInstance();
+
+    for (size_t wave = 0; wave < phase.waveCount; wave++) {
+        JobCounter counter;
+        bool writesTransforms = false;
+        for (TypeBucket& bucket : phase.buckets) {
+            if (bucket.components.empty() || bucket.wave != wave) continue;
+            runBucket(bucket, counter);
+            writesTransforms = writesTransforms || (bucket.info.writes & ACCESS_TRANSFORM) != 0;
+        }
+
+        // Lo del hilo principal mientras los trabajadores hacen el resto de la oleada
+        for (TypeBucket& bucket : phase.buckets) {
+            if (bucket.components.empty() || bucket.wave != wave) continue;
+            for (Component* component : bucket.mainThreadComponents) {
+                component->update();
+            }
+        }
+        jobs.wait(counter);
+
+        // Las lecturas que vengan despues no deben rellenar caches de transform desde varios hilos
+        if (writesTransforms && objects) {
+            GameObject::updateWorldTransforms(*objects);
+        }
+    }
+}
+
+size_t ComponentScheduler::getTypeCount(UpdatePhase phaseId) const {
+    const PhaseBuckets& phase = phases[static_cast<size_t>(phaseId)];
+    return static_cast<size_t>(std::count_if(phase.buckets.begin(), phase.buckets.end(), [](const TypeBucket& bucket) {
+        return !bucket.components.empty();
+    }));
+}
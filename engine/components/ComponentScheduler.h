@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include "Component.h"
+#include "../core/JobSystem.h"
+#include "../core/CoreExporter.h"
+
+// Reparte update() de los componentes de una escena por fases y tipos. Cada tipo declara en
+// Component::getUpdateInfo() que estado compartido lee y escribe; dos tipos chocan si uno escribe
+// algo que el otro lee o escribe. Dentro de una fase los tipos se agrupan en oleadas: los de una
+// oleada no chocan entre si y corren a la vez en JobSystem, y un tipo va siempre despues de los
+// que chocan con el y aparecieron antes. Los tipos perObject se trocean entre hilos; el resto
+// corre en serie en un solo trabajo. Las instancias que piden el hilo principal
+// (Component::needsMainThreadUpdate) corren en el que llama mientras los trabajadores hacen lo suyo.
+// Solo hilo principal
+class MANTRAXCORE_API ComponentScheduler {
+public:
+    // Reparte los componentes de los objetos activos; una vez por frame antes de run()
+    void collect(const std::vector<GameObject*>& objects);
+    // update() de los componentes de phase. Si una oleada escribe transforms, las vuelve a
+    // resolver antes de la siguiente (GameObject::updateWorldTransforms)
+    void run(UpdatePhase phase);
+
+    // Instancias por trabajo en los tipos perObject
+    void setGrain(size_t count) { grain = count > 0 ? count : 1; }
+    size_t getGrain() const { return grain; }
+
+    size_t getTypeCount(UpdatePhase phase) const;
+    size_t getWaveCount(UpdatePhase phase) const { return phases[static_cast<size_t>(phase)].waveCount; }
+
+private:
+    struct TypeBucket {
+        ComponentUpdateInfo info;
+        std::vector<Component*> components;
+        std::vector<Component*> workerComponents;        // Rellenados en run()
+        std::vector<Component*> mainThreadComponents;
+        size_t wave = 0;
+    };
+
+    struct PhaseBuckets {
+        std::vector<TypeBucket> buckets;    // En el orden en que aparecio cada tipo
+        size_t waveCount = 0;
+    };
+
+    static bool conflicts(const ComponentUpdateInfo& a, const ComponentUpdateInfo& b);
+    void buildWaves(PhaseBuckets& phase);
+    // Encola lo de los trabajadores en counter; lo del principal queda en mainThreadComponents
+    void runBucket(TypeBucket& bucket, JobCounter& counter);
+
+    // Tipo -> fase y posicion en su PhaseBuckets; se conserva entre frames
+    struct BucketSlot {
+        size_t phase = 0;
+        size_t index = 0;
+    };
+    std::unordered_map<std::type_index, BucketSlot> slots;
+    PhaseBuckets phases[static_cast<size_t>(UpdatePhase::Count)];
+    const std::vector<GameObject*>* objects = nullptr;
+    size_t grain = 64;
+};
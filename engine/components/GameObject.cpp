@@ -1,8 +1,10 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include "GameObject.h"
+#include "Scene.h"
 #include "../render/AssimpGeometry.h"
 #include "../render/ModelLoader.h"
 #include "../core/FileSystem.h"
+#include "../core/JobSystem.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
@@ -68,6 +70,103 @@ GameObject::GameObject(std::shared_ptr<AssimpGeometry> geometry, std::shared_ptr
 GameObject::~GameObject()
 {
     cleanup();
+
+    // Borrado sin pasar por Scene::removeGameObject: que los indices no apunten aqui
+    if (scene)
+    {
+        scene->getObjectIndex().remove(this);
+    }
+    ObjectHandleTable::getInstance().release(handle);
+}
+
+void GameObject::setName(const std::string &name)
+{
+    if (Name == name)
+    {
+        return;
+    }
+
+    Name = name;
+    if (scene)
+    {
+        scene->getObjectIndex().rename(this);
+    }
+    markDirty();
+}
+
+void GameObject::setTag(const std::string &tag)
+{
+    if (Tag == tag)
+    {
+        return;
+    }
+
+    Tag = tag;
+    if (scene)
+    {
+        scene->getObjectIndex().retag(this);
+    }
+    markDirty();
+}
+
+void GameObject::setObjectID(const std::string &id)
+{
+    if (ObjectID == id)
+    {
+        return;
+    }
+
+    std::string previousID = ObjectID;
+    ObjectID = id;
+    if (scene)
+    {
+        scene->getObjectIndex().changeID(this, previousID);
+    }
+    markDirty();
+}
+
+void GameObject::setLayer(physx::PxU32 layer)
+{
+    if (Layer == layer)
+    {
+        return;
+    }
+
+    Layer = layer;
+    notifyLayerChanged();
+}
+
+void GameObject::setLayerMask(physx::PxU32 layerMask)
+{
+    if (LayerMask == layerMask)
+    {
+        return;
+    }
+
+    LayerMask = layerMask;
+    notifyLayerChanged();
+}
+
+void GameObject::notifyLayerChanged()
+{
+    // Los filtros de PhysX se actualizan aqui y no comparando capas en cada update
+    for (auto &comp : components)
+    {
+        if (comp)
+        {
+            comp->onLayerChanged();
+        }
+    }
+    markDirty();
+}
+
+// Definido aqui porque Component.h solo declara GameObject
+void Component::markDirty()
+{
+    if (owner)
+    {
+        owner->markDirty();
+    }
 }
 
 void GameObject::destroy()
@@ -79,6 +178,31 @@ void GameObject::destroy()
     }
 }
 
+void GameObject::setActive(bool value)
+{
+    if (active == value || isDestroyed)
+    {
+        return;
+    }
+
+    active = value;
+    for (auto &comp : components)
+    {
+        if (comp)
+        {
+            comp->onActiveChanged(value);
+        }
+    }
+
+    for (auto *child : children)
+    {
+        if (child)
+        {
+            child->setActive(value);
+        }
+    }
+}
+
 void GameObject::cleanup()
 {
     // Primero destruir todos los hijos
@@ -535,6 +659,23 @@ GameObject *GameObject::findChild(const std::string &name) const
 
 GameObject *GameObject::findChildRecursive(const std::string &name) const
 {
+    // Con escena: los objetos con ese nombre salen del indice y solo se comprueba si descienden
+    // de este, en lugar de recorrer todo el subarbol comparando nombres
+    if (scene)
+    {
+        for (GameObject *candidate : scene->findAllByName(name))
+        {
+            for (GameObject *ancestor = candidate->parent; ancestor; ancestor = ancestor->parent)
+            {
+                if (ancestor == this)
+                {
+                    return candidate;
+                }
+            }
+        }
+        return nullptr;
+    }
+
     GameObject *result = findChild(name);
     if (result)
     {
@@ -616,6 +757,7 @@ void GameObject::invalidateWorldTransform()
 {
     dirtyWorldTransform = true;
     worldBoundingSphereDirty = true;
+    markDirty(); // Tambien los hijos: su transform de mundo cambia
     updateChildrenTransforms();
 }
 
@@ -680,6 +822,14 @@ void GameObject::update(float deltaTime)
         }
     }
 
+    updateGraph();
+}
+
+void GameObject::updateGraph()
+{
+    if (isDestroyed)
+        return;
+
     _GlyphsEngine->ExecuteGraphOnTick();
 
     // Actualizar la transformación si es necesario
@@ -689,6 +839,53 @@ void GameObject::update(float deltaTime)
     }
 }
 
+void GameObject::updateWorldTransformTree() const
+{
+    if (dirtyWorldTransform)
+    {
+        updateWorldModelMatrix();
+    }
+    if (worldBoundingSphereDirty)
+    {
+        getWorldBoundingSphere();
+    }
+
+    // El padre ya esta resuelto: los hijos no vuelven a subir por el arbol
+    for (GameObject *child : children)
+    {
+        child->updateWorldTransformTree();
+    }
+}
+
+void GameObject::updateWorldTransforms(const std::vector<GameObject *> &objects)
+{
+    JobSystem::getInstance().parallelFor(objects.size(), 128, [&objects](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            GameObject *object = objects[i];
+            if (object && !object->parent)
+            {
+                object->updateWorldTransformTree();
+            }
+        }
+    });
+}
+
+void GameObject::fixedUpdate(float fixedDeltaTime)
+{
+    if (isDestroyed)
+        return;
+
+    for (auto &comp : components)
+    {
+        if (comp)
+        {
+            comp->fixedUpdate(fixedDeltaTime);
+        }
+    }
+}
+
 AssimpGeometry *GameObject::getGeometry() const
 {
     return geometry;
@@ -699,11 +896,13 @@ void GameObject::setGeometry(std::shared_ptr<AssimpGeometry> geom)
     geometry = geom.get();
     sharedGeometry = geom;
     calculateBoundingVolumes();
+    markDirty();
 }
 
 void GameObject::setModelPath(const std::string &path)
 {
     ModelPath = path;
+    markDirty();
 }
 
 bool GameObject::loadModelFromPath()
@@ -726,7 +925,8 @@ bool GameObject::loadModelFromPath(const std::string &path)
 
     // Usar el ModelLoader singleton para cargar el modelo
     auto &modelLoader = ModelLoader::getInstance();
-    auto loadedModel = modelLoader.loadModel(FileSystem::getProjectPath() + "\\Content\\" + path);
+    // Ruta relativa a Content: el VFS la resuelve en packs montados, overlays o disco
+    auto loadedModel = modelLoader.loadModel(FileSystem::normalizeAssetPath(path));
 
     std::cout << "Model Path: " << loadedModel << std::endl;
 
@@ -776,6 +976,7 @@ void GameObject::setMaterial(std::shared_ptr<Material> mat)
         std::cout << "  - No albedo texture" << std::endl;
     }
     material = mat;
+    markDirty();
     if (material == mat)
     {
         std::cout << "GameObject::setMaterial: Material successfully assigned to object '" << Name << "'" << std::endl;
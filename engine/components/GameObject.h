@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/mat4x4.hpp>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
@@ -14,8 +15,11 @@
 #include "../render/Frustum.h"
 #include "../core/CoreExporter.h"
 #include "../core/UIDGenerator.h"
+#include "../core/NameTable.h"
 #include "../render/AssimpGeometry.h"
 #include "Component.h"
+#include "ObjectHandle.h"
+#include "../core/SceneAllocator.h"
 #include "../mpak/MNodeEngine.h"
 
 // Layer constants for physics
@@ -50,11 +54,18 @@
 // Forward declaration
 class AssimpGeometry;
 class MNodeEngine;
+class Scene;
 class MANTRAXCORE_API GameObject
 {
 public:
     MNodeEngine *_GlyphsEngine;
 
+    // Memoria en los pools de la escena que se esta cargando o actualizando (ver SceneAllocator)
+    static void *operator new(std::size_t size) { return SceneAllocator::allocate(size); }
+    static void operator delete(void *ptr) { SceneAllocator::deallocate(ptr); }
+    static void *operator new(std::size_t, void *place) { return place; }
+    static void operator delete(void *, void *) {}
+
     // Constructor por defecto para objetos vacíos
     GameObject();
 
@@ -84,6 +95,29 @@ public:
     // Validación del objeto
     bool isValid() const { return !isDestroyed && ObjectID != ""; }
 
+    // Referencia que no queda colgando: handle.get() da nullptr cuando el objeto ya no existe
+    ObjectHandle getHandle() const { return handle; }
+    // Escena a la que pertenece (nullptr si no esta en ninguna)
+    Scene *getScene() const { return scene; }
+
+    // Cambiar Name, Tag u ObjectID por aqui mantiene al dia los indices de la escena
+    // (Scene::findByName, findByTag, findByID)
+    void setName(const std::string &name);
+    void setTag(const std::string &tag);
+    void setObjectID(const std::string &id);
+    // Destruccion pedida con SceneCommandBuffer::destroy, pendiente hasta el final del frame
+    bool isDestroyQueued() const { return destroyQueued; }
+
+    // Un objeto inactivo sigue en la escena pero no se actualiza ni se dibuja, y sus actores de
+    // fisica salen de la simulacion sin liberarse (ver ObjectPool). Se aplica tambien a los hijos.
+    void setActive(bool value);
+    bool isActive() const { return active; }
+
+    // Cambia cada vez que se modifica algo que se guarda en la escena (transform, jerarquia,
+    // componentes, modelo o material); el guardado incremental solo reserializa los que cambiaron
+    void markDirty() { revision++; }
+    uint64_t getRevision() const { return revision; }
+
     // ===== TRANSFORM SYSTEM =====
     // Local Transform (relative to parent)
     void setLocalPosition(const glm::vec3 &pos);
@@ -217,9 +251,9 @@ public:
 
     // Getters and setters for layer configuration
     physx::PxU32 getLayer() const { return Layer; }
-    void setLayer(physx::PxU32 layer) { Layer = layer; }
+    void setLayer(physx::PxU32 layer);
     physx::PxU32 getLayerMask() const { return LayerMask; }
-    void setLayerMask(physx::PxU32 layerMask) { LayerMask = layerMask; }
+    void setLayerMask(physx::PxU32 layerMask);
 
     // Sistema de componentes
     template <typename T, typename... Args>
@@ -231,6 +265,7 @@ public:
         comp->setOwner(this);
         T *rawPtr = comp.get();
         components.push_back(std::move(comp));
+        markDirty();
 
         if (rawPtr && rawPtr->isActive())
         {
@@ -325,6 +360,7 @@ public:
 
     void removeComponent(const Component *componentPtr)
     {
+        markDirty();
         components.erase(
             std::remove_if(components.begin(), components.end(),
                            [componentPtr](const std::unique_ptr<Component> &ptr)
@@ -336,6 +372,7 @@ public:
 
     bool removeComponentSafe(const Component *componentPtr)
     {
+        markDirty();
         auto initialSize = components.size();
         components.erase(
             std::remove_if(components.begin(), components.end(),
@@ -364,11 +401,15 @@ public:
                 it->get()->destroy();
             }
             components.erase(it);
+            markDirty();
             return true;
         }
         return false;
     }
 
+    // Sin copiar, para recorrerlos cada frame (ComponentScheduler)
+    const std::vector<std::unique_ptr<Component>> &getComponents() const { return components; }
+
     // Obtener todos los componentes
     std::vector<const Component *> getAllComponents() const
     {
@@ -384,8 +425,20 @@ public:
         return result;
     }
 
-    // Update method
+    // Update method: todos los componentes en serie y despues updateGraph(). La escena no la usa:
+    // reparte los componentes por fases con ComponentScheduler
     void update(float deltaTime);
+    // Grafo de Glyphs del objeto y transform pendiente; hilo principal
+    void updateGraph();
+    // Paso fijo de fisica: Component::fixedUpdate de todos los componentes
+    void fixedUpdate(float fixedDeltaTime);
+
+    // Matriz de mundo y esfera envolvente de este objeto y de sus hijos. No comparte estado con
+    // otros arboles, asi que raices distintas se pueden resolver en paralelo
+    void updateWorldTransformTree() const;
+    // Resuelve los arboles de todas las raices de objects repartidas en JobSystem; despues las
+    // lecturas de transform de esos objetos no escriben nada y valen desde cualquier hilo
+    static void updateWorldTransforms(const std::vector<GameObject *> &objects);
 
     std::string Name = "New Object";
     std::string Tag = "Default";
@@ -421,10 +474,31 @@ private:
     void removeFromParent();
     void addToParent(GameObject *newParent);
     void invalidateWorldTransform();
+    void notifyLayerChanged();
     void cleanup();
 
     std::vector<std::unique_ptr<Component>> components;
     bool shouldRender{true};
     bool shouldUpdateTransform{true};
     bool isDestroyed{false};
+    bool active{true};
+
+    // Posicion en Scene::gameObjects y RenderPipeline::sceneObjects, para quitar con swap-and-pop
+    friend class Scene;
+    friend class RenderPipeline;
+    friend class SceneCommandBuffer;
+    friend class SceneObjectIndex;
+    Scene *scene{nullptr};
+    size_t sceneIndex{SIZE_MAX};
+    size_t renderIndex{SIZE_MAX};
+    bool destroyQueued{false};
+    uint64_t revision{0};
+
+    ObjectHandle handle{ObjectHandleTable::getInstance().acquire(this)};
+
+    // Bucket y posicion en los indices de nombre y tag de la escena (ver SceneObjectIndex)
+    NameTable::Id nameId{NameTable::kNone};
+    NameTable::Id tagId{NameTable::kNone};
+    size_t nameSlot{SIZE_MAX};
+    size_t tagSlot{SIZE_MAX};
 };
\ No newline at end of file
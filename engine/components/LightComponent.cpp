@@ -327,8 +327,15 @@ std::string LightComponent::serializeComponent() const {
 }
 
 void LightComponent::deserialize(const std::string& data) {
-    json j = json::parse(data);
+    try {
+        deserializeJson(json::parse(data));
+    }
+    catch (const json::parse_error& e) {
+        std::cerr << "[LightComponent] Deserialization error: " << e.what() << std::endl;
+    }
+}
 
+void LightComponent::deserializeJson(const json& j) {
     LightType type = static_cast<LightType>(j.value("type", static_cast<int>(LightType::Point)));
     if (!light || light->getType() != type) {
         light = std::make_shared<Light>(type);
@@ -14,8 +14,15 @@ public:
 
     void defines() override;
     void update() override;
+    // Al final del frame, con las transforms ya movidas; solo copia propiedades y la transform
+    // del owner a su Light
+    ComponentUpdateInfo getUpdateInfo() const override {
+        return { UpdatePhase::Late, ACCESS_TRANSFORM, ACCESS_RENDER_STATE, true };
+    }
+    bool needsMainThreadUpdate() const override { return false; }
     std::string serializeComponent() const override;
     void deserialize(const std::string& data) override;
+    void deserializeJson(const nlohmann::json& data) override;
     void setOwner(GameObject* owner) override;
 
     // Validación del componente
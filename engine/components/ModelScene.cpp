@@ -43,7 +43,7 @@ void ModelScene::initialize() {
 
             // Crear modelo de carro usando el nuevo sistema de carga automática
             auto* carModel = new GameObject("x64/Debug/oldcar.fbx");
-            carModel->Name = "OldCar";
+            carModel->setName("OldCar");
             carModel->setLocalPosition({ 0.0f, 5.0f, 0.0f });
             carModel->setLocalScale({ 0.01f, 0.01f, 0.01f });
             carModel->setLocalRotationEuler({45.0f, 15.0f, 30.0f});
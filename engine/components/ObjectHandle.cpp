@@ -0,0 +1,64 @@
+#include "ObjectHandle.h"
+#include "GameObject.h"
+
+GameObject* ObjectHandle::get() const {
+    return ObjectHandleTable::getInstance().resolve(*this);
+}
+
+ObjectHandleTable& ObjectHandleTable::getInstance() {
+    // Sin destruir al salir: los GameObjects que sobreviven a los estaticos aun lo usan
+    static ObjectHandleTable* instance = new ObjectHandleTable();
+    return *instance;
+}
+
+ObjectHandle ObjectHandleTable::acquire(GameObject* object) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    slots[index].object = object;
+    liveCount++;
+    return ObjectHandle(index, slots[index].generation);
+}
+
+void ObjectHandleTable::release(ObjectHandle handle) {
+    if (handle.isNull()) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t index = handle.index();
+    if (index >= slots.size() || slots[index].generation != handle.generation()) {
+        return;
+    }
+
+    Slot& slot = slots[index];
+    slot.object = nullptr;
+    slot.generation = slot.generation >= kMaxGeneration ? 1 : slot.generation + 1;
+    freeSlots.push_back(index);
+    liveCount--;
+}
+
+GameObject* ObjectHandleTable::resolve(ObjectHandle handle) const {
+    if (handle.isNull()) return nullptr;
+
+    GameObject* object = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint32_t index = handle.index();
+        if (index < slots.size() && slots[index].generation == handle.generation()) {
+            object = slots[index].object;
+        }
+    }
+    return object && object->isValid() ? object : nullptr;
+}
+
+size_t ObjectHandleTable::getLiveCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return liveCount;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "../core/CoreExporter.h"
+
+class GameObject;
+
+// Referencia numerica de 64 bits a un GameObject: slot (32 bits bajos) + generacion (altos).
+// Al borrarse el objeto su slot cambia de generacion, asi que un handle viejo resuelve a nullptr
+// en lugar de a un puntero colgante. 0 es el handle nulo.
+struct MANTRAXCORE_API ObjectHandle {
+    uint64_t value = 0;
+
+    ObjectHandle() = default;
+    explicit ObjectHandle(uint64_t raw) : value(raw) {}
+    ObjectHandle(uint32_t index, uint32_t generation)
+        : value((static_cast<uint64_t>(generation) << 32) | index) {}
+
+    uint32_t index() const { return static_cast<uint32_t>(value & 0xFFFFFFFFu); }
+    uint32_t generation() const { return static_cast<uint32_t>(value >> 32); }
+    bool isNull() const { return value == 0; }
+
+    // nullptr si el objeto ya no existe o esta destruido
+    GameObject* get() const;
+
+    bool operator==(const ObjectHandle& other) const { return value == other.value; }
+    bool operator!=(const ObjectHandle& other) const { return value != other.value; }
+};
+
+struct ObjectHandleHash {
+    size_t operator()(const ObjectHandle& handle) const { return std::hash<uint64_t>()(handle.value); }
+};
+
+// Slots de todos los GameObjects vivos. Cada GameObject toma uno al construirse y lo devuelve
+// al destruirse; los slots libres se reutilizan con la generacion siguiente. Seguro entre hilos.
+class MANTRAXCORE_API ObjectHandleTable {
+public:
+    static ObjectHandleTable& getInstance();
+
+    ObjectHandle acquire(GameObject* object);
+    void release(ObjectHandle handle);
+    GameObject* resolve(ObjectHandle handle) const;
+
+    size_t getLiveCount() const;
+
+private:
+    // Generacion de 31 bits: el handle cabe en un entero de Lua sin signo negativo
+    static constexpr uint32_t kMaxGeneration = 0x7FFFFFFFu;
+
+    struct Slot {
+        GameObject* object = nullptr;
+        uint32_t generation = 1;
+    };
+
+    ObjectHandleTable() = default;
+
+    mutable std::mutex mutex;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    size_t liveCount = 0;
+};
@@ -0,0 +1,285 @@
+#include "ObjectPool.h"
+#include <algorithm>
+#include <iostream>
+#include <glm/gtc/quaternion.hpp>
+#include "Scene.h"
+#include "GameObject.h"
+#include "SceneManager.h"
+
+ObjectPool::ObjectPool(Scene* scene, std::shared_ptr<const Prefab> prefab)
+    : scene(scene), prefab(std::move(prefab)) {
+}
+
+ObjectPool::ObjectPool(Scene* scene, Factory factory)
+    : scene(scene), factory(std::move(factory)) {
+}
+
+GameObject* ObjectPool::create() {
+    if (!scene) {
+        return nullptr;
+    }
+
+    GameObject* obj = nullptr;
+    if (prefab) {
+        obj = prefab->instantiate(scene, PrefabTransform());
+    }
+    else if (factory) {
+        obj = factory(scene);
+    }
+
+    if (!obj) {
+        std::cerr << "ObjectPool: Could not create object" << std::endl;
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.baseScale = obj->getLocalScale();
+    entries.emplace(obj->getHandle(), entry);
+    return obj;
+}
+
+void ObjectPool::dropStale() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (!it->first.get()) {
+            it = entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    freeList.erase(std::remove_if(freeList.begin(), freeList.end(),
+        [](const ObjectHandle& handle) { return handle.get() == nullptr; }), freeList.end());
+}
+
+bool ObjectPool::owns(GameObject* obj) const {
+    return obj && entries.count(obj->getHandle()) != 0;
+}
+
+void ObjectPool::prewarm(size_t count) {
+    dropStale();
+    if (!scene || freeList.size() >= count) {
+        return;
+    }
+
+    size_t missing = count - freeList.size();
+    freeList.reserve(entries.size() + missing);
+    entries.reserve(entries.size() + missing);
+    scene->reserveGameObjects(missing * (prefab ? prefab->getNodes().size() : 1));
+
+    for (size_t i = 0; i < missing; i++) {
+        GameObject* obj = create();
+        if (!obj) {
+            break;
+        }
+        obj->setActive(false);
+        freeList.push_back(obj->getHandle());
+    }
+}
+
+GameObject* ObjectPool::acquire(const PrefabTransform& transform) {
+    GameObject* obj = nullptr;
+    // Los libres que se borraron por fuera del pool se descartan por el camino
+    while (!obj && !freeList.empty()) {
+        ObjectHandle handle = freeList.back();
+        freeList.pop_back();
+        obj = handle.get();
+        if (!obj) {
+            entries.erase(handle);
+        }
+    }
+
+    if (!obj) {
+        // Crece de uno en uno; prewarm() evita que esto pase durante el juego
+        obj = create();
+        if (!obj) {
+            return nullptr;
+        }
+        // Mismo camino que un objeto reciclado: el reset y la activacion ven el transform final
+        obj->setActive(false);
+    }
+
+    Entry& entry = entries[obj->getHandle()];
+    entry.inUse = true;
+
+    obj->setWorldPosition(transform.position);
+    obj->setWorldRotationQuat(glm::quat(glm::radians(transform.rotation)));
+    obj->setLocalScale(entry.baseScale * transform.scale);
+
+    if (resetHook) {
+        resetHook(obj);
+    }
+
+    // Los actores de fisica vuelven a la escena con el transform nuevo
+    obj->setActive(true);
+    return obj;
+}
+
+bool ObjectPool::release(GameObject* obj) {
+    if (!obj) {
+        return false;
+    }
+
+    auto it = entries.find(obj->getHandle());
+    if (it == entries.end() || !it->second.inUse) {
+        return false;
+    }
+
+    it->second.inUse = false;
+    obj->setActive(false);
+    freeList.push_back(it->first);
+    return true;
+}
+
+void ObjectPool::releaseAll() {
+    dropStale();
+    for (auto& pair : entries) {
+        if (pair.second.inUse) {
+            release(pair.first.get());
+        }
+    }
+}
+
+void ObjectPool::destroyAll() {
+    if (scene) {
+        for (auto& pair : entries) {
+            GameObject* root = pair.first.get();
+            if (!root) {
+                continue;
+            }
+
+            // Descendientes antes que la raiz: al borrarse, cada objeto se desvincula de su padre
+            std::vector<GameObject*> hierarchy{ root };
+            for (size_t i = 0; i < hierarchy.size(); i++) {
+                for (GameObject* child : hierarchy[i]->getChildren()) {
+                    hierarchy.push_back(child);
+                }
+            }
+            for (auto it = hierarchy.rbegin(); it != hierarchy.rend(); ++it) {
+                scene->removeGameObject(*it);
+            }
+        }
+    }
+    forget();
+}
+
+void ObjectPool::forget() {
+    freeList.clear();
+    entries.clear();
+}
+
+ObjectPoolManager& ObjectPoolManager::getInstance() {
+    static ObjectPoolManager instance;
+    return instance;
+}
+
+ObjectPool* ObjectPoolManager::createPool(const std::string& name, const std::string& prefabPath, size_t prewarm) {
+    auto it = pools.find(name);
+    if (it != pools.end()) {
+        return it->second.get();
+    }
+
+    Scene* scene = SceneManager::getInstance().getActiveScene();
+    auto prefab = Prefab::load(prefabPath);
+    if (!scene || !prefab) {
+        std::cerr << "ObjectPoolManager: Could not create pool '" << name << "' from " << prefabPath << std::endl;
+        return nullptr;
+    }
+
+    auto pool = std::make_unique<ObjectPool>(scene, prefab);
+    pool->prewarm(prewarm);
+    return (pools[name] = std::move(pool)).get();
+}
+
+ObjectPool* ObjectPoolManager::createPool(const std::string& name, Scene* scene, ObjectPool::Factory factory, size_t prewarm) {
+    auto it = pools.find(name);
+    if (it != pools.end()) {
+        return it->second.get();
+    }
+
+    if (!scene || !factory) {
+        return nullptr;
+    }
+
+    auto pool = std::make_unique<ObjectPool>(scene, std::move(factory));
+    pool->prewarm(prewarm);
+    return (pools[name] = std::move(pool)).get();
+}
+
+bool ObjectPoolManager::isPooled(GameObject* obj) const {
+    return obj && owners.count(obj->getHandle()) != 0;
+}
+
+ObjectPool* ObjectPoolManager::getPool(const std::string& name) const {
+    auto it = pools.find(name);
+    return it != pools.end() ? it->second.get() : nullptr;
+}
+
+void ObjectPoolManager::destroyPool(const std::string& name) {
+    auto it = pools.find(name);
+    if (it == pools.end()) {
+        return;
+    }
+
+    dropOwners(it->second.get());
+    it->second->destroyAll();
+    pools.erase(it);
+}
+
+GameObject* ObjectPoolManager::spawn(const std::string& name, const glm::vec3& position, const glm::vec3& rotation) {
+    ObjectPool* pool = getPool(name);
+    if (!pool) {
+        std::cerr << "ObjectPoolManager: Pool '" << name << "' not found" << std::endl;
+        return nullptr;
+    }
+
+    PrefabTransform transform;
+    transform.position = position;
+    transform.rotation = rotation;
+    GameObject* obj = pool->acquire(transform);
+    if (obj) {
+        owners.emplace(obj->getHandle(), pool);
+    }
+    return obj;
+}
+
+bool ObjectPoolManager::despawn(GameObject* obj) {
+    if (!obj) {
+        return false;
+    }
+
+    auto it = owners.find(obj->getHandle());
+    return it != owners.end() && it->second->release(obj);
+}
+
+void ObjectPoolManager::dropOwners(ObjectPool* pool) {
+    for (auto it = owners.begin(); it != owners.end();) {
+        if (it->second == pool) {
+            it = owners.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void ObjectPoolManager::forgetScene(Scene* scene) {
+    for (auto it = pools.begin(); it != pools.end();) {
+        if (it->second->getScene() == scene) {
+            dropOwners(it->second.get());
+            it = pools.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void ObjectPoolManager::clear(bool destroyObjects) {
+    if (destroyObjects) {
+        for (auto& pair : pools) {
+            pair.second->destroyAll();
+        }
+    }
+    owners.clear();
+    pools.clear();
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../core/CoreExporter.h"
+#include "Prefab.h"
+#include "ObjectHandle.h"
+
+class Scene;
+class GameObject;
+
+// Reserva de objetos reutilizables para lo que se crea y destruye sin parar (balas, pickups,
+// efectos). Los objetos se crean una vez y se quedan en la escena: release() los desactiva
+// (GameObject::setActive) y acquire() los recoloca y los vuelve a activar. Los actores de fisica
+// salen de la simulacion sin liberarse, asi que un ciclo acquire/release no reserva memoria.
+//
+// La escena sigue siendo la duena de los objetos. Se guardan por ObjectHandle: si uno se borra por
+// fuera del pool (jerarquia, removeGameObject, al destruir su padre) el pool lo olvida sin tocarlo.
+class MANTRAXCORE_API ObjectPool {
+public:
+    using Factory = std::function<GameObject*(Scene*)>;
+    using ResetHook = std::function<void(GameObject*)>;
+
+    ObjectPool(Scene* scene, std::shared_ptr<const Prefab> prefab);
+    // factory debe devolver un objeto ya añadido a la escena
+    ObjectPool(Scene* scene, Factory factory);
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Crea objetos inactivos hasta tener count libres
+    void prewarm(size_t count);
+
+    // Crea uno nuevo si no quedan libres; la escala multiplica la original del objeto
+    GameObject* acquire(const PrefabTransform& transform);
+    // false si obj no es de este pool o ya estaba libre
+    bool release(GameObject* obj);
+    void releaseAll();
+
+    // Se llama en cada acquire, antes de activar el objeto (vida, temporizadores...)
+    void setResetHook(ResetHook hook) { resetHook = std::move(hook); }
+
+    bool owns(GameObject* obj) const;
+    Scene* getScene() const { return scene; }
+    size_t getActiveCount() const { return entries.size() - freeList.size(); }
+    size_t getFreeCount() const { return freeList.size(); }
+    size_t getTotalCount() const { return entries.size(); }
+
+    // Quita de la escena y borra todos los objetos del pool (con sus hijos)
+    void destroyAll();
+    // Olvida los objetos sin tocarlos (la escena ya los ha destruido)
+    void forget();
+
+private:
+    struct Entry {
+        bool inUse = false;
+        glm::vec3 baseScale = glm::vec3(1.0f);
+    };
+
+    GameObject* create();
+    // Quita las entradas de objetos que ya no existen
+    void dropStale();
+
+    Scene* scene = nullptr;
+    std::shared_ptr<const Prefab> prefab;
+    Factory factory;
+    ResetHook resetHook;
+
+    std::vector<ObjectHandle> freeList;
+    std::unordered_map<ObjectHandle, Entry, ObjectHandleHash> entries;
+};
+
+// Pools con nombre para scripts y nodos. spawn/despawn en lugar de instantiate/destroy.
+class MANTRAXCORE_API ObjectPoolManager {
+public:
+    static ObjectPoolManager& getInstance();
+
+    // Pool de un .prefab en la escena activa; si ya existe con ese nombre se devuelve el mismo
+    ObjectPool* createPool(const std::string& name, const std::string& prefabPath, size_t prewarm = 0);
+    ObjectPool* createPool(const std::string& name, Scene* scene, ObjectPool::Factory factory, size_t prewarm = 0);
+    ObjectPool* getPool(const std::string& name) const;
+    void destroyPool(const std::string& name);
+
+    GameObject* spawn(const std::string& name, const glm::vec3& position, const glm::vec3& rotation = glm::vec3(0.0f));
+    // false si obj no pertenece a ningun pool
+    bool despawn(GameObject* obj);
+    bool isPooled(GameObject* obj) const;
+
+    // Pools de una escena que se va a limpiar o borrar; sus objetos los destruye la escena
+    void forgetScene(Scene* scene);
+    // destroyObjects = false cuando la escena ya se ha limpiado por otro camino
+    void clear(bool destroyObjects);
+
+private:
+    ObjectPoolManager() = default;
+
+    void dropOwners(ObjectPool* pool);
+
+    std::unordered_map<std::string, std::unique_ptr<ObjectPool>> pools;
+    std::unordered_map<ObjectHandle, ObjectPool*, ObjectHandleHash> owners;
+};
@@ -3,6 +3,8 @@
 #include "../core/PhysicsManager.h"
 #include "../core/PhysicsEventHandler.h"
 #include "../components/SceneManager.h"
+#include "../core/MeshCooker.h"
+#include "../render/AssimpGeometry.h"
 #include <iostream>
 #include <functional>
 #include <algorithm>
@@ -63,6 +65,8 @@ std::string PhysicalObject::getShapeTypeString() const {
         case ShapeType::Sphere: return "Sphere";
         case ShapeType::Capsule: return "Capsule";
         case ShapeType::Plane: return "Plane";
+        case ShapeType::TriangleMesh: return "Triangle Mesh";
+        case ShapeType::ConvexMesh: return "Convex Mesh";
         default: return "Unknown";
     }
 }
@@ -96,6 +100,7 @@ void PhysicalObject::safeSetCollisionFilters(CollisionGroup group, CollisionMask
         
         shape->setSimulationFilterData(filterData);
         shape->setQueryFilterData(filterData);
+        syncHullShapes();
         
     } catch (const std::exception& e) {
         // If setting filter data fails, we need to recreate the shape
@@ -115,6 +120,7 @@ void PhysicalObject::safeSetCollisionFilters(CollisionGroup group, CollisionMask
         if (rigidActor && shape) {
             rigidActor->detachShape(*shape);
         }
+        releaseHullShapes();
         
         // Destroy current shape and recreate it
         if (shape) {
@@ -128,6 +134,7 @@ void PhysicalObject::safeSetCollisionFilters(CollisionGroup group, CollisionMask
         // Reattach to actor
         if (rigidActor && shape) {
             rigidActor->attachShape(*shape);
+            attachHullShapes();
             
             // Configure shape flags correctly for custom filter shader
             if (isTriggerShape) {
@@ -139,7 +146,7 @@ void PhysicalObject::safeSetCollisionFilters(CollisionGroup group, CollisionMask
                 shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, true);
                 shape->setFlag(physx::PxShapeFlag::eSCENE_QUERY_SHAPE, true);
             }
-            
+            syncHullShapes();
         }
     }
 }
@@ -158,6 +165,7 @@ void PhysicalObject::recreateShapeSafely() {
     if (rigidActor && shape) {
         rigidActor->detachShape(*shape);
     }
+    releaseHullShapes();
     
     // Destroy current shape
     if (shape) {
@@ -171,6 +179,7 @@ void PhysicalObject::recreateShapeSafely() {
     // Reattach to actor
     if (rigidActor && shape) {
         rigidActor->attachShape(*shape);
+        attachHullShapes();
         
         // Configure shape flags correctly
         if (isTriggerShape) {
@@ -180,8 +189,39 @@ void PhysicalObject::recreateShapeSafely() {
             shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, false);
             shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, true);
         }
-        
+        syncHullShapes();
+    }
+}
+
+void PhysicalObject::syncHullShapes() {
+    if (!shape) return;
+    
+    physx::PxShapeFlags flags = shape->getFlags();
+    physx::PxFilterData simulationFilter = shape->getSimulationFilterData();
+    physx::PxFilterData queryFilter = shape->getQueryFilterData();
+    for (physx::PxShape* hull : hullShapes) {
+        hull->setFlags(flags);
+        hull->setSimulationFilterData(simulationFilter);
+        hull->setQueryFilterData(queryFilter);
+    }
+}
+
+void PhysicalObject::attachHullShapes() {
+    if (!rigidActor) return;
+    
+    for (physx::PxShape* hull : hullShapes) {
+        rigidActor->attachShape(*hull);
+    }
+}
+
+void PhysicalObject::releaseHullShapes() {
+    for (physx::PxShape* hull : hullShapes) {
+        if (rigidActor && hull->getActor() == rigidActor) {
+            rigidActor->detachShape(*hull);
+        }
+        hull->release();
     }
+    hullShapes.clear();
 }
 
 PhysicalObject::PhysicalObject(GameObject* obj) : Component() {
@@ -203,6 +243,7 @@ PhysicalObject::PhysicalObject(GameObject* obj) : Component() {
     sphereRadius = 0.5f;
     capsuleRadius = 0.5f;
     capsuleHalfHeight = 0.5f;
+    convexHullCount = 1;
     initialized = false;
     isTriggerShape = false;
     
@@ -252,14 +293,9 @@ void PhysicalObject::initializePhysics() {
     
     if (rigidActor && shape) {
         rigidActor->attachShape(*shape);
+        attachHullShapes();
         physicsManager.addActor(*rigidActor);
         
-        // Register this PhysicalObject with the PhysicsEventHandler
-        PhysicsEventHandler* eventHandler = physicsManager.getEventHandler();
-        if (eventHandler) {
-            eventHandler->registerPhysicalObject(rigidActor, this);
-        }
-        
         initialized = true;
         
         // Debug collision filters
@@ -281,52 +317,45 @@ void PhysicalObject::initializePhysics() {
     }
 }
 
-void PhysicalObject::update() {
-    auto& physicsManager = PhysicsManager::getInstance();
-    if (rigidActor && isActive() && physicsManager.getPhysics()) {
-        syncTransformFromPhysX();
-        
-        // Update collision filters only when necessary
-        // Check if layer configuration has changed
-        if (owner) {
-            physx::PxU32 gameObjectLayer = owner->getLayer();
-            physx::PxU32 gameObjectLayerMask = owner->getLayerMask();
-            
-            // Only update if the layer configuration has actually changed
-            if (gameObjectLayer != currentLayer || gameObjectLayerMask != currentLayerMask) {
-                currentLayer = gameObjectLayer;
-                currentLayerMask = gameObjectLayerMask;
-                
-                // Update filters safely for custom filter shader
-                if (shape) {
-                    try {
-                        // Configure shape flags for custom filter shader
-                        if (isTriggerShape) {
-                            shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, true);
-                            shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, false);
-                            shape->setFlag(physx::PxShapeFlag::eSCENE_QUERY_SHAPE, true);
-                        } else {
-                            shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, false);
-                            shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, true);
-                            shape->setFlag(physx::PxShapeFlag::eSCENE_QUERY_SHAPE, true);
-                        }
-                        
-                        // Set filter data for custom filter shader
-                        physx::PxFilterData filterData;
-                        filterData.word0 = currentLayer;  // Collision group
-                        filterData.word1 = currentLayerMask;  // Collision mask
-                        filterData.word2 = isTriggerShape ? 0x1 : 0x0;  // Trigger flag
-                        filterData.word3 = 0;
-                        
-                        shape->setSimulationFilterData(filterData);
-                        shape->setQueryFilterData(filterData);
-                        
-                    } catch (const std::exception& e) {
-                        std::cerr << "Error updating filters, recreating shape: " << e.what() << std::endl;
-                        recreateShapeSafely();
-                    }
-                }
+void PhysicalObject::onLayerChanged() {
+    if (!owner) return;
+    
+    physx::PxU32 gameObjectLayer = owner->getLayer();
+    physx::PxU32 gameObjectLayerMask = owner->getLayerMask();
+    if (gameObjectLayer == currentLayer && gameObjectLayerMask == currentLayerMask) return;
+    
+    currentLayer = gameObjectLayer;
+    currentLayerMask = gameObjectLayerMask;
+    
+    // Update filters safely for custom filter shader
+    if (shape) {
+        PhysicsManager::getInstance().fetchResults();
+        try {
+            // Configure shape flags for custom filter shader
+            if (isTriggerShape) {
+                shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, true);
+                shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, false);
+                shape->setFlag(physx::PxShapeFlag::eSCENE_QUERY_SHAPE, true);
+            } else {
+                shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, false);
+                shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, true);
+                shape->setFlag(physx::PxShapeFlag::eSCENE_QUERY_SHAPE, true);
             }
+            
+            // Set filter data for custom filter shader
+            physx::PxFilterData filterData;
+            filterData.word0 = currentLayer;  // Collision group
+            filterData.word1 = currentLayerMask;  // Collision mask
+            filterData.word2 = isTriggerShape ? 0x1 : 0x0;  // Trigger flag
+            filterData.word3 = 0;
+            
+            shape->setSimulationFilterData(filterData);
+            shape->setQueryFilterData(filterData);
+            syncHullShapes();
+            
+        } catch (const std::exception& e) {
+            std::cerr << "Error updating filters, recreating shape: " << e.what() << std::endl;
+            recreateShapeSafely();
         }
     }
 }
@@ -342,14 +371,18 @@ void PhysicalObject::destroy() {
         if (eventHandler) {
             eventHandler->unregisterTriggerCallback(rigidActor);
             eventHandler->unregisterContactCallback(rigidActor);
-            eventHandler->unregisterPhysicalObject(rigidActor);
         }
     }
     
+    stopInterpolation();
+    physicsManager.fetchResults();
+    
     // Remove from scene and release actor
     if (rigidActor && physicsManager.getPhysics()) {
         std::cout << "PhysicalObject: Removing actor from scene..." << std::endl;
-        physicsManager.removeActor(*rigidActor);
+        if (rigidActor->getScene()) {
+            physicsManager.removeActor(*rigidActor);
+        }
         
         std::cout << "PhysicalObject: Releasing rigid actor..." << std::endl;
         rigidActor->release();
@@ -364,6 +397,7 @@ void PhysicalObject::destroy() {
         shape->release();
         shape = nullptr;
     }
+    releaseHullShapes();
     
     // Release material if we own it
     if (material) {
@@ -407,6 +441,14 @@ void PhysicalObject::createBody() {
         rigidActor = staticActor;
         std::cout << "[PhysicalObject] Static actor created: " << (staticActor ? "SUCCESS" : "FAILED") << std::endl;
     }
+    
+    // Como en Rigidbody y Collider: los eventos y consultas llegan al GameObject por userData
+    if (rigidActor) {
+        rigidActor->userData = owner;
+    }
+    
+    // Solo los dinamicos se mueven en la simulacion
+    bindPhysicsActor(dynamicActor);
 }
 
 void PhysicalObject::createShape() {
@@ -434,6 +476,10 @@ void PhysicalObject::createShape() {
     case ShapeType::Plane:
         shape = physicsManager.createPlaneShape(material);
         break;
+    case ShapeType::TriangleMesh:
+    case ShapeType::ConvexMesh:
+        createMeshShape();
+        break;
     }
 
     if (!shape) {
@@ -471,10 +517,49 @@ void PhysicalObject::createShape() {
     shape->setSimulationFilterData(filterData);
     shape->setQueryFilterData(filterData);
     
+    syncHullShapes();
+    
     // Establecer la referencia del collider para el inspector
     setColliderReference(shape);
 }
 
+void PhysicalObject::createMeshShape() {
+    auto& physicsManager = PhysicsManager::getInstance();
+    
+    AssimpGeometry* geometry = owner ? owner->getGeometry() : nullptr;
+    if (!geometry || !geometry->isLoaded()) {
+        std::cerr << "[PhysicalObject] " << getShapeTypeString() << " needs a model on the GameObject, using a box instead" << std::endl;
+        shape = physicsManager.createBoxShape(
+            physx::PxVec3(boxHalfExtents.x, boxHalfExtents.y, boxHalfExtents.z),
+            material
+        );
+        return;
+    }
+    
+    // La malla se cocina en espacio del modelo; la escala del objeto va en la geometria de la shape
+    glm::vec3 scale = owner->getWorldScale();
+    physx::PxVec3 meshScale(scale.x, scale.y, scale.z);
+    
+    // PhysX no simula mallas triangulares en actores dinamicos: se usa su envolvente convexa
+    if (shapeType == ShapeType::TriangleMesh) {
+        if (!dynamicActor) {
+            shape = physicsManager.createTriangleMeshShape(*geometry, meshScale, material);
+            return;
+        }
+        std::cerr << "[PhysicalObject] Triangle meshes can't be dynamic, using a convex mesh for " << owner->Name << std::endl;
+    }
+    
+    MeshCookingParams params;
+    params.maxHulls = static_cast<uint32_t>(std::max(convexHullCount, 1));
+    
+    std::vector<physx::PxShape*> pieces = physicsManager.createConvexMeshShapes(*geometry, meshScale, params, material);
+    if (pieces.empty()) {
+        return;
+    }
+    shape = pieces[0];
+    hullShapes.assign(pieces.begin() + 1, pieces.end());
+}
+
 void PhysicalObject::verifyTriggerSetup() {
     if (!shape || !rigidActor) {
         return;
@@ -497,6 +582,7 @@ void PhysicalObject::verifyTriggerSetup() {
 
 void PhysicalObject::syncTransformToPhysX() {
     if (!rigidActor) return;
+    PhysicsManager::getInstance().fetchResults();
     
     glm::vec3 position = owner->getWorldPosition();
     glm::quat rotation = owner->getWorldRotationQuat();
@@ -507,20 +593,35 @@ void PhysicalObject::syncTransformToPhysX() {
     );
     
     rigidActor->setGlobalPose(transform);
+    resetInterpolation(position, rotation);
 }
 
 void PhysicalObject::syncTransformFromPhysX() {
     if (!rigidActor) return;
     
-    physx::PxTransform transform = rigidActor->getGlobalPose();
-    
-    glm::vec3 position(transform.p.x, transform.p.y, transform.p.z);
-    glm::quat rotation(transform.q.w, transform.q.x, transform.q.y, transform.q.z);
-    
+    // Sincronizacion manual inmediata; la de cada frame la hace PhysicsManager::syncTransforms()
+    glm::vec3 position;
+    glm::quat rotation;
+    if (readPhysicsPose(position, rotation)) {
+        writePhysicsPose(position, rotation);
+    }
+}
+
+void PhysicalObject::writePhysicsPose(const glm::vec3& position, const glm::quat& rotation) {
     owner->setWorldPosition(position);
     owner->setWorldRotationQuat(rotation);
 }
 
+bool PhysicalObject::readPhysicsPose(glm::vec3& position, glm::quat& rotation) const {
+    // Los estaticos no se mueven en la simulacion: nada que interpolar
+    if (!dynamicActor) return false;
+    
+    physx::PxTransform transform = dynamicActor->getGlobalPose();
+    position = glm::vec3(transform.p.x, transform.p.y, transform.p.z);
+    rotation = glm::quat(transform.q.w, transform.q.x, transform.q.y, transform.q.z);
+    return true;
+}
+
 void PhysicalObject::setMass(float newMass) {
     mass = newMass;
     if (dynamicActor) {
@@ -530,7 +631,10 @@ void PhysicalObject::setMass(float newMass) {
 
 void PhysicalObject::setVelocity(const glm::vec3& velocity) {
     if (dynamicActor) {
-        dynamicActor->setLinearVelocity(physx::PxVec3(velocity.x, velocity.y, velocity.z));
+        physx::PxRigidDynamic* actor = dynamicActor;
+        PhysicsManager::getInstance().queueWrite([actor, velocity]() {
+            actor->setLinearVelocity(physx::PxVec3(velocity.x, velocity.y, velocity.z));
+        });
     }
 }
 
@@ -629,6 +733,19 @@ void PhysicalObject::setShapeType(ShapeType type) {
     }
 }
 
+void PhysicalObject::setConvexHullCount(int count) {
+    count = std::max(count, 1);
+    if (convexHullCount == count) {
+        return;
+    }
+    
+    convexHullCount = count;
+    if (initialized && shapeType == ShapeType::ConvexMesh) {
+        destroy();
+        start();
+    }
+}
+
 void PhysicalObject::setBoxHalfExtents(const glm::vec3& extents) {
     boxHalfExtents = extents;
     if (initialized && shapeType == ShapeType::Box) {
@@ -732,6 +849,7 @@ void PhysicalObject::configureTriggerFlags() {
     filterData.word2 = isTriggerShape ? 0x1 : 0x0;  // Trigger flag
     shape->setSimulationFilterData(filterData);
     shape->setQueryFilterData(filterData);
+    syncHullShapes();
 }
 
 
@@ -757,11 +875,15 @@ void PhysicalObject::addForce(const glm::vec3& force, physx::PxForceMode::Enum m
         physx::PxVec3 currentVel = dynamicActor->getLinearVelocity();
         std::cout << "[PhysicalObject] Current velocity: (" << currentVel.x << ", " << currentVel.y << ", " << currentVel.z << ")" << std::endl;
         
-        dynamicActor->addForce(physx::PxVec3(force.x, force.y, force.z), mode);
-        
-        // Get velocity after applying force
-        physx::PxVec3 newVel = dynamicActor->getLinearVelocity();
-        std::cout << "[PhysicalObject] New velocity: (" << newVel.x << ", " << newVel.y << ", " << newVel.z << ")" << std::endl;
+        // Con un paso en vuelo se aplica al recoger sus resultados
+        physx::PxRigidDynamic* actor = dynamicActor;
+        PhysicsManager::getInstance().queueWrite([actor, force, mode]() {
+            actor->addForce(physx::PxVec3(force.x, force.y, force.z), mode);
+            
+            // Get velocity after applying force
+            physx::PxVec3 newVel = actor->getLinearVelocity();
+            std::cout << "[PhysicalObject] New velocity: (" << newVel.x << ", " << newVel.y << ", " << newVel.z << ")" << std::endl;
+        });
         
     } else {
         std::cout << "[PhysicalObject] ERROR: dynamicActor is null! Cannot add force." << std::endl;
@@ -772,7 +894,10 @@ void PhysicalObject::addForce(const glm::vec3& force, physx::PxForceMode::Enum m
 
 void PhysicalObject::addTorque(const glm::vec3& torque, physx::PxForceMode::Enum mode) {
     if (dynamicActor) {
-        dynamicActor->addTorque(physx::PxVec3(torque.x, torque.y, torque.z), mode);
+        physx::PxRigidDynamic* actor = dynamicActor;
+        PhysicsManager::getInstance().queueWrite([actor, torque, mode]() {
+            actor->addTorque(physx::PxVec3(torque.x, torque.y, torque.z), mode);
+        });
     }
 }
 
@@ -786,11 +911,14 @@ void PhysicalObject::addImpulse(const glm::vec3& impulse, physx::PxForceMode::En
         physx::PxVec3 currentVel = dynamicActor->getLinearVelocity();
         std::cout << "[PhysicalObject] Current velocity: (" << currentVel.x << ", " << currentVel.y << ", " << currentVel.z << ")" << std::endl;
         
-        dynamicActor->addForce(physx::PxVec3(impulse.x, impulse.y, impulse.z), mode);
-        
-        // Get velocity after applying impulse
-        physx::PxVec3 newVel = dynamicActor->getLinearVelocity();
-        std::cout << "[PhysicalObject] New velocity: (" << newVel.x << ", " << newVel.y << ", " << newVel.z << ")" << std::endl;
+        physx::PxRigidDynamic* actor = dynamicActor;
+        PhysicsManager::getInstance().queueWrite([actor, impulse, mode]() {
+            actor->addForce(physx::PxVec3(impulse.x, impulse.y, impulse.z), mode);
+            
+            // Get velocity after applying impulse
+            physx::PxVec3 newVel = actor->getLinearVelocity();
+            std::cout << "[PhysicalObject] New velocity: (" << newVel.x << ", " << newVel.y << ", " << newVel.z << ")" << std::endl;
+        });
         
     } else {
         std::cout << "[PhysicalObject] ERROR: dynamicActor is null! Cannot add impulse." << std::endl;
@@ -821,10 +949,9 @@ void PhysicalObject::setTriggerCallback(std::function<void(PhysicalObject*, Phys
         auto& physicsManager = PhysicsManager::getInstance();
         PhysicsEventHandler* eventHandler = physicsManager.getEventHandler();
         if (eventHandler) {
-            eventHandler->registerTriggerCallback(rigidActor, [this, eventHandler](const TriggerEvent& event) {
+            eventHandler->registerTriggerCallback(rigidActor, [this](const TriggerEvent& event) {
                 if (triggerCallback) {
-                    // Find the other PhysicalObject using the mapping
-                    PhysicalObject* other = eventHandler->getPhysicalObject(event.otherActor);
+                    PhysicalObject* other = PhysicsEventHandler::getPhysicalObject(event.otherActor);
                     triggerCallback(this, other);
                 }
             });
@@ -840,16 +967,16 @@ void PhysicalObject::setContactCallback(std::function<void(PhysicalObject*, Phys
         auto& physicsManager = PhysicsManager::getInstance();
         PhysicsEventHandler* eventHandler = physicsManager.getEventHandler();
         if (eventHandler) {
-            eventHandler->registerContactCallback(rigidActor, [this, eventHandler](const ContactEvent& event) {
+            eventHandler->registerContactCallback(rigidActor, [this](const ContactEvent& event) {
                 if (contactCallback) {
                     // Find the other PhysicalObject
                     PhysicalObject* other = nullptr;
                     
                     // Determine which actor is the "other" one
                     if (event.actor1 == rigidActor) {
-                        other = eventHandler->getPhysicalObject(event.actor2);
+                        other = PhysicsEventHandler::getPhysicalObject(event.actor2);
                     } else if (event.actor2 == rigidActor) {
-                        other = eventHandler->getPhysicalObject(event.actor1);
+                        other = PhysicsEventHandler::getPhysicalObject(event.actor1);
                     }
                     
                     contactCallback(this, other, event.contactPoint, event.contactNormal, event.contactForce);
@@ -961,6 +1088,7 @@ void PhysicalObject::forceUpdateCollisionFiltersAggressive() {
             
             shape->setSimulationFilterData(filterData);
             shape->setQueryFilterData(filterData);
+            syncHullShapes();
             
             debugCollisionFilters();
         } catch (const std::exception& e) {
@@ -1133,6 +1261,7 @@ std::string PhysicalObject::serializeComponent() const {
     j["sphereRadius"] = std::isfinite(sphereRadius) ? sphereRadius : 0.5f;
     j["capsuleRadius"] = std::isfinite(capsuleRadius) ? capsuleRadius : 0.5f;
     j["capsuleHalfHeight"] = std::isfinite(capsuleHalfHeight) ? capsuleHalfHeight : 0.5f;
+    j["convexHullCount"] = convexHullCount;
 
     // Configuración de capas y colisiones
     j["currentLayer"] = currentLayer;
@@ -1206,8 +1335,15 @@ std::string PhysicalObject::serializeComponent() const {
 
 void PhysicalObject::deserialize(const std::string& data) {
     try {
-        json j = json::parse(data);
+        deserializeJson(json::parse(data));
+    }
+    catch (const json::parse_error& e) {
+        std::cerr << "[PhysicalObject] Deserialization error: " << e.what() << std::endl;
+    }
+}
 
+void PhysicalObject::deserializeJson(const json& j) {
+    try {
         // 2. Restaurar propiedades básicas (como variables locales, igual que en ImGui)
         BodyType deserializedBodyType = static_cast<BodyType>(j.value("bodyType", static_cast<int>(BodyType::Static)));
         ShapeType deserializedShapeType = static_cast<ShapeType>(j.value("shapeType", static_cast<int>(ShapeType::Box)));
@@ -1229,6 +1365,7 @@ void PhysicalObject::deserialize(const std::string& data) {
         float deserializedSphereRadius = j.value("sphereRadius", 0.5f);
         float deserializedCapsuleRadius = j.value("capsuleRadius", 0.5f);
         float deserializedCapsuleHalfHeight = j.value("capsuleHalfHeight", 0.5f);
+        int deserializedConvexHullCount = j.value("convexHullCount", 1);
 
         // Configuración de capas
         physx::PxU32 deserializedCurrentLayer = j.value("currentLayer", static_cast<physx::PxU32>(0));
@@ -1271,6 +1408,11 @@ void PhysicalObject::deserialize(const std::string& data) {
                 setBodyType(deserializedBodyType);
             }
 
+            // Antes del Shape Type para no cocinar dos veces al pasar a ConvexMesh
+            if (convexHullCount != deserializedConvexHullCount) {
+                setConvexHullCount(deserializedConvexHullCount);
+            }
+
             // Aplicar Shape Type (igual que en ImGui)
             if (shapeType != deserializedShapeType) {
                 setShapeType(deserializedShapeType);
@@ -1394,6 +1536,7 @@ void PhysicalObject::deserialize(const std::string& data) {
                 shape->setFlag(physx::PxShapeFlag::eVISUALIZATION,
                     shapeFlags.value("isVisualization", true));
             }
+            syncHullShapes();
 
             // Sincronizar transformación final
             syncTransformToPhysX();
@@ -1435,6 +1578,7 @@ void PhysicalObject::deserialize(const std::string& data) {
         sphereRadius = 0.5f;
         capsuleRadius = 0.5f;
         capsuleHalfHeight = 0.5f;
+        convexHullCount = 1;
         isTriggerShape = false;
         currentLayer = 0;
         currentLayerMask = 0xFFFFFFFF;
@@ -1451,4 +1595,25 @@ void PhysicalObject::deserialize(const std::string& data) {
             }
         }
     }
-}
\ No newline at end of file
+}
+
+void PhysicalObject::onActiveChanged(bool active) {
+    auto& physicsManager = PhysicsManager::getInstance();
+    if (!rigidActor || !physicsManager.getScene()) return;
+
+    if (!active) {
+        if (rigidActor->getScene()) {
+            physicsManager.removeActor(*rigidActor);
+        }
+        return;
+    }
+
+    if (!rigidActor->getScene()) {
+        syncTransformToPhysX();
+        if (dynamicActor && bodyType != BodyType::Kinematic) {
+            dynamicActor->setLinearVelocity(physx::PxVec3(0.0f));
+            dynamicActor->setAngularVelocity(physx::PxVec3(0.0f));
+        }
+        physicsManager.addActor(*rigidActor);
+    }
+}
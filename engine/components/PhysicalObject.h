@@ -8,6 +8,7 @@
 #include "../core/CoreExporter.h"
 #include "../core/PhysicsManager.h"
 #include "../core/PhysicsEvents.h"
+#include "../core/PhysicsInterpolation.h"
 #include <functional>
 
 enum class MANTRAXCORE_API BodyType {
@@ -20,18 +21,21 @@ enum class MANTRAXCORE_API ShapeType {
     Box,
     Sphere,
     Capsule,
-    Plane
+    Plane,
+    TriangleMesh,   // Malla del modelo tal cual; en cuerpos dinamicos se usa ConvexMesh
+    ConvexMesh      // Envolvente convexa del modelo, o varias con convexHullCount > 1
 };
 
 class MANTRAXCORE_API GameObject;
 
-class MANTRAXCORE_API PhysicalObject : public Component {
+class MANTRAXCORE_API PhysicalObject : public Component, public InterpolatedBody {
 private:
     // PhysX objects
     physx::PxRigidActor* rigidActor;
     physx::PxRigidDynamic* dynamicActor;
     physx::PxRigidStatic* staticActor;
     physx::PxShape* shape;
+    std::vector<physx::PxShape*> hullShapes;   // Piezas de la descomposicion convexa aparte de shape
     physx::PxMaterial* material;
     
     // Collider reference for inspector modification
@@ -51,6 +55,7 @@ private:
     float sphereRadius;
     float capsuleRadius;
     float capsuleHalfHeight;
+    int convexHullCount;
     
     bool initialized;
     bool isTriggerShape;
@@ -74,13 +79,20 @@ public:
     std::string getComponentName() const override {
         return "Physical Object";
     }
+    // No usa update(); a su actor lo mueve PhysX
+    ComponentUpdateInfo getUpdateInfo() const override {
+        return { UpdatePhase::PostPhysics, ACCESS_NONE, ACCESS_NONE, true };
+    }
+    bool needsMainThreadUpdate() const override { return false; }
     
     // Component overrides
     void defines() override;
     void start() override;
-    void update() override;
     void destroy() override;
+    void onActiveChanged(bool active) override;
+    void onLayerChanged() override;
     void deserialize(const std::string& data) override;
+    void deserializeJson(const nlohmann::json& data) override;
     std::string serializeComponent() const override;
 
     // Manual initialization
@@ -89,6 +101,7 @@ public:
     // Body creation
     void createBody();
     void createShape();
+    void createMeshShape();
     void verifyTriggerSetup();
     void configureShapeFlags();
     void configureTriggerFlags(); // Nueva función para configurar triggers correctamente
@@ -96,6 +109,12 @@ public:
     // Transform synchronization
     void syncTransformToPhysX();
     void syncTransformFromPhysX();
+
+protected:
+    bool readPhysicsPose(glm::vec3& position, glm::quat& rotation) const override;
+    void writePhysicsPose(const glm::vec3& position, const glm::quat& rotation) override;
+
+public:
     
     // Getters
     physx::PxRigidActor* getRigidActor() const { return rigidActor; }
@@ -150,6 +169,11 @@ public:
     void setCapsuleHalfHeight(float halfHeight);
     float getCapsuleHalfHeight() const { return capsuleHalfHeight; }
     
+    // Piezas de la descomposicion convexa (solo ShapeType::ConvexMesh; 1 = una sola envolvente)
+    void setConvexHullCount(int count);
+    int getConvexHullCount() const { return convexHullCount; }
+    const std::vector<physx::PxShape*>& getHullShapes() const { return hullShapes; }
+    
     // Forces and impulses
     void addForce(const glm::vec3& force, physx::PxForceMode::Enum mode = physx::PxForceMode::eFORCE);
     void addTorque(const glm::vec3& torque, physx::PxForceMode::Enum mode = physx::PxForceMode::eFORCE);
@@ -190,6 +214,11 @@ public:
     // Helper function to recreate shape safely when shared shape issues occur
     void recreateShapeSafely();
     
+    // Las piezas extra de un ConvexMesh siguen a la shape principal (flags y filtros)
+    void syncHullShapes();
+    void attachHullShapes();
+    void releaseHullShapes();
+    
     // Helper function to get shape type as string
     std::string getShapeTypeString() const;
     
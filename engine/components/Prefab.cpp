@@ -0,0 +1,260 @@
+#include "Prefab.h"
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+#include <glm/gtc/quaternion.hpp>
+#include "Scene.h"
+#include "GameObject.h"
+#include "ScriptExecutor.h"
+#include "SceneObjectLoader.h"
+#include "../core/FileSystem.h"
+#include "../render/ModelLoader.h"
+#include "../render/MaterialManager.h"
+
+namespace {
+    std::unordered_map<std::string, std::shared_ptr<const Prefab>> prefabCache;
+}
+
+std::shared_ptr<const Prefab> Prefab::fromObjects(const std::string& prefabName, const std::vector<SceneObjectData>& objects) {
+    // Padre de cada objeto: por indice (archivos binarios) o por ID
+    std::unordered_map<std::string, int> indexByID;
+    for (size_t i = 0; i < objects.size(); i++) {
+        if (!objects[i].objectID.empty()) indexByID[objects[i].objectID] = static_cast<int>(i);
+    }
+
+    int root = -1;
+    std::vector<std::vector<int>> children(objects.size());
+    for (size_t i = 0; i < objects.size(); i++) {
+        int parent = objects[i].parentIndex;
+        if (parent < 0 && !objects[i].parentID.empty()) {
+            auto it = indexByID.find(objects[i].parentID);
+            if (it != indexByID.end()) parent = it->second;
+        }
+
+        if (parent >= 0 && static_cast<size_t>(parent) < objects.size() && parent != static_cast<int>(i)) {
+            children[parent].push_back(static_cast<int>(i));
+        }
+        else if (root < 0) {
+            root = static_cast<int>(i);
+        }
+    }
+
+    if (root < 0) {
+        std::cerr << "Prefab: '" << prefabName << "' has no root object" << std::endl;
+        return nullptr;
+    }
+
+    // Orden en profundidad: cada padre queda antes que sus hijos
+    std::vector<int> order;
+    std::vector<int> parentOf(objects.size(), -1);
+    std::vector<bool> visited(objects.size(), false);
+    std::vector<int> stack{ root };
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+        if (visited[index]) continue;
+        visited[index] = true;
+        order.push_back(index);
+        for (auto it = children[index].rbegin(); it != children[index].rend(); ++it) {
+            parentOf[*it] = index;
+            stack.push_back(*it);
+        }
+    }
+
+    // Transforms locales resueltos con la misma jerarquia temporal que usa la carga de escenas
+    std::vector<GameObject*> temp(objects.size(), nullptr);
+    for (int index : order) {
+        temp[index] = SceneObjectLoader::createObject(objects[index]);
+        if (parentOf[index] >= 0) {
+            temp[index]->setParent(temp[parentOf[index]]);
+        }
+    }
+
+    auto prefab = std::make_shared<Prefab>();
+    prefab->name = prefabName;
+    prefab->nodes.reserve(order.size());
+
+    std::unordered_map<int, int> nodeIndex;
+    auto& modelLoader = ModelLoader::getInstance();
+    for (int index : order) {
+        const SceneObjectData& object = objects[index];
+        GameObject* obj = temp[index];
+
+        Node node;
+        node.name = object.name;
+        node.tag = object.tag;
+        node.parent = parentOf[index] >= 0 ? nodeIndex[parentOf[index]] : -1;
+        node.localPosition = obj->getLocalPosition();
+        node.localRotation = obj->getLocalRotationQuat();
+        node.localScale = obj->getLocalScale();
+
+        node.modelPath = object.modelPath;
+        if (!object.modelPath.empty()) {
+            node.geometry = modelLoader.loadModel(FileSystem::normalizeAssetPath(object.modelPath));
+        }
+        if (object.hasMaterial && !object.materialName.empty()) {
+            node.material = MaterialManager::getInstance().getMaterial(object.materialName);
+        }
+
+        for (const auto& compData : object.components) {
+            Component component;
+            std::string typeName = compData.value("type", "");
+            component.type = BinarySceneWriter::componentTypeFromName(typeName);
+            if (component.type == SceneComponentType::Unknown) {
+                std::cerr << "Prefab: Skipping unknown component '" << typeName << "' in " << prefabName << std::endl;
+                continue;
+            }
+            component.enabled = compData.value("enabled", true);
+            component.data = compData;
+
+            // Compilar los scripts ahora y no en la primera instancia
+            if (component.type == SceneComponentType::ScriptExecutor && compData.contains("luaPath")) {
+                std::string error;
+                ScriptExecutor::getCompiledScript(compData["luaPath"].get<std::string>(), error);
+            }
+            node.components.push_back(std::move(component));
+        }
+
+        nodeIndex[index] = static_cast<int>(prefab->nodes.size());
+        prefab->nodes.push_back(std::move(node));
+    }
+
+    // Hijos antes que padres: cada uno se desvincula de su padre al destruirse
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        delete temp[*it];
+    }
+
+    return prefab;
+}
+
+std::shared_ptr<const Prefab> Prefab::load(const std::string& assetPath) {
+    std::string key = FileSystem::normalizeAssetPath(assetPath);
+    auto it = prefabCache.find(key);
+    if (it != prefabCache.end()) {
+        return it->second;
+    }
+
+    FileData file;
+    BinarySceneReader reader;
+    if (!FileSystem::readAsset(assetPath, file) || !reader.openMemory(file.data(), file.size())) {
+        std::cerr << "Prefab: Could not open " << assetPath << std::endl;
+        return nullptr;
+    }
+
+    std::vector<SceneObjectData> objects(reader.getObjectCount());
+    for (size_t i = 0; i < objects.size(); i++) {
+        if (!reader.readObject(i, objects[i], true)) {
+            std::cerr << "Prefab: Corrupt object " << i << " in " << assetPath << std::endl;
+            return nullptr;
+        }
+    }
+
+    auto prefab = fromObjects(FileSystem::getFileNameWithoutExtension(assetPath), objects);
+    if (prefab) {
+        prefabCache[key] = prefab;
+    }
+    return prefab;
+}
+
+void Prefab::unload(const std::string& assetPath) {
+    prefabCache.erase(FileSystem::normalizeAssetPath(assetPath));
+}
+
+void Prefab::clearCache() {
+    prefabCache.clear();
+}
+
+bool Prefab::save(const std::vector<SceneObjectData>& objects, const std::string& filePath) {
+    if (objects.empty()) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::path directory = std::filesystem::path(filePath).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, ec);
+    }
+
+    BinarySceneWriter writer;
+    writer.setMetadata({ { "Prefab", objects.front().name } });
+    writer.reserveObjects(objects.size());
+    for (const auto& object : objects) {
+        writer.addObject(object);
+    }
+
+    if (!writer.writeToFile(filePath)) {
+        return false;
+    }
+
+    // Un prefab ya cargado con esta ruta queda obsoleto
+    unload(FileSystem::GetPathAfterContent(filePath));
+    return true;
+}
+
+GameObject* Prefab::build(Scene* scene, const PrefabTransform& transform, std::vector<GameObject*>& instance) const {
+    instance.assign(nodes.size(), nullptr);
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const Node& node = nodes[i];
+
+        GameObject* obj = node.geometry ? new GameObject(node.geometry, node.material) : new GameObject();
+        obj->setName(node.name);
+        obj->setTag(node.tag);
+        if (!node.modelPath.empty()) {
+            obj->setModelPath(node.modelPath);
+        }
+        if (!node.geometry && node.material) {
+            obj->setMaterial(node.material);
+        }
+
+        if (node.parent < 0) {
+            obj->setWorldPosition(transform.position);
+            obj->setWorldRotationQuat(glm::quat(glm::radians(transform.rotation)) * node.localRotation);
+            obj->setLocalScale(node.localScale * transform.scale);
+        }
+        else {
+            obj->setParentNoWorldPreserve(instance[node.parent]);
+            obj->setLocalPosition(node.localPosition);
+            obj->setLocalRotationQuat(node.localRotation);
+            obj->setLocalScale(node.localScale);
+        }
+
+        scene->addGameObject(obj);
+        instance[i] = obj;
+    }
+
+    // Componentes al final: los actores de fisica se crean ya con el transform definitivo
+    for (size_t i = 0; i < nodes.size(); i++) {
+        for (const Component& component : nodes[i].components) {
+            SceneObjectLoader::addComponent(instance[i], component.type, component.data, component.enabled);
+        }
+    }
+
+    return instance.front();
+}
+
+GameObject* Prefab::instantiate(Scene* scene, const PrefabTransform& transform) const {
+    if (!scene || nodes.empty()) {
+        return nullptr;
+    }
+
+    std::vector<GameObject*> instance;
+    return build(scene, transform, instance);
+}
+
+std::vector<GameObject*> Prefab::instantiate(Scene* scene, const std::vector<PrefabTransform>& transforms) const {
+    std::vector<GameObject*> roots;
+    if (!scene || nodes.empty()) {
+        return roots;
+    }
+
+    roots.reserve(transforms.size());
+    scene->reserveGameObjects(transforms.size() * nodes.size());
+
+    std::vector<GameObject*> instance;
+    instance.reserve(nodes.size());
+    for (const PrefabTransform& transform : transforms) {
+        roots.push_back(build(scene, transform, instance));
+    }
+    return roots;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <nlohmann/json.hpp>
+#include "../core/CoreExporter.h"
+#include "../core/BinaryScene.h"
+
+class Scene;
+class GameObject;
+class AssimpGeometry;
+class Material;
+
+// Posicion y rotacion (Euler, grados) en mundo de la raiz de una instancia. La escala multiplica
+// la de la raiz del prefab.
+struct MANTRAXCORE_API PrefabTransform {
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 rotation = glm::vec3(0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+};
+
+// Jerarquia de objetos cocinada una vez y lista para copiar. Todo lo inmutable se resuelve al
+// cocinar y lo comparten las instancias: geometria y material (shared_ptr), datos de los
+// componentes ya parseados con su tipo resuelto, y el bytecode de los scripts (ver
+// ScriptExecutor::getCompiledScript). Instanciar no toca disco ni parsea nada.
+//
+// Los archivos .prefab usan el formato binario de escena; el primer objeto sin padre es la raiz.
+class MANTRAXCORE_API Prefab {
+public:
+    struct Component {
+        SceneComponentType type = SceneComponentType::Unknown;
+        bool enabled = true;
+        nlohmann::json data;
+    };
+
+    struct Node {
+        std::string name;
+        std::string tag;
+        int parent = -1;                            // Siempre menor que el indice del nodo
+        glm::vec3 localPosition = glm::vec3(0.0f);
+        glm::quat localRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec3 localScale = glm::vec3(1.0f);
+        std::string modelPath;
+        std::shared_ptr<AssimpGeometry> geometry;
+        std::shared_ptr<Material> material;
+        std::vector<Component> components;
+    };
+
+    // Cocina la jerarquia de la primera raiz de objects (padres por parentIndex o parentID).
+    // Hilo principal: carga modelos.
+    static std::shared_ptr<const Prefab> fromObjects(const std::string& name, const std::vector<SceneObjectData>& objects);
+
+    // Lee y cocina un .prefab del VFS; las siguientes llamadas con la misma ruta devuelven el mismo
+    static std::shared_ptr<const Prefab> load(const std::string& assetPath);
+    static void unload(const std::string& assetPath);
+    static void clearCache();
+
+    // objects: raiz y descendientes, en el formato de SceneSaver::CaptureObject
+    static bool save(const std::vector<SceneObjectData>& objects, const std::string& filePath);
+
+    // Devuelven la raiz de cada instancia; ya estan en la escena con sus componentes iniciados
+    GameObject* instantiate(Scene* scene, const PrefabTransform& transform) const;
+    std::vector<GameObject*> instantiate(Scene* scene, const std::vector<PrefabTransform>& transforms) const;
+
+    const std::string& getName() const { return name; }
+    const std::vector<Node>& getNodes() const { return nodes; }
+
+private:
+    GameObject* build(Scene* scene, const PrefabTransform& transform, std::vector<GameObject*>& instance) const;
+
+    std::string name;
+    std::vector<Node> nodes;
+};
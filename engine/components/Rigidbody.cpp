@@ -39,26 +39,20 @@ void Rigidbody::start()
     }
 }
 
-void Rigidbody::update()
-{
-    if (initialized && rigidActor)
-    {
-        // Sync transform from PhysX to GameObject
-        syncTransformFromPhysX();
-    }
-}
-
 void Rigidbody::destroy()
 {
     std::cout << "[Rigidbody] Starting cleanup for " << (owner ? owner->Name : "Unknown") << std::endl;
 
+    stopInterpolation();
+
     if (rigidActor)
     {
         std::cout << "[Rigidbody] Removing actor from scene..." << std::endl;
         auto &physicsManager = PhysicsManager::getInstance();
-        if (physicsManager.getScene())
+        physicsManager.fetchResults();
+        if (physicsManager.getScene() && rigidActor->getScene())
         {
-            physicsManager.getScene()->removeActor(*rigidActor);
+            physicsManager.removeActor(*rigidActor);
         }
 
         std::cout << "[Rigidbody] Releasing rigid actor..." << std::endl;
@@ -135,6 +129,9 @@ void Rigidbody::createBody()
     }
     }
 
+    // Los estaticos no se mueven en la simulacion: no hace falta sincronizarlos
+    bindPhysicsActor(dynamicActor);
+
     if (rigidActor)
     {
         // Set user data to link back to this component
@@ -154,6 +151,7 @@ void Rigidbody::syncTransformToPhysX()
 {
     if (!rigidActor)
         return;
+    PhysicsManager::getInstance().fetchResults();
 
     glm::vec3 position = owner->getWorldPosition();
     glm::quat rotation = owner->getWorldRotationQuat();
@@ -168,7 +166,9 @@ void Rigidbody::syncTransformToPhysX()
     }
     else
     {
+        // Teletransporte: sin mezclar con la pose del paso anterior
         rigidActor->setGlobalPose(transform);
+        resetInterpolation(position, rotation);
     }
 }
 
@@ -177,11 +177,30 @@ void Rigidbody::syncTransformFromPhysX()
     if (!rigidActor || bodyType == BodyType::Static)
         return;
 
-    physx::PxTransform transform = rigidActor->getGlobalPose();
+    // Sincronizacion manual inmediata; la de cada frame la hace PhysicsManager::syncTransforms()
+    glm::vec3 position;
+    glm::quat rotation;
+    if (readPhysicsPose(position, rotation))
+    {
+        writePhysicsPose(position, rotation);
+    }
+}
 
-    // Update GameObject transform
-    owner->setWorldPosition(glm::vec3(transform.p.x, transform.p.y, transform.p.z));
-    owner->setWorldRotationQuat(glm::quat(transform.q.w, transform.q.x, transform.q.y, transform.q.z));
+void Rigidbody::writePhysicsPose(const glm::vec3 &position, const glm::quat &rotation)
+{
+    owner->setWorldPosition(position);
+    owner->setWorldRotationQuat(rotation);
+}
+
+bool Rigidbody::readPhysicsPose(glm::vec3 &position, glm::quat &rotation) const
+{
+    if (!dynamicActor)
+        return false;
+
+    physx::PxTransform transform = dynamicActor->getGlobalPose();
+    position = glm::vec3(transform.p.x, transform.p.y, transform.p.z);
+    rotation = glm::quat(transform.q.w, transform.q.x, transform.q.y, transform.q.z);
+    return true;
 }
 
 // Physics properties
@@ -198,7 +217,9 @@ void Rigidbody::setVelocity(const glm::vec3 &velocity)
 {
     if (dynamicActor && bodyType == BodyType::Dynamic)
     {
-        dynamicActor->setLinearVelocity(physx::PxVec3(velocity.x, velocity.y, velocity.z));
+        physx::PxRigidDynamic *actor = dynamicActor;
+        PhysicsManager::getInstance().queueWrite([actor, velocity]()
+                                                 { actor->setLinearVelocity(physx::PxVec3(velocity.x, velocity.y, velocity.z)); });
     }
 }
 
@@ -287,7 +308,9 @@ void Rigidbody::addForce(const glm::vec3 &force, physx::PxForceMode::Enum mode)
 {
     if (dynamicActor && bodyType == BodyType::Dynamic)
     {
-        dynamicActor->addForce(physx::PxVec3(force.x, force.y, force.z), mode);
+        physx::PxRigidDynamic *actor = dynamicActor;
+        PhysicsManager::getInstance().queueWrite([actor, force, mode]()
+                                                 { actor->addForce(physx::PxVec3(force.x, force.y, force.z), mode); });
     }
 }
 
@@ -295,7 +318,9 @@ void Rigidbody::addTorque(const glm::vec3 &torque, physx::PxForceMode::Enum mode
 {
     if (dynamicActor && bodyType == BodyType::Dynamic)
     {
-        dynamicActor->addTorque(physx::PxVec3(torque.x, torque.y, torque.z), mode);
+        physx::PxRigidDynamic *actor = dynamicActor;
+        PhysicsManager::getInstance().queueWrite([actor, torque, mode]()
+                                                 { actor->addTorque(physx::PxVec3(torque.x, torque.y, torque.z), mode); });
     }
 }
 
@@ -303,7 +328,9 @@ void Rigidbody::addImpulse(const glm::vec3 &impulse, physx::PxForceMode::Enum mo
 {
     if (dynamicActor && bodyType == BodyType::Dynamic)
     {
-        dynamicActor->addForce(physx::PxVec3(impulse.x, impulse.y, impulse.z), mode);
+        physx::PxRigidDynamic *actor = dynamicActor;
+        PhysicsManager::getInstance().queueWrite([actor, impulse, mode]()
+                                                 { actor->addForce(physx::PxVec3(impulse.x, impulse.y, impulse.z), mode); });
     }
 }
 
@@ -365,8 +392,18 @@ void Rigidbody::deserialize(const std::string &data)
 {
     try
     {
-        json j = json::parse(data);
+        deserializeJson(json::parse(data));
+    }
+    catch (const json::parse_error &e)
+    {
+        std::cerr << "[Rigidbody] Deserialization error: " << e.what() << std::endl;
+    }
+}
 
+void Rigidbody::deserializeJson(const json &j)
+{
+    try
+    {
         if (j.contains("bodyType"))
         {
             bodyType = static_cast<BodyType>(j["bodyType"]);
@@ -389,3 +426,40 @@ void Rigidbody::deserialize(const std::string &data)
         std::cerr << "[Rigidbody] Deserialization error: " << e.what() << std::endl;
     }
 }
+
+void Rigidbody::onActiveChanged(bool active)
+{
+    auto &physicsManager = PhysicsManager::getInstance();
+    if (!rigidActor || !physicsManager.getScene())
+    {
+        return;
+    }
+
+    if (!active)
+    {
+        // Fuera de la simulacion pero sin liberar: reactivar no reconstruye el actor
+        if (rigidActor->getScene())
+        {
+            physicsManager.removeActor(*rigidActor);
+        }
+        return;
+    }
+
+    if (!rigidActor->getScene())
+    {
+        // setKinematicTarget requiere que el actor este en la escena
+        glm::vec3 position = owner->getWorldPosition();
+        glm::quat rotation = owner->getWorldRotationQuat();
+        rigidActor->setGlobalPose(physx::PxTransform(
+            physx::PxVec3(position.x, position.y, position.z),
+            physx::PxQuat(rotation.x, rotation.y, rotation.z, rotation.w)));
+        resetInterpolation(position, rotation);
+
+        if (dynamicActor && bodyType != BodyType::Kinematic)
+        {
+            dynamicActor->setLinearVelocity(physx::PxVec3(0.0f));
+            dynamicActor->setAngularVelocity(physx::PxVec3(0.0f));
+        }
+        physicsManager.addActor(*rigidActor);
+    }
+}
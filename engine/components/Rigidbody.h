@@ -8,10 +8,11 @@
 #include "../core/CoreExporter.h"
 #include "../core/PhysicsManager.h"
 #include "PhysicalObject.h"
+#include "../core/PhysicsInterpolation.h"
 
 class MANTRAXCORE_API GameObject;
 
-class MANTRAXCORE_API Rigidbody : public Component {
+class MANTRAXCORE_API Rigidbody : public Component, public InterpolatedBody {
 private:
     // PhysX objects
     physx::PxRigidActor* rigidActor;
@@ -33,13 +34,19 @@ public:
     std::string getComponentName() const override {
         return "Rigidbody";
     }
+    // update() vacio: la pose la trae PhysicsManager::syncTransforms
+    ComponentUpdateInfo getUpdateInfo() const override {
+        return { UpdatePhase::PostPhysics, ACCESS_NONE, ACCESS_NONE, true };
+    }
+    bool needsMainThreadUpdate() const override { return false; }
     
     // Component overrides
     void defines() override;
     void start() override;
-    void update() override;
     void destroy() override;
+    void onActiveChanged(bool active) override;
     void deserialize(const std::string& data) override;
+    void deserializeJson(const nlohmann::json& data) override;
     std::string serializeComponent() const override;
 
     // Manual initialization
@@ -51,6 +58,12 @@ public:
     // Transform synchronization
     void syncTransformToPhysX();
     void syncTransformFromPhysX();
+
+protected:
+    bool readPhysicsPose(glm::vec3& position, glm::quat& rotation) const override;
+    void writePhysicsPose(const glm::vec3& position, const glm::quat& rotation) override;
+
+public:
     
     // Getters
     physx::PxRigidActor* getRigidActor() const { return rigidActor; }
@@ -2,13 +2,92 @@
 #include "../render/RenderPipeline.h"
 #include "../components/PhysicalObject.h"
 #include "SceneManager.h"
+#include "ObjectPool.h"
 #include <iostream>
 
-Scene::Scene(const std::string& name) : name(name), initialized(false), camera(nullptr), renderPipeline(nullptr) {
+Scene::Scene(const std::string& name) : name(name), initialized(false), camera(nullptr), renderPipeline(nullptr),
+    allocator(std::make_unique<SceneAllocator>()) {
     std::cout << "Scene: Creating new scene: " << name << std::endl;
     std::cout << "Scene: Initial camera state: " << (camera ? "Valid" : "Null") << std::endl;
 }
 
+Scene::~Scene() {
+    for (auto* obj : gameObjects) {
+        if (obj) {
+            obj->scene = nullptr;
+        }
+    }
+
+    // Objetos de esta escena que siguen vivos fuera de ella (la escena se borro sin cleanup()):
+    // sus bloques apuntan a estos pools, asi que no se pueden liberar
+    if (allocator && allocator->hasLiveObjects()) {
+        std::cerr << "Scene: '" << name << "' destroyed with live objects; keeping its allocator" << std::endl;
+        allocator.release();
+    }
+}
+
+void Scene::cleanup() {
+    std::cout << "Scene: cleanup - start" << std::endl;
+
+    // Las celdas en streaming y los pools guardan punteros a estos objetos
+    auto& sceneManager = SceneManager::getInstance();
+    if (sceneManager.getWorldPartition().getScene() == this) {
+        sceneManager.getWorldPartition().close();
+    }
+    ObjectPoolManager::getInstance().forgetScene(this);
+
+    // Lo que quede grabado entra en la escena para borrarse con el resto
+    applyCommands();
+    allocator->logStats(name + " before cleanup");
+
+    std::cout << "Scene: cleaning gameObjects..." << std::endl;
+    // Sin jerarquia antes de borrar: asi el orden no importa y ningun hijo toca a un padre ya borrado
+    objectIndex.clear();
+    for (auto* obj : gameObjects) {
+        if (obj) {
+            obj->parent = nullptr;
+            obj->children.clear();
+            obj->scene = nullptr;
+        }
+    }
+    for (auto* obj : gameObjects) {
+        if (obj) {
+            if (renderPipeline) {
+                renderPipeline->RemoveGameObject(obj);
+            }
+            delete obj;
+        }
+    }
+    gameObjects.clear();
+
+    std::cout << "renderPipeline ptr: " << renderPipeline << std::endl;
+    if (renderPipeline) {
+        std::cout << "renderPipeline is not nullptr" << std::endl;
+        renderPipeline->clearLights();
+    }
+    else {
+        std::cout << "renderPipeline IS nullptr!" << std::endl;
+    }
+
+    std::cout << "Scene: clearing lights..." << std::endl;
+    lights.clear();
+
+    // NO eliminar la cámara para preservar su estado
+    // std::cout << "Scene: clearing camera..." << std::endl;
+    // camera.reset();
+
+    // Todos los chunks de una vez; si algun objeto de la escena vive fuera de ella se conservan
+    if (allocator->release()) {
+        allocator->logStats(name + " after cleanup");
+    }
+    else {
+        std::cerr << "Scene: objects allocated by '" << name << "' are still alive; pools kept" << std::endl;
+    }
+
+    initialized = false;
+    std::cout << "Scene: cleanup - end" << std::endl;
+}
+
 void Scene::initialize() {
     std::cout << "Scene: Initializing scene: " << name << std::endl;
     
@@ -32,50 +111,135 @@ void Scene::initialize() {
 }
 
 void Scene::addGameObject(GameObject* object) {
-    if (object) {
-        gameObjects.push_back(object);
-        
-        // Sincronizar automáticamente con RenderPipeline si está disponible
-        if (renderPipeline) {
-            renderPipeline->AddGameObject(object);
-        }
+    if (!object) return;
+
+    // No invalidar el recorrido de updateNative (scripts que instancian en OnTick)
+    if (updating) {
+        commands.spawn(object);
+        return;
+    }
+    insertGameObject(object);
+}
+
+void Scene::insertGameObject(GameObject* object) {
+    object->sceneIndex = gameObjects.size();
+    object->scene = this;
+    gameObjects.push_back(object);
+    objectIndex.add(object);
+    
+    // Sincronizar automáticamente con RenderPipeline si está disponible
+    if (renderPipeline) {
+        renderPipeline->AddGameObject(object);
     }
 }
 
 void Scene::addGameObjectNoSync(GameObject* object) {
     if (object) {
+        object->sceneIndex = gameObjects.size();
+        object->scene = this;
         gameObjects.push_back(object);
+        objectIndex.add(object);
+    }
+}
+
+void Scene::reserveGameObjects(size_t additional) {
+    gameObjects.reserve(gameObjects.size() + additional);
+    if (renderPipeline) {
+        renderPipeline->ReserveGameObjects(additional);
     }
 }
 
 void Scene::removeGameObject(GameObject* object) {
-    if (object) {
-        // Verificar que el objeto esté en la lista antes de eliminarlo
+    if (!object) return;
+
+    if (updating) {
+        commands.destroy(object);
+        return;
+    }
+
+    // Verificar que el objeto esté en la lista antes de eliminarlo
+    if (eraseGameObject(object)) {
+        // Eliminar el objeto de la memoria
+        delete object;
+    }
+}
+
+bool Scene::eraseGameObject(GameObject* object) {
+    // El indice puede haber quedado viejo tras cleanup(); entonces se busca
+    size_t index = object->sceneIndex;
+    if (index >= gameObjects.size() || gameObjects[index] != object) {
         auto it = std::find(gameObjects.begin(), gameObjects.end(), object);
-        if (it != gameObjects.end()) {
-            // Remover del RenderPipeline primero
-            if (renderPipeline) {
-                renderPipeline->RemoveGameObject(object);
-            }
-            // Remover de la lista de game objects
-            gameObjects.erase(it);
-            // Eliminar el objeto de la memoria
-            delete object;
+        if (it == gameObjects.end()) {
+            return false;
+        }
+        index = static_cast<size_t>(it - gameObjects.begin());
+    }
+
+    // Remover del RenderPipeline primero
+    if (renderPipeline) {
+        renderPipeline->RemoveGameObject(object);
+    }
+
+    // Swap-and-pop
+    if (index != gameObjects.size() - 1) {
+        gameObjects[index] = gameObjects.back();
+        gameObjects[index]->sceneIndex = index;
+    }
+    gameObjects.pop_back();
+    object->sceneIndex = SIZE_MAX;
+
+    objectIndex.remove(object);
+    object->scene = nullptr;
+    return true;
+}
+
+void Scene::fixedUpdateNative(float fixedDeltaTime) {
+    // Mismas reglas que updateNative: los cambios estructurales esperan al final del frame
+    SceneAllocator::Scope allocatorScope(allocator.get());
+    updating = true;
+    for (auto* obj : gameObjects) {
+        if (obj && obj->isActive()) {
+            obj->fixedUpdate(fixedDeltaTime);
         }
     }
+    updating = false;
 }
 
 void Scene::updateNative(float deltaTime) {
-    // Update all game objects
+    // Update all game objects. Los cambios estructurales de los scripts se graban en commands
+    // y gameObjects no cambia hasta applyCommands(). Lo que creen va a los pools de la escena
+    SceneAllocator::Scope allocatorScope(allocator.get());
+    updating = true;
+
+    // Componentes por fases; en cada una los tipos que no chocan corren a la vez en JobSystem.
+    // Con las transforms ya resueltas sus lecturas no escriben nada
+    GameObject::updateWorldTransforms(gameObjects);
+    componentScheduler.collect(gameObjects);
+    componentScheduler.run(UpdatePhase::PostPhysics);
+    componentScheduler.run(UpdatePhase::PrePhysics);
+
+    // Grafos de Glyphs: en serie en el hilo principal, como los scripts
     for (auto* obj : gameObjects) {
-        if (obj) {
-            obj->update(deltaTime);
+        if (obj && obj->isActive()) {
+            obj->updateGraph();
         }
     }
-    
+    GameObject::updateWorldTransforms(gameObjects);
+
+    componentScheduler.run(UpdatePhase::Animation);
+    componentScheduler.run(UpdatePhase::Late);
+    updating = false;
+
+    // Una sola fase para todo lo grabado en el frame; antes de iniciar la fisica para que lo
+    // creado por los scripts tenga sus actores este mismo frame
+    applyCommands();
+
     // Initialize physics components if physics is available
     auto& sceneManager = SceneManager::getInstance();
     if (sceneManager.getPhysicsManager().getPhysics()) {
+        // Los estaticos de esta pasada entran juntos con su arbol de consultas ya construido
+        PhysicsManager& physicsManager = sceneManager.getPhysicsManager();
+        physicsManager.beginActorBatch();
         for (auto* obj : gameObjects) {
             if (obj) {
                 // Initialize any PhysicalObject components that haven't been initialized yet
@@ -86,6 +250,7 @@ void Scene::updateNative(float deltaTime) {
                 }
             }
         }
+        physicsManager.endActorBatch();
     }
 }
 
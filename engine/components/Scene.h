@@ -4,6 +4,10 @@
 #include <memory>
 #include <vector>
 #include "GameObject.h"
+#include "SceneCommandBuffer.h"
+#include "ComponentScheduler.h"
+#include "SceneObjectIndex.h"
+#include "../core/SceneAllocator.h"
 #include "../render/Camera.h"
 #include "../render/Light.h"
 #include "../render/RenderPipeline.h"
@@ -15,50 +19,41 @@ class RenderPipeline;
 class MANTRAXCORE_API Scene {
 public:
     Scene(const std::string& name = "New Scene");
-    virtual ~Scene() = default;
+    virtual ~Scene();
 
     virtual void initialize();
     virtual void update(float deltaTime) {}
     void updateNative(float deltaTime);
+    // Una vez por paso fijo de fisica, antes de simular (lo llama PhysicsManager::update)
+    void fixedUpdateNative(float fixedDeltaTime);
 
-    virtual void cleanup() {
-        std::cout << "Scene: cleanup - start" << std::endl;
-
-        std::cout << "Scene: cleaning gameObjects..." << std::endl;
-        gameObjects.clear();
-
-        std::cout << "renderPipeline ptr: " << renderPipeline << std::endl;
-        if (renderPipeline) {
-            std::cout << "renderPipeline is not nullptr" << std::endl;
-            renderPipeline->clearLights();
-        }
-        else {
-            std::cout << "renderPipeline IS nullptr!" << std::endl;
-        }
-
-        std::cout << "Scene: clearing lights..." << std::endl;
-        lights.clear();
-
-        // NO eliminar la cámara para preservar su estado
-        // std::cout << "Scene: clearing camera..." << std::endl;
-        // camera.reset();
-
-        initialized = false;
-        std::cout << "Scene: cleanup - end" << std::endl;
-    }
+    // Borra todos los objetos y devuelve de golpe la memoria de sus pools (ver SceneAllocator)
+    virtual void cleanup();
 
     const std::string& getName() const { return name; }
     void setName(std::string newName) { name = newName; }
     bool isInitialized() const { return initialized; }
     void setInitialized(bool value) { initialized = value; }
 
+    // Durante updateNative se graba en el buffer de comandos y se aplica al final del frame
     void addGameObject(GameObject* object);
     
     // Agregar objeto sin sincronización automática (para casos especiales)
     void addGameObjectNoSync(GameObject* object);
+
+    // Antes de añadir muchos objetos seguidos (instanciado en lote)
+    void reserveGameObjects(size_t additional);
     
-    // Remover objeto del scene
+    // Remover objeto del scene (durante updateNative, con sus hijos al final del frame)
     void removeGameObject(GameObject* object);
+
+    // Cambios estructurales diferidos; ver SceneCommandBuffer
+    SceneCommandBuffer& getCommands() { return commands; }
+    void applyCommands() { commands.apply(*this); }
+    bool isUpdating() const { return updating; }
+
+    // Pools de GameObjects y componentes; activo durante updateNative y la carga de la escena
+    SceneAllocator* getAllocator() const { return allocator.get(); }
     
     // RenderPipeline access
     void setRenderPipeline(RenderPipeline* pipeline) { renderPipeline = pipeline; }
@@ -70,6 +65,15 @@ public:
     void removeLight(std::shared_ptr<Light> light);
 
     const std::vector<GameObject*>& getGameObjects() const { return gameObjects; }
+
+    // Busquedas O(1) en los indices de la escena (ver SceneObjectIndex). Lo creado durante
+    // updateNative no aparece hasta aplicar los comandos al final del frame
+    GameObject* findByID(const std::string& objectID) { return objectIndex.findByID(objectID); }
+    GameObject* findByName(const std::string& name) { return objectIndex.findByName(name); }
+    GameObject* findByTag(const std::string& tag) { return objectIndex.findByTag(tag); }
+    const std::vector<GameObject*>& findAllByName(const std::string& name) { return objectIndex.findAllByName(name); }
+    const std::vector<GameObject*>& findAllByTag(const std::string& tag) { return objectIndex.findAllByTag(tag); }
+    SceneObjectIndex& getObjectIndex() { return objectIndex; }
     const std::vector<std::shared_ptr<Light>>& getLights() const { return lights; }
 
     const Camera* getCamera() const { return camera.get(); }
@@ -83,10 +87,21 @@ public:
     bool isProperlyConfigured() const { return camera != nullptr && renderPipeline != nullptr; }
 
 protected:
+    friend class SceneCommandBuffer;
+
+    // Inmediatos: solo fuera de la iteracion de gameObjects
+    void insertGameObject(GameObject* object);
+    bool eraseGameObject(GameObject* object);
+
     std::string name;
     std::vector<GameObject*> gameObjects;
     std::vector<std::shared_ptr<Light>> lights;
     std::unique_ptr<Camera> camera;
     RenderPipeline* renderPipeline = nullptr;
     bool initialized;
+    bool updating = false;
+    SceneCommandBuffer commands;
+    ComponentScheduler componentScheduler;
+    SceneObjectIndex objectIndex;
+    std::unique_ptr<SceneAllocator> allocator;
 }; 
\ No newline at end of file
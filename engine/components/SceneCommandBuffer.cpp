@@ -0,0 +1,173 @@
+#include "SceneCommandBuffer.h"
+#include "Scene.h"
+#include "GameObject.h"
+
+void SceneCommandBuffer::record(Command&& command) {
+    std::lock_guard<std::mutex> lock(mutex);
+    commands.push_back(std::move(command));
+}
+
+void SceneCommandBuffer::spawn(GameObject* obj) {
+    if (!obj) return;
+
+    Command command;
+    command.type = Type::Spawn;
+    command.object = obj;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::destroy(GameObject* obj) {
+    if (!obj) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (obj->destroyQueued) {
+        return;
+    }
+    obj->destroyQueued = true;
+
+    Command command;
+    command.type = Type::Destroy;
+    command.object = obj;
+    commands.push_back(std::move(command));
+}
+
+void SceneCommandBuffer::setParent(GameObject* obj, GameObject* parent, bool keepWorldTransform) {
+    if (!obj) return;
+
+    Command command;
+    command.type = Type::SetParent;
+    command.object = obj;
+    command.parent = parent;
+    command.keepWorldTransform = keepWorldTransform;
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::addComponent(GameObject* obj, ComponentFactory add) {
+    if (!obj || !add) return;
+
+    Command command;
+    command.type = Type::AddComponent;
+    command.object = obj;
+    command.add = std::move(add);
+    record(std::move(command));
+}
+
+void SceneCommandBuffer::removeComponent(GameObject* obj, Component* component) {
+    if (!obj || !component) return;
+
+    Command command;
+    command.type = Type::RemoveComponent;
+    command.object = obj;
+    command.component = component;
+    record(std::move(command));
+}
+
+bool SceneCommandBuffer::empty() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return commands.empty();
+}
+
+size_t SceneCommandBuffer::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return commands.size();
+}
+
+void SceneCommandBuffer::apply(Scene& scene) {
+    // Aplicar un comando puede grabar otros (un componente que crea objetos al iniciarse); se
+    // aplican en la misma llamada con un limite para no quedarse en bucle
+    const int maxPasses = 4;
+    for (int pass = 0; pass < maxPasses; pass++) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (commands.empty()) {
+                break;
+            }
+            applying.swap(commands);
+        }
+
+        for (Command& command : applying) {
+            GameObject* obj = command.object;
+            switch (command.type) {
+            case Type::Spawn:
+                scene.insertGameObject(obj);
+                break;
+
+            case Type::Destroy:
+                destroyRoots.push_back(obj);
+                break;
+
+            case Type::SetParent:
+                if (obj->destroyQueued || (command.parent && command.parent->destroyQueued)) break;
+                if (command.keepWorldTransform) {
+                    obj->setParent(command.parent);
+                }
+                else {
+                    obj->setParentNoWorldPreserve(command.parent);
+                }
+                break;
+
+            case Type::AddComponent:
+                if (!obj->destroyQueued) {
+                    command.add(obj);
+                }
+                break;
+
+            case Type::RemoveComponent:
+                if (obj->destroyQueued) break;
+                for (const auto& comp : obj->components) {
+                    if (comp.get() == command.component) {
+                        command.component->destroy();
+                        obj->removeComponentSafe(command.component);
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+        applying.clear();
+
+        destroyQueued(scene);
+    }
+}
+
+void SceneCommandBuffer::destroyQueued(Scene& scene) {
+    if (destroyRoots.empty()) return;
+
+    // Cada raiz con todos sus descendientes, padres antes que hijos. isDestroyed marca los ya
+    // recogidos: un hijo puede estar en la cola ademas de su padre
+    destroyList.clear();
+    for (GameObject* root : destroyRoots) {
+        if (root->isDestroyed) continue;
+        root->isDestroyed = true;
+
+        size_t first = destroyList.size();
+        destroyList.push_back(root);
+        for (size_t i = first; i < destroyList.size(); i++) {
+            for (GameObject* child : destroyList[i]->children) {
+                if (child && !child->isDestroyed) {
+                    child->isDestroyed = true;
+                    destroyList.push_back(child);
+                }
+            }
+        }
+    }
+    destroyRoots.clear();
+
+    // Primero fuera de las listas (swap-and-pop), despues borrar hijos antes que padres: cada
+    // objeto se desvincula de su padre al destruirse, sin recursion por cleanup()
+    destroyOwned.assign(destroyList.size(), false);
+    for (size_t i = 0; i < destroyList.size(); i++) {
+        destroyOwned[i] = scene.eraseGameObject(destroyList[i]);
+    }
+
+    for (size_t i = destroyList.size(); i-- > 0;) {
+        if (destroyOwned[i]) {
+            delete destroyList[i];
+        }
+        else {
+            // Fuera de la escena no es nuestro: solo se limpia, como GameObject::destroy()
+            destroyList[i]->cleanup();
+        }
+    }
+    destroyList.clear();
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "../core/CoreExporter.h"
+
+class Scene;
+class GameObject;
+class Component;
+
+// Cambios estructurales de una escena (crear, destruir, reparentar, añadir o quitar componentes)
+// grabados durante el frame y aplicados juntos en Scene::applyCommands(), al final de
+// Scene::updateNative. Mientras tanto Scene::gameObjects no cambia y se puede recorrer sin copias.
+//
+// Grabar es seguro desde cualquier hilo; aplicar solo desde el principal.
+class MANTRAXCORE_API SceneCommandBuffer {
+public:
+    using ComponentFactory = std::function<void(GameObject*)>;
+
+    // obj ya construido; entra en la escena (y en el render) al aplicar
+    void spawn(GameObject* obj);
+    // Quita y borra obj con todos sus descendientes. Puede llamarse varias veces con el mismo objeto
+    void destroy(GameObject* obj);
+    void setParent(GameObject* obj, GameObject* parent, bool keepWorldTransform = true);
+    // add recibe el objeto y añade el componente (p.ej. [](GameObject* o) { o->addComponent<Rigidbody>(); })
+    void addComponent(GameObject* obj, ComponentFactory add);
+    void removeComponent(GameObject* obj, Component* component);
+
+    bool empty() const;
+    size_t size() const;
+
+    // Lo llama Scene::applyCommands; los comandos grabados mientras se aplica van en la siguiente tanda
+    void apply(Scene& scene);
+
+private:
+    enum class Type {
+        Spawn,
+        Destroy,
+        SetParent,
+        AddComponent,
+        RemoveComponent
+    };
+
+    struct Command {
+        Type type = Type::Spawn;
+        GameObject* object = nullptr;
+        GameObject* parent = nullptr;
+        Component* component = nullptr;
+        bool keepWorldTransform = true;
+        ComponentFactory add;
+    };
+
+    void record(Command&& command);
+    void destroyQueued(Scene& scene);
+
+    mutable std::mutex mutex;
+    std::vector<Command> commands;
+
+    // Reutilizados entre frames para no reservar memoria al aplicar
+    std::vector<Command> applying;
+    std::vector<GameObject*> destroyRoots;
+    std::vector<GameObject*> destroyList;
+    std::vector<bool> destroyOwned;
+};
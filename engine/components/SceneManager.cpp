@@ -4,6 +4,9 @@
 #include "../components/PhysicalObject.h"
 #include "../components/Collider.h"
 #include "../components/Rigidbody.h"
+#include "../components/ObjectPool.h"
+#include "../components/CharacterCrowd.h"
+#include "../core/JobSystem.h"
 
 SceneManager::SceneManager() : activeScene(nullptr), physicsInitialized(false) {
 }
@@ -16,6 +19,13 @@ bool SceneManager::initializePhysics() {
     try {
         if (PhysicsManager::getInstance().initialize()) {
             physicsInitialized = true;
+            PhysicsManager::getInstance().setFixedStepCallback([this](float fixedDeltaTime) {
+                if (activeScene) {
+                    activeScene->fixedUpdateNative(fixedDeltaTime);
+                }
+                // Moves de los CharacterController en modo multitud, todos juntos
+                CharacterCrowd::getInstance().flush(fixedDeltaTime);
+            });
             std::cout << "Physics system initialized successfully" << std::endl;
             return true;
         }
@@ -29,6 +39,11 @@ bool SceneManager::initializePhysics() {
 void SceneManager::cleanupPhysics() {
     if (physicsInitialized) {
         std::cout << "SceneManager: Starting physics cleanup..." << std::endl;
+
+        // Las celdas cargadas son objetos de la escena: soltarlas antes de limpiarla
+        worldPartition.close();
+        // Igual que los pools: la limpieza de cada escena borra sus objetos
+        ObjectPoolManager::getInstance().clear(false);
         
         // First, cleanup all scenes to destroy all PhysicalObjects
         for (auto& scenePair : scenes) {
@@ -47,6 +62,7 @@ void SceneManager::cleanupPhysics() {
         
         // Now cleanup the PhysicsManager
         std::cout << "SceneManager: Cleaning up PhysicsManager..." << std::endl;
+        CharacterCrowd::getInstance().reset();
         PhysicsManager::getInstance().cleanup();
         physicsInitialized = false;
         
@@ -97,6 +113,8 @@ void SceneManager::setActiveScene(const std::string& sceneName) {
         // Cleanup the current scene if it exists
         if (activeScene) {
             std::cout << "Switching from scene: " << activeScene->getName() << " to: " << sceneName << std::endl;
+            // Las celdas en streaming pertenecen a la escena anterior
+            worldPartition.close();
             // Cleanup physics components before switching scenes
             cleanupPhysicsComponents(activeScene);
             // No llamar cleanup() aquí para preservar los objetos
@@ -133,20 +151,51 @@ Scene* SceneManager::getScene(const std::string& sceneName) {
 }
 
 void SceneManager::update(float deltaTime) {
+    // Lo que los trabajos de otros hilos han dejado para el principal (GL, scripts)
+    JobSystem::getInstance().runMainThreadJobs();
+
     // Initialize physics if not already done
     if (!physicsInitialized) {
         initializePhysics();
     }
     
-    // Update physics
+    // Resultados del paso lanzado el frame anterior: la escena ve poses y eventos ya recogidos
     if (physicsInitialized) {
-        PhysicsManager::getInstance().update(deltaTime);
+        PhysicsManager& physicsManager = PhysicsManager::getInstance();
+        physicsManager.fetchResults();
+        // Solo los actores que PhysX ha movido, de una pasada
+        physicsManager.syncTransforms();
+        // Triggers y contactos, agrupados por receptor; los scripts ya ven las poses nuevas
+        physicsManager.dispatchEvents();
     }
     
+    // Integrar/descargar celdas del mundo dentro del presupuesto del frame
+    if (worldPartition.isOpen()) {
+        worldPartition.update();
+    }
+
     // Update active scene
     if (activeScene) {
         activeScene->updateNative(deltaTime);
     }
+
+    // Con las transformaciones ya enviadas a PhysX, el paso corre mientras se dibuja el frame
+    if (physicsInitialized) {
+        PhysicsManager::getInstance().update(deltaTime);
+    }
+}
+
+void SceneManager::destroyGameObject(GameObject* obj) {
+    if (!obj || ObjectPoolManager::getInstance().despawn(obj)) {
+        return;
+    }
+
+    if (activeScene) {
+        activeScene->getCommands().destroy(obj);
+    }
+    else {
+        obj->destroy();
+    }
 }
 
 void SceneManager::setupRenderPipeline(RenderPipeline& pipeline) {
@@ -280,6 +329,11 @@ void SceneManager::removeScene(const std::string& sceneName) {
     }
     
     std::cout << "SceneManager: Removing scene: " << sceneName << std::endl;
+
+    if (worldPartition.getScene() == it->second.get()) {
+        worldPartition.close();
+    }
+    ObjectPoolManager::getInstance().forgetScene(it->second.get());
     
     // Si es la escena activa, limpiar primero
     if (activeScene == it->second.get()) {
@@ -4,6 +4,7 @@
 #include <memory>
 #include <unordered_map>
 #include "Scene.h"
+#include "WorldPartition.h"
 #include "../render/RenderPipeline.h"
 #include "../core/CoreExporter.h"
 #include "../core/PhysicsManager.h"
@@ -39,6 +40,13 @@ public:
     // Reinitialize physics components for the active scene
     void reinitializePhysicsComponents();
 
+    // Streaming de celdas sobre la escena activa; se actualiza en update() y se cierra al cambiar de escena
+    WorldPartition& getWorldPartition() { return worldPartition; }
+
+    // destroy de scripts y nodos: un objeto de pool vuelve a su pool; el resto se destruye (con
+    // sus hijos) al final del frame con el buffer de comandos de la escena activa
+    void destroyGameObject(GameObject* obj);
+
 private:
     SceneManager();
     
@@ -49,4 +57,5 @@ private:
     Scene* activeScene;
     RenderPipeline* renderPipeline = nullptr;
     bool physicsInitialized = false;
+    WorldPartition worldPartition;
 }; 
\ No newline at end of file
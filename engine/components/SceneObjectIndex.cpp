@@ -0,0 +1,212 @@
+#include "SceneObjectIndex.h"
+#include "GameObject.h"
+#include <algorithm>
+
+namespace {
+    const SceneObjectIndex::Bucket emptyBucket;
+}
+
+void SceneObjectIndex::add(GameObject* object) {
+    if (!object) return;
+
+    byID[object->ObjectID] = object;
+    insertName(object);
+    insertTag(object);
+}
+
+void SceneObjectIndex::remove(GameObject* object) {
+    if (!object) return;
+
+    auto it = byID.find(object->ObjectID);
+    if (it != byID.end() && it->second == object) {
+        byID.erase(it);
+    }
+    else {
+        // ObjectID cambiado sin setObjectID: buscar la entrada vieja
+        for (auto entry = byID.begin(); entry != byID.end(); ++entry) {
+            if (entry->second == object) {
+                byID.erase(entry);
+                break;
+            }
+        }
+    }
+
+    eraseName(object);
+    eraseTag(object);
+}
+
+void SceneObjectIndex::clear() {
+    byID.clear();
+    byName.clear();
+    byTag.clear();
+}
+
+void SceneObjectIndex::rename(GameObject* object) {
+    eraseName(object);
+    insertName(object);
+}
+
+void SceneObjectIndex::retag(GameObject* object) {
+    eraseTag(object);
+    insertTag(object);
+}
+
+void SceneObjectIndex::changeID(GameObject* object, const std::string& previousID) {
+    auto it = byID.find(previousID);
+    if (it != byID.end() && it->second == object) {
+        byID.erase(it);
+    }
+    byID[object->ObjectID] = object;
+}
+
+void SceneObjectIndex::insertName(GameObject* object) {
+    NameTable::Id id = NameTable::getInstance().intern(object->Name);
+    Bucket& bucket = byName[id];
+    object->nameId = id;
+    object->nameSlot = bucket.size();
+    bucket.push_back(object);
+}
+
+void SceneObjectIndex::eraseName(GameObject* object) {
+    if (object->nameId == NameTable::kNone) return;
+
+    auto it = byName.find(object->nameId);
+    if (it != byName.end()) {
+        Bucket& bucket = it->second;
+        size_t slot = object->nameSlot;
+        if (slot >= bucket.size() || bucket[slot] != object) {
+            slot = static_cast<size_t>(std::find(bucket.begin(), bucket.end(), object) - bucket.begin());
+        }
+        if (slot < bucket.size()) {
+            bucket[slot] = bucket.back();
+            bucket[slot]->nameSlot = slot;
+            bucket.pop_back();
+        }
+    }
+    object->nameId = NameTable::kNone;
+    object->nameSlot = SIZE_MAX;
+}
+
+void SceneObjectIndex::insertTag(GameObject* object) {
+    NameTable::Id id = NameTable::getInstance().intern(object->Tag);
+    Bucket& bucket = byTag[id];
+    object->tagId = id;
+    object->tagSlot = bucket.size();
+    bucket.push_back(object);
+}
+
+void SceneObjectIndex::eraseTag(GameObject* object) {
+    if (object->tagId == NameTable::kNone) return;
+
+    auto it = byTag.find(object->tagId);
+    if (it != byTag.end()) {
+        Bucket& bucket = it->second;
+        size_t slot = object->tagSlot;
+        if (slot >= bucket.size() || bucket[slot] != object) {
+            slot = static_cast<size_t>(std::find(bucket.begin(), bucket.end(), object) - bucket.begin());
+        }
+        if (slot < bucket.size()) {
+            bucket[slot] = bucket.back();
+            bucket[slot]->tagSlot = slot;
+            bucket.pop_back();
+        }
+    }
+    object->tagId = NameTable::kNone;
+    object->tagSlot = SIZE_MAX;
+}
+
+SceneObjectIndex::Bucket* SceneObjectIndex::validNameBucket(NameTable::Id id) {
+    auto it = byName.find(id);
+    if (it == byName.end()) return nullptr;
+
+    const std::string& key = NameTable::getInstance().str(id);
+    Bucket& bucket = it->second;
+    for (size_t i = 0; i < bucket.size();) {
+        if (bucket[i]->Name == key) {
+            i++;
+        }
+        else {
+            rename(bucket[i]);      // Sale de este bucket con swap-and-pop: no avanzar
+        }
+    }
+    return &bucket;
+}
+
+SceneObjectIndex::Bucket* SceneObjectIndex::validTagBucket(NameTable::Id id) {
+    auto it = byTag.find(id);
+    if (it == byTag.end()) return nullptr;
+
+    const std::string& key = NameTable::getInstance().str(id);
+    Bucket& bucket = it->second;
+    for (size_t i = 0; i < bucket.size();) {
+        if (bucket[i]->Tag == key) {
+            i++;
+        }
+        else {
+            retag(bucket[i]);
+        }
+    }
+    return &bucket;
+}
+
+GameObject* SceneObjectIndex::findByID(const std::string& objectID) {
+    auto it = byID.find(objectID);
+    if (it == byID.end()) return nullptr;
+
+    GameObject* object = it->second;
+    if (object->ObjectID != objectID) {
+        byID.erase(it);
+        byID[object->ObjectID] = object;
+        return nullptr;
+    }
+    return object;
+}
+
+GameObject* SceneObjectIndex::findByName(const std::string& name) {
+    NameTable::Id id = NameTable::getInstance().find(name);
+    if (id == NameTable::kNone) return nullptr;
+
+    auto it = byName.find(id);
+    if (it == byName.end()) return nullptr;
+
+    // Solo hace falta validar hasta el primero que coincida
+    Bucket& bucket = it->second;
+    while (!bucket.empty()) {
+        GameObject* object = bucket.front();
+        if (object->Name == name) {
+            return object;
+        }
+        rename(object);
+    }
+    return nullptr;
+}
+
+GameObject* SceneObjectIndex::findByTag(const std::string& tag) {
+    NameTable::Id id = NameTable::getInstance().find(tag);
+    if (id == NameTable::kNone) return nullptr;
+
+    auto it = byTag.find(id);
+    if (it == byTag.end()) return nullptr;
+
+    Bucket& bucket = it->second;
+    while (!bucket.empty()) {
+        GameObject* object = bucket.front();
+        if (object->Tag == tag) {
+            return object;
+        }
+        retag(object);
+    }
+    return nullptr;
+}
+
+const SceneObjectIndex::Bucket& SceneObjectIndex::findAllByName(const std::string& name) {
+    NameTable::Id id = NameTable::getInstance().find(name);
+    Bucket* bucket = id != NameTable::kNone ? validNameBucket(id) : nullptr;
+    return bucket ? *bucket : emptyBucket;
+}
+
+const SceneObjectIndex::Bucket& SceneObjectIndex::findAllByTag(const std::string& tag) {
+    NameTable::Id id = NameTable::getInstance().find(tag);
+    Bucket* bucket = id != NameTable::kNone ? validTagBucket(id) : nullptr;
+    return bucket ? *bucket : emptyBucket;
+}
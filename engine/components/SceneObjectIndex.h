@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../core/CoreExporter.h"
+#include "../core/NameTable.h"
+
+class GameObject;
+
+// Indices hash de una escena por ObjectID, nombre y tag, para buscar sin recorrer gameObjects.
+// Nombre y tag van internados en NameTable; cada objeto guarda su posicion en el bucket para
+// salir de el con swap-and-pop (con varios objetos del mismo nombre el orden no se conserva).
+//
+// Se mantiene en Scene::insertGameObject / eraseGameObject y en GameObject::setName / setTag /
+// setObjectID. Si alguien escribe Name o Tag directamente, la busqueda lo detecta al encontrar el
+// objeto en un bucket que ya no le corresponde y lo recoloca. Solo hilo principal.
+class MANTRAXCORE_API SceneObjectIndex {
+public:
+    using Bucket = std::vector<GameObject*>;
+
+    void add(GameObject* object);
+    void remove(GameObject* object);
+    void clear();
+
+    // Tras cambiar object->Name / Tag / ObjectID
+    void rename(GameObject* object);
+    void retag(GameObject* object);
+    void changeID(GameObject* object, const std::string& previousID);
+
+    GameObject* findByID(const std::string& objectID);
+    GameObject* findByName(const std::string& name);
+    GameObject* findByTag(const std::string& tag);
+    const Bucket& findAllByName(const std::string& name);
+    const Bucket& findAllByTag(const std::string& tag);
+
+    size_t size() const { return byID.size(); }
+
+private:
+    void insertName(GameObject* object);
+    void eraseName(GameObject* object);
+    void insertTag(GameObject* object);
+    void eraseTag(GameObject* object);
+
+    // Recoloca los objetos del bucket cuyo nombre/tag ya no coincide (escrito sin setName/setTag)
+    Bucket* validNameBucket(NameTable::Id id);
+    Bucket* validTagBucket(NameTable::Id id);
+
+    std::unordered_map<std::string, GameObject*> byID;
+    std::unordered_map<NameTable::Id, Bucket> byName;
+    std::unordered_map<NameTable::Id, Bucket> byTag;
+};
@@ -0,0 +1,119 @@
+#include "SceneObjectLoader.h"
+#include <iostream>
+#include "Scene.h"
+#include "GameObject.h"
+#include "ScriptExecutor.h"
+#include "LightComponent.h"
+#include "AudioSource.h"
+#include "PhysicalObject.h"
+#include "CharacterController.h"
+#include "SpriteAnimator.h"
+#include "Collider.h"
+#include "Rigidbody.h"
+#include "../render/RenderPipeline.h"
+
+GameObject* SceneObjectLoader::createObject(const SceneObjectData& objectData) {
+    GameObject* obj = new GameObject();
+    obj->setName(objectData.name);
+    obj->setTag(objectData.tag);
+
+    // Cargar ObjectID si existe, sino mantener el generado automáticamente
+    if (!objectData.objectID.empty()) {
+        obj->setObjectID(objectData.objectID);
+    }
+
+    obj->setWorldPosition(objectData.position);
+    obj->setWorldRotationEuler(objectData.rotation);
+    obj->setLocalScale(objectData.scale);
+    return obj;
+}
+
+bool SceneObjectLoader::addComponentFromData(GameObject* obj, const nlohmann::json& compData) {
+    if (!obj || !compData.contains("type")) {
+        return false;
+    }
+
+    try {
+        std::string type = compData.at("type").get<std::string>();
+        SceneComponentType componentType = BinarySceneWriter::componentTypeFromName(type);
+        if (componentType == SceneComponentType::Unknown) {
+            std::cerr << "SceneObjectLoader: Unknown component type '" << type << "' on " << obj->Name << std::endl;
+            return false;
+        }
+
+        return addComponent(obj, componentType, compData, compData.at("enabled").get<bool>()) != nullptr;
+    }
+    catch (const nlohmann::json::exception& e) {
+        std::cerr << "Error al cargar componente: " << e.what() << std::endl;
+        std::cerr << "CompData problemático:\n" << compData.dump(4) << std::endl;
+        return false;
+    }
+}
+
+Component* SceneObjectLoader::addComponent(GameObject* obj, SceneComponentType type, const nlohmann::json& data, bool enabled) {
+    if (!obj) {
+        return nullptr;
+    }
+
+    Component* component = nullptr;
+    switch (type) {
+    case SceneComponentType::ScriptExecutor:
+        component = obj->addComponent<ScriptExecutor>();
+        break;
+    case SceneComponentType::LightComponent:
+        component = obj->addComponent<LightComponent>();
+        break;
+    case SceneComponentType::AudioSource:
+        component = obj->addComponent<AudioSource>();
+        break;
+    case SceneComponentType::PhysicalObject: {
+        auto* physComp = obj->addComponent<PhysicalObject>(obj);
+        physComp->initializePhysics();
+        component = physComp;
+        break;
+    }
+    case SceneComponentType::CharacterController:
+        component = obj->addComponent<CharacterController>();
+        break;
+    case SceneComponentType::SpriteAnimator:
+        component = obj->addComponent<SpriteAnimator>();
+        break;
+    case SceneComponentType::Collider:
+        component = obj->addComponent<Collider>(obj);
+        break;
+    case SceneComponentType::Rigidbody:
+        component = obj->addComponent<Rigidbody>(obj);
+        break;
+    default:
+        return nullptr;
+    }
+
+    try {
+        component->deserializeJson(data);
+    }
+    catch (const nlohmann::json::exception& e) {
+        std::cerr << "Error al cargar componente de " << obj->Name << ": " << e.what() << std::endl;
+    }
+
+    if (enabled) {
+        component->enable();
+    }
+    else {
+        component->disable();
+    }
+    return component;
+}
+
+void SceneObjectLoader::applyModelAndMaterial(Scene* scene, GameObject* obj, const SceneObjectData& objectData) {
+    if (!objectData.modelPath.empty()) {
+        obj->setModelPath(objectData.modelPath);
+        obj->loadModelFromPath();
+    }
+
+    if (objectData.hasMaterial && !objectData.materialName.empty() && scene && scene->getRenderPipeline()) {
+        auto material = scene->getRenderPipeline()->getMaterial(objectData.materialName);
+        if (material) {
+            obj->setMaterial(material);
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <nlohmann/json.hpp>
+#include "../core/CoreExporter.h"
+#include "../core/BinaryScene.h"
+
+class Scene;
+class GameObject;
+class Component;
+
+// Construye GameObjects a partir de los datos guardados en la escena (SceneObjectData).
+// Lo usan el cargador de escenas del editor y el streaming de WorldPartition.
+class MANTRAXCORE_API SceneObjectLoader {
+public:
+    // Nombre, tag, ID y transform; sin padre, componentes ni modelo. No toca la escena ni el render,
+    // se puede llamar desde un hilo de carga.
+    static GameObject* createObject(const SceneObjectData& objectData);
+
+    // Crea el componente descrito por compData ("type", "enabled" y sus datos). Hilo principal.
+    static bool addComponentFromData(GameObject* obj, const nlohmann::json& compData);
+    // Igual, con el tipo ya resuelto (prefabs: sin comparar nombres en cada instancia)
+    static Component* addComponent(GameObject* obj, SceneComponentType type, const nlohmann::json& data, bool enabled);
+    static void applyModelAndMaterial(Scene* scene, GameObject* obj, const SceneObjectData& objectData);
+};
@@ -1,5 +1,6 @@
 #include "ScriptExecutor.h"
 #include <filesystem>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 #include "../core/FileSystem.h"
 
@@ -7,6 +8,41 @@ using json = nlohmann::json;
 
 // Initialize static member
 std::vector<ScriptExecutor*> ScriptExecutor::s_instances;
+std::unordered_map<std::string, std::shared_ptr<const sol::bytecode>> ScriptExecutor::s_compiledScripts;
+
+std::shared_ptr<const sol::bytecode> ScriptExecutor::getCompiledScript(const std::string& scriptPath, std::string& outError) {
+    auto it = s_compiledScripts.find(scriptPath);
+    if (it != s_compiledScripts.end()) {
+        return it->second;
+    }
+
+    // Ruta virtual: el script puede venir de un pack montado, un overlay o Content
+    std::string fullPath = scriptPath + ".lua";
+    FileData code;
+    if (!FileSystem::readAsset(fullPath, code)) {
+        outError = "Script file not found: " + fullPath;
+        return nullptr;
+    }
+
+    // Un estado aparte solo para compilar; "@" hace que Lua use la ruta como nombre del chunk en
+    // los mensajes de error (se conserva en el bytecode)
+    sol::state compiler;
+    sol::load_result loaded = compiler.load(std::string_view(code.data(), code.size()), "@" + fullPath, sol::load_mode::text);
+    if (!loaded.valid()) {
+        sol::error error = loaded;
+        outError = error.what();
+        return nullptr;
+    }
+
+    sol::protected_function chunk = loaded;
+    auto compiled = std::make_shared<const sol::bytecode>(chunk.dump());
+    s_compiledScripts[scriptPath] = compiled;
+    return compiled;
+}
+
+void ScriptExecutor::invalidateCompiledScript(const std::string& scriptPath) {
+    s_compiledScripts.erase(scriptPath);
+}
 
 void ScriptExecutor::defines() {
     set_var("LuaPath", &luaPath);
@@ -39,17 +75,18 @@ void ScriptExecutor::start() {
     CoreWrapper coreWrapper;
     coreWrapper.Register(lua);
 
-    std::string fullPath = FileSystem::getProjectPath() + "\\Content\\" + luaPath + ".lua";
+    // Ruta virtual: el script puede venir de un pack montado, un overlay o Content
+    std::string fullPath = luaPath + ".lua";
 
-    // Check if file exists before trying to load it
-    if (!std::filesystem::exists(fullPath)) {
-        std::cerr << "[ScriptExecutor] LUA file does not exist: " << fullPath << std::endl;
-        lastError = "Script file not found: " + fullPath;
+    // Compilado una sola vez por script; cada instancia solo carga el bytecode
+    std::shared_ptr<const sol::bytecode> compiled = getCompiledScript(luaPath, lastError);
+    if (!compiled) {
+        std::cerr << "[ScriptExecutor] " << lastError << std::endl;
         return;
     }
 
     try {
-        lua.script_file(fullPath);
+        lua.script(compiled->as_string_view(), "@" + fullPath, sol::load_mode::binary);
 
         if (lua[luaPath].valid() && lua[luaPath].get_type() == sol::type::table) {
             scriptTable = lua[luaPath];
@@ -156,9 +193,8 @@ bool ScriptExecutor::isScriptValid() const {
         return false;
     }
     
-    // Check if script file still exists on disk
-    std::string fullPath = FileSystem::getProjectPath() + "\\Content\\" + luaPath + ".lua";
-    return std::filesystem::exists(fullPath);
+    // Check if script file still exists in the VFS
+    return FileSystem::assetExists(luaPath + ".lua");
 }
 
 bool ScriptExecutor::hasFunction(const std::string& functionName) const {
@@ -220,8 +256,28 @@ void ScriptExecutor::onTriggerExit(GameObject* other) {
     }
 }
 
+void ScriptExecutor::onActiveChanged(bool active) {
+    if (!scriptLoaded || !scriptTable.valid()) {
+        return;
+    }
+
+    const char* functionName = active ? "OnEnable" : "OnDisable";
+    sol::function func = scriptTable[functionName];
+    if (func.valid()) {
+        try {
+            func();
+            lastError.clear();
+        }
+        catch (const sol::error& e) {
+            lastError = e.what();
+            std::cerr << "Error in " << functionName << "() of script " << luaPath << ": " << e.what() << std::endl;
+        }
+    }
+}
+
 void ScriptExecutor::notifyScriptDeleted(const std::string& scriptName) {
     std::cout << "[ScriptExecutor] Notifying all instances about deleted script: " << scriptName << std::endl;
+    invalidateCompiledScript(scriptName);
     
     for (auto* instance : s_instances) {
         if (instance && instance->luaPath == scriptName) {
@@ -235,6 +291,7 @@ void ScriptExecutor::notifyScriptDeleted(const std::string& scriptName) {
 
 void ScriptExecutor::notifyScriptModified(const std::string& scriptName) {
     std::cout << "[ScriptExecutor] Notifying all instances about modified script: " << scriptName << std::endl;
+    invalidateCompiledScript(scriptName);
     
     for (auto* instance : s_instances) {
         if (instance && instance->luaPath == scriptName) {
@@ -253,15 +310,22 @@ std::string ScriptExecutor::serializeComponent() const {
 
 void ScriptExecutor::deserialize(const std::string& data) {
     try {
-        json j = json::parse(data);
+        deserializeJson(json::parse(data));
+    }
+    catch (const json::parse_error& e) {
+        std::cerr << "[ScriptExecutor] Deserialization error: " << e.what() << std::endl;
+    }
+}
 
+void ScriptExecutor::deserializeJson(const json& j) {
+    try {
         // Only assign if it exists and is string
         if (j.contains("luaPath") && j["luaPath"].is_string()) {
             luaPath = j["luaPath"];
             
             // Check if script exists before reloading
-            std::string fullPath = FileSystem::getProjectPath() + "\\Content\\" + luaPath + ".lua";
-            if (std::filesystem::exists(fullPath)) {
+            std::string fullPath = luaPath + ".lua";
+            if (FileSystem::assetExists(fullPath)) {
                 reloadScript();
             }
             else {
@@ -1,6 +1,8 @@
 #pragma once
 #include <iostream>
 #include <string>
+#include <memory>
+#include <unordered_map>
 #include "GameObject.h"
 #include "../wrapper/CoreWrapper.h"
 #include "../core/CoreExporter.h"
@@ -21,6 +23,7 @@ public:
     void setOwner(GameObject* owner) override;
     std::string serializeComponent() const override;
     void deserialize(const std::string& data) override;
+    void deserializeJson(const nlohmann::json& data) override;
 
     // Inspector helper methods
     bool isScriptLoaded() const { return scriptLoaded; }
@@ -33,10 +36,18 @@ public:
     void onTriggerEnter(GameObject* other);
     void onTriggerExit(GameObject* other);
 
+    // Llama a OnEnable()/OnDisable() del script cuando el objeto se activa o desactiva (pools)
+    void onActiveChanged(bool active) override;
+
     // Static methods for managing script instances
     static void notifyScriptDeleted(const std::string& scriptName);
     static void notifyScriptModified(const std::string& scriptName);
 
+    // Bytecode del script (luaPath sin ".lua"), compilado la primera vez y compartido por todas
+    // las instancias. nullptr si no existe o no compila (el motivo queda en outError)
+    static std::shared_ptr<const sol::bytecode> getCompiledScript(const std::string& scriptPath, std::string& outError);
+    static void invalidateCompiledScript(const std::string& scriptPath);
+
 private:
     sol::state lua;
     sol::table scriptTable;
@@ -45,4 +56,5 @@ private:
     
     // Static tracking of all instances
     static std::vector<ScriptExecutor*> s_instances;
+    static std::unordered_map<std::string, std::shared_ptr<const sol::bytecode>> s_compiledScripts;
 };
@@ -274,6 +274,33 @@ bool SpriteAnimator::hasValidTextures(const std::string& stateName) const {
     return false;
 }
 
+bool SpriteAnimator::hasCachedTextures(const std::string& stateName) const {
+    for (const auto& state : SpriteStates) {
+        if (state.state_name == stateName) {
+            for (const auto& texturePath : state.texturePaths) {
+                if (persistentTextures.find(texturePath) == persistentTextures.end()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+    return true;
+}
+
+bool SpriteAnimator::needsMainThreadUpdate() const {
+    if (debugMode) {
+        return true;
+    }
+    if (getOwner() && getOwner()->getMaterial() != spriteMaterial) {
+        return true;
+    }
+    if ((currentState != appliedState || forceMaterialUpdate) && !hasCachedTextures(currentState)) {
+        return true;
+    }
+    return isPlaying && !hasCachedTextures(playbackState);
+}
+
 bool SpriteAnimator::isMaterialValid() const {
     return spriteMaterial != nullptr && spriteMaterial->isValid();
 }
@@ -326,10 +353,9 @@ void SpriteAnimator::update() {
     }
 
     // Actualizar la textura del material si cambió el estado o se fuerza la actualización
-    static std::string lastState = "";
-    if (currentState != lastState || forceMaterialUpdate) {
+    if (currentState != appliedState || forceMaterialUpdate) {
         updateMaterialTexture();
-        lastState = currentState;
+        appliedState = currentState;
         forceMaterialUpdate = false;
         if (debugMode) {
             std::cout << "Estado cambiado o actualización forzada: " << currentState << std::endl;
@@ -433,8 +459,15 @@ std::string SpriteAnimator::serializeComponent() const {
 
 void SpriteAnimator::deserialize(const std::string& data) {
     try {
-        json j = json::parse(data);
-        
+        deserializeJson(json::parse(data));
+    }
+    catch (const json::parse_error& e) {
+        std::cerr << "[SpriteAnimator] Deserialization error: " << e.what() << std::endl;
+    }
+}
+
+void SpriteAnimator::deserializeJson(const json& j) {
+    try {
         // Deserializar estado actual
         if (j.contains("currentState") && j["currentState"].is_string()) {
             currentState = j["currentState"];
@@ -545,7 +578,7 @@ void SpriteAnimator::deserialize(const std::string& data) {
             std::cout << "- Is playing: " << (isPlaying ? "true" : "false") << std::endl;
         }
         
-        loadFromAnimatorFile(FileSystem::getProjectPath() + "\\Content\\" + animator_file);
+        loadFromAnimatorFile(animator_file);
     }
     catch (const json::exception& e) {
         std::cerr << "SpriteAnimator::deserialize error: " << e.what() << std::endl;
@@ -613,15 +646,14 @@ void SpriteAnimator::clearTextureCache() {
 
 bool SpriteAnimator::loadFromAnimatorFile(const std::string& filePath) {
     try {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
+        // Ruta relativa a Content (VFS) o absoluta en disco
+        FileData file;
+        if (!FileSystem::readAsset(filePath, file)) {
             std::cerr << "Failed to open animator file: " << filePath << std::endl;
             return false;
         }
         
-        nlohmann::json animatorData;
-        file >> animatorData;
-        file.close();
+        nlohmann::json animatorData = nlohmann::json::parse(file.data(), file.data() + file.size());
         
         return loadFromAnimatorData(animatorData);
     }
@@ -36,6 +36,8 @@ public:
 	// Debug flags
 	bool debugMode = false;
 	bool forceMaterialUpdate = false;
+	// Estado cuya textura tiene ya el material; por instancia para poder animar en paralelo
+	std::string appliedState = "";
 	
 	// Array de texturas persistentes
 	std::unordered_map<std::string, std::shared_ptr<Texture>> persistentTextures;
@@ -88,6 +90,8 @@ public:
 	// Métodos de validación
 	bool isValidState(const std::string& stateName) const;
 	bool hasValidTextures(const std::string& stateName) const;
+	// Todas las texturas del estado ya estan en persistentTextures (sin cargas GL pendientes)
+	bool hasCachedTextures(const std::string& stateName) const;
 	bool isMaterialValid() const;
 	
 	// Métodos de información
@@ -97,6 +101,7 @@ public:
 	// Métodos de serialización para el inspector
 	std::string serializeComponent() const override;
 	void deserialize(const std::string& data) override;
+	void deserializeJson(const nlohmann::json& data) override;
 
 	// Métodos para cargar configuraciones desde archivos .animator
 	bool loadFromAnimatorFile(const std::string& filePath);
@@ -110,4 +115,10 @@ public:
 	void defines() override;
 	void start() override;
 	void update() override;
+	// Cada animador solo toca su material: se reparten entre hilos
+	ComponentUpdateInfo getUpdateInfo() const override {
+		return { UpdatePhase::Animation, ACCESS_RENDER_STATE, ACCESS_RENDER_STATE, true };
+	}
+	// Cambio de material del owner o texturas aun sin cargar
+	bool needsMainThreadUpdate() const override;
 };
\ No newline at end of file
@@ -36,33 +36,33 @@ void TestScene::initialize() {
 
     // Crear objetos basicos sin geometria (objetos vacios)
     auto* redCube = new GameObject();
-    redCube->Name = "RedCube";
+    redCube->setName("RedCube");
     redCube->setLocalPosition({ -2.0f, 0.0f, 0.0f });
     redCube->setMaterial(redMaterial);
     addGameObject(redCube);
 
     auto* blueCube = new GameObject();
-    blueCube->Name = "BlueCube";
+    blueCube->setName("BlueCube");
     blueCube->setLocalPosition({ 0.0f, 0.0f, 0.0f });
     blueCube->setMaterial(blueMaterial);
     addGameObject(blueCube);
 
     auto* greenCube = new GameObject();
-    greenCube->Name = "GreenCube";
+    greenCube->setName("GreenCube");
     greenCube->setLocalPosition({ 2.0f, 0.0f, 0.0f });
     greenCube->setMaterial(greenMaterial);
     addGameObject(greenCube);
 
     // Ejemplo de GameObject vacio (sin geometria) - no se renderiza
     auto* emptyObject = new GameObject();
-    emptyObject->Name = "EmptyObject";
+    emptyObject->setName("EmptyObject");
     emptyObject->setLocalPosition({ 0.0f, 3.0f, 0.0f });
     emptyObject->setLocalScale({ 2.0f, 2.0f, 2.0f });
     addGameObject(emptyObject);
     
     // Ejemplo de GameObject que recibe geometria despues de la creacion
     auto* delayedGeometryObject = new GameObject();
-    delayedGeometryObject->Name = "DelayedGeometryObject";
+    delayedGeometryObject->setName("DelayedGeometryObject");
     delayedGeometryObject->setLocalPosition({ 4.0f, 0.0f, 0.0f });
     // Nota: Sin geometria por defecto, se puede cargar un modelo despues
     delayedGeometryObject->setMaterial(redMaterial);
@@ -71,7 +71,7 @@ void TestScene::initialize() {
     // Ejemplo de GameObject con carga automatica de modelo desde path
     // Nota: Este objeto intentara cargar "models/cube.obj" pero si no existe, quedara vacio
     auto* autoLoadObject = new GameObject("models/cube.obj");
-    autoLoadObject->Name = "AutoLoadObject";
+    autoLoadObject->setName("AutoLoadObject");
     autoLoadObject->setLocalPosition({ 6.0f, 0.0f, 0.0f });
     autoLoadObject->setMaterial(blueMaterial);
     addGameObject(autoLoadObject);
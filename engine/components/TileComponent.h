@@ -17,6 +17,10 @@ public:
 	}
 
 	void update() override;
+	ComponentUpdateInfo getUpdateInfo() const override {
+		return { UpdatePhase::PrePhysics, ACCESS_NONE, ACCESS_NONE, true };
+	}
+	bool needsMainThreadUpdate() const override { return false; }
 	void SetTile(Material _Mat);
 	void SetupNewMaterial(std::string _PathTexture);
 };
\ No newline at end of file
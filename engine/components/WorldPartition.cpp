@@ -0,0 +1,584 @@
+#include "WorldPartition.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <map>
+#include "Scene.h"
+#include "GameObject.h"
+#include "SceneObjectLoader.h"
+#include "../core/FileSystem.h"
+#include "../render/Camera.h"
+
+namespace {
+    const char* WORLD_MANIFEST = "world.json";
+
+    WorldCellCoord cellFromPosition(const glm::vec3& position, float cellSize) {
+        WorldCellCoord coord;
+        coord.x = static_cast<int>(std::floor(position.x / cellSize));
+        coord.z = static_cast<int>(std::floor(position.z / cellSize));
+        return coord;
+    }
+
+    std::string joinPath(const std::string& directory, const std::string& file) {
+        if (directory.empty()) return file;
+        char last = directory.back();
+        if (last == '/' || last == '\\') return directory + file;
+        return directory + "/" + file;
+    }
+}
+
+WorldPartition::~WorldPartition() {
+    // El hilo puede estar creando objetos en el allocator de la escena: se espera a que termine
+    stopWorker();
+
+    // Los que ya estan en la escena se van con ella (SceneManager llama a close antes)
+    for (auto& pair : cells) {
+        Cell& cell = pair.second;
+        cell.objects.erase(cell.objects.begin(), cell.objects.begin() + cell.added);
+        discardObjects(cell.objects);
+    }
+}
+
+bool WorldPartition::open(Scene* targetScene, const std::string& worldDirectory) {
+    close();
+
+    if (!targetScene) {
+        std::cerr << "WorldPartition: No scene to stream into" << std::endl;
+        return false;
+    }
+
+    std::string manifestText;
+    if (!FileSystem::readAssetString(joinPath(worldDirectory, WORLD_MANIFEST), manifestText)) {
+        std::cerr << "WorldPartition: Could not read " << joinPath(worldDirectory, WORLD_MANIFEST) << std::endl;
+        return false;
+    }
+
+    try {
+        nlohmann::json manifest = nlohmann::json::parse(manifestText);
+        float size = manifest.value("CellSize", 0.0f);
+        if (size <= 0.0f) {
+            std::cerr << "WorldPartition: Invalid cell size in " << worldDirectory << std::endl;
+            return false;
+        }
+
+        cellSize = size;
+        for (const auto& entry : manifest.at("Cells")) {
+            Cell cell;
+            cell.coord.x = entry.at(0).get<int>();
+            cell.coord.z = entry.at(1).get<int>();
+            cells.emplace(cell.coord, std::move(cell));
+        }
+    }
+    catch (const nlohmann::json::exception& e) {
+        std::cerr << "WorldPartition: Invalid manifest in " << worldDirectory << ": " << e.what() << std::endl;
+        cells.clear();
+        return false;
+    }
+
+    scene = targetScene;
+    directory = worldDirectory;
+    stats = WorldPartitionStats();
+    stats.cellCount = cells.size();
+    startWorker();
+
+    std::cout << "WorldPartition: Opened " << worldDirectory << " (" << cells.size() << " cells of "
+              << cellSize << " units)" << std::endl;
+    return true;
+}
+
+void WorldPartition::close() {
+    stopWorker();
+
+    if (scene) {
+        for (auto& pair : cells) {
+            Cell& cell = pair.second;
+            // Al reves: los hijos suelen ir detras de su padre
+            for (size_t i = cell.added; i-- > 0;) {
+                if (GameObject* obj = cell.objects[i].get()) {
+                    scene->removeGameObject(obj);
+                }
+            }
+            cell.objects.erase(cell.objects.begin(), cell.objects.begin() + cell.added);
+            discardObjects(cell.objects);
+        }
+    }
+
+    cells.clear();
+    sources.clear();
+    scene = nullptr;
+    directory.clear();
+    stats = WorldPartitionStats();
+}
+
+void WorldPartition::addStreamingSource(GameObject* source) {
+    if (!source) return;
+    ObjectHandle handle = source->getHandle();
+    if (std::find(sources.begin(), sources.end(), handle) == sources.end()) {
+        sources.push_back(handle);
+    }
+}
+
+void WorldPartition::removeStreamingSource(GameObject* source) {
+    if (!source) return;
+    sources.erase(std::remove(sources.begin(), sources.end(), source->getHandle()), sources.end());
+}
+
+WorldCellCoord WorldPartition::cellAt(const glm::vec3& position) const {
+    return cellFromPosition(position, cellSize);
+}
+
+bool WorldPartition::isCellLoaded(const WorldCellCoord& coord) const {
+    auto it = cells.find(coord);
+    return it != cells.end() && it->second.state == CellState::Loaded;
+}
+
+void WorldPartition::gatherSources(std::vector<glm::vec3>& outPositions) const {
+    outPositions.clear();
+    if (settings.streamFromCamera && scene->getCamera()) {
+        outPositions.push_back(scene->getCamera()->getPosition());
+    }
+    for (const ObjectHandle& handle : sources) {
+        GameObject* source = handle.get();
+        if (source && source->isValid()) {
+            outPositions.push_back(source->getWorldPosition());
+        }
+    }
+}
+
+float WorldPartition::distanceToCell(const WorldCellCoord& coord, const glm::vec3& position) const {
+    float minX = coord.x * cellSize;
+    float minZ = coord.z * cellSize;
+    float dx = std::max({ minX - position.x, 0.0f, position.x - (minX + cellSize) });
+    float dz = std::max({ minZ - position.z, 0.0f, position.z - (minZ + cellSize) });
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+float WorldPartition::nearestSourceDistance(const WorldCellCoord& coord, const std::vector<glm::vec3>& positions) const {
+    float nearest = std::numeric_limits<float>::max();
+    for (const glm::vec3& position : positions) {
+        nearest = std::min(nearest, distanceToCell(coord, position));
+    }
+    return nearest;
+}
+
+void WorldPartition::update() {
+    if (!scene) return;
+
+    stats.integratedLastFrame = 0;
+    stats.removedLastFrame = 0;
+
+    collectResults();
+
+    std::vector<glm::vec3> positions;
+    gatherSources(positions);
+
+    // Cargar por debajo de loadRadius y descargar por encima de unloadRadius: entre los dos una
+    // celda conserva su estado, asi no se carga y descarga cada frame en el borde
+    float unloadRadius = std::max(settings.unloadRadius, settings.loadRadius);
+    std::vector<std::pair<float, Cell*>> toLoad;
+    std::vector<std::pair<float, Cell*>> toIntegrate;
+    std::vector<Cell*> toUnload;
+
+    for (auto& pair : cells) {
+        Cell& cell = pair.second;
+        float distance = nearestSourceDistance(cell.coord, positions);
+
+        switch (cell.state) {
+        case CellState::Unloaded:
+            if (distance <= settings.loadRadius) toLoad.emplace_back(distance, &cell);
+            break;
+        case CellState::Loading:
+        case CellState::Integrating:
+        case CellState::Loaded:
+            if (distance > unloadRadius) {
+                requestUnload(cell);
+            }
+            break;
+        case CellState::Unloading:
+            break;
+        }
+
+        if (cell.state == CellState::Integrating) toIntegrate.emplace_back(distance, &cell);
+        if (cell.state == CellState::Unloading) toUnload.push_back(&cell);
+    }
+
+    // Las mas cercanas primero
+    auto byDistance = [](const std::pair<float, Cell*>& a, const std::pair<float, Cell*>& b) { return a.first < b.first; };
+    std::sort(toLoad.begin(), toLoad.end(), byDistance);
+    std::sort(toIntegrate.begin(), toIntegrate.end(), byDistance);
+    for (auto& entry : toLoad) {
+        requestLoad(*entry.second);
+    }
+
+    // Presupuesto del frame: al menos un objeto para no quedarse nunca parado
+    auto start = std::chrono::steady_clock::now();
+    size_t processed = 0;
+    auto withinBudget = [&]() {
+        if (processed == 0) return true;
+        if (settings.maxObjectsPerFrame > 0 && processed >= settings.maxObjectsPerFrame) return false;
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() < settings.frameBudgetMs;
+    };
+
+    // Descargar antes de integrar: libera memoria y actores de fisica
+    for (Cell* cell : toUnload) {
+        while (cell->state == CellState::Unloading && withinBudget()) {
+            removeObject(*cell);
+            processed++;
+            stats.removedLastFrame++;
+        }
+    }
+
+    for (auto& entry : toIntegrate) {
+        Cell* cell = entry.second;
+        while (cell->state == CellState::Integrating && withinBudget()) {
+            integrateObject(*cell);
+            processed++;
+            stats.integratedLastFrame++;
+        }
+    }
+
+    stats.loadedCells = 0;
+    stats.loadingCells = 0;
+    stats.pendingObjects = 0;
+    for (const auto& pair : cells) {
+        const Cell& cell = pair.second;
+        if (cell.state == CellState::Loaded) stats.loadedCells++;
+        if (cell.state == CellState::Loading || cell.state == CellState::Integrating) stats.loadingCells++;
+        if (cell.state == CellState::Integrating) stats.pendingObjects += cell.objects.size() - cell.added;
+    }
+}
+
+void WorldPartition::requestLoad(Cell& cell) {
+    cell.state = CellState::Loading;
+    cell.request = nextRequest++;
+
+    LoadRequest request;
+    request.coord = cell.coord;
+    request.request = cell.request;
+    request.path = joinPath(directory, cellFileName(cell.coord));
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        requests.push_back(std::move(request));
+    }
+    queueCondition.notify_one();
+}
+
+void WorldPartition::requestUnload(Cell& cell) {
+    if (cell.state == CellState::Loading) {
+        // Si aun no ha empezado se quita de la cola; si ya esta en el hilo, su resultado se descarta
+        std::lock_guard<std::mutex> lock(queueMutex);
+        requests.erase(std::remove_if(requests.begin(), requests.end(),
+            [&](const LoadRequest& request) { return request.request == cell.request; }), requests.end());
+        cell.request = 0;
+        cell.state = CellState::Unloaded;
+        return;
+    }
+
+    // Los que aun no estan en la escena no tienen padre ni componentes: se borran ya
+    std::vector<ObjectHandle> notAdded(cell.objects.begin() + cell.added, cell.objects.end());
+    discardObjects(notAdded);
+    cell.objects.resize(cell.added);
+    cell.data.clear();
+    cell.data.shrink_to_fit();
+    cell.state = cell.added > 0 ? CellState::Unloading : CellState::Unloaded;
+}
+
+void WorldPartition::collectResults() {
+    std::vector<LoadResult> finished;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        finished.swap(results);
+    }
+
+    for (LoadResult& result : finished) {
+        auto it = cells.find(result.coord);
+        if (it == cells.end() || it->second.state != CellState::Loading || it->second.request != result.request) {
+            discardObjects(result.objects);
+            continue;
+        }
+
+        Cell& cell = it->second;
+        cell.added = 0;
+        if (!result.ok) {
+            // Sin reintentos hasta que la celda salga del radio y vuelva a entrar
+            cell.state = CellState::Loaded;
+            continue;
+        }
+
+        cell.data = std::move(result.data);
+        cell.objects.clear();
+        cell.objects.reserve(result.objects.size());
+        for (GameObject* obj : result.objects) {
+            cell.objects.push_back(obj->getHandle());
+        }
+        result.objects.clear();
+        cell.state = cell.objects.empty() ? CellState::Loaded : CellState::Integrating;
+    }
+}
+
+void WorldPartition::integrateObject(Cell& cell) {
+    size_t index = cell.added;
+    GameObject* obj = cell.objects[index].get();
+    const SceneObjectData& objectData = cell.data[index];
+    cell.added++;
+
+    if (obj) {
+        scene->addGameObject(obj);
+
+        int parentIndex = objectData.parentIndex;
+        GameObject* parent = parentIndex >= 0 && static_cast<size_t>(parentIndex) < index ? cell.objects[parentIndex].get() : nullptr;
+        if (parent) {
+            obj->setParent(parent);
+        }
+
+        // start() de cada componente crea sus actores de fisica, sonidos, scripts...
+        SceneAllocator::Scope allocatorScope(scene->getAllocator());
+        for (const auto& compData : objectData.components) {
+            SceneObjectLoader::addComponentFromData(obj, compData);
+        }
+        SceneObjectLoader::applyModelAndMaterial(scene, obj, objectData);
+    }
+
+    if (cell.added == cell.objects.size()) {
+        linkParents(cell);
+        cell.data.clear();
+        cell.data.shrink_to_fit();
+        cell.state = CellState::Loaded;
+    }
+}
+
+void WorldPartition::linkParents(Cell& cell) {
+    // writeCells guarda cada padre antes que sus hijos; esto solo cubre celdas escritas por otros medios
+    for (size_t i = 0; i < cell.objects.size(); i++) {
+        int parentIndex = cell.data[i].parentIndex;
+        if (parentIndex <= static_cast<int>(i) || static_cast<size_t>(parentIndex) >= cell.objects.size()) continue;
+
+        GameObject* obj = cell.objects[i].get();
+        GameObject* parent = cell.objects[parentIndex].get();
+        if (obj && parent) {
+            obj->setParent(parent);
+        }
+    }
+}
+
+void WorldPartition::removeObject(Cell& cell) {
+    if (cell.added == 0) {
+        cell.state = CellState::Unloaded;
+        return;
+    }
+
+    cell.added--;
+    // Puede que ya no exista: borrado desde un script, la jerarquia o con su padre
+    if (GameObject* obj = cell.objects[cell.added].get()) {
+        scene->removeGameObject(obj);
+    }
+    cell.objects.pop_back();
+
+    if (cell.added == 0) {
+        cell.state = CellState::Unloaded;
+    }
+}
+
+void WorldPartition::discardObjects(std::vector<GameObject*>& objects) {
+    for (GameObject* obj : objects) {
+        delete obj;
+    }
+    objects.clear();
+}
+
+void WorldPartition::discardObjects(std::vector<ObjectHandle>& objects) {
+    for (const ObjectHandle& handle : objects) {
+        delete handle.get();
+    }
+    objects.clear();
+}
+
+void WorldPartition::startWorker() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stopping = false;
+    if (!worker.joinable()) {
+        worker = std::thread(&WorldPartition::workerLoop, this);
+    }
+}
+
+void WorldPartition::stopWorker() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    requests.clear();
+    for (LoadResult& result : results) {
+        discardObjects(result.objects);
+    }
+    results.clear();
+    stopping = false;
+}
+
+void WorldPartition::workerLoop() {
+    // Los objetos de las celdas van a los pools de la escena (scene no cambia con el hilo vivo)
+    SceneAllocator::Scope allocatorScope(scene->getAllocator());
+    while (true) {
+        LoadRequest request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !requests.empty(); });
+            if (stopping) return;
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+
+        LoadResult result;
+        result.coord = request.coord;
+        result.request = request.request;
+
+        // Leer, decodificar los componentes y crear los GameObjects (sin tocar escena ni render)
+        FileData file;
+        BinarySceneReader reader;
+        if (FileSystem::readAsset(request.path, file) && reader.openMemory(file.data(), file.size())) {
+            size_t count = reader.getObjectCount();
+            result.data.resize(count);
+            result.ok = true;
+            for (size_t i = 0; i < count; i++) {
+                if (!reader.readObject(i, result.data[i], true)) {
+                    result.ok = false;
+                    break;
+                }
+            }
+
+            if (result.ok) {
+                result.objects.reserve(count);
+                for (const SceneObjectData& objectData : result.data) {
+                    result.objects.push_back(SceneObjectLoader::createObject(objectData));
+                }
+            }
+            else {
+                result.data.clear();
+            }
+        }
+
+        if (!result.ok) {
+            std::cerr << "WorldPartition: Failed to load cell " << request.path << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (stopping) {
+            discardObjects(result.objects);
+            return;
+        }
+        results.push_back(std::move(result));
+    }
+}
+
+std::string WorldPartition::cellFileName(const WorldCellCoord& coord) {
+    return "cell_" + std::to_string(coord.x) + "_" + std::to_string(coord.z) + ".scene";
+}
+
+bool WorldPartition::writeCells(const std::vector<SceneObjectData>& objects, float cellSize, const std::string& directory) {
+    if (cellSize <= 0.0f) {
+        std::cerr << "WorldPartition: Cell size must be positive" << std::endl;
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        std::cerr << "WorldPartition: Could not create " << directory << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    // Padre de cada objeto: por indice (escenas binarias) o por ID
+    std::unordered_map<std::string, int> indexByID;
+    for (size_t i = 0; i < objects.size(); i++) {
+        if (!objects[i].objectID.empty()) indexByID[objects[i].objectID] = static_cast<int>(i);
+    }
+
+    std::vector<int> parents(objects.size(), -1);
+    std::vector<std::vector<int>> children(objects.size());
+    for (size_t i = 0; i < objects.size(); i++) {
+        int parent = objects[i].parentIndex;
+        if (parent < 0 && !objects[i].parentID.empty()) {
+            auto it = indexByID.find(objects[i].parentID);
+            if (it != indexByID.end()) parent = it->second;
+        }
+        if (parent >= 0 && static_cast<size_t>(parent) < objects.size() && parent != static_cast<int>(i)) {
+            parents[i] = parent;
+            children[parent].push_back(static_cast<int>(i));
+        }
+    }
+
+    // Cada jerarquia va entera a la celda de su raiz, en profundidad (padre antes que hijos)
+    std::map<std::pair<int, int>, std::vector<int>> cellObjects;
+    std::vector<bool> visited(objects.size(), false);
+    for (size_t root = 0; root < objects.size(); root++) {
+        if (parents[root] >= 0) continue;
+
+        WorldCellCoord coord = cellFromPosition(objects[root].position, cellSize);
+        std::vector<int>& order = cellObjects[{ coord.x, coord.z }];
+
+        std::vector<int> stack{ static_cast<int>(root) };
+        while (!stack.empty()) {
+            int index = stack.back();
+            stack.pop_back();
+            if (visited[index]) continue;
+            visited[index] = true;
+            order.push_back(index);
+            for (auto it = children[index].rbegin(); it != children[index].rend(); ++it) {
+                stack.push_back(*it);
+            }
+        }
+    }
+
+    size_t skipped = std::count(visited.begin(), visited.end(), false);
+    if (skipped > 0) {
+        std::cerr << "WorldPartition: " << skipped << " objects in parent cycles were not written" << std::endl;
+    }
+
+    nlohmann::json cellList = nlohmann::json::array();
+    for (const auto& pair : cellObjects) {
+        WorldCellCoord coord;
+        coord.x = pair.first.first;
+        coord.z = pair.first.second;
+        const std::vector<int>& order = pair.second;
+
+        std::unordered_map<int, int> localIndex;
+        for (size_t i = 0; i < order.size(); i++) {
+            localIndex[order[i]] = static_cast<int>(i);
+        }
+
+        BinarySceneWriter writer;
+        writer.setMetadata({ { "Cell", { coord.x, coord.z } } });
+        writer.reserveObjects(order.size());
+        for (int index : order) {
+            SceneObjectData object = objects[index];
+            object.parentIndex = parents[index] >= 0 ? localIndex[parents[index]] : -1;
+            writer.addObject(object);
+        }
+
+        if (!writer.writeToFile(joinPath(directory, cellFileName(coord)))) {
+            return false;
+        }
+        cellList.push_back({ coord.x, coord.z });
+    }
+
+    // El manifiesto al final: si algo falla antes, el mundo anterior sigue siendo valido
+    nlohmann::json manifest;
+    manifest["Version"] = 1;
+    manifest["CellSize"] = cellSize;
+    manifest["Cells"] = cellList;
+    if (!FileSystem::writeString(joinPath(directory, WORLD_MANIFEST), manifest.dump(4))) {
+        return false;
+    }
+
+    std::cout << "WorldPartition: Wrote " << cellList.size() << " cells to " << directory << std::endl;
+    return true;
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../core/CoreExporter.h"
+#include "../core/BinaryScene.h"
+#include "ObjectHandle.h"
+
+class Scene;
+class GameObject;
+
+struct MANTRAXCORE_API WorldCellCoord {
+    int x = 0;
+    int z = 0;
+
+    bool operator==(const WorldCellCoord& other) const { return x == other.x && z == other.z; }
+    bool operator!=(const WorldCellCoord& other) const { return !(*this == other); }
+};
+
+struct WorldCellCoordHash {
+    size_t operator()(const WorldCellCoord& coord) const {
+        uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) | static_cast<uint32_t>(coord.z);
+        return std::hash<uint64_t>()(key);
+    }
+};
+
+struct MANTRAXCORE_API WorldPartitionSettings {
+    float loadRadius = 150.0f;          // Distancia (XZ) al borde de una celda para empezar a cargarla
+    float unloadRadius = 200.0f;        // Para descargarla; mayor que loadRadius (histeresis)
+    bool streamFromCamera = true;       // La camara de la escena cuenta como fuente
+    float frameBudgetMs = 2.0f;         // Tiempo por frame para añadir/quitar objetos de la escena
+    size_t maxObjectsPerFrame = 64;     // 0 = sin limite (solo cuenta el tiempo)
+};
+
+struct MANTRAXCORE_API WorldPartitionStats {
+    size_t cellCount = 0;
+    size_t loadedCells = 0;
+    size_t loadingCells = 0;            // En el hilo de carga o esperando a integrarse
+    size_t pendingObjects = 0;          // Decodificados, aun sin añadir a la escena
+    size_t integratedLastFrame = 0;
+    size_t removedLastFrame = 0;
+};
+
+// Mundo dividido en celdas XZ, cada una guardada como una escena binaria independiente
+// ("cell_<x>_<z>.scene") junto a un "world.json" con el tamaño de celda y la lista de celdas.
+//
+// Las celdas se cargan y descargan de forma aditiva sobre la escena activa segun la distancia a
+// la camara y a las fuentes registradas (el jugador, normalmente). Leer y decodificar una celda se
+// hace en un hilo aparte; añadir los objetos a la escena (render, componentes, actores de fisica)
+// se reparte entre frames con un presupuesto fijo.
+//
+// Los objetos de una celda pertenecen a la particion: se destruyen al descargarla.
+class MANTRAXCORE_API WorldPartition {
+public:
+    WorldPartition() = default;
+    ~WorldPartition();
+
+    WorldPartition(const WorldPartition&) = delete;
+    WorldPartition& operator=(const WorldPartition&) = delete;
+
+    // worldDirectory: ruta de asset (VFS) o absoluta de la carpeta con world.json
+    bool open(Scene* scene, const std::string& worldDirectory);
+    // Descarga todas las celdas de golpe y para el hilo de carga
+    void close();
+    bool isOpen() const { return scene != nullptr; }
+    Scene* getScene() const { return scene; }
+
+    // Hilo principal, una vez por frame
+    void update();
+
+    // Se guarda el handle: una fuente destruida deja de contar sin tener que quitarla
+    void addStreamingSource(GameObject* source);
+    void removeStreamingSource(GameObject* source);
+    void clearStreamingSources() { sources.clear(); }
+
+    WorldPartitionSettings& getSettings() { return settings; }
+    const WorldPartitionStats& getStats() const { return stats; }
+    float getCellSize() const { return cellSize; }
+    WorldCellCoord cellAt(const glm::vec3& position) const;
+    bool isCellLoaded(const WorldCellCoord& coord) const;
+
+    // Reparte los objetos raiz por celda segun su posicion (los hijos van con su raiz) y escribe
+    // world.json y una escena binaria por celda en la carpeta indicada
+    static bool writeCells(const std::vector<SceneObjectData>& objects, float cellSize, const std::string& directory);
+    static std::string cellFileName(const WorldCellCoord& coord);
+
+private:
+    enum class CellState {
+        Unloaded,
+        Loading,        // En el hilo de carga
+        Integrating,    // Objetos creados, añadiendose a la escena
+        Loaded,
+        Unloading       // Quitando objetos de la escena
+    };
+
+    struct Cell {
+        WorldCellCoord coord;
+        CellState state = CellState::Unloaded;
+        uint64_t request = 0;                   // Cambia en cada carga; descarta resultados cancelados
+        std::vector<SceneObjectData> data;      // Solo mientras se integra
+        // Handles: un script, la jerarquia o el padre pueden borrar un objeto ya integrado
+        std::vector<ObjectHandle> objects;
+        size_t added = 0;                       // objects[0, added) ya estan en la escena
+    };
+
+    struct LoadRequest {
+        WorldCellCoord coord;
+        uint64_t request = 0;
+        std::string path;
+    };
+
+    struct LoadResult {
+        WorldCellCoord coord;
+        uint64_t request = 0;
+        bool ok = false;
+        std::vector<SceneObjectData> data;
+        std::vector<GameObject*> objects;
+    };
+
+    void gatherSources(std::vector<glm::vec3>& outPositions) const;
+    float distanceToCell(const WorldCellCoord& coord, const glm::vec3& position) const;
+    float nearestSourceDistance(const WorldCellCoord& coord, const std::vector<glm::vec3>& positions) const;
+
+    void requestLoad(Cell& cell);
+    void requestUnload(Cell& cell);
+    void collectResults();
+    void integrateObject(Cell& cell);
+    void removeObject(Cell& cell);
+    void linkParents(Cell& cell);
+
+    void startWorker();
+    void stopWorker();
+    void workerLoop();
+    static void discardObjects(std::vector<GameObject*>& objects);
+    // Solo para objetos que aun no estan en la escena: son de la particion y nadie mas los borra
+    static void discardObjects(std::vector<ObjectHandle>& objects);
+
+    Scene* scene = nullptr;
+    std::string directory;
+    float cellSize = 64.0f;
+    WorldPartitionSettings settings;
+    WorldPartitionStats stats;
+
+    std::unordered_map<WorldCellCoord, Cell, WorldCellCoordHash> cells;
+    std::vector<ObjectHandle> sources;
+    uint64_t nextRequest = 1;
+
+    std::thread worker;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<LoadRequest> requests;
+    std::vector<LoadResult> results;
+    bool stopping = false;
+};
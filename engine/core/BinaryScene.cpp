@@ -0,0 +1,555 @@
+#include "BinaryScene.h"
+#include "FileSystem.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+using json = nlohmann::json;
+
+namespace {
+    const size_t SCENE_CHUNK_ALIGNMENT = 8;
+
+    size_t alignUp(size_t value) {
+        return (value + SCENE_CHUNK_ALIGNMENT - 1) / SCENE_CHUNK_ALIGNMENT * SCENE_CHUNK_ALIGNMENT;
+    }
+
+    // Tabla de strings con deduplicacion (tags, rutas de modelo y tipos se repiten mucho)
+    class StringTableBuilder {
+    public:
+        SceneStringRef add(const std::string& value) {
+            if (value.empty()) return SceneStringRef{ 0, 0 };
+
+            auto it = lookup.find(value);
+            if (it != lookup.end()) return it->second;
+
+            SceneStringRef ref{ static_cast<uint32_t>(table.size()), static_cast<uint32_t>(value.size()) };
+            table += value;
+            lookup.emplace(value, ref);
+            return ref;
+        }
+
+        const std::string& data() const { return table; }
+
+    private:
+        std::string table;
+        std::unordered_map<std::string, SceneStringRef> lookup;
+    };
+
+    void appendChunk(std::vector<char>& buffer, std::vector<SceneChunkEntry>& chunks, uint32_t id, const void* data, size_t size) {
+        buffer.resize(alignUp(buffer.size()), 0);
+
+        SceneChunkEntry entry = {};
+        entry.id = id;
+        entry.offset = buffer.size();
+        entry.size = size;
+        chunks.push_back(entry);
+
+        const char* bytes = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    void copyVec3(const glm::vec3& value, float out[3]) {
+        out[0] = value.x;
+        out[1] = value.y;
+        out[2] = value.z;
+    }
+
+    glm::vec3 readVec3(const json& value, const glm::vec3& fallback) {
+        if (!value.is_array() || value.size() < 3) return fallback;
+        if (!value[0].is_number() || !value[1].is_number() || !value[2].is_number()) return fallback;
+        return glm::vec3(value[0].get<float>(), value[1].get<float>(), value[2].get<float>());
+    }
+}
+
+// ===== BinarySceneWriter =====
+
+void BinarySceneWriter::setMetadata(const json& metadata) {
+    this->metadata = metadata;
+}
+
+EncodedSceneObject EncodedSceneObject::encode(const SceneObjectData& object) {
+    EncodedSceneObject encoded;
+    encoded.object = object;
+    encoded.object.components.clear();
+    encoded.components.reserve(object.components.size());
+
+    for (const auto& component : object.components) {
+        Component encodedComponent;
+        encodedComponent.typeName = component.value("type", "");
+        encodedComponent.enabled = component.value("enabled", true);
+        json::to_cbor(component, encodedComponent.data);
+        encoded.components.push_back(std::move(encodedComponent));
+    }
+    return encoded;
+}
+
+void BinarySceneWriter::addObject(const SceneObjectData& object) {
+    objects.push_back(std::make_shared<EncodedSceneObject>(EncodedSceneObject::encode(object)));
+}
+
+void BinarySceneWriter::addObject(std::shared_ptr<const EncodedSceneObject> object) {
+    if (object) {
+        objects.push_back(std::move(object));
+    }
+}
+
+SceneComponentType BinarySceneWriter::componentTypeFromName(const std::string& typeName) {
+    static const std::unordered_map<std::string, SceneComponentType> types = {
+        { "ScriptExecutor", SceneComponentType::ScriptExecutor },
+        { "LightComponent", SceneComponentType::LightComponent },
+        { "AudioSource", SceneComponentType::AudioSource },
+        { "PhysicalObject", SceneComponentType::PhysicalObject },
+        { "CharacterController", SceneComponentType::CharacterController },
+        { "SpriteAnimator", SceneComponentType::SpriteAnimator },
+        { "Collider", SceneComponentType::Collider },
+        { "Rigidbody", SceneComponentType::Rigidbody }
+    };
+
+    auto it = types.find(typeName);
+    return it != types.end() ? it->second : SceneComponentType::Unknown;
+}
+
+bool BinarySceneWriter::writeToBuffer(std::vector<char>& outBuffer) const {
+    StringTableBuilder strings;
+    std::vector<SceneObjectRecord> objectRecords;
+    std::vector<SceneComponentRecord> componentRecords;
+    std::vector<uint8_t> blobs;
+    objectRecords.reserve(objects.size());
+
+    // Los padres se guardan como indice para no tener que buscarlos por ID al cargar
+    std::unordered_map<std::string, int32_t> indexByID;
+    indexByID.reserve(objects.size());
+    size_t blobsSize = 0;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (!objects[i]->object.objectID.empty()) {
+            indexByID.emplace(objects[i]->object.objectID, static_cast<int32_t>(i));
+        }
+        for (const auto& component : objects[i]->components) {
+            blobsSize += component.data.size();
+        }
+    }
+    blobs.reserve(blobsSize);
+
+    for (const auto& encoded : objects) {
+        const SceneObjectData& object = encoded->object;
+        SceneObjectRecord record = {};
+        record.name = strings.add(object.name);
+        record.tag = strings.add(object.tag);
+        record.objectID = strings.add(object.objectID);
+        record.parentID = strings.add(object.parentID);
+        record.modelPath = strings.add(object.modelPath);
+        record.materialName = strings.add(object.materialName);
+        record.flags = object.hasMaterial ? static_cast<uint32_t>(SceneObjectHasMaterial) : 0u;
+        copyVec3(object.position, record.position);
+        copyVec3(object.rotation, record.rotation);
+        copyVec3(object.scale, record.scale);
+
+        record.parentIndex = -1;
+        if (!object.parentID.empty()) {
+            auto parent = indexByID.find(object.parentID);
+            if (parent != indexByID.end()) {
+                record.parentIndex = parent->second;
+            }
+        }
+
+        record.firstComponent = static_cast<uint32_t>(componentRecords.size());
+        for (const auto& component : encoded->components) {
+            SceneComponentRecord componentRecord = {};
+            componentRecord.type = static_cast<uint32_t>(componentTypeFromName(component.typeName));
+            componentRecord.typeName = strings.add(component.typeName);
+            componentRecord.flags = component.enabled ? static_cast<uint32_t>(SceneComponentEnabled) : 0u;
+            componentRecord.blobOffset = blobs.size();
+            componentRecord.blobSize = component.data.size();
+
+            blobs.insert(blobs.end(), component.data.begin(), component.data.end());
+            componentRecords.push_back(componentRecord);
+        }
+        record.componentCount = static_cast<uint32_t>(componentRecords.size()) - record.firstComponent;
+        objectRecords.push_back(record);
+    }
+
+    std::vector<uint8_t> metadataCbor = json::to_cbor(metadata);
+
+    const uint32_t chunkCount = 5;
+    std::vector<SceneChunkEntry> chunks;
+    chunks.reserve(chunkCount);
+
+    outBuffer.clear();
+    outBuffer.resize(sizeof(SceneFileHeader) + chunkCount * sizeof(SceneChunkEntry), 0);
+    appendChunk(outBuffer, chunks, SCENE_CHUNK_STRINGS, strings.data().data(), strings.data().size());
+    appendChunk(outBuffer, chunks, SCENE_CHUNK_META, metadataCbor.data(), metadataCbor.size());
+    appendChunk(outBuffer, chunks, SCENE_CHUNK_OBJECTS, objectRecords.data(), objectRecords.size() * sizeof(SceneObjectRecord));
+    appendChunk(outBuffer, chunks, SCENE_CHUNK_COMPONENTS, componentRecords.data(), componentRecords.size() * sizeof(SceneComponentRecord));
+    appendChunk(outBuffer, chunks, SCENE_CHUNK_BLOBS, blobs.data(), blobs.size());
+
+    SceneFileHeader header = {};
+    std::memcpy(header.magic, SCENE_FILE_MAGIC, sizeof(header.magic));
+    header.version = SCENE_FILE_VERSION;
+    header.chunkCount = chunkCount;
+    header.fileSize = outBuffer.size();
+
+    std::memcpy(outBuffer.data(), &header, sizeof(header));
+    std::memcpy(outBuffer.data() + sizeof(header), chunks.data(), chunks.size() * sizeof(SceneChunkEntry));
+    return true;
+}
+
+bool BinarySceneWriter::writeToFile(const std::string& filePath) const {
+    std::vector<char> buffer;
+    if (!writeToBuffer(buffer)) return false;
+
+    std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to open file for writing: " << tempPath << std::endl;
+            return false;
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!out) {
+            std::cerr << "Failed to write scene: " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, filePath, ec);
+    if (ec) {
+        std::cerr << "Failed to replace " << filePath << ": " << ec.message() << std::endl;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+// ===== BinarySceneReader =====
+
+bool BinarySceneReader::isBinaryScene(const char* data, size_t size) {
+    return data && size >= sizeof(SceneFileHeader) && std::memcmp(data, SCENE_FILE_MAGIC, sizeof(SCENE_FILE_MAGIC)) == 0;
+}
+
+bool BinarySceneReader::isBinaryScene(const std::string& filePath) {
+    char magic[sizeof(SceneFileHeader)] = {};
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in || !in.read(magic, sizeof(magic))) return false;
+    return isBinaryScene(magic, sizeof(magic));
+}
+
+bool BinarySceneReader::open(const std::string& filePath) {
+    close();
+    if (!mappedFile.open(filePath)) return false;
+
+    data = mappedFile.getData();
+    size = mappedFile.getSize();
+    valid = parse();
+    if (!valid) {
+        std::cerr << "BinaryScene: Archivo de escena invalido: " << filePath << std::endl;
+        close();
+    }
+    return valid;
+}
+
+bool BinarySceneReader::openMemory(const char* data, size_t size) {
+    close();
+    this->data = data;
+    this->size = size;
+    valid = parse();
+    if (!valid) {
+        close();
+    }
+    return valid;
+}
+
+void BinarySceneReader::close() {
+    mappedFile.close();
+    data = nullptr;
+    size = 0;
+    valid = false;
+    chunks = nullptr;
+    chunkCount = 0;
+    strings = nullptr;
+    stringsSize = 0;
+    objects = nullptr;
+    objectCount = 0;
+    components = nullptr;
+    componentCount = 0;
+    blobs = nullptr;
+    blobsSize = 0;
+}
+
+const SceneChunkEntry* BinarySceneReader::findChunk(uint32_t id) const {
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        if (chunks[i].id == id) return &chunks[i];
+    }
+    return nullptr;
+}
+
+bool BinarySceneReader::parse() {
+    if (!isBinaryScene(data, size)) return false;
+
+    const SceneFileHeader* header = reinterpret_cast<const SceneFileHeader*>(data);
+    if (header->version != SCENE_FILE_VERSION) {
+        std::cerr << "BinaryScene: version no soportada (" << header->version << ")" << std::endl;
+        return false;
+    }
+
+    uint64_t tableEnd = sizeof(SceneFileHeader) + static_cast<uint64_t>(header->chunkCount) * sizeof(SceneChunkEntry);
+    if (tableEnd > size) return false;
+
+    chunks = reinterpret_cast<const SceneChunkEntry*>(data + sizeof(SceneFileHeader));
+    chunkCount = header->chunkCount;
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        if (chunks[i].offset > size || chunks[i].size > size - chunks[i].offset) {
+            std::cerr << "BinaryScene: chunk fuera de rango" << std::endl;
+            return false;
+        }
+    }
+
+    const SceneChunkEntry* stringChunk = findChunk(SCENE_CHUNK_STRINGS);
+    const SceneChunkEntry* objectChunk = findChunk(SCENE_CHUNK_OBJECTS);
+    const SceneChunkEntry* componentChunk = findChunk(SCENE_CHUNK_COMPONENTS);
+    const SceneChunkEntry* blobChunk = findChunk(SCENE_CHUNK_BLOBS);
+    if (!stringChunk || !objectChunk || !componentChunk || !blobChunk) {
+        std::cerr << "BinaryScene: faltan chunks obligatorios" << std::endl;
+        return false;
+    }
+
+    if (objectChunk->size % sizeof(SceneObjectRecord) != 0 ||
+        componentChunk->size % sizeof(SceneComponentRecord) != 0) {
+        return false;
+    }
+
+    strings = data + stringChunk->offset;
+    stringsSize = static_cast<size_t>(stringChunk->size);
+    objects = reinterpret_cast<const SceneObjectRecord*>(data + objectChunk->offset);
+    objectCount = static_cast<size_t>(objectChunk->size / sizeof(SceneObjectRecord));
+    components = reinterpret_cast<const SceneComponentRecord*>(data + componentChunk->offset);
+    componentCount = static_cast<size_t>(componentChunk->size / sizeof(SceneComponentRecord));
+    blobs = data + blobChunk->offset;
+    blobsSize = static_cast<size_t>(blobChunk->size);
+
+    for (size_t i = 0; i < objectCount; ++i) {
+        const SceneObjectRecord& record = objects[i];
+        if (static_cast<uint64_t>(record.firstComponent) + record.componentCount > componentCount ||
+            record.parentIndex < -1 || record.parentIndex >= static_cast<int32_t>(objectCount)) {
+            std::cerr << "BinaryScene: objeto " << i << " fuera de rango" << std::endl;
+            return false;
+        }
+    }
+    for (size_t i = 0; i < componentCount; ++i) {
+        if (components[i].blobOffset > blobsSize || components[i].blobSize > blobsSize - components[i].blobOffset) {
+            std::cerr << "BinaryScene: componente " << i << " fuera de rango" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view BinarySceneReader::getString(const SceneStringRef& ref) const {
+    if (static_cast<uint64_t>(ref.offset) + ref.length > stringsSize) return std::string_view();
+    return std::string_view(strings + ref.offset, ref.length);
+}
+
+const SceneComponentRecord* BinarySceneReader::getComponentRecords(size_t objectIndex, size_t& outCount) const {
+    const SceneObjectRecord& record = objects[objectIndex];
+    outCount = record.componentCount;
+    return components + record.firstComponent;
+}
+
+bool BinarySceneReader::readMetadata(json& outMetadata) const {
+    const SceneChunkEntry* metaChunk = findChunk(SCENE_CHUNK_META);
+    if (!valid || !metaChunk || metaChunk->size == 0) {
+        outMetadata = json::object();
+        return valid;
+    }
+
+    const uint8_t* begin = reinterpret_cast<const uint8_t*>(data + metaChunk->offset);
+    outMetadata = json::from_cbor(begin, begin + metaChunk->size, true, false);
+    if (outMetadata.is_discarded()) {
+        std::cerr << "BinaryScene: metadatos corruptos" << std::endl;
+        outMetadata = json::object();
+        return false;
+    }
+    return true;
+}
+
+bool BinarySceneReader::readComponent(const SceneComponentRecord& record, json& outComponent) const {
+    const uint8_t* begin = reinterpret_cast<const uint8_t*>(blobs + record.blobOffset);
+    outComponent = json::from_cbor(begin, begin + record.blobSize, true, false);
+    if (outComponent.is_discarded() || !outComponent.is_object()) {
+        std::cerr << "BinaryScene: componente corrupto (" << getString(record.typeName) << ")" << std::endl;
+        outComponent = json::object();
+        return false;
+    }
+    return true;
+}
+
+bool BinarySceneReader::readObject(size_t index, SceneObjectData& outObject, bool includeComponents) const {
+    if (!valid || index >= objectCount) return false;
+
+    const SceneObjectRecord& record = objects[index];
+    outObject.name = std::string(getString(record.name));
+    outObject.tag = std::string(getString(record.tag));
+    outObject.objectID = std::string(getString(record.objectID));
+    outObject.parentID = std::string(getString(record.parentID));
+    outObject.parentIndex = record.parentIndex;
+    outObject.position = glm::vec3(record.position[0], record.position[1], record.position[2]);
+    outObject.rotation = glm::vec3(record.rotation[0], record.rotation[1], record.rotation[2]);
+    outObject.scale = glm::vec3(record.scale[0], record.scale[1], record.scale[2]);
+    outObject.modelPath = std::string(getString(record.modelPath));
+    outObject.hasMaterial = (record.flags & SceneObjectHasMaterial) != 0;
+    outObject.materialName = std::string(getString(record.materialName));
+
+    outObject.components.clear();
+    if (!includeComponents) return true;
+
+    outObject.components.reserve(record.componentCount);
+    for (uint32_t i = 0; i < record.componentCount; ++i) {
+        json component;
+        if (readComponent(components[record.firstComponent + i], component)) {
+            outObject.components.push_back(std::move(component));
+        }
+    }
+    return true;
+}
+
+// ===== SceneConverter =====
+
+bool SceneConverter::jsonToObjectData(const json& object, SceneObjectData& outObject) {
+    if (!object.is_object()) return false;
+
+    // value()/get() lanzan type_error si un campo tiene otro tipo (un nombre numerico, por ejemplo)
+    try {
+        outObject = SceneObjectData();
+        outObject.name = object.value("Name", "New Object");
+        outObject.tag = object.value("Tag", "");
+        outObject.objectID = object.value("ObjectID", "");
+        outObject.parentID = object.value("parentID", "");
+        if (object.contains("position")) outObject.position = readVec3(object["position"], outObject.position);
+        if (object.contains("rotation")) outObject.rotation = readVec3(object["rotation"], outObject.rotation);
+        if (object.contains("scale")) outObject.scale = readVec3(object["scale"], outObject.scale);
+
+        if (object.contains("components")) {
+            const json& components = object["components"];
+            if (components.contains("component") && components["component"].is_array()) {
+                for (const auto& component : components["component"]) {
+                    if (component.is_object()) {
+                        outObject.components.push_back(component);
+                    }
+                }
+            }
+            if (components.contains("Geometry") && components["Geometry"].contains("modelPath")) {
+                outObject.modelPath = components["Geometry"]["modelPath"].get<std::string>();
+            }
+            outObject.hasMaterial = components.contains("Material") || components.contains("MaterialName");
+            outObject.materialName = components.value("MaterialName", "");
+        }
+    }
+    catch (const json::exception& e) {
+        std::cerr << "SceneConverter: Invalid object: " << e.what() << std::endl;
+        outObject = SceneObjectData();
+        return false;
+    }
+    return true;
+}
+
+json SceneConverter::objectDataToJson(const SceneObjectData& object) {
+    json subObject;
+    subObject["Name"] = object.name;
+    subObject["Tag"] = object.tag;
+    subObject["ObjectID"] = object.objectID;
+    subObject["position"] = { object.position.x, object.position.y, object.position.z };
+    subObject["rotation"] = { object.rotation.x, object.rotation.y, object.rotation.z };
+    subObject["scale"] = { object.scale.x, object.scale.y, object.scale.z };
+    if (!object.parentID.empty()) {
+        subObject["parentID"] = object.parentID;
+    }
+
+    json components = json::object();
+    for (const auto& component : object.components) {
+        components["component"].push_back(component);
+    }
+    if (!object.modelPath.empty()) {
+        components["Geometry"]["modelPath"] = object.modelPath;
+    }
+    if (object.hasMaterial) {
+        components["Material"]["exists"] = true;
+        components["MaterialName"] = object.materialName;
+    }
+    subObject["components"] = components;
+    return subObject;
+}
+
+json SceneConverter::extractMetadata(const json& scene) {
+    json metadata = scene.is_object() ? scene : json::object();
+    metadata.erase("objects");
+    return metadata;
+}
+
+namespace {
+    bool fillWriter(const json& scene, BinarySceneWriter& writer) {
+        if (!scene.is_object()) return false;
+
+        writer.setMetadata(SceneConverter::extractMetadata(scene));
+        if (scene.contains("objects")) {
+            writer.reserveObjects(scene["objects"].size());
+            for (const auto& object : scene["objects"]) {
+                SceneObjectData data;
+                if (SceneConverter::jsonToObjectData(object, data)) {
+                    writer.addObject(data);
+                }
+            }
+        }
+        return true;
+    }
+}
+
+bool SceneConverter::jsonToBinary(const json& scene, std::vector<char>& outBuffer) {
+    BinarySceneWriter writer;
+    return fillWriter(scene, writer) && writer.writeToBuffer(outBuffer);
+}
+
+bool SceneConverter::saveBinary(const json& scene, const std::string& binaryPath) {
+    BinarySceneWriter writer;
+    return fillWriter(scene, writer) && writer.writeToFile(binaryPath);
+}
+
+bool SceneConverter::binaryToJson(const BinarySceneReader& reader, json& outScene) {
+    if (!reader.isValid()) return false;
+
+    reader.readMetadata(outScene);
+    if (!outScene.is_object()) outScene = json::object();
+
+    json objects = json::array();
+    SceneObjectData data;
+    for (size_t i = 0; i < reader.getObjectCount(); ++i) {
+        if (reader.readObject(i, data)) {
+            objects.push_back(objectDataToJson(data));
+        }
+    }
+    outScene["objects"] = std::move(objects);
+    return true;
+}
+
+bool SceneConverter::convertJsonToBinaryFile(const std::string& jsonPath, const std::string& binaryPath) {
+    std::string text;
+    if (!FileSystem::readString(jsonPath, text)) return false;
+
+    json scene = json::parse(text, nullptr, false);
+    if (scene.is_discarded()) {
+        std::cerr << "SceneConverter: JSON invalido: " << jsonPath << std::endl;
+        return false;
+    }
+
+    return saveBinary(scene, binaryPath);
+}
+
+bool SceneConverter::convertBinaryToJsonFile(const std::string& binaryPath, const std::string& jsonPath) {
+    BinarySceneReader reader;
+    if (!reader.open(binaryPath)) return false;
+
+    json scene;
+    if (!binaryToJson(reader, scene)) return false;
+    return FileSystem::writeString(jsonPath, scene.dump(4));
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+#include "CoreExporter.h"
+#include "MappedFile.h"
+#include "SceneFormat.h"
+
+// Datos de un objeto tal como se guardan en la escena, independiente del formato (JSON o binario)
+struct MANTRAXCORE_API SceneObjectData {
+    std::string name;
+    std::string tag;
+    std::string objectID;
+    std::string parentID;
+    int parentIndex = -1;               // Solo en escenas binarias; -1 = resolver por parentID
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 rotation = glm::vec3(0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+    std::string modelPath;
+    bool hasMaterial = false;
+    std::string materialName;
+    std::vector<nlohmann::json> components; // Cada uno con "type" y "enabled"
+};
+
+// Objeto con los componentes ya codificados en CBOR. Se puede reutilizar entre guardados mientras
+// el objeto no cambie (ver SceneSaver).
+struct MANTRAXCORE_API EncodedSceneObject {
+    struct Component {
+        std::string typeName;
+        bool enabled = true;
+        std::vector<uint8_t> data;
+    };
+
+    SceneObjectData object;             // Sin componentes
+    std::vector<Component> components;
+
+    static EncodedSceneObject encode(const SceneObjectData& object);
+};
+
+class MANTRAXCORE_API BinarySceneWriter {
+public:
+    // Camara, settings, tiles... (todo lo que no son objetos)
+    void setMetadata(const nlohmann::json& metadata);
+    void addObject(const SceneObjectData& object);
+    void addObject(std::shared_ptr<const EncodedSceneObject> object);
+    void reserveObjects(size_t count) { objects.reserve(count); }
+
+    bool writeToBuffer(std::vector<char>& outBuffer) const;
+    // Escribe en "<archivo>.tmp" y lo renombra: un guardado interrumpido no deja la escena a medias
+    bool writeToFile(const std::string& filePath) const;
+
+    static SceneComponentType componentTypeFromName(const std::string& typeName);
+
+private:
+    nlohmann::json metadata = nlohmann::json::object();
+    std::vector<std::shared_ptr<const EncodedSceneObject>> objects;
+};
+
+// Lee escenas binarias sin construir un documento completo: los registros se leen directamente
+// del archivo mapeado y solo el componente que se pide se decodifica.
+class MANTRAXCORE_API BinarySceneReader {
+public:
+    BinarySceneReader() = default;
+
+    BinarySceneReader(const BinarySceneReader&) = delete;
+    BinarySceneReader& operator=(const BinarySceneReader&) = delete;
+
+    bool open(const std::string& filePath);
+    // El buffer debe seguir vivo mientras se use el reader
+    bool openMemory(const char* data, size_t size);
+    void close();
+
+    bool isValid() const { return valid; }
+    static bool isBinaryScene(const std::string& filePath);
+    static bool isBinaryScene(const char* data, size_t size);
+
+    bool readMetadata(nlohmann::json& outMetadata) const;
+
+    size_t getObjectCount() const { return objectCount; }
+    const SceneObjectRecord& getObjectRecord(size_t index) const { return objects[index]; }
+    const SceneComponentRecord* getComponentRecords(size_t objectIndex, size_t& outCount) const;
+    std::string_view getString(const SceneStringRef& ref) const;
+
+    // Sin componentes solo se leen los registros (no se decodifica ningun blob)
+    bool readObject(size_t index, SceneObjectData& outObject, bool includeComponents = true) const;
+    bool readComponent(const SceneComponentRecord& record, nlohmann::json& outComponent) const;
+
+private:
+    bool parse();
+    const SceneChunkEntry* findChunk(uint32_t id) const;
+
+    MappedFile mappedFile;
+    const char* data = nullptr;
+    size_t size = 0;
+    bool valid = false;
+
+    const SceneChunkEntry* chunks = nullptr;
+    uint32_t chunkCount = 0;
+    const char* strings = nullptr;
+    size_t stringsSize = 0;
+    const SceneObjectRecord* objects = nullptr;
+    size_t objectCount = 0;
+    const SceneComponentRecord* components = nullptr;
+    size_t componentCount = 0;
+    const char* blobs = nullptr;
+    size_t blobsSize = 0;
+};
+
+// Conversion entre el JSON de escena (intercambio / export) y el formato binario
+class MANTRAXCORE_API SceneConverter {
+public:
+    static bool jsonToObjectData(const nlohmann::json& object, SceneObjectData& outObject);
+    static nlohmann::json objectDataToJson(const SceneObjectData& object);
+
+    // Todo el documento excepto "objects"
+    static nlohmann::json extractMetadata(const nlohmann::json& scene);
+
+    static bool jsonToBinary(const nlohmann::json& scene, std::vector<char>& outBuffer);
+    static bool saveBinary(const nlohmann::json& scene, const std::string& binaryPath);
+    static bool binaryToJson(const BinarySceneReader& reader, nlohmann::json& outScene);
+
+    static bool convertJsonToBinaryFile(const std::string& jsonPath, const std::string& binaryPath);
+    static bool convertBinaryToJsonFile(const std::string& binaryPath, const std::string& jsonPath);
+};
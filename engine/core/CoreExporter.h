@@ -1,7 +1,9 @@
 #pragma once
 
-#ifdef MANTRAXCORE_EXPORTS
+#if defined(MANTRAXCORE_STATIC) || !defined(_WIN32)
+#define MANTRAXCORE_API
+#elif defined(MANTRAXCORE_EXPORTS)
 #define MANTRAXCORE_API __declspec(dllexport)
 #else
 #define MANTRAXCORE_API __declspec(dllimport)
-#endif
\ No newline at end of file
+#endif
@@ -1,7 +1,14 @@
 #include "FileSystem.h"
+#include "../mpak/MantraxCorePackReader.h"
 #include <filesystem>
 #include <iostream>
 #include <sstream>
+#include <shared_mutex>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
 
 namespace fs = std::filesystem;
 
@@ -258,4 +265,442 @@ std::string FileSystem::normalizePath(const std::string& path) {
 
 std::filesystem::path FileSystem::workDirectory() {
     return std::filesystem::current_path();
-}
\ No newline at end of file
+}
+
+// ===== Sistema de archivos virtual =====
+
+namespace {
+    struct VfsMount {
+        VfsMountInfo info;
+        std::shared_ptr<MantraxCorePackReader> pack;
+        std::unordered_map<std::string, std::shared_ptr<const std::vector<char>>> memoryFiles;
+    };
+
+    // Ordenados por prioridad descendente; a igual prioridad gana el ultimo montado
+    std::shared_mutex vfsMutex;
+    std::vector<std::shared_ptr<VfsMount>> vfsMounts;
+
+    std::string normalizeMountPoint(const std::string& mountPoint) {
+        std::string normalized = FileSystem::normalizeAssetPath(mountPoint);
+        while (!normalized.empty() && normalized.back() == '/') {
+            normalized.pop_back();
+        }
+        return normalized;
+    }
+
+    // Quita el prefijo del mount point; false si la ruta no cae dentro del mount
+    bool stripMountPoint(const std::string& path, const std::string& mountPoint, std::string& outRelative) {
+        if (mountPoint.empty()) {
+            outRelative = path;
+            return true;
+        }
+        if (path.size() <= mountPoint.size() ||
+            path.compare(0, mountPoint.size(), mountPoint) != 0 ||
+            path[mountPoint.size()] != '/') {
+            return false;
+        }
+        outRelative = path.substr(mountPoint.size() + 1);
+        return true;
+    }
+
+    void insertMount(std::shared_ptr<VfsMount> mount) {
+        std::unique_lock<std::shared_mutex> lock(vfsMutex);
+        auto it = std::find_if(vfsMounts.begin(), vfsMounts.end(), [&](const std::shared_ptr<VfsMount>& other) {
+            return other->info.priority <= mount->info.priority;
+        });
+        vfsMounts.insert(it, std::move(mount));
+    }
+
+    std::vector<std::shared_ptr<VfsMount>> snapshotMounts() {
+        std::shared_lock<std::shared_mutex> lock(vfsMutex);
+        return vfsMounts;
+    }
+
+    bool readOsFile(const std::string& osPath, std::vector<char>& buffer) {
+        std::ifstream file(osPath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::streamsize size = file.tellg();
+        if (size < 0) {
+            return false;
+        }
+        file.seekg(0, std::ios::beg);
+        buffer.resize(static_cast<size_t>(size));
+        if (size > 0 && !file.read(buffer.data(), size)) {
+            return false;
+        }
+        return true;
+    }
+
+    // Un solo hilo de IO: las lecturas async se atienden en orden de llegada
+    class VfsIOThread {
+    public:
+        static VfsIOThread& getInstance() {
+            static VfsIOThread instance;
+            return instance;
+        }
+
+        std::future<FileData> enqueue(const std::string& assetPath) {
+            Request request;
+            request.path = assetPath;
+            std::future<FileData> future = request.promise.get_future();
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (!worker.joinable()) {
+                    worker = std::thread(&VfsIOThread::run, this);
+                }
+                requests.push_back(std::move(request));
+            }
+            queueCondition.notify_one();
+            return future;
+        }
+
+        // Espera a la lectura en curso; las pendientes se completan sin datos
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                stopping = true;
+            }
+            queueCondition.notify_all();
+            if (worker.joinable()) {
+                worker.join();
+            }
+
+            std::lock_guard<std::mutex> lock(queueMutex);
+            for (Request& request : requests) {
+                request.promise.set_value(FileData());
+            }
+            requests.clear();
+            stopping = false;
+        }
+
+    private:
+        struct Request {
+            std::string path;
+            std::promise<FileData> promise;
+        };
+
+        VfsIOThread() = default;
+        ~VfsIOThread() {
+            stop();
+        }
+
+        void run() {
+            while (true) {
+                Request request;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    queueCondition.wait(lock, [this] { return stopping || !requests.empty(); });
+                    if (stopping) return;
+                    request = std::move(requests.front());
+                    requests.pop_front();
+                }
+
+                FileData data;
+                try {
+                    FileSystem::readAsset(request.path, data);
+                    request.promise.set_value(std::move(data));
+                }
+                catch (...) {
+                    request.promise.set_exception(std::current_exception());
+                }
+            }
+        }
+
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::deque<Request> requests;
+        std::thread worker;
+        bool stopping = false;
+    };
+}
+
+std::string FileSystem::normalizeAssetPath(const std::string& assetPath) {
+    std::string normalized;
+    normalized.reserve(assetPath.size());
+    for (char c : assetPath) {
+        if (c == '\\') c = '/';
+        // Colapsar separadores repetidos
+        if (c == '/' && !normalized.empty() && normalized.back() == '/') continue;
+        normalized.push_back(c);
+    }
+
+    while (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    if (!normalized.empty() && normalized.front() == '/') {
+        normalized.erase(0, 1);
+    }
+    return normalized;
+}
+
+std::string FileSystem::getContentPath(const std::string& assetPath) {
+    if (fs::path(assetPath).is_absolute()) {
+        return assetPath;
+    }
+    std::string relative = assetPath;
+    std::replace(relative.begin(), relative.end(), '/', '\\');
+    return getProjectPath() + "\\Content\\" + relative;
+}
+
+bool FileSystem::mountDirectory(const std::string& directory, const std::string& mountPoint, int priority) {
+    std::error_code error;
+    if (!fs::is_directory(directory, error)) {
+        std::cerr << "VFS: La carpeta no existe: " << directory << std::endl;
+        return false;
+    }
+
+    auto mount = std::make_shared<VfsMount>();
+    mount->info.type = VfsMountType::Directory;
+    mount->info.source = directory;
+    mount->info.mountPoint = normalizeMountPoint(mountPoint);
+    mount->info.priority = priority;
+    insertMount(std::move(mount));
+    return true;
+}
+
+bool FileSystem::mountPack(const std::string& packPath, const std::string& mountPoint, int priority) {
+    auto pack = std::make_shared<MantraxCorePackReader>(packPath);
+    if (!pack->IsValid()) {
+        std::cerr << "VFS: Pack invalido: " << packPath << std::endl;
+        return false;
+    }
+
+    auto mount = std::make_shared<VfsMount>();
+    mount->info.type = VfsMountType::Pack;
+    mount->info.source = packPath;
+    mount->info.mountPoint = normalizeMountPoint(mountPoint);
+    mount->info.priority = priority;
+    mount->pack = std::move(pack);
+    insertMount(std::move(mount));
+    return true;
+}
+
+bool FileSystem::mountMemory(const std::string& overlayName, const std::string& mountPoint, int priority) {
+    {
+        std::shared_lock<std::shared_mutex> lock(vfsMutex);
+        for (const auto& mount : vfsMounts) {
+            if (mount->info.type == VfsMountType::Memory && mount->info.source == overlayName) {
+                std::cerr << "VFS: El overlay ya esta montado: " << overlayName << std::endl;
+                return false;
+            }
+        }
+    }
+
+    auto mount = std::make_shared<VfsMount>();
+    mount->info.type = VfsMountType::Memory;
+    mount->info.source = overlayName;
+    mount->info.mountPoint = normalizeMountPoint(mountPoint);
+    mount->info.priority = priority;
+    insertMount(std::move(mount));
+    return true;
+}
+
+bool FileSystem::setMemoryFile(const std::string& overlayName, const std::string& assetPath, std::vector<char> data) {
+    auto shared = std::make_shared<const std::vector<char>>(std::move(data));
+    std::unique_lock<std::shared_mutex> lock(vfsMutex);
+    for (auto& mount : vfsMounts) {
+        if (mount->info.type == VfsMountType::Memory && mount->info.source == overlayName) {
+            mount->memoryFiles[normalizeAssetPath(assetPath)] = std::move(shared);
+            return true;
+        }
+    }
+    std::cerr << "VFS: Overlay no montado: " << overlayName << std::endl;
+    return false;
+}
+
+bool FileSystem::removeMemoryFile(const std::string& overlayName, const std::string& assetPath) {
+    std::unique_lock<std::shared_mutex> lock(vfsMutex);
+    for (auto& mount : vfsMounts) {
+        if (mount->info.type == VfsMountType::Memory && mount->info.source == overlayName) {
+            return mount->memoryFiles.erase(normalizeAssetPath(assetPath)) > 0;
+        }
+    }
+    return false;
+}
+
+bool FileSystem::unmount(const std::string& source) {
+    std::unique_lock<std::shared_mutex> lock(vfsMutex);
+    auto it = std::find_if(vfsMounts.begin(), vfsMounts.end(), [&](const std::shared_ptr<VfsMount>& mount) {
+        return mount->info.source == source;
+    });
+    if (it == vfsMounts.end()) {
+        return false;
+    }
+    vfsMounts.erase(it);
+    return true;
+}
+
+void FileSystem::unmountAll() {
+    // Una lectura async en curso puede estar usando un pack que se va a cerrar
+    shutdownAsyncIO();
+    std::unique_lock<std::shared_mutex> lock(vfsMutex);
+    vfsMounts.clear();
+}
+
+namespace {
+    // Lo montado por mountProject, para quitarlo al cambiar de proyecto sin tocar otros mounts
+    std::string projectPackSource;
+    std::string projectContentSource;
+}
+
+std::string FileSystem::getProjectPackPath(const std::string& projectRoot) {
+    return (fs::path(projectRoot) / "Build" / "Content.mpak").string();
+}
+
+bool FileSystem::mountProject(const std::string& projectRoot, bool preferLooseContent) {
+    if (!projectPackSource.empty()) {
+        unmount(projectPackSource);
+        projectPackSource.clear();
+    }
+    if (!projectContentSource.empty()) {
+        unmount(projectContentSource);
+        projectContentSource.clear();
+    }
+
+    int contentPriority = preferLooseContent ? 100 : 0;
+    int packPriority = preferLooseContent ? 0 : 100;
+
+    std::string contentDirectory = (fs::path(projectRoot) / "Content").string();
+    std::error_code error;
+    if (fs::is_directory(contentDirectory, error) && mountDirectory(contentDirectory, "", contentPriority)) {
+        projectContentSource = contentDirectory;
+    }
+
+    std::string packPath = getProjectPackPath(projectRoot);
+    if (!fs::is_regular_file(packPath, error)) {
+        std::cout << "VFS: Sin pack en " << packPath << "; se lee Content suelto" << std::endl;
+        return false;
+    }
+    if (!mountPack(packPath, "", packPriority)) {
+        return false;
+    }
+    projectPackSource = packPath;
+    std::cout << "VFS: Pack montado: " << packPath << std::endl;
+    return true;
+}
+
+std::vector<VfsMountInfo> FileSystem::getMounts() {
+    std::shared_lock<std::shared_mutex> lock(vfsMutex);
+    std::vector<VfsMountInfo> result;
+    result.reserve(vfsMounts.size());
+    for (const auto& mount : vfsMounts) {
+        result.push_back(mount->info);
+    }
+    return result;
+}
+
+bool FileSystem::assetExists(const std::string& assetPath) {
+    std::error_code error;
+    if (fs::path(assetPath).is_absolute()) {
+        return fs::is_regular_file(assetPath, error);
+    }
+
+    std::string path = normalizeAssetPath(assetPath);
+    std::shared_lock<std::shared_mutex> lock(vfsMutex);
+    for (const auto& mount : vfsMounts) {
+        std::string relative;
+        if (!stripMountPoint(path, mount->info.mountPoint, relative)) continue;
+
+        switch (mount->info.type) {
+        case VfsMountType::Memory:
+            if (mount->memoryFiles.count(relative)) return true;
+            break;
+        case VfsMountType::Pack:
+            if (mount->pack->Contains(relative)) return true;
+            break;
+        case VfsMountType::Directory:
+            if (fs::is_regular_file(fs::path(mount->info.source) / relative, error)) return true;
+            break;
+        }
+    }
+    lock.unlock();
+
+    return fs::is_regular_file(getContentPath(path), error);
+}
+
+bool FileSystem::readAsset(const std::string& assetPath, FileData& outData) {
+    outData = FileData();
+
+    if (fs::path(assetPath).is_absolute()) {
+        outData.found = readOsFile(assetPath, outData.owned);
+        return outData.found;
+    }
+
+    std::string path = normalizeAssetPath(assetPath);
+    std::error_code error;
+
+    // Copia de la lista para no bloquear montajes mientras se lee de disco
+    for (const auto& mount : snapshotMounts()) {
+        std::string relative;
+        if (!stripMountPoint(path, mount->info.mountPoint, relative)) continue;
+
+        switch (mount->info.type) {
+        case VfsMountType::Memory: {
+            std::shared_ptr<const std::vector<char>> file;
+            {
+                std::shared_lock<std::shared_mutex> lock(vfsMutex);
+                auto it = mount->memoryFiles.find(relative);
+                if (it != mount->memoryFiles.end()) file = it->second;
+            }
+            if (!file) break;
+            if (!file->empty()) {
+                outData.view = file->data();
+                outData.viewSize = file->size();
+                outData.keepAlive = file;
+            }
+            outData.found = true;
+            return true;
+        }
+        case VfsMountType::Pack: {
+            CorePackView view;
+            if (mount->pack->GetFileView(relative, view)) {
+                if (!view.empty()) {
+                    outData.view = view.data;
+                    outData.viewSize = view.size;
+                    outData.keepAlive = mount->pack;
+                }
+                outData.found = true;
+                return true;
+            }
+            // Entradas comprimidas o packs v1
+            if (mount->pack->Contains(relative) && mount->pack->ReadFile(relative, outData.owned)) {
+                outData.found = true;
+                return true;
+            }
+            break;
+        }
+        case VfsMountType::Directory: {
+            fs::path osPath = fs::path(mount->info.source) / relative;
+            if (fs::is_regular_file(osPath, error) && readOsFile(osPath.string(), outData.owned)) {
+                outData.found = true;
+                return true;
+            }
+            break;
+        }
+        }
+    }
+
+    // Sin mount que lo tenga: carpeta Content del proyecto
+    outData.found = readOsFile(getContentPath(path), outData.owned);
+    return outData.found;
+}
+
+bool FileSystem::readAssetString(const std::string& assetPath, std::string& outContent) {
+    FileData data;
+    if (!readAsset(assetPath, data)) {
+        std::cerr << "VFS: No se encontro el asset: " << assetPath << std::endl;
+        return false;
+    }
+    outContent = data.toString();
+    return true;
+}
+
+std::future<FileData> FileSystem::readAssetAsync(const std::string& assetPath) {
+    return VfsIOThread::getInstance().enqueue(assetPath);
+}
+
+void FileSystem::shutdownAsyncIO() {
+    VfsIOThread::getInstance().stop();
+}
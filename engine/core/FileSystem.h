@@ -4,8 +4,45 @@
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include <filesystem>
+#include <future>
+#include <memory>
 #include "CoreExporter.h"
 
+// Contenido de un asset leido por el VFS: buffer propio o vista sin copia sobre un pack mapeado.
+// La vista mantiene vivo el pack aunque se desmonte mientras se usa.
+class MANTRAXCORE_API FileData {
+public:
+    const char* data() const { return view ? view : owned.data(); }
+    size_t size() const { return view ? viewSize : owned.size(); }
+    bool empty() const { return size() == 0; }
+    bool isValid() const { return found; }
+    bool isMapped() const { return view != nullptr; }
+    std::string toString() const { return std::string(data(), size()); }
+
+private:
+    friend class FileSystem;
+
+    std::vector<char> owned;
+    const char* view = nullptr;
+    size_t viewSize = 0;
+    std::shared_ptr<const void> keepAlive;
+    bool found = false;
+};
+
+enum class VfsMountType {
+    Directory,
+    Pack,
+    Memory
+};
+
+struct MANTRAXCORE_API VfsMountInfo {
+    VfsMountType type = VfsMountType::Directory;
+    std::string source;         // Carpeta, archivo .mpak o nombre del overlay en memoria
+    std::string mountPoint;     // Prefijo virtual ("" = raiz de Content)
+    int priority = 0;
+};
+
 class MANTRAXCORE_API FileSystem {
 public:
     static std::string projectPath;
@@ -38,6 +75,38 @@ public:
     static std::filesystem::path workDirectory();
     static std::string GetPathAfterContent(const std::string& fullPath);
 
+    // ===== Sistema de archivos virtual =====
+    // Las rutas de assets son relativas a Content ("Models/Cube.fbx", da igual '/' o '\').
+    // Se consultan los mounts de mayor a menor prioridad; si ninguno tiene el archivo se
+    // busca en la carpeta Content del proyecto. Las rutas absolutas se leen tal cual del disco.
+    static bool mountDirectory(const std::string& directory, const std::string& mountPoint = "", int priority = 0);
+    static bool mountPack(const std::string& packPath, const std::string& mountPoint = "", int priority = 100);
+    static bool mountMemory(const std::string& overlayName, const std::string& mountPoint = "", int priority = 200);
+    static bool setMemoryFile(const std::string& overlayName, const std::string& assetPath, std::vector<char> data);
+    static bool removeMemoryFile(const std::string& overlayName, const std::string& assetPath);
+    static bool unmount(const std::string& source);
+    static void unmountAll();
+    static std::vector<VfsMountInfo> getMounts();
+
+    // Contenido de un proyecto: su Build/Content.mpak (si existe) por encima y la carpeta Content
+    // debajo para lo que no este en el pack. Con preferLooseContent (editor) es al reves: lo que se
+    // edita en disco se ve sin reconstruir el pack. Sustituye a lo montado por la llamada anterior.
+    // true si se monto el pack
+    static bool mountProject(const std::string& projectRoot, bool preferLooseContent = false);
+    static std::string getProjectPackPath(const std::string& projectRoot);
+
+    static bool assetExists(const std::string& assetPath);
+    static bool readAsset(const std::string& assetPath, FileData& outData);
+    static bool readAssetString(const std::string& assetPath, std::string& outContent);
+    // Lectura en el hilo de IO del VFS; FileData::isValid() indica si se encontro el archivo
+    static std::future<FileData> readAssetAsync(const std::string& assetPath);
+    // Para el hilo de IO (al cerrar el motor, antes de los estaticos); las lecturas pendientes
+    // quedan sin datos. Una lectura posterior lo vuelve a arrancar
+    static void shutdownAsyncIO();
+
+    static std::string normalizeAssetPath(const std::string& assetPath);
+    static std::string getContentPath(const std::string& assetPath);
+
 private:
     static bool ensureDirectoryExists(const std::string& filePath);
 }; 
\ No newline at end of file
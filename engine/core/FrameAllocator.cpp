@@ -0,0 +1,137 @@
+#include "FrameAllocator.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> heapAllocationCount{0};
+
+    uintptr_t alignUp(uintptr_t value, size_t alignment) {
+        return (value + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    }
+}
+
+// operator new global reemplazado solo para contar reservas; la memoria sigue saliendo de malloc.
+// Las versiones alineadas (align_val_t) se quedan con la implementacion de la runtime
+void* operator new(std::size_t size) {
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+FrameAllocator& FrameAllocator::getInstance() {
+    static FrameAllocator instance;
+    return instance;
+}
+
+FrameAllocator::FrameAllocator() {
+    for (Buffer& buffer : buffers) {
+        buffer.data = static_cast<char*>(::operator new(kDefaultCapacity));
+        buffer.capacity = kDefaultCapacity;
+    }
+    frameStartHeapAllocations = getHeapAllocationCount();
+}
+
+FrameAllocator::~FrameAllocator() {
+    for (Buffer& buffer : buffers) {
+        reset(buffer);
+        ::operator delete(buffer.data);
+    }
+}
+
+uint64_t FrameAllocator::getHeapAllocationCount() {
+    return heapAllocationCount.load(std::memory_order_relaxed);
+}
+
+void FrameAllocator::reset(Buffer& buffer) {
+    size_t used = buffer.offset.load(std::memory_order_relaxed);
+
+    for (void* block : buffer.overflow) {
+        ::operator delete(block);
+    }
+    buffer.overflow.clear();
+
+    // El frame no cupo: crecer hasta el pico con margen para que el siguiente no salga al heap
+    if (buffer.overflowBytes > 0) {
+        size_t capacity = (used + buffer.overflowBytes) * 3 / 2;
+        ::operator delete(buffer.data);
+        buffer.data = static_cast<char*>(::operator new(capacity));
+        buffer.capacity = capacity;
+    }
+
+    buffer.overflowBytes = 0;
+    buffer.offset.store(0, std::memory_order_relaxed);
+}
+
+void FrameAllocator::beginFrame() {
+    Buffer& finished = buffers[current];
+    lastFrameBytes = finished.offset.load(std::memory_order_relaxed) + finished.overflowBytes;
+    lastFrameOverflow = finished.overflowBytes;
+
+    uint64_t heapAllocations = getHeapAllocationCount();
+    lastFrameHeapAllocations = heapAllocations - frameStartHeapAllocations;
+
+    current ^= 1;
+    reset(buffers[current]);
+    frameIndex++;
+
+    // El crecimiento del buffer cuenta para este frame, no para el anterior
+    frameStartHeapAllocations = heapAllocations;
+}
+
+void* FrameAllocator::allocate(size_t size, size_t alignment) {
+    if (size == 0) size = 1;
+    if (alignment == 0) alignment = 1;
+
+    Buffer& buffer = buffers[current];
+    uintptr_t base = reinterpret_cast<uintptr_t>(buffer.data);
+
+    size_t offset = buffer.offset.load(std::memory_order_relaxed);
+    for (;;) {
+        size_t start = static_cast<size_t>(alignUp(base + offset, alignment) - base);
+        size_t end = start + size;
+        if (end > buffer.capacity) {
+            break;
+        }
+        if (buffer.offset.compare_exchange_weak(offset, end, std::memory_order_relaxed)) {
+            return buffer.data + start;
+        }
+    }
+
+    // No cabe: bloque suelto del heap hasta que se vacie este buffer
+    std::lock_guard<std::mutex> lock(overflowMutex);
+    void* block = ::operator new(size + alignment);
+    buffer.overflow.push_back(block);
+    buffer.overflowBytes += size;
+    return reinterpret_cast<void*>(alignUp(reinterpret_cast<uintptr_t>(block), alignment));
+}
+
+size_t FrameAllocator::getCapacity() const {
+    return buffers[current].capacity;
+}
+
+size_t FrameAllocator::getUsedBytes() const {
+    const Buffer& buffer = buffers[current];
+    return buffer.offset.load(std::memory_order_relaxed) + buffer.overflowBytes;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "CoreExporter.h"
+
+// Memoria temporal de un frame: reservar es avanzar un offset en un buffer lineal y no se libera
+// nada suelto. Hay dos buffers alternos; beginFrame() pasa al otro y lo vacia, asi que lo reservado
+// en un frame sigue valido durante el siguiente (p.ej. datos del update leidos por el render).
+//
+// Si un frame no cabe, lo que sobra sale del heap y el buffer crece al vaciarse, de modo que tras
+// unos frames todo el trabajo temporal cabe sin reservas de heap. Reservar es seguro entre hilos;
+// beginFrame() solo desde el principal, con el frame anterior terminado.
+class MANTRAXCORE_API FrameAllocator {
+public:
+    static FrameAllocator& getInstance();
+
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    void beginFrame();
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    uint64_t getFrameIndex() const { return frameIndex; }
+    size_t getCapacity() const;                  // Del buffer del frame actual
+    size_t getUsedBytes() const;                 // En el frame actual, incluido lo que no cupo
+    size_t getLastFrameBytes() const { return lastFrameBytes; }
+    size_t getLastFrameOverflow() const { return lastFrameOverflow; }
+
+    // Reservas de heap (operator new global) hechas durante el frame anterior
+    uint64_t getLastFrameHeapAllocations() const { return lastFrameHeapAllocations; }
+    // Desde el arranque; solo cuenta el operator new global de este modulo
+    static uint64_t getHeapAllocationCount();
+
+private:
+    static constexpr size_t kDefaultCapacity = 512 * 1024;
+
+    struct Buffer {
+        char* data = nullptr;
+        size_t capacity = 0;
+        std::atomic<size_t> offset{0};
+        std::vector<void*> overflow;     // Bloques del heap para lo que no cupo
+        size_t overflowBytes = 0;
+    };
+
+    FrameAllocator();
+    ~FrameAllocator();
+
+    void reset(Buffer& buffer);
+
+    Buffer buffers[2];
+    int current = 0;
+    std::mutex overflowMutex;
+
+    uint64_t frameIndex = 0;
+    size_t lastFrameBytes = 0;
+    size_t lastFrameOverflow = 0;
+    uint64_t frameStartHeapAllocations = 0;
+    uint64_t lastFrameHeapAllocations = 0;
+};
+
+// Adaptador para contenedores STL: reserva en el FrameAllocator y deallocate no hace nada.
+// Los contenedores no deben sobrevivir al frame siguiente; conviene reservar el tamaño de
+// antemano porque cada crecimiento deja el bloque anterior ocupado hasta el reset.
+template <typename T>
+class FrameStlAllocator {
+public:
+    using value_type = T;
+
+    FrameStlAllocator() noexcept = default;
+    template <typename U>
+    FrameStlAllocator(const FrameStlAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(FrameAllocator::getInstance().allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    template <typename U>
+    bool operator==(const FrameStlAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const FrameStlAllocator<U>&) const noexcept { return false; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
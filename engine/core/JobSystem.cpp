@@ -0,0 +1,265 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Indice del hilo en JobSystem::queues; -1 fuera del sistema
+    thread_local int currentThreadIndex = -1;
+}
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem* instance = new JobSystem();
+    return *instance;
+}
+
+void JobSystem::initialize(uint32_t workerCount) {
+    if (isInitialized()) return;
+
+    if (workerCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    mainThreadId = std::this_thread::get_id();
+    currentThreadIndex = 0;
+
+    queues.clear();
+    for (uint32_t i = 0; i <= workerCount; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    running.store(true, std::memory_order_release);
+    workers.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, static_cast<int>(i));
+    }
+
+    std::cout << "JobSystem: " << workerCount << " worker threads" << std::endl;
+}
+
+void JobSystem::shutdown() {
+    if (!isInitialized()) return;
+
+    // Lo que quede encolado se termina antes de parar; los Worker los sacan los trabajadores
+    while (queuedJobs.load(std::memory_order_acquire) > 0) {
+        if (!runOne(currentThreadIndex)) {
+            std::this_thread::yield();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running.store(false, std::memory_order_release);
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    queues.clear();
+    queuedJobs.store(0, std::memory_order_relaxed);
+}
+
+bool JobSystem::isMainThread() const {
+    return !isInitialized() || std::this_thread::get_id() == mainThreadId;
+}
+
+int JobSystem::getThreadIndex() const {
+    return currentThreadIndex;
+}
+
+void JobSystem::schedule(std::function<void()> job, JobCounter* counter, JobAffinity affinity, JobCounter* dependency) {
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (dependency) {
+        // Se comprueba con el mutex: quien baje el contador a 0 lo toma despues para soltar la lista
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (!dependency->isDone()) {
+            dependency->continuations.push_back({ std::move(job), counter, affinity });
+            return;
+        }
+    }
+
+    Job entry;
+    entry.function = std::move(job);
+    entry.counter = counter;
+    enqueue(std::move(entry), affinity);
+}
+
+void JobSystem::finishJob(JobCounter& counter) {
+    // Bajar y recoger la lista con el mutex: schedule() no puede colar una continuacion entre
+    // medias y wait() no devuelve hasta que esto lo suelta
+    std::vector<JobCounter::Continuation> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter.continuationMutex);
+        if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            ready.swap(counter.continuations);
+        }
+    }
+
+    for (JobCounter::Continuation& continuation : ready) {
+        Job entry;
+        entry.function = std::move(continuation.function);
+        entry.counter = continuation.counter;
+        enqueue(std::move(entry), continuation.affinity);
+    }
+}
+
+void JobSystem::enqueue(Job entry, JobAffinity affinity) {
+    // Sin hilos: en linea, tambien lo de MainThread y Worker (solo hay un hilo)
+    if (!isInitialized()) {
+        execute(entry);
+        return;
+    }
+
+    if (affinity == JobAffinity::MainThread) {
+        std::lock_guard<std::mutex> lock(mainThreadQueue.mutex);
+        mainThreadQueue.jobs.push_back(std::move(entry));
+        return;
+    }
+
+    // Cada trabajador encola en la suya. Lo Worker desde el principal y lo que llega de hilos
+    // ajenos (p. ej. callbacks de otras librerias) va repartido entre los trabajadores: si cayera
+    // en la del principal, cualquier wait() suyo lo ejecutaria en mitad del frame
+    int index = currentThreadIndex;
+    if (index < 0 || (index == 0 && affinity == JobAffinity::Worker)) {
+        index = 1 + static_cast<int>(nextWorkerQueue.fetch_add(1, std::memory_order_relaxed) % workers.size());
+    }
+    entry.workerOnly = affinity == JobAffinity::Worker;
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(std::move(entry));
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+
+    // Con el mutex de dormir para no perder el aviso entre la comprobacion y el wait del trabajador
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+bool JobSystem::popLocal(int threadIndex, Job& job) {
+    if (threadIndex < 0) return false;
+
+    WorkQueue& queue = *queues[threadIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+
+    // Lo ultimo encolado: sus datos siguen en la cache de este hilo
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(int threadIndex, Job& job) {
+    size_t count = queues.size();
+    size_t start = threadIndex >= 0 ? static_cast<size_t>(threadIndex) : 0;
+    for (size_t i = 1; i <= count; i++) {
+        size_t victim = (start + i) % count;
+        if (static_cast<int>(victim) == threadIndex) continue;
+
+        WorkQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+        if (threadIndex == 0 && queue.jobs.front().workerOnly) continue;
+
+        // Lo mas antiguo: suele ser el trabajo mas grande sin repartir
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::popMainThread(Job& job) {
+    std::lock_guard<std::mutex> lock(mainThreadQueue.mutex);
+    if (mainThreadQueue.jobs.empty()) return false;
+
+    job = std::move(mainThreadQueue.jobs.front());
+    mainThreadQueue.jobs.pop_front();
+    return true;
+}
+
+bool JobSystem::runOne(int threadIndex) {
+    if (queues.empty()) return false;
+
+    Job job;
+    if (popLocal(threadIndex, job) || steal(threadIndex, job)) {
+        execute(job);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(Job& job) {
+    job.function();
+    if (job.counter) {
+        finishJob(*job.counter);
+    }
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!runOne(currentThreadIndex)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // El ultimo trabajo aun puede tener el mutex del contador; despues ya se puede destruir
+    std::lock_guard<std::mutex> lock(counter.continuationMutex);
+}
+
+void JobSystem::runMainThreadJobs() {
+    if (!isMainThread()) return;
+
+    Job job;
+    while (popMainThread(job)) {
+        execute(job);
+    }
+}
+
+void JobSystem::workerLoop(int threadIndex) {
+    currentThreadIndex = threadIndex;
+
+    while (running.load(std::memory_order_acquire)) {
+        if (runOne(threadIndex)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() {
+            return queuedJobs.load(std::memory_order_acquire) > 0 || !running.load(std::memory_order_acquire);
+        });
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& work) {
+    if (count == 0) return;
+
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || !isInitialized() || workers.empty()) {
+        work(0, count);
+        return;
+    }
+
+    // Los tramos salen de un cursor compartido: quien acaba antes coge mas
+    std::atomic<size_t> next{0};
+    auto drain = [&]() {
+        for (size_t begin = next.fetch_add(grain); begin < count; begin = next.fetch_add(grain)) {
+            work(begin, std::min(begin + grain, count));
+        }
+    };
+
+    JobCounter counter;
+    size_t helpers = std::min<size_t>(workers.size(), chunks - 1);
+    for (size_t i = 0; i < helpers; i++) {
+        schedule(drain, &counter);
+    }
+
+    drain();
+    wait(counter);
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CoreExporter.h"
+
+// Donde puede correr un trabajo. MainThread es el hilo que llamo a JobSystem::initialize() (el
+// del contexto GL): para lo que toca OpenGL, SDL o el estado de scripts. Worker nunca corre en el
+// principal, ni siquiera dentro de un wait(): para trabajo largo que no debe frenar el frame (PhysX,
+// decodificar texturas)
+enum class JobAffinity {
+    Any,
+    MainThread,
+    Worker
+};
+
+// Trabajos pendientes de un grupo: schedule() lo sube y cada trabajo al terminar lo baja.
+// JobSystem::wait() espera a que llegue a 0 ejecutando otros trabajos mientras tanto. Debe vivir
+// hasta que terminen todos sus trabajos y los que dependen de el
+class MANTRAXCORE_API JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+    int getPending() const { return pending.load(std::memory_order_relaxed); }
+
+private:
+    friend class JobSystem;
+
+    // Trabajo que espera a que este contador llegue a 0 para encolarse
+    struct Continuation {
+        std::function<void()> function;
+        JobCounter* counter = nullptr;
+        JobAffinity affinity = JobAffinity::Any;
+    };
+
+    std::atomic<int> pending{0};
+    mutable std::mutex continuationMutex;
+    std::vector<Continuation> continuations;
+};
+
+// Sistema de trabajos del motor. Cada hilo (el principal y los trabajadores) tiene su cola: saca
+// por detras lo que encola el mismo y, cuando se queda sin trabajo, roba por delante de las de
+// los demas. Los trabajos con afinidad MainThread van aparte y solo los ejecuta el principal en
+// runMainThreadJobs(). Los Worker y los que llegan de hilos ajenos van a las colas de los
+// trabajadores. PhysX usa los mismos hilos (ver PhysicsJobDispatcher).
+//
+// Sin initialize() todo corre en linea en el hilo que llama, asi el codigo que lo usa funciona
+// igual en herramientas sin hilos
+class MANTRAXCORE_API JobSystem {
+public:
+    static JobSystem& getInstance();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Arranca los trabajadores; 0 = un hilo por nucleo menos el principal. El hilo que llama
+    // pasa a ser el principal
+    void initialize(uint32_t workerCount = 0);
+    // Termina lo encolado y para los hilos
+    void shutdown();
+    bool isInitialized() const { return running.load(std::memory_order_acquire); }
+
+    // dependency: el trabajo no se encola hasta que ese contador llegue a 0; mientras tanto
+    // espera en la lista de continuaciones del contador sin ocupar ningun hilo
+    void schedule(std::function<void()> job, JobCounter* counter = nullptr, JobAffinity affinity = JobAffinity::Any, JobCounter* dependency = nullptr);
+    // Ejecuta trabajos hasta que counter llegue a 0. Los de MainThread no: esperar desde el
+    // principal a uno de esos solo termina si lo saca runMainThreadJobs()
+    void wait(const JobCounter& counter);
+
+    // Reparte [0, count) en tramos de grain entre los trabajadores y el hilo que llama, y vuelve
+    // al terminar todos. Con un solo tramo corre en linea
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& work);
+
+    // Trabajos con afinidad MainThread encolados desde otros hilos; una vez por frame
+    void runMainThreadJobs();
+
+    bool isMainThread() const;
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(workers.size()); }
+    // 0 = principal, 1..N = trabajadores, -1 = hilo ajeno al sistema
+    int getThreadIndex() const;
+
+private:
+    JobSystem() = default;
+
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter = nullptr;
+        bool workerOnly = false;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // A la cola que toca segun afinidad y el hilo que encola
+    void enqueue(Job job, JobAffinity affinity);
+    // Baja counter; si llega a 0 encola lo que esperaba por el
+    void finishJob(JobCounter& counter);
+    bool popLocal(int threadIndex, Job& job);
+    bool steal(int threadIndex, Job& job);
+    bool popMainThread(Job& job);
+    // Un trabajo propio o robado; el principal no roba los Worker
+    bool runOne(int threadIndex);
+    void execute(Job& job);
+    void workerLoop(int threadIndex);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;    // [0] principal, [i] trabajador i
+    WorkQueue mainThreadQueue;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedJobs{0};    // En queues; los de MainThread no cuentan
+    std::atomic<uint32_t> nextWorkerQueue{0};
+    std::atomic<bool> running{false};
+    std::thread::id mainThreadId;
+};
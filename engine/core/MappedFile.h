@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include "CoreExporter.h"
+
+// Archivo de solo lectura mapeado en memoria (MapViewOfFile en Windows, mmap en POSIX).
+// El contenido sigue siendo valido mientras el objeto este abierto.
+class MANTRAXCORE_API MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& filePath);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const char* getData() const { return data; }
+    size_t getSize() const { return size; }
+    const std::string& getPath() const { return path; }
+
+private:
+    void moveFrom(MappedFile& other);
+
+    std::string path;
+    const char* data = nullptr;
+    size_t size = 0;
+    bool opened = false;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+};
@@ -0,0 +1,402 @@
+#include "MeshCooker.h"
+#include "PhysicsManager.h"
+#include "FileSystem.h"
+#include "../mpak/CorePackCodec.h"
+#include "../render/AssimpGeometry.h"
+#include <algorithm>
+#include <cfloat>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // Cambiar si cambia el formato del archivo o la forma de cocinar: invalida toda la cache
+    constexpr uint32_t kCookerVersion = 1;
+    constexpr uint32_t kCacheMagic = 0x4D43584D; // "MXCM"
+
+    // Por debajo de esto una pieza no se sigue partiendo
+    constexpr size_t kMinTrianglesPerHull = 8;
+    // Limite de piezas al leer la cache (protege de archivos corruptos)
+    constexpr uint32_t kMaxCachedHulls = 1024;
+
+    struct HullPiece {
+        std::vector<uint32_t> triangles;
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+    };
+
+    glm::vec3 triangleCentroid(const AssimpGeometry& geometry, uint32_t triangle) {
+        const std::vector<Vertex>& vertices = geometry.getVertices();
+        const std::vector<unsigned int>& indices = geometry.getIndices();
+        return (vertices[indices[triangle * 3]].position +
+                vertices[indices[triangle * 3 + 1]].position +
+                vertices[indices[triangle * 3 + 2]].position) / 3.0f;
+    }
+
+    void computeBounds(const AssimpGeometry& geometry, HullPiece& piece) {
+        const std::vector<Vertex>& vertices = geometry.getVertices();
+        const std::vector<unsigned int>& indices = geometry.getIndices();
+        piece.min = glm::vec3(FLT_MAX);
+        piece.max = glm::vec3(-FLT_MAX);
+        for (uint32_t triangle : piece.triangles) {
+            for (int corner = 0; corner < 3; corner++) {
+                const glm::vec3& p = vertices[indices[triangle * 3 + corner]].position;
+                piece.min = glm::min(piece.min, p);
+                piece.max = glm::max(piece.max, p);
+            }
+        }
+    }
+
+    // Descomposicion aproximada: parte la pieza mas grande por la mediana de los centroides en su
+    // eje mas largo hasta tener maxHulls piezas; cada pieza se envuelve luego con su propio convexo
+    std::vector<HullPiece> splitIntoPieces(const AssimpGeometry& geometry, uint32_t maxHulls) {
+        std::vector<HullPiece> pieces(1);
+        size_t triangleCount = geometry.getIndices().size() / 3;
+        pieces[0].triangles.resize(triangleCount);
+        for (size_t i = 0; i < triangleCount; i++) {
+            pieces[0].triangles[i] = static_cast<uint32_t>(i);
+        }
+        computeBounds(geometry, pieces[0]);
+
+        while (pieces.size() < maxHulls) {
+            size_t largest = SIZE_MAX;
+            float largestSize = 0.0f;
+            for (size_t i = 0; i < pieces.size(); i++) {
+                glm::vec3 extent = pieces[i].max - pieces[i].min;
+                float size = extent.x + extent.y + extent.z;
+                if (pieces[i].triangles.size() >= kMinTrianglesPerHull * 2 && size > largestSize) {
+                    largest = i;
+                    largestSize = size;
+                }
+            }
+            if (largest == SIZE_MAX) {
+                break;
+            }
+
+            HullPiece& piece = pieces[largest];
+            glm::vec3 extent = piece.max - piece.min;
+            int axis = extent.x >= extent.y ? (extent.x >= extent.z ? 0 : 2) : (extent.y >= extent.z ? 1 : 2);
+
+            auto middle = piece.triangles.begin() + piece.triangles.size() / 2;
+            std::nth_element(piece.triangles.begin(), middle, piece.triangles.end(),
+                [&](uint32_t a, uint32_t b) {
+                    return triangleCentroid(geometry, a)[axis] < triangleCentroid(geometry, b)[axis];
+                });
+
+            HullPiece upper;
+            upper.triangles.assign(middle, piece.triangles.end());
+            piece.triangles.erase(middle, piece.triangles.end());
+            computeBounds(geometry, piece);
+            computeBounds(geometry, upper);
+            pieces.push_back(std::move(upper));
+        }
+        return pieces;
+    }
+
+    template <typename Mesh>
+    Mesh* createFromBlob(std::vector<physx::PxU8>& blob, Mesh* (physx::PxPhysics::*create)(physx::PxInputStream&)) {
+        physx::PxPhysics* physics = PhysicsManager::getInstance().getPhysics();
+        physx::PxDefaultMemoryInputData input(blob.data(), static_cast<physx::PxU32>(blob.size()));
+        return (physics->*create)(input);
+    }
+}
+
+MeshCooker& MeshCooker::getInstance() {
+    static MeshCooker* instance = new MeshCooker();
+    return *instance;
+}
+
+std::string MeshCooker::getCacheDirectory() const {
+    if (!cacheDirectory.empty()) {
+        return cacheDirectory;
+    }
+    return (std::filesystem::path(FileSystem::getProjectPath()) / "Cache" / "Physics").string();
+}
+
+uint64_t MeshCooker::computeKey(const AssimpGeometry& geometry, const MeshCookingParams& params, MeshKind kind) const {
+    const physx::PxTolerancesScale& scale = PhysicsManager::getInstance().getPhysics()->getTolerancesScale();
+
+    uint64_t hash = CorePackCodec::Hash64(&kCookerVersion, sizeof(kCookerVersion));
+    uint32_t physxVersion = PX_PHYSICS_VERSION;
+    hash = CorePackCodec::Hash64(&physxVersion, sizeof(physxVersion), hash);
+    hash = CorePackCodec::Hash64(&kind, sizeof(kind), hash);
+    hash = CorePackCodec::Hash64(&scale.length, sizeof(scale.length), hash);
+    hash = CorePackCodec::Hash64(&scale.speed, sizeof(scale.speed), hash);
+    hash = CorePackCodec::Hash64(&params.weldTolerance, sizeof(params.weldTolerance), hash);
+    if (kind == MeshKind::Convex) {
+        hash = CorePackCodec::Hash64(&params.hullVertexLimit, sizeof(params.hullVertexLimit), hash);
+        hash = CorePackCodec::Hash64(&params.maxHulls, sizeof(params.maxHulls), hash);
+    }
+
+    // Solo las posiciones: normales y UVs no afectan a la colision
+    for (const Vertex& vertex : geometry.getVertices()) {
+        hash = CorePackCodec::Hash64(&vertex.position, sizeof(vertex.position), hash);
+    }
+    const std::vector<unsigned int>& indices = geometry.getIndices();
+    return CorePackCodec::Hash64(indices.data(), indices.size() * sizeof(unsigned int), hash);
+}
+
+std::string MeshCooker::getCacheFile(uint64_t key, MeshKind kind) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << key << (kind == MeshKind::Triangle ? ".tri" : ".cvx");
+    return (std::filesystem::path(getCacheDirectory()) / name.str()).string();
+}
+
+bool MeshCooker::readCacheFile(const std::string& path, std::vector<std::vector<physx::PxU8>>& blobs) const {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    uint32_t header[3] = {};
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        header[0] != kCacheMagic || header[1] != kCookerVersion || header[2] == 0 || header[2] > kMaxCachedHulls) {
+        return false;
+    }
+
+    blobs.assign(header[2], {});
+    for (std::vector<physx::PxU8>& blob : blobs) {
+        uint32_t size = 0;
+        if (!file.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+            return false;
+        }
+        blob.resize(size);
+        if (!file.read(reinterpret_cast<char*>(blob.data()), size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MeshCooker::writeCacheFile(const std::string& path, const std::vector<std::vector<physx::PxU8>>& blobs) const {
+    std::error_code ec;
+    std::filesystem::create_directories(getCacheDirectory(), ec);
+    if (ec) {
+        std::cerr << "MeshCooker: Could not create " << getCacheDirectory() << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    // Se escribe aparte y se renombra para no dejar nunca un archivo a medias con el nombre final
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        uint32_t header[3] = { kCacheMagic, kCookerVersion, static_cast<uint32_t>(blobs.size()) };
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        for (const std::vector<physx::PxU8>& blob : blobs) {
+            uint32_t size = static_cast<uint32_t>(blob.size());
+            file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            file.write(reinterpret_cast<const char*>(blob.data()), size);
+        }
+        if (!file) {
+            std::cerr << "MeshCooker: Could not write " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    std::filesystem::remove(path, ec);
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::cerr << "MeshCooker: Could not write " << path << ": " << ec.message() << std::endl;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+physx::PxCookingParams MeshCooker::makeCookingParams(const MeshCookingParams& params) const {
+    physx::PxCookingParams cookingParams(PhysicsManager::getInstance().getPhysics()->getTolerancesScale());
+    if (params.weldTolerance > 0.0f) {
+        cookingParams.meshPreprocessParams |= physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
+        cookingParams.meshWeldTolerance = params.weldTolerance;
+    }
+    return cookingParams;
+}
+
+bool MeshCooker::cookTriangleMesh(const AssimpGeometry& geometry, const MeshCookingParams& params, std::vector<physx::PxU8>& blob) const {
+    const std::vector<Vertex>& vertices = geometry.getVertices();
+    const std::vector<unsigned int>& indices = geometry.getIndices();
+
+    // Los puntos se leen directamente del array de vertices del render, sin copiarlos
+    physx::PxTriangleMeshDesc desc;
+    desc.points.count = static_cast<physx::PxU32>(vertices.size());
+    desc.points.stride = sizeof(Vertex);
+    desc.points.data = &vertices[0].position;
+    desc.triangles.count = static_cast<physx::PxU32>(indices.size() / 3);
+    desc.triangles.stride = 3 * sizeof(unsigned int);
+    desc.triangles.data = indices.data();
+
+    physx::PxDefaultMemoryOutputStream output;
+    physx::PxTriangleMeshCookingResult::Enum result;
+    if (!PxCookTriangleMesh(makeCookingParams(params), desc, output, &result)) {
+        std::cerr << "MeshCooker: Triangle mesh cooking failed for " << geometry.getPath() << " (" << result << ")" << std::endl;
+        return false;
+    }
+
+    blob.assign(output.getData(), output.getData() + output.getSize());
+    return true;
+}
+
+bool MeshCooker::cookConvexMeshes(const AssimpGeometry& geometry, const MeshCookingParams& params, std::vector<std::vector<physx::PxU8>>& blobs) const {
+    const std::vector<Vertex>& vertices = geometry.getVertices();
+    const std::vector<unsigned int>& indices = geometry.getIndices();
+
+    physx::PxCookingParams cookingParams = makeCookingParams(params);
+    physx::PxU16 vertexLimit = std::clamp<physx::PxU16>(params.hullVertexLimit, 8, 255);
+
+    std::vector<HullPiece> pieces = splitIntoPieces(geometry, std::max(params.maxHulls, 1u));
+    std::vector<unsigned int> pieceIndices;
+    std::vector<physx::PxVec3> points;
+
+    blobs.clear();
+    for (const HullPiece& piece : pieces) {
+        pieceIndices.clear();
+        for (uint32_t triangle : piece.triangles) {
+            pieceIndices.insert(pieceIndices.end(), &indices[triangle * 3], &indices[triangle * 3] + 3);
+        }
+        std::sort(pieceIndices.begin(), pieceIndices.end());
+        pieceIndices.erase(std::unique(pieceIndices.begin(), pieceIndices.end()), pieceIndices.end());
+        if (pieceIndices.size() < 4) {
+            continue;
+        }
+
+        points.clear();
+        for (unsigned int index : pieceIndices) {
+            const glm::vec3& p = vertices[index].position;
+            points.emplace_back(p.x, p.y, p.z);
+        }
+
+        physx::PxConvexMeshDesc desc;
+        desc.points.count = static_cast<physx::PxU32>(points.size());
+        desc.points.stride = sizeof(physx::PxVec3);
+        desc.points.data = points.data();
+        desc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX | physx::PxConvexFlag::eSHIFT_VERTICES;
+        desc.vertexLimit = vertexLimit;
+
+        physx::PxDefaultMemoryOutputStream output;
+        physx::PxConvexMeshCookingResult::Enum result;
+        if (!PxCookConvexMesh(cookingParams, desc, output, &result)) {
+            // Piezas planas o degeneradas: se descartan, el resto del objeto sigue colisionando
+            std::cerr << "MeshCooker: Convex hull cooking failed for a piece of " << geometry.getPath() << " (" << result << ")" << std::endl;
+            continue;
+        }
+        blobs.emplace_back(output.getData(), output.getData() + output.getSize());
+    }
+
+    if (blobs.empty()) {
+        std::cerr << "MeshCooker: No convex hull could be cooked for " << geometry.getPath() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+physx::PxTriangleMesh* MeshCooker::getTriangleMesh(const AssimpGeometry& geometry, const MeshCookingParams& params) {
+    if (!PhysicsManager::getInstance().getPhysics()) {
+        std::cerr << "MeshCooker: PhysicsManager not initialized yet!" << std::endl;
+        return nullptr;
+    }
+    if (geometry.getVertexCount() < 3 || geometry.getIndexCount() < 3) {
+        std::cerr << "MeshCooker: " << geometry.getPath() << " has no triangles to cook" << std::endl;
+        return nullptr;
+    }
+
+    uint64_t key = computeKey(geometry, params, MeshKind::Triangle);
+    auto it = triangleMeshes.find(key);
+    if (it != triangleMeshes.end()) {
+        memoryHitCount++;
+        return it->second;
+    }
+
+    std::string path = getCacheFile(key, MeshKind::Triangle);
+    std::vector<std::vector<physx::PxU8>> blobs;
+    physx::PxTriangleMesh* mesh = nullptr;
+    if (readCacheFile(path, blobs) && blobs.size() == 1) {
+        mesh = createFromBlob(blobs[0], &physx::PxPhysics::createTriangleMesh);
+        if (mesh) {
+            diskHitCount++;
+        }
+    }
+
+    if (!mesh) {
+        blobs.assign(1, {});
+        if (!cookTriangleMesh(geometry, params, blobs[0])) {
+            return nullptr;
+        }
+        mesh = createFromBlob(blobs[0], &physx::PxPhysics::createTriangleMesh);
+        if (!mesh) {
+            std::cerr << "MeshCooker: Could not create triangle mesh for " << geometry.getPath() << std::endl;
+            return nullptr;
+        }
+        cookCount++;
+        writeCacheFile(path, blobs);
+    }
+
+    triangleMeshes[key] = mesh;
+    return mesh;
+}
+
+const std::vector<physx::PxConvexMesh*>& MeshCooker::getConvexMeshes(const AssimpGeometry& geometry, const MeshCookingParams& params) {
+    static const std::vector<physx::PxConvexMesh*> empty;
+
+    if (!PhysicsManager::getInstance().getPhysics()) {
+        std::cerr << "MeshCooker: PhysicsManager not initialized yet!" << std::endl;
+        return empty;
+    }
+    if (geometry.getVertexCount() < 4 || geometry.getIndexCount() < 3) {
+        std::cerr << "MeshCooker: " << geometry.getPath() << " has no triangles to cook" << std::endl;
+        return empty;
+    }
+
+    uint64_t key = computeKey(geometry, params, MeshKind::Convex);
+    auto it = convexMeshes.find(key);
+    if (it != convexMeshes.end()) {
+        memoryHitCount++;
+        return it->second;
+    }
+
+    auto createAll = [](std::vector<std::vector<physx::PxU8>>& blobs, std::vector<physx::PxConvexMesh*>& meshes) {
+        for (std::vector<physx::PxU8>& blob : blobs) {
+            physx::PxConvexMesh* mesh = createFromBlob(blob, &physx::PxPhysics::createConvexMesh);
+            if (!mesh) {
+                for (physx::PxConvexMesh* created : meshes) {
+                    created->release();
+                }
+                meshes.clear();
+                return false;
+            }
+            meshes.push_back(mesh);
+        }
+        return true;
+    };
+
+    std::string path = getCacheFile(key, MeshKind::Convex);
+    std::vector<std::vector<physx::PxU8>> blobs;
+    std::vector<physx::PxConvexMesh*> meshes;
+    if (readCacheFile(path, blobs) && createAll(blobs, meshes)) {
+        diskHitCount++;
+    }
+    else {
+        if (!cookConvexMeshes(geometry, params, blobs) || !createAll(blobs, meshes)) {
+            std::cerr << "MeshCooker: Could not create convex meshes for " << geometry.getPath() << std::endl;
+            return empty;
+        }
+        cookCount++;
+        writeCacheFile(path, blobs);
+    }
+
+    return convexMeshes[key] = std::move(meshes);
+}
+
+void MeshCooker::clear() {
+    for (auto& entry : triangleMeshes) {
+        entry.second->release();
+    }
+    for (auto& entry : convexMeshes) {
+        for (physx::PxConvexMesh* mesh : entry.second) {
+            mesh->release();
+        }
+    }
+    triangleMeshes.clear();
+    convexMeshes.clear();
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <physx/PxPhysicsAPI.h>
+#include "CoreExporter.h"
+
+class AssimpGeometry;
+
+// Opciones de cocinado; todas forman parte de la clave de la cache
+struct MANTRAXCORE_API MeshCookingParams {
+    float weldTolerance = 0.001f;    // Fusiona vertices mas cercanos que esto (0 = sin fusionar)
+    uint16_t hullVertexLimit = 64;   // Vertices maximos por envolvente convexa (4..255)
+    uint32_t maxHulls = 1;           // >1: descomposicion convexa en hasta este numero de piezas
+};
+
+// Cocina las mallas de colision (PxTriangleMesh estatica, PxConvexMesh dinamica) a partir de un
+// AssimpGeometry. El resultado se guarda en disco con el hash de los vertices, los indices y los
+// parametros como nombre, asi en las siguientes ejecuciones se carga el stream ya cocinado en vez
+// de volver a cocinar al cargar la escena. En memoria se comparte la misma malla entre todos los
+// objetos con la misma geometria. Solo hilo principal.
+class MANTRAXCORE_API MeshCooker {
+public:
+    static MeshCooker& getInstance();
+
+    MeshCooker(const MeshCooker&) = delete;
+    MeshCooker& operator=(const MeshCooker&) = delete;
+
+    // Carpeta de la cache en disco; por defecto <proyecto>/Cache/Physics
+    void setCacheDirectory(const std::string& directory) { cacheDirectory = directory; }
+    std::string getCacheDirectory() const;
+
+    // Las mallas devueltas son de la cache: quien cree shapes con ellas no debe liberarlas
+    physx::PxTriangleMesh* getTriangleMesh(const AssimpGeometry& geometry, const MeshCookingParams& params = MeshCookingParams());
+    // Una pieza por envolvente; una sola si params.maxHulls es 1
+    const std::vector<physx::PxConvexMesh*>& getConvexMeshes(const AssimpGeometry& geometry, const MeshCookingParams& params = MeshCookingParams());
+
+    // Suelta las mallas en memoria; la llama PhysicsManager antes de liberar PxPhysics
+    void clear();
+
+    uint64_t getCookCount() const { return cookCount; }          // Mallas cocinadas en esta ejecucion
+    uint64_t getDiskHitCount() const { return diskHitCount; }    // Cargadas de la cache en disco
+    uint64_t getMemoryHitCount() const { return memoryHitCount; }
+
+private:
+    MeshCooker() = default;
+
+    enum class MeshKind : uint32_t { Triangle = 1, Convex = 2 };
+
+    uint64_t computeKey(const AssimpGeometry& geometry, const MeshCookingParams& params, MeshKind kind) const;
+    std::string getCacheFile(uint64_t key, MeshKind kind) const;
+
+    // Cada blob es un stream cocinado de PhysX
+    bool readCacheFile(const std::string& path, std::vector<std::vector<physx::PxU8>>& blobs) const;
+    bool writeCacheFile(const std::string& path, const std::vector<std::vector<physx::PxU8>>& blobs) const;
+
+    bool cookTriangleMesh(const AssimpGeometry& geometry, const MeshCookingParams& params, std::vector<physx::PxU8>& blob) const;
+    bool cookConvexMeshes(const AssimpGeometry& geometry, const MeshCookingParams& params, std::vector<std::vector<physx::PxU8>>& blobs) const;
+
+    physx::PxCookingParams makeCookingParams(const MeshCookingParams& params) const;
+
+    std::string cacheDirectory;
+    std::unordered_map<uint64_t, physx::PxTriangleMesh*> triangleMeshes;
+    std::unordered_map<uint64_t, std::vector<physx::PxConvexMesh*>> convexMeshes;
+
+    uint64_t cookCount = 0;
+    uint64_t diskHitCount = 0;
+    uint64_t memoryHitCount = 0;
+};
@@ -0,0 +1,42 @@
+#include "NameTable.h"
+
+NameTable& NameTable::getInstance() {
+    // Sin destruir al salir: los GameObjects que sobreviven a los estaticos aun lo usan
+    static NameTable* instance = new NameTable();
+    return *instance;
+}
+
+NameTable::NameTable() = default;
+
+NameTable::Id NameTable::intern(const std::string& text) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(text);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    strings.push_back(text);
+    Id id = static_cast<Id>(strings.size());
+    ids.emplace(text, id);
+    return id;
+}
+
+NameTable::Id NameTable::find(const std::string& text) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(text);
+    return it != ids.end() ? it->second : kNone;
+}
+
+const std::string& NameTable::str(Id id) const {
+    static const std::string none;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (id == kNone || id > strings.size()) {
+        return none;
+    }
+    return strings[id - 1];
+}
+
+size_t NameTable::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return strings.size();
+}
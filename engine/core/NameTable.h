@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "CoreExporter.h"
+
+// Strings internados: cada texto distinto recibe un id estable (0 = ninguno) y se guarda una vez.
+// Los indices de la escena por nombre y tag usan estos ids como clave. Seguro entre hilos.
+class MANTRAXCORE_API NameTable {
+public:
+    using Id = uint32_t;
+    static constexpr Id kNone = 0;
+
+    static NameTable& getInstance();
+
+    // Id del texto, creandolo si es nuevo
+    Id intern(const std::string& text);
+    // Solo busca; kNone si nunca se internó (util para busquedas que no deben crear entradas)
+    Id find(const std::string& text) const;
+    // Referencia estable mientras viva la tabla
+    const std::string& str(Id id) const;
+
+    size_t size() const;
+
+private:
+    NameTable();
+
+    mutable std::mutex mutex;
+    std::deque<std::string> strings;                   // strings[id - 1]; deque no mueve los elementos
+    std::unordered_map<std::string, Id> ids;
+};
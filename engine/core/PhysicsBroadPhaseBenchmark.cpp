@@ -0,0 +1,182 @@
+#include "PhysicsBroadPhaseBenchmark.h"
+#include <physx/extensions/PxDefaultSimulationFilterShader.h>
+#include <physx/extensions/PxRigidBodyExt.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    const char* broadPhaseName(BroadPhaseType type) {
+        switch (type) {
+        case BroadPhaseType::SAP: return "SAP";
+        case BroadPhaseType::MBP: return "MBP";
+        case BroadPhaseType::ABP: return "ABP";
+        case BroadPhaseType::PABP: return "PABP";
+        }
+        return "?";
+    }
+
+    constexpr float kSpacing = 4.0f;       // Separacion de la rejilla de estaticos
+    constexpr float kHalfExtent = 1.0f;
+    constexpr float kStepSeconds = 1.0f / 60.0f;
+}
+
+std::vector<BroadPhaseBenchmarkResult> PhysicsBroadPhaseBenchmark::Run(size_t staticCount, size_t dynamicCount, size_t steps) {
+    std::vector<BroadPhaseBenchmarkResult> results;
+
+    // Lo demas (arboles de consultas, margen) como en la escena de juego
+    PhysicsSceneSettings settings = PhysicsManager::getInstance().getSceneSettings();
+    settings.worldBounds = physx::PxBounds3::empty();
+
+    for (BroadPhaseType type : { BroadPhaseType::SAP, BroadPhaseType::MBP, BroadPhaseType::ABP, BroadPhaseType::PABP }) {
+        settings.broadPhase = type;
+        results.push_back(RunConfiguration(settings, staticCount, dynamicCount, steps));
+    }
+    return results;
+}
+
+BroadPhaseBenchmarkResult PhysicsBroadPhaseBenchmark::RunConfiguration(const PhysicsSceneSettings& settings, size_t staticCount, size_t dynamicCount, size_t steps) {
+    BroadPhaseBenchmarkResult result;
+    result.broadPhase = settings.broadPhase;
+    result.staticCount = staticCount;
+    result.dynamicCount = dynamicCount;
+    result.steps = steps;
+
+    PhysicsManager& manager = PhysicsManager::getInstance();
+    physx::PxPhysics* physics = manager.getPhysics();
+    if (!physics || !manager.getCpuDispatcher()) {
+        std::cerr << "BroadPhaseBenchmark: PhysicsManager no esta inicializado" << std::endl;
+        return result;
+    }
+
+    // El dispatcher se comparte con la escena de juego: que no tenga un paso en vuelo
+    manager.fetchResults();
+
+    physx::PxSceneDesc sceneDesc(physics->getTolerancesScale());
+    sceneDesc.gravity = physx::PxVec3(0.0f, -9.81f, 0.0f);
+    sceneDesc.cpuDispatcher = manager.getCpuDispatcher();
+    sceneDesc.filterShader = physx::PxDefaultSimulationFilterShader;
+    PhysicsManager::applySceneSettings(sceneDesc, settings);
+
+    physx::PxScene* scene = physics->createScene(sceneDesc);
+    if (!scene) {
+        std::cerr << "BroadPhaseBenchmark: createScene failed (" << broadPhaseName(settings.broadPhase) << ")" << std::endl;
+        return result;
+    }
+
+    physx::PxMaterial* material = physics->createMaterial(0.5f, 0.5f, 0.1f);
+    physx::PxShape* box = physics->createShape(physx::PxBoxGeometry(kHalfExtent, kHalfExtent, kHalfExtent), *material, false);
+
+    // Rejilla cuadrada de estaticos en XZ
+    size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(std::max<size_t>(staticCount, 1)))));
+    float extent = static_cast<float>(side) * kSpacing;
+
+    physx::PxBounds3 worldBounds = settings.worldBounds;
+    if (worldBounds.isEmpty()) {
+        worldBounds = physx::PxBounds3(physx::PxVec3(-kSpacing, -50.0f, -kSpacing), physx::PxVec3(extent + kSpacing, 100.0f, extent + kSpacing));
+    }
+    std::vector<physx::PxU32> regions = PhysicsManager::createBroadPhaseRegions(*scene, worldBounds, settings.mbpSubdivisions);
+    result.regionCount = regions.size();
+
+    std::vector<physx::PxRigidActor*> statics;
+    statics.reserve(staticCount);
+    for (size_t i = 0; i < staticCount; ++i) {
+        float x = static_cast<float>(i % side) * kSpacing;
+        float z = static_cast<float>(i / side) * kSpacing;
+        physx::PxRigidStatic* actor = physics->createRigidStatic(physx::PxTransform(physx::PxVec3(x, 0.0f, z)));
+        actor->attachShape(*box);
+        statics.push_back(actor);
+    }
+
+    // Igual que PhysicsManager::endActorBatch()
+    Clock::time_point insertStart = Clock::now();
+    physx::PxPruningStructure* pruningStructure = statics.empty() ? nullptr : physics->createPruningStructure(statics.data(), static_cast<physx::PxU32>(statics.size()));
+    if (pruningStructure) {
+        scene->addActors(*pruningStructure);
+        pruningStructure->release();
+    }
+    else {
+        for (physx::PxRigidActor* actor : statics) {
+            scene->addActor(*actor);
+        }
+    }
+    result.insertMs = elapsedMs(insertStart);
+
+    // Dinamicas a distintas alturas sobre la rejilla: durante la prueba van cayendo y chocando
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> horizontal(0.0f, extent);
+    std::uniform_real_distribution<float> height(5.0f, 60.0f);
+    std::vector<physx::PxRigidDynamic*> dynamics;
+    dynamics.reserve(dynamicCount);
+    for (size_t i = 0; i < dynamicCount; ++i) {
+        physx::PxRigidDynamic* actor = physics->createRigidDynamic(physx::PxTransform(physx::PxVec3(horizontal(rng), height(rng), horizontal(rng))));
+        actor->attachShape(*box);
+        physx::PxRigidBodyExt::updateMassAndInertia(*actor, 1.0f);
+        scene->addActor(*actor);
+        dynamics.push_back(actor);
+    }
+
+    double totalMs = 0.0;
+    for (size_t i = 0; i < steps; ++i) {
+        Clock::time_point stepStart = Clock::now();
+        scene->simulate(kStepSeconds);
+        scene->fetchResults(true);
+        double stepMs = elapsedMs(stepStart);
+        totalMs += stepMs;
+        result.maxStepMs = std::max(result.maxStepMs, stepMs);
+    }
+    result.averageStepMs = steps > 0 ? totalMs / static_cast<double>(steps) : 0.0;
+
+    // Dinamicas que han salido de las regiones MBP (no deberia haber con estos limites)
+    if (scene->getBroadPhaseType() == physx::PxBroadPhaseType::eMBP) {
+        for (physx::PxRigidDynamic* actor : dynamics) {
+            if (!actor->getWorldBounds().isInside(worldBounds)) {
+                result.outOfBounds++;
+            }
+        }
+    }
+
+    for (physx::PxRigidDynamic* actor : dynamics) {
+        actor->release();
+    }
+    for (physx::PxRigidActor* actor : statics) {
+        actor->release();
+    }
+    scene->release();
+    box->release();
+    material->release();
+
+    result.success = true;
+    return result;
+}
+
+void PhysicsBroadPhaseBenchmark::Print(const std::vector<BroadPhaseBenchmarkResult>& results) {
+    if (results.empty()) {
+        return;
+    }
+
+    const BroadPhaseBenchmarkResult& first = results.front();
+    std::cout << "=== BroadPhase Benchmark (" << first.staticCount << " static, " << first.dynamicCount
+              << " dynamic, " << first.steps << " steps) ===" << std::endl;
+    for (const BroadPhaseBenchmarkResult& result : results) {
+        std::cout << broadPhaseName(result.broadPhase) << ": ";
+        if (!result.success) {
+            std::cout << "FAILED" << std::endl;
+            continue;
+        }
+        std::cout << "step avg " << result.averageStepMs << " ms | max " << result.maxStepMs
+                  << " ms | insert " << result.insertMs << " ms";
+        if (result.regionCount > 0) {
+            std::cout << " | " << result.regionCount << " regions, " << result.outOfBounds << " out of bounds";
+        }
+        std::cout << std::endl;
+    }
+}
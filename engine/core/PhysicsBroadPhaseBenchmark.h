@@ -0,0 +1,30 @@
+#pragma once
+#include "CoreExporter.h"
+#include "PhysicsManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct MANTRAXCORE_API BroadPhaseBenchmarkResult {
+    BroadPhaseType broadPhase = BroadPhaseType::PABP;
+    size_t staticCount = 0;
+    size_t dynamicCount = 0;
+    size_t steps = 0;
+    size_t regionCount = 0;      // Regiones MBP (0 con el resto)
+    double insertMs = 0.0;       // Estaticos a la escena con PxPruningStructure
+    double averageStepMs = 0.0;  // simulate + fetchResults por paso
+    double maxStepMs = 0.0;
+    uint64_t outOfBounds = 0;
+    bool success = false;
+};
+
+// Misma escena con cada tipo de broadphase: una rejilla de cajas estaticas y cajas dinamicas que
+// caen sobre ella. Usa el PxPhysics y el dispatcher de PhysicsManager (que debe estar
+// inicializado) en escenas temporales, sin tocar la de juego
+class MANTRAXCORE_API PhysicsBroadPhaseBenchmark {
+public:
+    static std::vector<BroadPhaseBenchmarkResult> Run(size_t staticCount = 50000, size_t dynamicCount = 2000, size_t steps = 120);
+    // Una sola configuracion; worldBounds vacio con MBP = limites de la rejilla
+    static BroadPhaseBenchmarkResult RunConfiguration(const PhysicsSceneSettings& settings, size_t staticCount, size_t dynamicCount, size_t steps);
+    static void Print(const std::vector<BroadPhaseBenchmarkResult>& results);
+};
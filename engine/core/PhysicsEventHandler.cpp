@@ -1,5 +1,7 @@
 #include "PhysicsEventHandler.h"
 #include "../components/PhysicalObject.h"
+#include "../components/ScriptExecutor.h"
+#include "../components/GameObject.h"
 
 void PhysicsEventHandler::registerTriggerCallback(physx::PxActor* triggerActor, std::function<void(const TriggerEvent&)> callback) {
     if (triggerActor) {
@@ -45,25 +47,106 @@ void PhysicsEventHandler::processContactEvent(const ContactEvent& event) {
     }
 }
 
-void PhysicsEventHandler::registerPhysicalObject(physx::PxActor* actor, PhysicalObject* physicalObject) {
-    if (actor && physicalObject) {
-        actorToPhysicalObject[actor] = physicalObject;
+GameObject* PhysicsEventHandler::getGameObject(const physx::PxActor* actor) {
+    return actor ? static_cast<GameObject*>(actor->userData) : nullptr;
+}
+
+PhysicalObject* PhysicsEventHandler::getPhysicalObject(const physx::PxActor* actor) {
+    GameObject* object = getGameObject(actor);
+    return object ? object->getComponent<PhysicalObject>() : nullptr;
+}
+
+void PhysicsEventHandler::dispatchQueuedEvents() {
+    // Un script que fuerce un fetchResults desde su callback no vuelve a entrar aqui;
+    // lo que llegue mientras tanto queda encolado para el siguiente frame
+    if (isDispatching) return;
+
+    eventQueue.drain(dispatching);
+    if (dispatching.empty()) return;
+
+    isDispatching = true;
+    size_t begin = 0;
+    while (begin < dispatching.size()) {
+        physx::PxActor* receiver = dispatching[begin].receiver;
+        size_t end = begin + 1;
+        while (end < dispatching.size() && dispatching[end].receiver == receiver) {
+            end++;
+        }
+
+        // Receptor y sus scripts se resuelven una vez por grupo, no por evento
+        GameObject* receiverObject = getGameObject(receiver);
+        receiverScripts.clear();
+        if (receiverObject) {
+            for (const Component* component : receiverObject->getAllComponents()) {
+                if (const ScriptExecutor* script = dynamic_cast<const ScriptExecutor*>(component)) {
+                    receiverScripts.push_back(const_cast<ScriptExecutor*>(script));
+                }
+            }
+        }
+
+        for (size_t i = begin; i < end; i++) {
+            // Un callback anterior puede haber destruido el receptor (discardActorEvents)
+            if (dispatching[i].receiver) {
+                dispatchRecord(dispatching[i], receiverObject);
+            }
+        }
+        begin = end;
     }
+    dispatching.clear();
+    isDispatching = false;
 }
 
-void PhysicsEventHandler::unregisterPhysicalObject(physx::PxActor* actor) {
-    if (actor) {
-        actorToPhysicalObject.erase(actor);
+void PhysicsEventHandler::dispatchRecord(const PhysicsEventRecord& record, GameObject* receiverObject) {
+    switch (record.kind) {
+    case PhysicsEventRecord::TRIGGER_ENTER:
+    case PhysicsEventRecord::TRIGGER_EXIT: {
+        bool enter = record.kind == PhysicsEventRecord::TRIGGER_ENTER;
+        GameObject* otherObject = getGameObject(record.other);
+        if (receiverObject && otherObject) {
+            for (ScriptExecutor* script : receiverScripts) {
+                if (enter) script->onTriggerEnter(otherObject);
+                else script->onTriggerExit(otherObject);
+            }
+        }
+
+        TriggerEvent event;
+        event.type = enter ? TriggerEvent::ENTER : TriggerEvent::EXIT;
+        event.triggerActor = record.receiver;
+        event.otherActor = record.other;
+        processTriggerEvent(event);
+        break;
+    }
+    case PhysicsEventRecord::CONTACT_BEGIN:
+    case PhysicsEventRecord::CONTACT_END: {
+        // Cada lado del contacto llega como un evento propio con su actor de receptor
+        auto it = contactCallbacks.find(record.receiver);
+        if (it == contactCallbacks.end() || !it->second) break;
+
+        ContactEvent event;
+        event.type = record.kind == PhysicsEventRecord::CONTACT_BEGIN ? ContactEvent::BEGIN : ContactEvent::END;
+        event.actor1 = record.receiver;
+        event.actor2 = record.other;
+        event.contactPoint = record.point;
+        event.contactNormal = record.normal;
+        event.contactForce = record.impulse;
+        it->second(event);
+        break;
+    }
     }
 }
 
-PhysicalObject* PhysicsEventHandler::getPhysicalObject(physx::PxActor* actor) {
-    auto it = actorToPhysicalObject.find(actor);
-    return (it != actorToPhysicalObject.end()) ? it->second : nullptr;
+void PhysicsEventHandler::discardActorEvents(const physx::PxActor* actor) {
+    eventQueue.discardActor(actor);
+    PhysicsEventQueue::discardActor(dispatching, actor);
 }
 
 void PhysicsEventHandler::clear() {
     triggerCallbacks.clear();
     contactCallbacks.clear();
-    actorToPhysicalObject.clear();
+    eventQueue.clear();
+    // Si se limpia desde un callback, lo que queda del reparto en curso ya no tiene destino
+    for (PhysicsEventRecord& record : dispatching) {
+        record.receiver = nullptr;
+        record.other = nullptr;
+    }
 } 
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PhysicsEvents.h"
+#include "PhysicsEventQueue.h"
 #include <functional>
 #include <unordered_map>
 #include <vector>
@@ -8,6 +9,8 @@
 
 // Forward declarations
 class PhysicalObject;
+class GameObject;
+class ScriptExecutor;
 
 class PhysicsEventHandler {
 private:
@@ -17,8 +20,13 @@ private:
     // Contact callbacks
     std::unordered_map<physx::PxActor*, std::function<void(const ContactEvent&)>> contactCallbacks;
     
-    // Actor to PhysicalObject mapping
-    std::unordered_map<physx::PxActor*, PhysicalObject*> actorToPhysicalObject;
+    // Eventos encolados por PhysicsEventCallback durante la simulacion
+    PhysicsEventQueue eventQueue;
+    std::vector<PhysicsEventRecord> dispatching;
+    std::vector<ScriptExecutor*> receiverScripts;
+    bool isDispatching = false;
+    
+    void dispatchRecord(const PhysicsEventRecord& record, GameObject* receiverObject);
     
 public:
     PhysicsEventHandler() = default;
@@ -34,11 +42,20 @@ public:
     void unregisterContactCallback(physx::PxActor* actor);
     void processContactEvent(const ContactEvent& event);
     
-    // Actor mapping
-    void registerPhysicalObject(physx::PxActor* actor, PhysicalObject* physicalObject);
-    void unregisterPhysicalObject(physx::PxActor* actor);
-    PhysicalObject* getPhysicalObject(physx::PxActor* actor);
+    // Desde los callbacks de PhysX; no toca componentes ni scripts
+    void queueEvent(const PhysicsEventRecord& record) { eventQueue.push(record); }
+    // Tras fetchResults, en el hilo principal: reparte lo encolado agrupado por receptor
+    // (scripts OnTriggerEnter/Exit y callbacks registrados)
+    void dispatchQueuedEvents();
+    // Antes de liberar un actor, para que ningun evento pendiente apunte a el
+    void discardActorEvents(const physx::PxActor* actor);
+    const PhysicsEventQueue& getEventQueue() const { return eventQueue; }
+    
+    // Actor -> GameObject: Rigidbody, Collider, PhysicalObject y CharacterController guardan su
+    // GameObject en PxActor::userData
+    static GameObject* getGameObject(const physx::PxActor* actor);
+    static PhysicalObject* getPhysicalObject(const physx::PxActor* actor);
     
     // Clear all data
     void clear();
-}; 
\ No newline at end of file
+};
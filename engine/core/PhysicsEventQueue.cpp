@@ -0,0 +1,64 @@
+#include "PhysicsEventQueue.h"
+#include <algorithm>
+
+PhysicsEventQueue::PhysicsEventQueue() {
+    buffer.resize(kDefaultCapacity);
+}
+
+void PhysicsEventQueue::push(const PhysicsEventRecord& record) {
+    size_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    if (index < buffer.size()) {
+        buffer[index] = record;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(overflowMutex);
+    overflow.push_back(record);
+}
+
+size_t PhysicsEventQueue::getBufferedCount() const {
+    return std::min(writeIndex.load(std::memory_order_relaxed), buffer.size());
+}
+
+void PhysicsEventQueue::drain(std::vector<PhysicsEventRecord>& out) {
+    size_t count = getBufferedCount();
+    out.assign(buffer.begin(), buffer.begin() + count);
+    out.insert(out.end(), overflow.begin(), overflow.end());
+    lastDrainCount = out.size();
+
+    // No cupo: crecer hasta el pico con margen para que el siguiente frame no pase por el mutex
+    if (!overflow.empty()) {
+        buffer.resize(out.size() * 3 / 2);
+        overflow.clear();
+    }
+    writeIndex.store(0, std::memory_order_relaxed);
+
+    std::stable_sort(out.begin(), out.end(), [](const PhysicsEventRecord& a, const PhysicsEventRecord& b) {
+        return a.receiver < b.receiver;
+    });
+}
+
+void PhysicsEventQueue::discardActor(const physx::PxActor* actor) {
+    if (!actor) return;
+
+    for (size_t i = 0, count = getBufferedCount(); i < count; i++) {
+        PhysicsEventRecord& record = buffer[i];
+        if (record.receiver == actor) record.receiver = nullptr;
+        if (record.other == actor) record.other = nullptr;
+    }
+    discardActor(overflow, actor);
+}
+
+void PhysicsEventQueue::discardActor(std::vector<PhysicsEventRecord>& records, const physx::PxActor* actor) {
+    if (!actor) return;
+
+    for (PhysicsEventRecord& record : records) {
+        if (record.receiver == actor) record.receiver = nullptr;
+        if (record.other == actor) record.other = nullptr;
+    }
+}
+
+void PhysicsEventQueue::clear() {
+    overflow.clear();
+    writeIndex.store(0, std::memory_order_relaxed);
+}
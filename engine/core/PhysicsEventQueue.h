@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include "PhysicsEvents.h"
+#include "CoreExporter.h"
+
+// Cola de eventos de fisica de un frame. push() solo reserva un hueco con un contador atomico y
+// copia el evento, asi los callbacks de PhysX no bloquean ni reservan memoria. Si el buffer se
+// llena, lo que sobra va a una lista con mutex y el buffer crece en el siguiente drain(), de modo
+// que tras unos frames todo cabe sin bloqueos.
+//
+// push() desde cualquier hilo mientras corre la simulacion; drain() y discardActor() solo desde
+// el principal, con la simulacion recogida.
+class MANTRAXCORE_API PhysicsEventQueue {
+public:
+    PhysicsEventQueue();
+
+    PhysicsEventQueue(const PhysicsEventQueue&) = delete;
+    PhysicsEventQueue& operator=(const PhysicsEventQueue&) = delete;
+
+    void push(const PhysicsEventRecord& record);
+
+    // Mueve lo encolado a out agrupado por receptor (en orden de llegada dentro de cada grupo)
+    // y deja la cola vacia
+    void drain(std::vector<PhysicsEventRecord>& out);
+
+    // El actor se va a liberar: sus eventos pendientes se anulan (receptor) o pierden el otro actor
+    void discardActor(const physx::PxActor* actor);
+    static void discardActor(std::vector<PhysicsEventRecord>& records, const physx::PxActor* actor);
+
+    void clear();
+
+    size_t getCapacity() const { return buffer.size(); }
+    size_t getLastDrainCount() const { return lastDrainCount; }
+
+private:
+    static constexpr size_t kDefaultCapacity = 1024;
+
+    size_t getBufferedCount() const;
+
+    std::vector<PhysicsEventRecord> buffer;
+    std::atomic<size_t> writeIndex{0};
+
+    std::mutex overflowMutex;
+    std::vector<PhysicsEventRecord> overflow;
+
+    size_t lastDrainCount = 0;
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <physx/PxPhysicsAPI.h>
 #include <glm/glm.hpp>
 
@@ -35,6 +36,24 @@ struct ContactEvent {
     float contactForce;
 };
 
+// Evento tal como sale de los callbacks de PhysX: datos planos, sin punteros a componentes. Se
+// encola durante la simulacion y se reparte despues de fetchResults (ver PhysicsEventHandler)
+struct PhysicsEventRecord {
+    enum Kind : uint8_t {
+        TRIGGER_ENTER,
+        TRIGGER_EXIT,
+        CONTACT_BEGIN,
+        CONTACT_END
+    };
+
+    physx::PxActor* receiver = nullptr;   // Trigger o actor que recibe el contacto
+    physx::PxActor* other = nullptr;
+    glm::vec3 point{0.0f};                // Contactos: punto medio y normal del primer punto
+    glm::vec3 normal{0.0f};
+    float impulse = 0.0f;                 // Suma de los impulsos de todos los puntos
+    Kind kind = TRIGGER_ENTER;
+};
+
 // Raycast hit structure
 struct RaycastHit {
     bool hit = false;
@@ -0,0 +1,67 @@
+#include "PhysicsInterpolation.h"
+#include "PhysicsManager.h"
+
+InterpolatedBody::~InterpolatedBody() {
+    stopInterpolation();
+}
+
+void InterpolatedBody::bindPhysicsActor(physx::PxActor* actor) {
+    PhysicsManager::getInstance().bindInterpolatedBody(actor, this);
+}
+
+void InterpolatedBody::stopInterpolation() {
+    if (boundActor || movingIndex != SIZE_MAX) {
+        PhysicsManager::getInstance().unbindInterpolatedBody(this);
+    }
+    hasPoses = false;
+}
+
+void InterpolatedBody::capturePreviousPose() {
+    glm::vec3 position;
+    glm::quat rotation;
+    if (readPhysicsPose(position, rotation)) {
+        previousPosition = position;
+        previousRotation = rotation;
+    }
+}
+
+void InterpolatedBody::captureCurrentPose() {
+    glm::vec3 position;
+    glm::quat rotation;
+    if (!readPhysicsPose(position, rotation)) {
+        return;
+    }
+
+    // Primer paso del cuerpo: todavia no hay pose anterior de la que partir
+    if (!hasPoses) {
+        previousPosition = position;
+        previousRotation = rotation;
+        hasPoses = true;
+    }
+    currentPosition = position;
+    currentRotation = rotation;
+}
+
+void InterpolatedBody::resetInterpolation(const glm::vec3& position, const glm::quat& rotation) {
+    previousPosition = currentPosition = position;
+    previousRotation = currentRotation = rotation;
+    hasPoses = true;
+}
+
+void InterpolatedBody::applyInterpolatedPose() {
+    PhysicsManager& physicsManager = PhysicsManager::getInstance();
+
+    glm::vec3 position;
+    glm::quat rotation;
+    if (!hasPoses || !physicsManager.isInterpolationEnabled()) {
+        if (!readPhysicsPose(position, rotation)) {
+            return;
+        }
+    }
+    else {
+        float alpha = physicsManager.getInterpolationAlpha();
+        position = glm::mix(previousPosition, currentPosition, alpha);
+        rotation = glm::slerp(previousRotation, currentRotation, alpha);
+    }
+    writePhysicsPose(position, rotation);
+}
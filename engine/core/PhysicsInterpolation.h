@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "CoreExporter.h"
+
+namespace physx {
+    class PxActor;
+}
+
+// Cuerpo cuya pose se dibuja interpolada entre los dos ultimos pasos fijos de fisica. PhysicsManager
+// guarda la pose antes y despues del ultimo paso de cada frame y aplica al GameObject la mezcla
+// segun PhysicsManager::getInterpolationAlpha(), asi la fisica puede ir a 30-60 Hz con el render a
+// cualquier frecuencia sin tirones.
+//
+// Solo se sincronizan los cuerpos cuyo actor aparece en los active actors de PhysX (los que se han
+// movido en el paso); los dormidos y los estaticos no cuestan nada por frame. Solo hilo principal.
+class MANTRAXCORE_API InterpolatedBody {
+public:
+    InterpolatedBody() = default;
+    virtual ~InterpolatedBody();
+
+    InterpolatedBody(const InterpolatedBody&) = delete;
+    InterpolatedBody& operator=(const InterpolatedBody&) = delete;
+
+    // Los llama PhysicsManager alrededor del ultimo paso del frame
+    void capturePreviousPose();
+    void captureCurrentPose();
+
+    // Teletransporte: la siguiente pose dibujada es esta, sin mezclar con la anterior
+    void resetInterpolation(const glm::vec3& position, const glm::quat& rotation);
+
+    // Escribe en el GameObject la pose de este frame
+    void applyInterpolatedPose();
+
+protected:
+    // Pose actual en PhysX; false si todavia no hay actor o controlador
+    virtual bool readPhysicsPose(glm::vec3& position, glm::quat& rotation) const = 0;
+    // Lleva la pose al GameObject
+    virtual void writePhysicsPose(const glm::vec3& position, const glm::quat& rotation) = 0;
+
+    // Al crear (o recrear) el actor; sin actor asociado el cuerpo no se sincroniza
+    void bindPhysicsActor(physx::PxActor* actor);
+    // Al liberar el actor (antes de que readPhysicsPose deje de ser valido)
+    void stopInterpolation();
+
+private:
+    friend class PhysicsManager;
+
+    physx::PxActor* boundActor = nullptr;
+    size_t movingIndex = SIZE_MAX;
+    uint64_t lastActiveStep = 0;
+
+    bool hasPoses = false;
+    glm::vec3 previousPosition{0.0f};
+    glm::vec3 currentPosition{0.0f};
+    glm::quat previousRotation{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::quat currentRotation{1.0f, 0.0f, 0.0f, 0.0f};
+};
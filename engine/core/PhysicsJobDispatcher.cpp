@@ -0,0 +1,15 @@
+#include "PhysicsJobDispatcher.h"
+#include "JobSystem.h"
+
+void PhysicsJobDispatcher::submitTask(physx::PxBaseTask& task) {
+    // Igual que PxDefaultCpuDispatcher: la tarea se libera al terminar y eso avisa a sus dependientes.
+    // Solo en trabajadores: simulate() las encola desde el principal y no deben correr en sus wait()
+    JobSystem::getInstance().schedule([&task]() {
+        task.run();
+        task.release();
+    }, nullptr, JobAffinity::Worker);
+}
+
+uint32_t PhysicsJobDispatcher::getWorkerCount() const {
+    return JobSystem::getInstance().getWorkerCount();
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <physx/PxPhysicsAPI.h>
+#include <physx/task/PxCpuDispatcher.h>
+#include "CoreExporter.h"
+
+// PxCpuDispatcher sobre JobSystem: las tareas de PhysX corren en los mismos hilos que el resto
+// del motor en vez de en un pool propio. PhysicsManager lo usa si JobSystem esta inicializado
+class MANTRAXCORE_API PhysicsJobDispatcher : public physx::PxCpuDispatcher {
+public:
+    void submitTask(physx::PxBaseTask& task) override;
+    uint32_t getWorkerCount() const override;
+};
@@ -1,14 +1,89 @@
 #include "PhysicsManager.h"
 #include "PhysicsEventHandler.h"
 #include "PhysicsEventCallback.h"
+#include "PhysicsInterpolation.h"
+#include "MeshCooker.h"
+#include "JobSystem.h"
+#include "PhysicsJobDispatcher.h"
+#include "Time.h"
 #include <physx/PxPhysicsAPI.h>
 #include <physx/extensions/PxDefaultCpuDispatcher.h>
+#include <physx/extensions/PxBroadPhaseExt.h>
 #include <physx/extensions/PxDefaultSimulationFilterShader.h>
 #include <physx/extensions/PxRigidBodyExt.h>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <thread>
 
 PhysicsManager *PhysicsManager::instance = nullptr;
 
+namespace
+{
+    struct ParallelForState
+    {
+        const std::function<void(size_t, size_t)> *work = nullptr;
+        size_t count = 0;
+        size_t grain = 1;
+        std::atomic<size_t> next{0};
+        std::atomic<int> pendingTasks{0};
+
+        void drain()
+        {
+            for (size_t begin = next.fetch_add(grain); begin < count; begin = next.fetch_add(grain))
+            {
+                (*work)(begin, std::min(begin + grain, count));
+            }
+        }
+    };
+
+    // Tarea para el PxDefaultCpuDispatcher: saca tramos hasta que no quedan
+    class ParallelForTask : public physx::PxBaseTask
+    {
+    public:
+        ParallelForState *state = nullptr;
+
+        void run() override { state->drain(); }
+        const char *getName() const override { return "ParallelForTask"; }
+        void addReference() override {}
+        void removeReference() override {}
+        int32_t getReference() const override { return 1; }
+        // Lo ultimo que toca el hilo del dispatcher; despues la tarea puede desaparecer
+        void release() override { state->pendingTasks.fetch_sub(1, std::memory_order_acq_rel); }
+    };
+
+    // Las regiones MBP solo se reparten en XZ; en vertical se estiran para que lo que salta o
+    // cae desde los actores cargados no se salga por arriba o por abajo
+    physx::PxBounds3 padBroadPhaseBounds(physx::PxBounds3 bounds, float margin)
+    {
+        bounds.fattenFast(margin);
+        float verticalPad = std::max(margin * 10.0f, bounds.maximum.y - bounds.minimum.y);
+        bounds.minimum.y -= verticalPad;
+        bounds.maximum.y += verticalPad;
+        return bounds;
+    }
+}
+
+// Objetos que salen de todas las regiones MBP: PhysX deja de calcular sus pares. Llega durante
+// la simulacion, asi que solo cuenta y avisa la primera vez
+class BroadPhaseBoundsCallback : public physx::PxBroadPhaseCallback
+{
+public:
+    std::atomic<uint64_t> outOfBounds{0};
+
+    void onObjectOutOfBounds(physx::PxShape &, physx::PxActor &) override { report(); }
+    void onObjectOutOfBounds(physx::PxAggregate &) override { report(); }
+
+private:
+    void report()
+    {
+        if (outOfBounds.fetch_add(1, std::memory_order_relaxed) == 0)
+        {
+            std::cerr << "[Physics] Object left the MBP broadphase regions; widen worldBounds or call fitBroadPhaseRegions()" << std::endl;
+        }
+    }
+};
+
 // Custom filter shader implementation
 physx::PxFilterFlags CustomFilterShader(
     physx::PxFilterObjectAttributes attributes0, physx::PxFilterData filterData0,
@@ -86,6 +161,7 @@ PhysicsManager::PhysicsManager()
 
     eventHandler = new PhysicsEventHandler();
     eventCallback = new PhysicsEventCallback(eventHandler);
+    broadPhaseCallback = new BroadPhaseBoundsCallback();
 }
 
 PhysicsManager::~PhysicsManager()
@@ -112,6 +188,8 @@ PhysicsManager::~PhysicsManager()
         delete eventHandler;
         eventHandler = nullptr;
     }
+    delete broadPhaseCallback;
+    broadPhaseCallback = nullptr;
     
     std::cout << "PhysicsManager: Destruction completed." << std::endl;
 }
@@ -125,8 +203,10 @@ PhysicsManager &PhysicsManager::getInstance()
     return *instance;
 }
 
-bool PhysicsManager::initialize()
+bool PhysicsManager::initialize(const PhysicsSceneSettings &settings)
 {
+    sceneSettings = settings;
+
     // Initialize PhysX foundation
     foundation = PxCreateFoundation(PX_PHYSICS_VERSION, mDefaultAllocatorCallback, mDefaultErrorCallback);
     if (!foundation)
@@ -151,8 +231,20 @@ bool PhysicsManager::initialize()
         return false;
     }
 
-    // Create CPU dispatcher
-    cpuDispatcher = physx::PxDefaultCpuDispatcherCreate(4);
+    // Create CPU dispatcher: los hilos de JobSystem, compartidos con el resto del motor; sin el,
+    // un hilo por nucleo menos el principal, que sigue con el render
+    if (JobSystem::getInstance().isInitialized())
+    {
+        jobDispatcher = new PhysicsJobDispatcher();
+        cpuDispatcher = jobDispatcher;
+    }
+    else
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        physx::PxU32 workerThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        defaultDispatcher = physx::PxDefaultCpuDispatcherCreate(workerThreads);
+        cpuDispatcher = defaultDispatcher;
+    }
     if (!cpuDispatcher)
     {
         std::cerr << "PxDefaultCpuDispatcherCreate failed!" << std::endl;
@@ -174,6 +266,10 @@ bool PhysicsManager::initialize()
     sceneDesc.kineKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
     sceneDesc.staticKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
 
+    // Broadphase y arboles de consultas
+    applySceneSettings(sceneDesc, sceneSettings);
+    sceneDesc.broadPhaseCallback = broadPhaseCallback;
+
     // Validate scene descriptor
     if (!sceneDesc.isValid())
     {
@@ -192,8 +288,15 @@ bool PhysicsManager::initialize()
         return false;
     }
 
-    // Create controller manager
-    controllerManager = PxCreateControllerManager(*scene);
+    // MBP con limites fijos: regiones desde ya. Sin limites se ajustan al cargar los actores
+    if (!sceneSettings.worldBounds.isEmpty())
+    {
+        fitBroadPhaseRegions(sceneSettings.worldBounds);
+    }
+
+    // Create controller manager. Con locking: CharacterCrowd mueve controllers desde varios hilos a
+    // la vez, y setParallel se puede cambiar en cualquier momento
+    controllerManager = PxCreateControllerManager(*scene, true);
     if (!controllerManager)
     {
         std::cerr << "PxCreateControllerManager failed!" << std::endl;
@@ -320,31 +423,288 @@ bool PhysicsManager::isPVDConnected() const
 
 void PhysicsManager::update(float deltaTime)
 {
-    if (scene)
+    // Por si nadie ha sincronizado desde el frame anterior
+    fetchResults();
+
+    lastSubstepCount = 0;
+    if (!scene)
     {
-        // Debug deltaTime to see if it's reasonable
-        static float lastDebugTime = 0.0f;
-        static float debugAccumulator = 0.0f;
-        debugAccumulator += deltaTime;
-        
-        if (debugAccumulator - lastDebugTime > 1.0f) { // Print every second
-            std::cout << "[PhysicsManager] Average deltaTime: " << (debugAccumulator / 60.0f) << " seconds" << std::endl;
-            lastDebugTime = debugAccumulator;
+        return;
+    }
+
+    float fixedStep = Time::getFixedDeltaTime();
+    if (fixedStep <= 0.0f)
+    {
+        return;
+    }
+
+    // Actores anadidos fuera de las regiones MBP desde el ultimo paso
+    refitPendingBroadPhase();
+
+    stepAccumulator += deltaTime;
+
+    // Espiral de muerte: si simular cuesta mas que el tiempo que avanza, cada frame deberia mas
+    // pasos que el anterior. Se simulan como mucho maxSubsteps y el resto se pierde
+    float maxAccumulated = fixedStep * static_cast<float>(maxSubsteps);
+    if (stepAccumulator > maxAccumulated)
+    {
+        droppedTime += stepAccumulator - maxAccumulated;
+        stepAccumulator = maxAccumulated;
+    }
+
+    int steps = static_cast<int>(stepAccumulator / fixedStep);
+    if (steps > 0)
+    {
+        firstStepOfLaunch = stepCount + 1;
+    }
+
+    for (int i = 0; i < steps; i++)
+    {
+        // Solo interesa la pose de antes del ultimo paso; antes del callback porque los
+        // CharacterController se mueven en el, no en simulate. Los cuerpos quietos ya tienen
+        // la anterior igual a la actual
+        if (i == steps - 1)
+        {
+            for (InterpolatedBody *body : movingBodies)
+            {
+                body->capturePreviousPose();
+            }
         }
-        
-        // Clamp deltaTime to prevent huge physics steps
-        float clampedDeltaTime = std::min(deltaTime, 0.033f); // Max 30 FPS equivalent
-        
-        scene->simulate(clampedDeltaTime);
-        scene->fetchResults(true);
+
+        if (fixedStepCallback)
+        {
+            fixedStepCallback(fixedStep);
+        }
+
+        scene->simulate(fixedStep);
+        stepAccumulator -= fixedStep;
+        stepCount++;
+
+        // Los pasos intermedios se esperan; el ultimo queda en vuelo hasta fetchResults()
+        if (i < steps - 1)
+        {
+            scene->fetchResults(true);
+            collectActiveBodies();
+        }
+        else
+        {
+            simulating = true;
+        }
+    }
+
+    lastSubstepCount = steps;
+    interpolationAlpha = std::min(std::max(stepAccumulator / fixedStep, 0.0f), 1.0f);
+}
+
+void PhysicsManager::fetchResults()
+{
+    if (!simulating)
+    {
+        return;
+    }
+
+    // Los callbacks de contacto y trigger se disparan aqui, en este hilo
+    scene->fetchResults(true);
+    simulating = false;
+    collectActiveBodies();
+
+    // Recorrido hacia atras: los que no se han movido en ninguno de los pasos de este frame se
+    // quedan en su ultima pose y salen de la lista hasta que PhysX los vuelva a mover
+    for (size_t i = movingBodies.size(); i-- > 0;)
+    {
+        InterpolatedBody *body = movingBodies[i];
+        body->captureCurrentPose();
+        if (body->lastActiveStep < firstStepOfLaunch)
+        {
+            body->resetInterpolation(body->currentPosition, body->currentRotation);
+            body->applyInterpolatedPose();
+            removeMovingBody(body);
+        }
+    }
+
+    flushPendingWrites();
+}
+
+void PhysicsManager::collectActiveBodies()
+{
+    physx::PxU32 count = 0;
+    physx::PxActor **activeActors = scene->getActiveActors(count);
+    for (physx::PxU32 i = 0; i < count; i++)
+    {
+        auto it = actorBodies.find(activeActors[i]);
+        if (it == actorBodies.end())
+        {
+            continue;
+        }
+
+        InterpolatedBody *body = it->second;
+        body->lastActiveStep = stepCount;
+        if (body->movingIndex == SIZE_MAX)
+        {
+            body->movingIndex = movingBodies.size();
+            movingBodies.push_back(body);
+        }
+    }
+}
+
+void PhysicsManager::syncTransforms()
+{
+    for (InterpolatedBody *body : movingBodies)
+    {
+        body->applyInterpolatedPose();
+    }
+}
+
+void PhysicsManager::queueWrite(std::function<void()> write)
+{
+    if (!write)
+    {
+        return;
+    }
+
+    if (!simulating)
+    {
+        write();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pendingWritesMutex);
+    pendingWrites.push_back(std::move(write));
+}
+
+void PhysicsManager::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &work)
+{
+    if (count == 0 || !work)
+    {
+        return;
+    }
+
+    fetchResults();
+
+    // Con JobSystem los hilos son los mismos; su parallelFor ademas ayuda con otros trabajos
+    if (JobSystem::getInstance().isInitialized())
+    {
+        JobSystem::getInstance().parallelFor(count, grain, work);
+        return;
+    }
+
+    ParallelForState state;
+    state.work = &work;
+    state.count = count;
+    state.grain = grain > 0 ? grain : 1;
+
+    size_t chunks = (count + state.grain - 1) / state.grain;
+    size_t workers = cpuDispatcher ? std::min<size_t>(cpuDispatcher->getWorkerCount(), chunks - 1) : 0;
+
+    std::vector<ParallelForTask> tasks(workers);
+    state.pendingTasks.store(static_cast<int>(workers));
+    for (ParallelForTask &task : tasks)
+    {
+        task.state = &state;
+        cpuDispatcher->submitTask(task);
+    }
+
+    // Este hilo tambien trabaja; luego espera a las tareas que aun tengan un tramo entre manos
+    state.drain();
+    while (state.pendingTasks.load(std::memory_order_acquire) > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void PhysicsManager::flushPendingWrites()
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingWritesMutex);
+        if (pendingWrites.empty())
+        {
+            return;
+        }
+        applyingWrites.swap(pendingWrites);
+    }
+
+    // En orden de llegada, como si se hubieran hecho en su momento
+    for (auto &write : applyingWrites)
+    {
+        write();
     }
+    applyingWrites.clear();
+}
+
+void PhysicsManager::resetAccumulator()
+{
+    stepAccumulator = 0.0f;
+    interpolationAlpha = 0.0f;
+}
+
+void PhysicsManager::bindInterpolatedBody(physx::PxActor *actor, InterpolatedBody *body)
+{
+    if (!body)
+    {
+        return;
+    }
+
+    unbindInterpolatedBody(body);
+    if (actor)
+    {
+        actorBodies[actor] = body;
+        body->boundActor = actor;
+    }
+}
+
+void PhysicsManager::unbindInterpolatedBody(InterpolatedBody *body)
+{
+    if (!body)
+    {
+        return;
+    }
+
+    if (body->boundActor)
+    {
+        auto it = actorBodies.find(body->boundActor);
+        if (it != actorBodies.end() && it->second == body)
+        {
+            actorBodies.erase(it);
+        }
+        body->boundActor = nullptr;
+    }
+    removeMovingBody(body);
+}
+
+void PhysicsManager::removeMovingBody(InterpolatedBody *body)
+{
+    if (body->movingIndex >= movingBodies.size() || movingBodies[body->movingIndex] != body)
+    {
+        body->movingIndex = SIZE_MAX;
+        return;
+    }
+
+    size_t index = body->movingIndex;
+    movingBodies[index] = movingBodies.back();
+    movingBodies[index]->movingIndex = index;
+    movingBodies.pop_back();
+    body->movingIndex = SIZE_MAX;
 }
 
 void PhysicsManager::cleanup()
 {
+    fetchResults();
+
     // Disconnect PVD
     disconnectPVD();
 
+    for (auto &entry : actorBodies)
+    {
+        entry.second->boundActor = nullptr;
+    }
+    for (InterpolatedBody *body : movingBodies)
+    {
+        body->movingIndex = SIZE_MAX;
+    }
+    actorBodies.clear();
+    movingBodies.clear();
+    resetAccumulator();
+
     // IMPORTANT: Release controller manager BEFORE the scene
     // This is the correct order according to PhysX documentation
     if (controllerManager)
@@ -354,6 +714,13 @@ void PhysicsManager::cleanup()
         controllerManager = nullptr;
     }
 
+    // Lo que quede de un lote sin cerrar muere con la escena
+    actorBatchDepth = 0;
+    batchedStatics.clear();
+    broadPhaseRegions.clear();
+    broadPhaseBounds = physx::PxBounds3::empty();
+    pendingBounds = physx::PxBounds3::empty();
+
     if (scene)
     {
         std::cout << "Releasing scene..." << std::endl;
@@ -363,11 +730,19 @@ void PhysicsManager::cleanup()
     if (cpuDispatcher)
     {
         std::cout << "Releasing CPU dispatcher..." << std::endl;
-        cpuDispatcher->release();
+        if (defaultDispatcher)
+        {
+            defaultDispatcher->release();
+        }
+        delete jobDispatcher;
+        defaultDispatcher = nullptr;
+        jobDispatcher = nullptr;
         cpuDispatcher = nullptr;
     }
     if (physics)
     {
+        MeshCooker::getInstance().clear();
+
         std::cout << "Releasing physics..." << std::endl;
         physics->release();
         physics = nullptr;
@@ -549,27 +924,300 @@ physx::PxShape *PhysicsManager::createPlaneShape(physx::PxMaterial *material)
     return nullptr;
 }
 
+physx::PxShape *PhysicsManager::createTriangleMeshShape(const AssimpGeometry &geometry, const physx::PxVec3 &scale, physx::PxMaterial *material)
+{
+    if (!physics)
+    {
+        return nullptr;
+    }
+
+    physx::PxTriangleMesh *mesh = MeshCooker::getInstance().getTriangleMesh(geometry);
+    if (!mesh)
+    {
+        return nullptr;
+    }
+
+    // La shape toma su propia referencia de la malla; la de la cache sigue en MeshCooker
+    physx::PxTriangleMeshGeometry meshGeometry(mesh, physx::PxMeshScale(scale));
+    physx::PxShape *shape = physics->createShape(meshGeometry, material ? *material : *defaultMaterial, true);
+    if (shape)
+    {
+        shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, true);
+        shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, false);
+        shape->setFlag(physx::PxShapeFlag::eSCENE_QUERY_SHAPE, true);
+        shape->setSimulationFilterData(physx::PxFilterData(0, 0, 0, 0));
+        shape->setQueryFilterData(physx::PxFilterData(0, 0, 0, 0));
+    }
+    return shape;
+}
+
+std::vector<physx::PxShape *> PhysicsManager::createConvexMeshShapes(const AssimpGeometry &geometry, const physx::PxVec3 &scale, const MeshCookingParams &params, physx::PxMaterial *material)
+{
+    std::vector<physx::PxShape *> shapes;
+    if (!physics)
+    {
+        return shapes;
+    }
+
+    for (physx::PxConvexMesh *mesh : MeshCooker::getInstance().getConvexMeshes(geometry, params))
+    {
+        physx::PxConvexMeshGeometry meshGeometry(mesh, physx::PxMeshScale(scale));
+        physx::PxShape *shape = physics->createShape(meshGeometry, material ? *material : *defaultMaterial, true);
+        if (!shape)
+        {
+            continue;
+        }
+
+        shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, true);
+        shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, false);
+        shape->setFlag(physx::PxShapeFlag::eSCENE_QUERY_SHAPE, true);
+        shape->setSimulationFilterData(physx::PxFilterData(0, 0, 0, 0));
+        shape->setQueryFilterData(physx::PxFilterData(0, 0, 0, 0));
+        shapes.push_back(shape);
+    }
+    return shapes;
+}
+
 void PhysicsManager::addActor(physx::PxActor &actor)
 {
     if (scene)
     {
+        fetchResults();
+
+        physx::PxRigidStatic *rigidStatic = actor.is<physx::PxRigidStatic>();
+        if (rigidStatic && actorBatchDepth > 0 && sceneSettings.batchStaticInsertion)
+        {
+            if (std::find(batchedStatics.begin(), batchedStatics.end(), rigidStatic) == batchedStatics.end())
+            {
+                batchedStatics.push_back(rigidStatic);
+            }
+            return;
+        }
+
         scene->addActor(actor);
+        trackActorBounds(actor);
     }
 }
 
 void PhysicsManager::removeActor(physx::PxActor &actor)
 {
-    if (scene)
+    if (!batchedStatics.empty())
+    {
+        batchedStatics.erase(std::remove(batchedStatics.begin(), batchedStatics.end(), actor.is<physx::PxRigidActor>()), batchedStatics.end());
+    }
+    if (scene && actor.getScene())
     {
+        fetchResults();
         scene->removeActor(actor);
     }
+    if (eventHandler)
+    {
+        eventHandler->discardActorEvents(&actor);
+    }
+}
+
+void PhysicsManager::beginActorBatch()
+{
+    actorBatchDepth++;
+}
+
+void PhysicsManager::endActorBatch()
+{
+    if (actorBatchDepth == 0 || --actorBatchDepth > 0)
+    {
+        return;
+    }
+
+    if (scene && !batchedStatics.empty())
+    {
+        fetchResults();
+
+        // El arbol de consultas de los estaticos se construye aqui de una vez y la escena lo
+        // adopta tal cual; la estructura se libera antes que sus actores
+        physx::PxPruningStructure *pruningStructure = nullptr;
+        if (physics)
+        {
+            pruningStructure = physics->createPruningStructure(batchedStatics.data(), static_cast<physx::PxU32>(batchedStatics.size()));
+        }
+
+        bool added = pruningStructure && scene->addActors(*pruningStructure);
+        if (pruningStructure)
+        {
+            pruningStructure->release();
+        }
+        if (!added)
+        {
+            // Sin arbol previo (p. ej. actores sin shapes de consulta): al menos en una llamada
+            std::vector<physx::PxActor *> actors(batchedStatics.begin(), batchedStatics.end());
+            scene->addActors(actors.data(), static_cast<physx::PxU32>(actors.size()));
+        }
+
+        for (physx::PxRigidActor *actor : batchedStatics)
+        {
+            trackActorBounds(*actor);
+        }
+    }
+    batchedStatics.clear();
+
+    refitPendingBroadPhase();
+}
+
+void PhysicsManager::trackActorBounds(const physx::PxActor &actor)
+{
+    // Solo MBP con limites automaticos
+    if (sceneSettings.broadPhase != BroadPhaseType::MBP || !sceneSettings.worldBounds.isEmpty())
+    {
+        return;
+    }
+
+    physx::PxBounds3 bounds = actor.getWorldBounds();
+    if (bounds.isEmpty() || (!broadPhaseBounds.isEmpty() && bounds.isInside(broadPhaseBounds)))
+    {
+        return;
+    }
+    pendingBounds.include(bounds);
+}
+
+void PhysicsManager::refitPendingBroadPhase()
+{
+    if (pendingBounds.isEmpty() || actorBatchDepth > 0)
+    {
+        return;
+    }
+
+    // Las regiones solo crecen: lo que ya cubrian sigue dentro
+    physx::PxBounds3 bounds = padBroadPhaseBounds(pendingBounds, sceneSettings.mbpBoundsMargin);
+    if (!broadPhaseBounds.isEmpty())
+    {
+        bounds.include(broadPhaseBounds);
+    }
+    fitBroadPhaseRegions(bounds);
+}
+
+void PhysicsManager::fitBroadPhaseRegions(const physx::PxBounds3 &bounds)
+{
+    if (!scene || scene->getBroadPhaseType() != physx::PxBroadPhaseType::eMBP)
+    {
+        return;
+    }
+    fetchResults();
+
+    physx::PxBounds3 target = bounds;
+    if (target.isEmpty())
+    {
+        const physx::PxActorTypeFlags types = physx::PxActorTypeFlag::eRIGID_STATIC | physx::PxActorTypeFlag::eRIGID_DYNAMIC;
+        std::vector<physx::PxActor *> actors(scene->getNbActors(types));
+        scene->getActors(types, actors.data(), static_cast<physx::PxU32>(actors.size()));
+        for (physx::PxActor *actor : actors)
+        {
+            physx::PxBounds3 actorBounds = actor->getWorldBounds();
+            if (!actorBounds.isEmpty())
+            {
+                target.include(actorBounds);
+            }
+        }
+        if (target.isEmpty())
+        {
+            return;
+        }
+        target = padBroadPhaseBounds(target, sceneSettings.mbpBoundsMargin);
+    }
+
+    // Las nuevas se anaden (y se pueblan) antes de quitar las viejas para que ningun objeto
+    // quede un momento fuera de todas
+    std::vector<physx::PxU32> previousRegions = std::move(broadPhaseRegions);
+    broadPhaseRegions = createBroadPhaseRegions(*scene, target, sceneSettings.mbpSubdivisions);
+    for (physx::PxU32 handle : previousRegions)
+    {
+        scene->removeBroadPhaseRegion(handle);
+    }
+
+    broadPhaseBounds = target;
+    pendingBounds = physx::PxBounds3::empty();
+}
+
+uint64_t PhysicsManager::getOutOfBoundsCount() const
+{
+    return broadPhaseCallback ? broadPhaseCallback->outOfBounds.load(std::memory_order_relaxed) : 0;
+}
+
+void PhysicsManager::applySceneSettings(physx::PxSceneDesc &sceneDesc, const PhysicsSceneSettings &settings)
+{
+    switch (settings.broadPhase)
+    {
+    case BroadPhaseType::SAP:
+        sceneDesc.broadPhaseType = physx::PxBroadPhaseType::eSAP;
+        break;
+    case BroadPhaseType::MBP:
+        sceneDesc.broadPhaseType = physx::PxBroadPhaseType::eMBP;
+        break;
+    case BroadPhaseType::ABP:
+        sceneDesc.broadPhaseType = physx::PxBroadPhaseType::eABP;
+        break;
+    case BroadPhaseType::PABP:
+        sceneDesc.broadPhaseType = physx::PxBroadPhaseType::ePABP;
+        break;
+    }
+
+    // Al reajustar conviven las regiones viejas y las nuevas
+    if (settings.broadPhase == BroadPhaseType::MBP)
+    {
+        physx::PxU32 subdivisions = std::clamp<physx::PxU32>(settings.mbpSubdivisions, 1, 11);
+        sceneDesc.limits.maxNbRegions = subdivisions * subdivisions * 2;
+    }
+
+    // El arbol estatico puede ser de cualquier tipo; el dinamico no puede ser eSTATIC_AABB_TREE
+    sceneDesc.staticStructure = settings.staticStructure;
+    sceneDesc.dynamicStructure = settings.dynamicStructure == physx::PxPruningStructureType::eSTATIC_AABB_TREE
+        ? physx::PxPruningStructureType::eDYNAMIC_AABB_TREE
+        : settings.dynamicStructure;
+    sceneDesc.dynamicTreeRebuildRateHint = std::max<physx::PxU32>(settings.treeRebuildRateHint, 4);
+}
+
+std::vector<physx::PxU32> PhysicsManager::createBroadPhaseRegions(physx::PxScene &targetScene, const physx::PxBounds3 &bounds, physx::PxU32 subdivisions)
+{
+    std::vector<physx::PxU32> handles;
+    if (targetScene.getBroadPhaseType() != physx::PxBroadPhaseType::eMBP || bounds.isEmpty())
+    {
+        return handles;
+    }
+
+    // Hasta 11x11 para que quepan las viejas y las nuevas durante un reajuste (limite 256)
+    subdivisions = std::clamp<physx::PxU32>(subdivisions, 1, 11);
+    std::vector<physx::PxBounds3> regionBounds(subdivisions * subdivisions);
+    physx::PxU32 count = physx::PxBroadPhaseExt::createRegionsFromWorldBounds(regionBounds.data(), bounds, subdivisions);
+
+    handles.reserve(count);
+    for (physx::PxU32 i = 0; i < count; i++)
+    {
+        physx::PxBroadPhaseRegion region;
+        region.mBounds = regionBounds[i];
+        region.mUserData = nullptr;
+
+        physx::PxU32 handle = targetScene.addBroadPhaseRegion(region, true);
+        if (handle != 0xffffffff)
+        {
+            handles.push_back(handle);
+        }
+    }
+    return handles;
+}
+
+void PhysicsManager::dispatchEvents()
+{
+    if (eventHandler)
+    {
+        eventHandler->dispatchQueuedEvents();
+    }
 }
 
 void PhysicsManager::setGravity(const physx::PxVec3 &gravity)
 {
     if (scene)
     {
-        scene->setGravity(gravity);
+        physx::PxScene *target = scene;
+        queueWrite([target, gravity]()
+                   { target->setGravity(gravity); });
     }
 }
 
@@ -803,6 +1451,7 @@ void PhysicsManager::debugTriggerSetup(physx::PxActor *actor, bool isTrigger)
 void PhysicsManager::forceCleanupAllObjects()
 {
     std::cout << "PhysicsManager: Force cleaning up all objects..." << std::endl;
+    fetchResults();
     
     // Clear event handler to prevent any callbacks during cleanup
     if (eventHandler) {
@@ -835,6 +1484,7 @@ void PhysicsManager::forceCleanupAllObjects()
 
 void PhysicsManager::cleanupScenePhysicsComponents() {
     std::cout << "PhysicsManager: Cleaning up scene physics components..." << std::endl;
+    fetchResults();
     
     // Clear event handler to prevent any callbacks during cleanup
     if (eventHandler) {
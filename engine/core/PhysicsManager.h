@@ -6,9 +6,12 @@
 #include <physx/PxPhysicsAPI.h>
 #include <physx/pvd/PxPvd.h>
 #include "../core/CoreExporter.h"
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 #include <iostream>
+#include <mutex>
 
 // Layer constants (similar to the example)
 #define LAYER_PLAYER 1
@@ -20,6 +23,11 @@
 // Forward declarations
 class PhysicalObject;
 class GameObject;
+class InterpolatedBody;
+class AssimpGeometry;
+struct MeshCookingParams;
+class BroadPhaseBoundsCallback;
+class PhysicsJobDispatcher;
 
 // Collision layers and filters
 enum class CollisionLayer : physx::PxU32 {
@@ -70,6 +78,34 @@ inline CollisionMask operator&(CollisionMask a, CollisionMask b) {
     return static_cast<CollisionMask>(static_cast<physx::PxU32>(a) & static_cast<physx::PxU32>(b));
 }
 
+// Algoritmo de broadphase de la escena; solo se puede elegir al crearla
+enum class BroadPhaseType {
+    SAP,    // Sweep and prune: rapido si casi todo duerme, lento insertando muchos objetos
+    MBP,    // Multi box pruning: regiones fijas sobre los limites del mundo
+    ABP,    // Automatic box pruning: como MBP sin regiones
+    PABP    // ABP en varios hilos (por defecto en PhysX 5)
+};
+
+// Configuracion de la escena de PhysX para PhysicsManager::initialize()
+struct MANTRAXCORE_API PhysicsSceneSettings {
+    BroadPhaseType broadPhase = BroadPhaseType::PABP;
+
+    // MBP: limites del mundo. Vacios = se ajustan solos a los actores (al cerrar cada lote de
+    // actores y antes de simular si se ha anadido alguno fuera)
+    physx::PxBounds3 worldBounds = physx::PxBounds3::empty();
+    physx::PxU32 mbpSubdivisions = 8;    // Regiones por eje en XZ (8 -> 64); como mucho 11
+    float mbpBoundsMargin = 50.0f;       // Holgura alrededor de los actores al ajustar
+
+    // Arboles de consultas. El de estaticos solo se reconstruye al anadir o quitar; el hint son
+    // los pasos que tarda en reconstruirse de fondo, menos = consultas antes al dia tras cargar
+    physx::PxPruningStructureType::Enum staticStructure = physx::PxPruningStructureType::eDYNAMIC_AABB_TREE;
+    physx::PxPruningStructureType::Enum dynamicStructure = physx::PxPruningStructureType::eDYNAMIC_AABB_TREE;
+    physx::PxU32 treeRebuildRateHint = 100;    // Minimo 4
+
+    // En un lote (beginActorBatch) los estaticos entran juntos con su arbol ya construido
+    bool batchStaticInsertion = true;
+};
+
 // Custom filter shader declaration
 physx::PxFilterFlags CustomFilterShader(
     physx::PxFilterObjectAttributes attributes0, physx::PxFilterData filterData0,
@@ -85,7 +121,10 @@ private:
     physx::PxPhysics* physics;
     physx::PxScene* scene;
     physx::PxMaterial* defaultMaterial;
-    physx::PxDefaultCpuDispatcher* cpuDispatcher;
+    // Las tareas de PhysX van a JobSystem si esta en marcha y si no a un pool propio
+    physx::PxCpuDispatcher* cpuDispatcher;
+    physx::PxDefaultCpuDispatcher* defaultDispatcher = nullptr;
+    PhysicsJobDispatcher* jobDispatcher = nullptr;
     
     // Tolerance scale for better physics simulation
     physx::PxTolerancesScale toleranceScale;
@@ -108,6 +147,44 @@ private:
     // Event callback (separate from physics simulation)
     PhysicsEventCallback* eventCallback;
     
+    // Paso fijo
+    float stepAccumulator = 0.0f;
+    float interpolationAlpha = 0.0f;
+    int maxSubsteps = 5;
+    int lastSubstepCount = 0;
+    uint64_t stepCount = 0;
+    float droppedTime = 0.0f;
+    bool interpolationEnabled = true;
+    std::function<void(float)> fixedStepCallback;
+    
+    // Cuerpos por actor y los que PhysX ha movido en los ultimos pasos (active actors)
+    std::unordered_map<const physx::PxActor*, InterpolatedBody*> actorBodies;
+    std::vector<InterpolatedBody*> movingBodies;
+    uint64_t firstStepOfLaunch = 0;
+    
+    void collectActiveBodies();
+    void removeMovingBody(InterpolatedBody* body);
+    
+    // Paso en vuelo entre update() y fetchResults()
+    bool simulating = false;
+    std::mutex pendingWritesMutex;
+    std::vector<std::function<void()>> pendingWrites;
+    std::vector<std::function<void()>> applyingWrites;
+    
+    void flushPendingWrites();
+    
+    // Broadphase y carga por lotes
+    PhysicsSceneSettings sceneSettings;
+    BroadPhaseBoundsCallback* broadPhaseCallback = nullptr;
+    std::vector<physx::PxU32> broadPhaseRegions;
+    physx::PxBounds3 broadPhaseBounds = physx::PxBounds3::empty();
+    physx::PxBounds3 pendingBounds = physx::PxBounds3::empty();    // Actores fuera de las regiones
+    int actorBatchDepth = 0;
+    std::vector<physx::PxRigidActor*> batchedStatics;
+    
+    void trackActorBounds(const physx::PxActor& actor);
+    void refitPendingBroadPhase();
+    
 public:
     PhysicsManager();
     ~PhysicsManager();
@@ -115,10 +192,54 @@ public:
 public:
     static PhysicsManager& getInstance();
     
-    bool initialize();
+    bool initialize(const PhysicsSceneSettings& settings = PhysicsSceneSettings());
+    const PhysicsSceneSettings& getSceneSettings() const { return sceneSettings; }
+    // Vuelca la configuracion en un descriptor (tambien para escenas de prueba como el benchmark)
+    static void applySceneSettings(physx::PxSceneDesc& sceneDesc, const PhysicsSceneSettings& settings);
+    // Rejilla XZ de regiones MBP sobre bounds; devuelve los handles. Sin efecto si no es MBP
+    static std::vector<physx::PxU32> createBroadPhaseRegions(physx::PxScene& targetScene, const physx::PxBounds3& bounds, physx::PxU32 subdivisions);
+    // Acumula deltaTime y simula en pasos de Time::getFixedDeltaTime(), como mucho maxSubsteps por
+    // frame; el tiempo que no cabe se descarta para que un frame lento no arrastre a los siguientes.
+    // El ultimo paso se lanza sin esperar: corre en los hilos del dispatcher mientras se dibuja y
+    // sus resultados se recogen en fetchResults()
     void update(float deltaTime);
+    // Punto de sincronizacion: espera al paso en vuelo, recoge poses y eventos y aplica las
+    // escrituras encoladas. Sin paso en vuelo no hace nada; llamarlo antes de tocar actores
+    void fetchResults();
+    bool isSimulating() const { return simulating; }
+    // Escritura sobre actores (fuerzas, velocidades...): inmediata si no hay paso en vuelo y si no,
+    // encolada hasta fetchResults(). Lo que capture debe seguir vivo hasta entonces; liberar un
+    // actor pasa siempre por fetchResults() antes
+    void queueWrite(std::function<void()> write);
+    // Reparte [0, count) en tramos de grain entre los hilos del dispatcher y este, y vuelve al
+    // terminar todos. Para trabajo de solo lectura sobre la escena (consultas por lotes); sincroniza
+    // antes porque con un paso en vuelo el dispatcher esta ocupado
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& work);
     void cleanup();
     
+    // Paso fijo
+    void setMaxSubsteps(int count) { maxSubsteps = count > 0 ? count : 1; }
+    int getMaxSubsteps() const { return maxSubsteps; }
+    int getLastSubstepCount() const { return lastSubstepCount; }
+    uint64_t getStepCount() const { return stepCount; }
+    float getDroppedTime() const { return droppedTime; }
+    // Fraccion del siguiente paso ya acumulada, en [0, 1): mezcla entre las dos ultimas poses
+    float getInterpolationAlpha() const { return interpolationAlpha; }
+    void resetAccumulator();
+    // Antes de cada paso (SceneManager -> Component::fixedUpdate)
+    void setFixedStepCallback(std::function<void(float)> callback) { fixedStepCallback = std::move(callback); }
+    
+    // Interpolacion de poses para el render (ver InterpolatedBody)
+    void setInterpolationEnabled(bool enabled) { interpolationEnabled = enabled; }
+    bool isInterpolationEnabled() const { return interpolationEnabled; }
+    void bindInterpolatedBody(physx::PxActor* actor, InterpolatedBody* body);
+    void unbindInterpolatedBody(InterpolatedBody* body);
+    // Escribe en los GameObjects la pose de los cuerpos que se mueven, de una pasada; tras fetchResults()
+    void syncTransforms();
+    // Reparte los eventos de trigger y contacto encolados durante los pasos; tras syncTransforms()
+    void dispatchEvents();
+    size_t getMovingBodyCount() const { return movingBodies.size(); }
+    
     // PVD methods
     bool initializePVD();
     void setupPvdFlags();
@@ -132,6 +253,7 @@ public:
     // Getters
     physx::PxScene* getScene() const { return scene; }
     physx::PxPhysics* getPhysics() const { return physics; }
+    physx::PxCpuDispatcher* getCpuDispatcher() const { return cpuDispatcher; }
     PhysicsEventHandler* getEventHandler() const { return eventHandler; }
     PhysicsEventCallback* getEventCallback() const { return eventCallback; }
     
@@ -150,10 +272,26 @@ public:
     physx::PxShape* createSphereShape(float radius, physx::PxMaterial* material = nullptr);
     physx::PxShape* createCapsuleShape(float radius, float halfHeight, physx::PxMaterial* material = nullptr);
     physx::PxShape* createPlaneShape(physx::PxMaterial* material = nullptr);
+    // Mallas cocinadas por MeshCooker (con cache en disco). La triangular solo vale para actores
+    // estaticos o cinematicos; la convexa devuelve una shape por pieza de la descomposicion
+    physx::PxShape* createTriangleMeshShape(const AssimpGeometry& geometry, const physx::PxVec3& scale, physx::PxMaterial* material = nullptr);
+    std::vector<physx::PxShape*> createConvexMeshShapes(const AssimpGeometry& geometry, const physx::PxVec3& scale, const MeshCookingParams& params, physx::PxMaterial* material = nullptr);
     
     // Scene management
     void addActor(physx::PxActor& actor);
     void removeActor(physx::PxActor& actor);
+    // Carga de escena: entre begin y end los estaticos se guardan y entran juntos en un
+    // PxPruningStructure ya construido, en vez de uno a uno en el arbol de consultas. Se puede
+    // anidar; los actores del lote no se deben quitar antes de cerrarlo
+    void beginActorBatch();
+    void endActorBatch();
+    bool isBatchingActors() const { return actorBatchDepth > 0; }
+    // MBP: rehace las regiones sobre bounds, o sobre todos los actores de la escena si esta vacio
+    void fitBroadPhaseRegions(const physx::PxBounds3& bounds = physx::PxBounds3::empty());
+    physx::PxBounds3 getBroadPhaseBounds() const { return broadPhaseBounds; }
+    size_t getBroadPhaseRegionCount() const { return broadPhaseRegions.size(); }
+    // Objetos que han salido de todas las regiones MBP (PhysX deja de detectar sus colisiones)
+    uint64_t getOutOfBoundsCount() const;
     
     // Physics properties
     void setGravity(const physx::PxVec3& gravity);
@@ -0,0 +1,89 @@
+#include "PoolAllocator.h"
+#include <new>
+
+namespace {
+    constexpr size_t kBlockAlignment = 16;
+}
+
+PoolAllocator::PoolAllocator(size_t blockSize, size_t blocksPerChunk)
+    : blockSize((blockSize + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment),
+      blocksPerChunk(blocksPerChunk > 0 ? blocksPerChunk : 1) {
+    if (this->blockSize < sizeof(FreeBlock)) {
+        this->blockSize = kBlockAlignment;
+    }
+}
+
+PoolAllocator::~PoolAllocator() {
+    for (char* chunk : chunks) {
+        ::operator delete(chunk);
+    }
+}
+
+void PoolAllocator::addChunk() {
+    char* chunk = static_cast<char*>(::operator new(blockSize * blocksPerChunk));
+    chunks.push_back(chunk);
+
+    // Enlazados en orden: los primeros bloques que se entregan quedan contiguos
+    for (size_t i = blocksPerChunk; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+        block->next = freeList;
+        freeList = block;
+    }
+}
+
+void* PoolAllocator::allocate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeList) {
+        addChunk();
+    }
+
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    liveBlocks++;
+    totalAllocations++;
+    return block;
+}
+
+void PoolAllocator::deallocate(void* ptr) {
+    if (!ptr) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = freeList;
+    freeList = block;
+    liveBlocks--;
+}
+
+bool PoolAllocator::release() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (liveBlocks > 0) {
+        return false;
+    }
+
+    for (char* chunk : chunks) {
+        ::operator delete(chunk);
+    }
+    chunks.clear();
+    freeList = nullptr;
+    return true;
+}
+
+size_t PoolAllocator::getLiveBlocks() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return liveBlocks;
+}
+
+size_t PoolAllocator::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return chunks.size() * blocksPerChunk;
+}
+
+size_t PoolAllocator::getChunkCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return chunks.size();
+}
+
+size_t PoolAllocator::getTotalAllocations() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalAllocations;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include "CoreExporter.h"
+
+// Bloques de tamaño fijo sacados de chunks contiguos, con lista libre intrusiva. Los bloques
+// liberados se reutilizan sin volver al heap; los chunks solo se devuelven todos juntos con
+// release() (o en el destructor), cuando no queda ningun bloque vivo.
+//
+// Seguro entre hilos (un mutex por pool).
+class MANTRAXCORE_API PoolAllocator {
+public:
+    // blockSize se redondea a multiplo de 16 (alineacion de new)
+    explicit PoolAllocator(size_t blockSize, size_t blocksPerChunk = 32);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* allocate();
+    void deallocate(void* block);
+
+    // Devuelve todos los chunks al heap. false (sin tocar nada) si quedan bloques vivos
+    bool release();
+
+    size_t getBlockSize() const { return blockSize; }
+    size_t getLiveBlocks() const;
+    size_t getCapacity() const;         // Bloques reservados en total
+    size_t getChunkCount() const;
+    size_t getTotalAllocations() const; // Desde la creacion, incluidos los ya liberados
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void addChunk();
+
+    size_t blockSize;
+    size_t blocksPerChunk;
+
+    mutable std::mutex mutex;
+    std::vector<char*> chunks;
+    FreeBlock* freeList = nullptr;
+    size_t liveBlocks = 0;
+    size_t totalAllocations = 0;
+};
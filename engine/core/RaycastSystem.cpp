@@ -1,9 +1,32 @@
 #include "RaycastSystem.h"
 #include "PhysicsManager.h"
+#include "../components/PhysicalObject.h"
+#include <algorithm>
 #include <iostream>
 
 RaycastSystem* RaycastSystem::instance = nullptr;
 
+namespace {
+    physx::PxQueryFilterData makeFilter(physx::PxU32 layerMask) {
+        physx::PxQueryFilterData filterData;
+        filterData.data.word0 = layerMask;
+        filterData.flags = physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC;
+        return filterData;
+    }
+
+    physx::PxVec3 toPx(const glm::vec3& v) {
+        return physx::PxVec3(v.x, v.y, v.z);
+    }
+
+    physx::PxVec3 unitDirection(const glm::vec3& direction) {
+        physx::PxVec3 dir = toPx(direction);
+        dir.normalize();
+        return dir;
+    }
+
+    constexpr size_t kMaxOverlapHits = 256;
+}
+
 RaycastSystem& RaycastSystem::getInstance() {
     if (!instance) {
         instance = new RaycastSystem();
@@ -212,6 +235,103 @@ std::vector<RaycastHit> RaycastSystem::overlapBox(const glm::vec3& center, const
     return hits;
 }
 
+void RaycastSystem::raycastBatch(const RaycastQuery* queries, size_t count, RaycastHit* results) {
+    auto& physicsManager = PhysicsManager::getInstance();
+    physx::PxScene* scene = physicsManager.getScene();
+    if (!scene) {
+        std::fill(results, results + count, RaycastHit());
+        return;
+    }
+
+    physicsManager.parallelFor(count, kBatchGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const RaycastQuery& query = queries[i];
+            physx::PxRaycastBuffer hit;
+            physx::PxQueryFilterData filterData = makeFilter(query.layerMask);
+
+            bool hasHit = scene->raycast(toPx(query.origin), unitDirection(query.direction), query.maxDistance,
+                                         hit, physx::PxHitFlag::eDEFAULT, filterData);
+            results[i] = hasHit && hit.hasBlock ? convertHit(hit.block) : RaycastHit();
+        }
+    });
+}
+
+void RaycastSystem::sweepBatch(const SweepQuery* queries, size_t count, RaycastHit* results) {
+    auto& physicsManager = PhysicsManager::getInstance();
+    physx::PxScene* scene = physicsManager.getScene();
+    if (!scene) {
+        std::fill(results, results + count, RaycastHit());
+        return;
+    }
+
+    physicsManager.parallelFor(count, kBatchGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const SweepQuery& query = queries[i];
+            physx::PxSweepBuffer hit;
+            physx::PxQueryFilterData filterData = makeFilter(query.layerMask);
+            physx::PxTransform pose(toPx(query.origin));
+            physx::PxVec3 dir = unitDirection(query.direction);
+
+            bool hasHit = false;
+            if (query.shape == QueryShape::Box) {
+                physx::PxBoxGeometry boxGeom(query.halfExtents.x, query.halfExtents.y, query.halfExtents.z);
+                hasHit = scene->sweep(boxGeom, pose, dir, query.maxDistance, hit, physx::PxHitFlag::eDEFAULT, filterData);
+            }
+            else {
+                physx::PxSphereGeometry sphereGeom(query.radius);
+                hasHit = scene->sweep(sphereGeom, pose, dir, query.maxDistance, hit, physx::PxHitFlag::eDEFAULT, filterData);
+            }
+            results[i] = hasHit && hit.hasBlock ? convertSweepHit(hit.block) : RaycastHit();
+        }
+    });
+}
+
+void RaycastSystem::overlapBatch(const OverlapQuery* queries, size_t count, RaycastHit* hits, size_t maxHitsPerQuery, uint32_t* hitCounts) {
+    auto& physicsManager = PhysicsManager::getInstance();
+    physx::PxScene* scene = physicsManager.getScene();
+    if (!scene || maxHitsPerQuery == 0) {
+        std::fill(hitCounts, hitCounts + count, 0u);
+        return;
+    }
+
+    physx::PxU32 bufferSize = static_cast<physx::PxU32>(std::min(maxHitsPerQuery, kMaxOverlapHits));
+    physicsManager.parallelFor(count, kBatchGrain, [&](size_t begin, size_t end) {
+        // Un buffer por tramo, en la pila del hilo que lo ejecuta
+        physx::PxOverlapHit hitBuffer[kMaxOverlapHits];
+        for (size_t i = begin; i < end; i++) {
+            const OverlapQuery& query = queries[i];
+            physx::PxOverlapBuffer overlapBuffer(hitBuffer, bufferSize);
+            physx::PxQueryFilterData filterData = makeFilter(query.layerMask);
+            // Sin bloqueo: todos los solapes vuelven como touches
+            filterData.flags |= physx::PxQueryFlag::eNO_BLOCK;
+            physx::PxTransform pose(toPx(query.center));
+
+            if (query.shape == QueryShape::Box) {
+                physx::PxBoxGeometry boxGeom(query.halfExtents.x, query.halfExtents.y, query.halfExtents.z);
+                scene->overlap(boxGeom, pose, overlapBuffer, filterData);
+            }
+            else {
+                physx::PxSphereGeometry sphereGeom(query.radius);
+                scene->overlap(sphereGeom, pose, overlapBuffer, filterData);
+            }
+
+            RaycastHit* out = hits + i * maxHitsPerQuery;
+            for (physx::PxU32 h = 0; h < overlapBuffer.nbTouches; h++) {
+                out[h] = convertOverlapHit(overlapBuffer.touches[h], query.center);
+            }
+            hitCounts[i] = overlapBuffer.nbTouches;
+        }
+    });
+}
+
+GameObject* RaycastSystem::getHitObject(const RaycastHit& hit) {
+    if (!hit.hit || !hit.actor) {
+        return nullptr;
+    }
+
+    return PhysicsEventHandler::getGameObject(hit.actor);
+}
+
 bool RaycastSystem::isPointInCollider(const glm::vec3& point, physx::PxShape* shape, const glm::vec3& shapePosition) {
     if (!shape) return false;
     
@@ -1,10 +1,45 @@
 #pragma once
 #include <physx/PxPhysicsAPI.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 #include "CoreExporter.h"
 #include "PhysicsEvents.h"
 
+class GameObject;
+
+// Consultas por lotes (ver RaycastSystem::raycastBatch). layerMask filtra por la capa del shape
+// (PxFilterData::word0); 0 acepta todas
+struct MANTRAXCORE_API RaycastQuery {
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, 1.0f};
+    float maxDistance = 1000.0f;
+    physx::PxU32 layerMask = 0;
+};
+
+enum class QueryShape {
+    Sphere,
+    Box
+};
+
+struct MANTRAXCORE_API SweepQuery {
+    QueryShape shape = QueryShape::Sphere;
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, 1.0f};
+    float radius = 0.5f;                    // Sphere
+    glm::vec3 halfExtents{0.5f};            // Box
+    float maxDistance = 1000.0f;
+    physx::PxU32 layerMask = 0;
+};
+
+struct MANTRAXCORE_API OverlapQuery {
+    QueryShape shape = QueryShape::Sphere;
+    glm::vec3 center{0.0f};
+    float radius = 0.5f;
+    glm::vec3 halfExtents{0.5f};
+    physx::PxU32 layerMask = 0;
+};
+
 class MANTRAXCORE_API RaycastSystem {
 private:
     static RaycastSystem* instance;
@@ -38,6 +73,19 @@ public:
     std::vector<RaycastHit> overlapSphere(const glm::vec3& center, float radius);
     std::vector<RaycastHit> overlapBox(const glm::vec3& center, const glm::vec3& halfExtents);
     
+    // Lotes: todas las consultas se reparten entre los hilos del dispatcher de PhysX y los
+    // resultados van a buffers del llamador, sin reservar memoria. Desde el hilo principal,
+    // fuera de la simulacion (sincronizan con PhysicsManager::fetchResults())
+    //
+    // results[i] = impacto mas cercano de queries[i] (hit == false si no toca nada)
+    void raycastBatch(const RaycastQuery* queries, size_t count, RaycastHit* results);
+    void sweepBatch(const SweepQuery* queries, size_t count, RaycastHit* results);
+    // Hasta maxHitsPerQuery solapes de queries[i] en hits[i * maxHitsPerQuery ...]; hitCounts[i] dice cuantos
+    void overlapBatch(const OverlapQuery* queries, size_t count, RaycastHit* hits, size_t maxHitsPerQuery, uint32_t* hitCounts);
+
+    // GameObject del actor tocado (PhysicalObject registrado o userData), o nullptr
+    static GameObject* getHitObject(const RaycastHit& hit);
+    
     // Utility methods
     bool isPointInCollider(const glm::vec3& point, physx::PxShape* shape, const glm::vec3& shapePosition);
     float distanceToCollider(const glm::vec3& point, physx::PxShape* shape, const glm::vec3& shapePosition);
@@ -51,4 +99,6 @@ private:
     RaycastHit convertHit(const physx::PxRaycastHit& pxHit);
     RaycastHit convertSweepHit(const physx::PxSweepHit& pxHit);
     RaycastHit convertOverlapHit(const physx::PxOverlapHit& pxHit, const glm::vec3& queryCenter);
+
+    static constexpr size_t kBatchGrain = 32;       // Consultas por tramo de trabajo
 };
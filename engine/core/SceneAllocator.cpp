@@ -0,0 +1,122 @@
+#include "SceneAllocator.h"
+#include <iostream>
+#include <new>
+
+namespace {
+    // Delante de cada bloque; 16 bytes para conservar la alineacion de new
+    struct alignas(16) BlockHeader {
+        PoolAllocator* pool;
+    };
+
+    thread_local SceneAllocator* currentAllocator = nullptr;
+    std::atomic<size_t> unscopedAllocations{0};
+}
+
+SceneAllocator::Scope::Scope(SceneAllocator* allocator) : previous(currentAllocator) {
+    currentAllocator = allocator;
+}
+
+SceneAllocator::Scope::~Scope() {
+    currentAllocator = previous;
+}
+
+SceneAllocator* SceneAllocator::current() {
+    return currentAllocator;
+}
+
+size_t SceneAllocator::getUnscopedAllocations() {
+    return unscopedAllocations.load(std::memory_order_relaxed);
+}
+
+PoolAllocator* SceneAllocator::poolFor(size_t size) {
+    size_t index = (size + kSizeClass - 1) / kSizeClass - 1;
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    if (!pools[index]) {
+        pools[index] = std::make_unique<PoolAllocator>((index + 1) * kSizeClass);
+    }
+    return pools[index].get();
+}
+
+void* SceneAllocator::allocate(size_t size) {
+    size_t total = size + sizeof(BlockHeader);
+    SceneAllocator* allocator = currentAllocator;
+
+    BlockHeader* header = nullptr;
+    if (allocator && total <= kMaxPooledSize) {
+        PoolAllocator* pool = allocator->poolFor(total);
+        header = static_cast<BlockHeader*>(pool->allocate());
+        header->pool = pool;
+    }
+    else {
+        if (allocator) {
+            allocator->heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        else {
+            unscopedAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        header = static_cast<BlockHeader*>(::operator new(total));
+        header->pool = nullptr;
+    }
+    return header + 1;
+}
+
+void SceneAllocator::deallocate(void* ptr) {
+    if (!ptr) return;
+
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    if (header->pool) {
+        header->pool->deallocate(header);
+    }
+    else {
+        ::operator delete(header);
+    }
+}
+
+bool SceneAllocator::release() {
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    bool released = true;
+    for (auto& pool : pools) {
+        if (pool && !pool->release()) {
+            released = false;
+        }
+    }
+    return released;
+}
+
+bool SceneAllocator::hasLiveObjects() const {
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    for (const auto& pool : pools) {
+        if (pool && pool->getLiveBlocks() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SceneAllocatorStats SceneAllocator::getStats() const {
+    SceneAllocatorStats stats;
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    for (const auto& pool : pools) {
+        if (!pool) continue;
+
+        size_t live = pool->getLiveBlocks();
+        size_t capacity = pool->getCapacity();
+        stats.liveBlocks += live;
+        stats.capacityBlocks += capacity;
+        stats.chunks += pool->getChunkCount();
+        stats.usedBytes += live * pool->getBlockSize();
+        stats.reservedBytes += capacity * pool->getBlockSize();
+        stats.pooledAllocations += pool->getTotalAllocations();
+    }
+    stats.heapAllocations = heapAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SceneAllocator::logStats(const std::string& label) const {
+    SceneAllocatorStats stats = getStats();
+    std::cout << "SceneAllocator [" << label << "]: " << stats.liveBlocks << " live objects in "
+              << stats.chunks << " chunks (" << stats.usedBytes / 1024 << " / " << stats.reservedBytes / 1024
+              << " KB, fragmentation " << static_cast<int>(stats.fragmentation() * 100.0f) << "%), "
+              << stats.pooledAllocations << " pooled allocations, " << stats.heapAllocations
+              << " too large for a pool, " << getUnscopedAllocations() << " outside any scene" << std::endl;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "CoreExporter.h"
+#include "PoolAllocator.h"
+
+struct MANTRAXCORE_API SceneAllocatorStats {
+    size_t liveBlocks = 0;
+    size_t capacityBlocks = 0;
+    size_t chunks = 0;
+    size_t usedBytes = 0;
+    size_t reservedBytes = 0;
+    size_t pooledAllocations = 0;       // Desde la creacion
+    size_t heapAllocations = 0;         // Demasiado grandes para un pool
+
+    // Parte de la memoria reservada que no ocupa ningun objeto vivo
+    float fragmentation() const {
+        return reservedBytes > 0 ? 1.0f - static_cast<float>(usedBytes) / static_cast<float>(reservedBytes) : 0.0f;
+    }
+};
+
+// Memoria de los GameObjects y componentes de una escena: pools por clase de tamaño (multiplos de
+// 64 bytes) en chunks contiguos, en lugar de un bloque de heap por objeto. Los operator new de
+// GameObject y Component usan el SceneAllocator activo en el hilo (ver Scope); sin ninguno van al
+// heap como antes. Cada bloque recuerda su pool, asi que delete funciona desde cualquier sitio.
+//
+// Scene::cleanup() borra los objetos y devuelve los chunks de golpe con release().
+class MANTRAXCORE_API SceneAllocator {
+public:
+    SceneAllocator() = default;
+    ~SceneAllocator() = default;
+
+    SceneAllocator(const SceneAllocator&) = delete;
+    SceneAllocator& operator=(const SceneAllocator&) = delete;
+
+    // Activa allocator en este hilo mientras vive el Scope (anidable)
+    class MANTRAXCORE_API Scope {
+    public:
+        explicit Scope(SceneAllocator* allocator);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        SceneAllocator* previous;
+    };
+
+    static SceneAllocator* current();
+
+    // Para los operator new/delete de GameObject y Component
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr);
+
+    // Reservas hechas sin ningun SceneAllocator activo (editor, hilos sin Scope)
+    static size_t getUnscopedAllocations();
+
+    // Devuelve los chunks de todos los pools vacios; false si queda algun objeto vivo
+    bool release();
+    bool hasLiveObjects() const;
+
+    SceneAllocatorStats getStats() const;
+    void logStats(const std::string& label) const;
+
+private:
+    static constexpr size_t kSizeClass = 64;
+    static constexpr size_t kMaxPooledSize = 4096;
+    static constexpr size_t kPoolCount = kMaxPooledSize / kSizeClass;
+
+    PoolAllocator* poolFor(size_t size);
+
+    mutable std::mutex poolsMutex;
+    std::unique_ptr<PoolAllocator> pools[kPoolCount];
+    std::atomic<size_t> heapAllocations{0};
+};
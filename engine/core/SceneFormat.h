@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Formato binario de escena (.scene v2)
+//
+// [SceneFileHeader][SceneChunkEntry x chunkCount][chunks, cada uno alineado a 8 bytes]
+//
+// Chunks:
+//   STRS  tabla de strings (UTF-8 sin terminador; se referencian con SceneStringRef)
+//   META  camara, settings y tiles en CBOR
+//   OBJS  SceneObjectRecord x N (layout fijo, transform incluido)
+//   COMP  SceneComponentRecord x M (los de cada objeto son contiguos)
+//   BLOB  datos de cada componente en CBOR
+//
+// Las escenas JSON (v1) siguen siendo validas como formato de intercambio; ver SceneConverter.
+
+static const char SCENE_FILE_MAGIC[4] = { 'M', 'S', 'C', 'N' };
+static const uint32_t SCENE_FILE_VERSION = 1;
+
+inline constexpr uint32_t SceneChunkId(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+}
+
+static const uint32_t SCENE_CHUNK_STRINGS = SceneChunkId('S', 'T', 'R', 'S');
+static const uint32_t SCENE_CHUNK_META = SceneChunkId('M', 'E', 'T', 'A');
+static const uint32_t SCENE_CHUNK_OBJECTS = SceneChunkId('O', 'B', 'J', 'S');
+static const uint32_t SCENE_CHUNK_COMPONENTS = SceneChunkId('C', 'O', 'M', 'P');
+static const uint32_t SCENE_CHUNK_BLOBS = SceneChunkId('B', 'L', 'O', 'B');
+
+// Tipos conocidos; un tipo no listado se guarda como Unknown con su nombre en typeName
+enum class SceneComponentType : uint32_t {
+    Unknown = 0,
+    ScriptExecutor = 1,
+    LightComponent = 2,
+    AudioSource = 3,
+    PhysicalObject = 4,
+    CharacterController = 5,
+    SpriteAnimator = 6,
+    Collider = 7,
+    Rigidbody = 8
+};
+
+struct SceneFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t chunkCount;
+    uint32_t reserved0;
+    uint64_t fileSize;
+    uint64_t reserved1;
+};
+static_assert(sizeof(SceneFileHeader) == 32, "SceneFileHeader debe ocupar 32 bytes");
+
+struct SceneChunkEntry {
+    uint32_t id;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+};
+static_assert(sizeof(SceneChunkEntry) == 24, "SceneChunkEntry debe ocupar 24 bytes");
+
+struct SceneStringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+enum SceneObjectFlags : uint32_t {
+    SceneObjectHasMaterial = 1u << 0
+};
+
+struct SceneObjectRecord {
+    SceneStringRef name;
+    SceneStringRef tag;
+    SceneStringRef objectID;
+    SceneStringRef parentID;        // Vacio si no tiene padre
+    SceneStringRef modelPath;
+    SceneStringRef materialName;
+    int32_t parentIndex;            // Indice en OBJS, -1 si no tiene padre o no esta en la escena
+    uint32_t flags;                 // SceneObjectFlags
+    float position[3];              // Mundo
+    float rotation[3];              // Euler mundo (grados)
+    float scale[3];                 // Local
+    uint32_t firstComponent;
+    uint32_t componentCount;
+    uint32_t reserved;
+};
+static_assert(sizeof(SceneObjectRecord) == 104, "SceneObjectRecord debe ocupar 104 bytes");
+
+enum SceneComponentFlags : uint32_t {
+    SceneComponentEnabled = 1u << 0
+};
+
+struct SceneComponentRecord {
+    uint32_t type;                  // SceneComponentType
+    uint32_t flags;                 // SceneComponentFlags
+    SceneStringRef typeName;
+    uint64_t blobOffset;            // Dentro del chunk BLOB
+    uint64_t blobSize;
+};
+static_assert(sizeof(SceneComponentRecord) == 32, "SceneComponentRecord debe ocupar 32 bytes");
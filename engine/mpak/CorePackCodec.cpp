@@ -0,0 +1,218 @@
+#include "CorePackCodec.h"
+#include <cstring>
+
+namespace {
+    const size_t LZ4_MIN_MATCH = 4;
+    const size_t LZ4_LAST_LITERALS = 5;     // Los ultimos 5 bytes siempre son literales
+    const size_t LZ4_MF_LIMIT = 12;         // Un match no puede empezar en los ultimos 12 bytes
+    const size_t LZ4_MAX_OFFSET = 65535;
+    const int LZ4_HASH_BITS = 16;
+
+    struct Crc32Table {
+        uint32_t values[256];
+
+        Crc32Table() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                }
+                values[i] = c;
+            }
+        }
+    };
+
+    inline uint32_t read32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint32_t hashSequence(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+    }
+
+    inline void writeLength(uint8_t*& op, size_t length) {
+        while (length >= 255) {
+            *op++ = 255;
+            length -= 255;
+        }
+        *op++ = static_cast<uint8_t>(length);
+    }
+
+    inline void emitLiterals(uint8_t*& op, uint8_t* token, const uint8_t* literals, size_t literalLength) {
+        if (literalLength >= 15) {
+            *token = 15 << 4;
+            writeLength(op, literalLength - 15);
+        }
+        else {
+            *token = static_cast<uint8_t>(literalLength << 4);
+        }
+        std::memcpy(op, literals, literalLength);
+        op += literalLength;
+    }
+}
+
+uint32_t CorePackCodec::Crc32(const void* data, size_t size, uint32_t previous) {
+    static const Crc32Table table;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t crc = previous ^ 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table.values[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+uint64_t CorePackCodec::Hash64(const void* data, size_t size, uint64_t previous) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = previous;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t CorePackCodec::LZ4CompressBound(size_t inputSize) {
+    return inputSize + inputSize / 255 + 16;
+}
+
+bool CorePackCodec::LZ4Compress(const char* input, size_t inputSize, std::vector<char>& output) {
+    output.resize(LZ4CompressBound(inputSize));
+
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(input);
+    const uint8_t* ip = src;
+    const uint8_t* anchor = src;
+    const uint8_t* iend = src + inputSize;
+    uint8_t* op = reinterpret_cast<uint8_t*>(output.data());
+
+    if (inputSize > LZ4_MF_LIMIT) {
+        const uint8_t* mflimit = iend - LZ4_MF_LIMIT;
+        const uint8_t* matchlimit = iend - LZ4_LAST_LITERALS;
+
+        // Posicion + 1 de la ultima aparicion de cada secuencia de 4 bytes (0 = vacio)
+        std::vector<uint32_t> table(size_t(1) << LZ4_HASH_BITS, 0);
+
+        while (ip < mflimit) {
+            uint32_t sequence = read32(ip);
+            uint32_t h = hashSequence(sequence);
+            uint32_t candidate = table[h];
+            table[h] = static_cast<uint32_t>(ip - src) + 1;
+
+            if (candidate == 0) {
+                ip++;
+                continue;
+            }
+
+            const uint8_t* match = src + (candidate - 1);
+            if (static_cast<size_t>(ip - match) > LZ4_MAX_OFFSET || read32(match) != sequence) {
+                ip++;
+                continue;
+            }
+
+            // Extender hacia atras mientras coincida
+            while (ip > anchor && match > src && ip[-1] == match[-1]) {
+                ip--;
+                match--;
+            }
+
+            // Extender hacia delante
+            size_t matchLength = LZ4_MIN_MATCH;
+            while (ip + matchLength < matchlimit && ip[matchLength] == match[matchLength]) {
+                matchLength++;
+            }
+
+            uint8_t* token = op++;
+            emitLiterals(op, token, anchor, static_cast<size_t>(ip - anchor));
+
+            uint16_t offset = static_cast<uint16_t>(ip - match);
+            *op++ = static_cast<uint8_t>(offset & 0xFF);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+
+            size_t encodedLength = matchLength - LZ4_MIN_MATCH;
+            if (encodedLength >= 15) {
+                *token |= 15;
+                writeLength(op, encodedLength - 15);
+            }
+            else {
+                *token |= static_cast<uint8_t>(encodedLength);
+            }
+
+            ip += matchLength;
+            anchor = ip;
+        }
+    }
+
+    // Ultima secuencia: solo literales
+    uint8_t* token = op++;
+    emitLiterals(op, token, anchor, static_cast<size_t>(iend - anchor));
+
+    size_t compressedSize = static_cast<size_t>(op - reinterpret_cast<uint8_t*>(output.data()));
+    if (compressedSize >= inputSize) {
+        output.clear();
+        return false;
+    }
+
+    output.resize(compressedSize);
+    return true;
+}
+
+bool CorePackCodec::LZ4Decompress(const char* input, size_t inputSize, char* output, size_t outputSize) {
+    const uint8_t* ip = reinterpret_cast<const uint8_t*>(input);
+    const uint8_t* iend = ip + inputSize;
+    uint8_t* op = reinterpret_cast<uint8_t*>(output);
+    uint8_t* dst = op;
+    uint8_t* oend = op + outputSize;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) return false;
+                b = *ip++;
+                literalLength += b;
+            } while (b == 255);
+        }
+
+        if (literalLength > static_cast<size_t>(iend - ip) || literalLength > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+        std::memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // La ultima secuencia no lleva match
+        if (ip >= iend) break;
+
+        if (iend - ip < 2) return false;
+        size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) return false;
+                b = *ip++;
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += LZ4_MIN_MATCH;
+
+        if (matchLength > static_cast<size_t>(oend - op)) return false;
+
+        // Copia byte a byte: el match puede solaparse con la salida
+        const uint8_t* match = op - offset;
+        for (size_t i = 0; i < matchLength; ++i) {
+            op[i] = match[i];
+        }
+        op += matchLength;
+    }
+
+    return op == oend;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "../core/CoreExporter.h"
+
+// CRC32 y compresion LZ4 (formato de bloque) para las entradas del CorePack.
+// Implementacion propia para no depender de librerias externas.
+class MANTRAXCORE_API CorePackCodec {
+public:
+    static uint32_t Crc32(const void* data, size_t size, uint32_t previous = 0);
+
+    // Hash de contenido de 64 bits (FNV-1a); junto con CRC32 y tamano identifica duplicados
+    static uint64_t Hash64(const void* data, size_t size, uint64_t previous = 14695981039346656037ull);
+
+    static size_t LZ4CompressBound(size_t inputSize);
+
+    // Devuelve false si la entrada no es comprimible (la salida queda vacia)
+    static bool LZ4Compress(const char* input, size_t inputSize, std::vector<char>& output);
+
+    // output debe tener exactamente el tamano original
+    static bool LZ4Decompress(const char* input, size_t inputSize, char* output, size_t outputSize);
+};
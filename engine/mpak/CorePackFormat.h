@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Formato MantraxCorePack v2
+//
+// [CorePackHeaderV2][CorePackEntryV2 x entryCount (ordenadas por nameHash)][tabla de nombres]
+// [padding hasta alignment][datos de cada entrada, cada una alineada a alignment]
+//
+// v1 (legacy) empieza directamente con un uint32 con el numero de archivos, seguido de
+// entradas de nombre fijo (100 chars) y los datos sin alinear.
+
+static const char CORE_PACK_MAGIC[4] = { 'M', 'C', 'P', '2' };
+static const uint32_t CORE_PACK_VERSION = 2;
+static const uint32_t CORE_PACK_DEFAULT_ALIGNMENT = 4096;
+
+enum class CorePackCompression : uint32_t {
+    None = 0,
+    LZ4 = 1
+};
+
+struct CorePackHeaderV2 {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t alignment;
+    uint64_t tocOffset;
+    uint64_t stringTableOffset;
+    uint64_t stringTableSize;
+    uint32_t tocCrc;            // CRC32 de la TOC + tabla de nombres
+    uint32_t reserved[5];
+};
+static_assert(sizeof(CorePackHeaderV2) == 64, "CorePackHeaderV2 debe ocupar 64 bytes");
+
+struct CorePackEntryV2 {
+    uint64_t nameHash;          // FNV-1a 64 del nombre normalizado
+    uint64_t offset;            // Alineado a header.alignment
+    uint64_t storedSize;        // Bytes en el pack
+    uint64_t size;              // Bytes originales
+    uint32_t nameOffset;        // Dentro de la tabla de nombres
+    uint32_t nameLength;
+    uint32_t crc;               // CRC32 de los datos originales
+    uint32_t compression;       // CorePackCompression
+};
+static_assert(sizeof(CorePackEntryV2) == 48, "CorePackEntryV2 debe ocupar 48 bytes");
+
+// Vista sin copia sobre los datos de una entrada del pack mapeado
+struct CorePackView {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    bool empty() const { return size == 0; }
+    const char* begin() const { return data; }
+    const char* end() const { return data + size; }
+};
+
+namespace CorePack {
+    // Los nombres se guardan con '/' como separador para que la busqueda no dependa del SO
+    inline std::string NormalizeName(const std::string& name) {
+        std::string normalized = name;
+        for (char& c : normalized) {
+            if (c == '\\') c = '/';
+        }
+        return normalized;
+    }
+
+    inline uint64_t HashName(const char* data, size_t length) {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < length; ++i) {
+            char c = data[i] == '\\' ? '/' : data[i];
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    inline uint64_t HashName(const std::string& name) {
+        return HashName(name.data(), name.size());
+    }
+
+    inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+        if (alignment <= 1) return value;
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
@@ -32,7 +32,7 @@ public:
                 if (obj)
                 {
                     std::string newName = node->GetInputValue<std::string>(2, "Hello");
-                    obj->Name = newName;
+                    obj->setName(newName);
                     node->SetOutputValue<std::string>(1, obj->Name);
                     std::cout << "GameObject renamed to: " << newName << std::endl;
                 }
@@ -63,7 +63,7 @@ public:
                 if (obj)
                 {
                     std::string newName = node->GetInputValue<std::string>(2, "Default");
-                    obj->Tag = newName;
+                    obj->setTag(newName);
                     node->SetOutputValue<std::string>(1, obj->Tag);
                     std::cout << "GameObject renamed to: " << newName << std::endl;
                 }
@@ -571,21 +571,63 @@ public:
             {
                 std::string targetName = node->GetInputValue<std::string>(1, "");
 
-                auto &gameObjects = SceneManager::getInstance().getActiveScene()->getGameObjects();
-                GameObject *foundObj = nullptr;
+                // Indice por nombre de la escena, sin recorrer sus objetos
+                Scene *scene = SceneManager::getInstance().getActiveScene();
+                GameObject *foundObj = scene ? scene->findByName(targetName) : nullptr;
 
-                for (auto *obj : gameObjects)
+                if (!foundObj)
                 {
-                    if (obj && obj->Name == targetName)
-                    {
-                        foundObj = obj;
-                        break; // encontramos el primero que coincide
-                    }
+                    std::cout << "GameObject with name \"" << targetName << "\" not found!" << std::endl;
+                }
+
+                node->SetOutputValue<GameObject *>(1, foundObj);
+            },
+            SCRIPT,                              // CATEGORY
+            true,                                // EXECUTE PIN INPUT
+            true,                                // EXECUTE PIN OUT
+            {{"Name", std::string("")}},         // INPUT PINS
+            {{"Object", (GameObject *)nullptr}}, // OUTPUT PINS
+            position                             // PIN POSITION
+        );
+
+        PremakeNode findObjectByTagNode(
+            "Object",
+            "Find Object By Tag",
+            [](CustomNode *node)
+            {
+                std::string targetTag = node->GetInputValue<std::string>(1, "");
+
+                Scene *scene = SceneManager::getInstance().getActiveScene();
+                GameObject *foundObj = scene ? scene->findByTag(targetTag) : nullptr;
+
+                if (!foundObj)
+                {
+                    std::cout << "GameObject with tag \"" << targetTag << "\" not found!" << std::endl;
                 }
 
+                node->SetOutputValue<GameObject *>(1, foundObj);
+            },
+            SCRIPT,                              // CATEGORY
+            true,                                // EXECUTE PIN INPUT
+            true,                                // EXECUTE PIN OUT
+            {{"Tag", std::string("")}},          // INPUT PINS
+            {{"Object", (GameObject *)nullptr}}, // OUTPUT PINS
+            position                             // PIN POSITION
+        );
+
+        PremakeNode findObjectByIDNode(
+            "Object",
+            "Find Object By ID",
+            [](CustomNode *node)
+            {
+                std::string targetID = node->GetInputValue<std::string>(1, "");
+
+                Scene *scene = SceneManager::getInstance().getActiveScene();
+                GameObject *foundObj = scene ? scene->findByID(targetID) : nullptr;
+
                 if (!foundObj)
                 {
-                    std::cout << "GameObject with name \"" << targetName << "\" not found!" << std::endl;
+                    std::cout << "GameObject with ID \"" << targetID << "\" not found!" << std::endl;
                 }
 
                 node->SetOutputValue<GameObject *>(1, foundObj);
@@ -593,7 +635,7 @@ public:
             SCRIPT,                              // CATEGORY
             true,                                // EXECUTE PIN INPUT
             true,                                // EXECUTE PIN OUT
-            {{"Name", std::string("")}},         // INPUT PINS
+            {{"ID", std::string("")}},           // INPUT PINS
             {{"Object", (GameObject *)nullptr}}, // OUTPUT PINS
             position                             // PIN POSITION
         );
@@ -746,7 +788,7 @@ public:
 
                 if (object != nullptr)
                 {
-                    object->destroy();
+                    SceneManager::getInstance().destroyGameObject(object);
                 }
             },
             SCRIPT,                              // CATEGORY
@@ -759,6 +801,8 @@ public:
 
         engine.PrefabNodes.push_back(thisObject);
         engine.PrefabNodes.push_back(findObjectByNameNode);
+        engine.PrefabNodes.push_back(findObjectByTagNode);
+        engine.PrefabNodes.push_back(findObjectByIDNode);
         engine.PrefabNodes.push_back(findObjectNode);
 
         engine.PrefabNodes.push_back(setParentNode);
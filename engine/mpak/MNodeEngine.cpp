@@ -11,12 +11,16 @@
 #include "DescomposerNode.h"
 #include "AudioNode.h"
 #include "RigidBodyNode.h"
+#include "PoolNodes.h"
+#include "QueryNodes.h"
+#include <atomic>
 
-static int NodeID = 0;
+// Los GameObject se pueden construir desde varios hilos al cargar una escena
+static std::atomic<int> NodeID{0};
 
 void CustomNode::SetupNode()
 {
-    n.id = NodeID;
+    n.id = NodeID++;
     nodeId = n.id;
     n.pos = ImVec2(50, 100);
     n.size = ImVec2(400, 80);
@@ -35,7 +39,6 @@ void CustomNode::SetupNode()
     {
         std::cout << "Custom Node [" << node->id << "]: " << node->data << std::endl;
     };
-    NodeID++;
 }
 
 MNodeEngine::MNodeEngine(GameObject *obj)
@@ -53,6 +56,8 @@ MNodeEngine::MNodeEngine(GameObject *obj)
     AudioNode *NodeAudio = new AudioNode();
     DescomposerNode *NodeDescomposer = new DescomposerNode();
     RigidBodyNode *NodeRigidbody = new RigidBodyNode();
+    PoolNodes *NodePool = new PoolNodes();
+    QueryNodes *NodeQuery = new QueryNodes();
 
     NodesGM->RegisterNodes(*this);
     NodesDB->RegisterNodes(*this);
@@ -65,6 +70,8 @@ MNodeEngine::MNodeEngine(GameObject *obj)
     NodeAudio->RegisterNodes(*this);
     NodeDescomposer->RegisterNodes(*this);
     NodeRigidbody->RegisterNodes(*this);
+    NodePool->RegisterNodes(*this);
+    NodeQuery->RegisterNodes(*this);
 }
 
 // Lambda Factory para crear nodos de manera simple (Nueva versión con NodeCategory)
@@ -628,8 +635,8 @@ void MNodeEngine::ExecuteFrom(CustomNode *d)
         int start = d->GetInputValue<int>(1, 0);
         int end = d->GetInputValue<int>(2, 0);
 
-        std::vector<Connection> loopBodyConns;
-        std::vector<Connection> completedConns;
+        FrameVector<Connection> loopBodyConns;
+        FrameVector<Connection> completedConns;
 
         for (auto &c : connections)
         {
@@ -669,19 +676,21 @@ void MNodeEngine::EvaluateDataDependencies(CustomNode *node)
     if (!node)
         return;
 
-    std::set<int> visited;
+    // Scratch del frame: se evalua en cada ejecucion del grafo
+    FrameVector<int> visited;
+    visited.reserve(customNodes.size());
     EvaluateDataDependenciesRecursive(node, visited);
 }
 
 // NUEVO: Evaluación recursiva de dependencias
-void MNodeEngine::EvaluateDataDependenciesRecursive(CustomNode *node, std::set<int> &visited)
+void MNodeEngine::EvaluateDataDependenciesRecursive(CustomNode *node, FrameVector<int> &visited)
 {
-    if (!node || visited.find(node->n.id) != visited.end())
+    if (!node || std::find(visited.begin(), visited.end(), node->n.id) != visited.end())
     {
         return; // Ya procesado o nulo
     }
 
-    visited.insert(node->n.id);
+    visited.push_back(node->n.id);
 
     // Primero, evaluar todas las dependencias de datos de este nodo
     for (const auto &connection : connections)
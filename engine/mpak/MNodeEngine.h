@@ -14,6 +14,7 @@
 #include <queue>
 #include "../components/GameObject.h"
 #include "../core/CoreExporter.h"
+#include "../core/FrameAllocator.h"
 
 inline ImVec2 operator+(const ImVec2 &a, const ImVec2 &b) { return ImVec2(a.x + b.x, a.y + b.y); }
 inline ImVec2 operator-(const ImVec2 &a, const ImVec2 &b) { return ImVec2(a.x - b.x, a.y - b.y); }
@@ -528,7 +529,7 @@ public:
 
     void EvaluateDataDependencies(CustomNode *node);
     // NUEVO: Evaluación recursiva de dependencias
-    void EvaluateDataDependenciesRecursive(CustomNode *node, std::set<int> &visited);
+    void EvaluateDataDependenciesRecursive(CustomNode *node, FrameVector<int> &visited);
 
     void ExecuteGraph();
     void ExecuteGraphOnTick();
@@ -0,0 +1,145 @@
+#include "MantraxCorePackBenchmark.h"
+#include "MantraxCorePackBuilder.h"
+#include "MantraxCorePackReader.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    uint64_t fileSize(const std::string& path) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        return ec ? 0 : static_cast<uint64_t>(size);
+    }
+}
+
+CorePackBenchmarkResult MantraxCorePackBenchmark::Run(const std::string& workDirectory, size_t assetCount, size_t assetSize) {
+    CorePackBenchmarkResult result;
+    result.assetCount = assetCount;
+    result.assetSize = assetSize;
+
+    namespace fs = std::filesystem;
+    fs::path root(workDirectory);
+    fs::path assetDir = root / "assets";
+    std::error_code ec;
+    fs::create_directories(assetDir, ec);
+    if (ec) {
+        std::cerr << "CorePackBenchmark: no se puede crear " << assetDir.string() << std::endl;
+        return result;
+    }
+
+    // Assets con contenido parecido a texto/JSON (comprimible, pero no trivial)
+    std::mt19937 rng(1234);
+    std::vector<std::string> files;
+    files.reserve(assetCount);
+    std::vector<char> content(assetSize);
+    for (size_t i = 0; i < assetCount; ++i) {
+        for (size_t b = 0; b < assetSize; ++b) {
+            content[b] = (rng() % 4 == 0) ? static_cast<char>('a' + rng() % 26) : "{\"key\": 0.0},\n"[b % 14];
+        }
+        fs::path file = assetDir / ("asset_" + std::to_string(i) + ".bin");
+        std::ofstream out(file, std::ios::binary);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        files.push_back(file.string());
+    }
+
+    std::string v1Pack = (root / "bench_v1.mpak").string();
+    std::string v2Pack = (root / "bench_v2.mpak").string();
+    std::string v2LZ4Pack = (root / "bench_v2_lz4.mpak").string();
+
+    CorePackBuildOptions options;
+    options.baseDirectory = assetDir.string();
+    options.verbose = false;
+
+    options.version = 1;
+    auto start = Clock::now();
+    bool built = MantraxCorePackBuilder::Build(files, v1Pack, options);
+    result.v1BuildMs = elapsedMs(start);
+
+    options.version = CORE_PACK_VERSION;
+    start = Clock::now();
+    built = built && MantraxCorePackBuilder::Build(files, v2Pack, options);
+    result.v2BuildMs = elapsedMs(start);
+
+    options.compression = CorePackCompression::LZ4;
+    built = built && MantraxCorePackBuilder::Build(files, v2LZ4Pack, options);
+
+    if (!built) {
+        std::cerr << "CorePackBenchmark: error construyendo los packs" << std::endl;
+        return result;
+    }
+
+    result.v1Bytes = fileSize(v1Pack);
+    result.v2Bytes = fileSize(v2Pack);
+    result.v2CompressedBytes = fileSize(v2LZ4Pack);
+
+    // Orden de lectura aleatorio, igual para ambos formatos
+    std::vector<std::string> names;
+    names.reserve(assetCount);
+    for (size_t i = 0; i < assetCount; ++i) {
+        names.push_back("asset_" + std::to_string(i) + ".bin");
+    }
+    std::shuffle(names.begin(), names.end(), rng);
+
+    std::vector<char> buffer;
+    size_t failures = 0;
+
+    start = Clock::now();
+    MantraxCorePackReader v1Reader(v1Pack);
+    result.v1OpenMs = elapsedMs(start);
+    start = Clock::now();
+    for (const auto& name : names) {
+        if (!v1Reader.ReadFile(name, buffer)) failures++;
+    }
+    result.v1ReadMs = elapsedMs(start);
+
+    start = Clock::now();
+    MantraxCorePackReader v2Reader(v2LZ4Pack);
+    result.v2OpenMs = elapsedMs(start);
+    start = Clock::now();
+    for (const auto& name : names) {
+        if (!v2Reader.ReadFile(name, buffer)) failures++;
+    }
+    result.v2ReadMs = elapsedMs(start);
+
+    MantraxCorePackReader v2StoredReader(v2Pack);
+    uint64_t checksum = 0;
+    start = Clock::now();
+    for (const auto& name : names) {
+        CorePackView view;
+        if (!v2StoredReader.GetFileView(name, view)) {
+            failures++;
+            continue;
+        }
+        checksum += static_cast<unsigned char>(view.data[view.size / 2]);
+    }
+    result.v2ViewMs = elapsedMs(start);
+
+    if (failures > 0) {
+        std::cerr << "CorePackBenchmark: " << failures << " lecturas fallidas (checksum " << checksum << ")" << std::endl;
+    }
+
+    result.success = failures == 0;
+    return result;
+}
+
+void MantraxCorePackBenchmark::Print(const CorePackBenchmarkResult& result) {
+    std::cout << "=== CorePack Benchmark (" << result.assetCount << " assets x " << result.assetSize << " bytes) ===" << std::endl;
+    std::cout << "Build   v1: " << result.v1BuildMs << " ms | v2: " << result.v2BuildMs << " ms" << std::endl;
+    std::cout << "Open    v1: " << result.v1OpenMs << " ms | v2: " << result.v2OpenMs << " ms" << std::endl;
+    std::cout << "Read    v1: " << result.v1ReadMs << " ms | v2 (LZ4): " << result.v2ReadMs
+              << " ms | v2 view: " << result.v2ViewMs << " ms" << std::endl;
+    std::cout << "Size    v1: " << result.v1Bytes << " | v2: " << result.v2Bytes
+              << " | v2 (LZ4): " << result.v2CompressedBytes << std::endl;
+    std::cout << "Result: " << (result.success ? "OK" : "FAILED") << std::endl;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "../core/CoreExporter.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+struct MANTRAXCORE_API CorePackBenchmarkResult {
+    size_t assetCount = 0;
+    size_t assetSize = 0;
+    double v1BuildMs = 0.0;
+    double v2BuildMs = 0.0;
+    double v1OpenMs = 0.0;
+    double v2OpenMs = 0.0;
+    double v1ReadMs = 0.0;      // ReadFile de todas las entradas (busqueda lineal + ifstream)
+    double v2ReadMs = 0.0;      // ReadFile de todas las entradas (TOC + mmap, con LZ4)
+    double v2ViewMs = 0.0;      // GetFileView de todas las entradas (pack sin comprimir)
+    uint64_t v1Bytes = 0;
+    uint64_t v2Bytes = 0;
+    uint64_t v2CompressedBytes = 0;
+    bool success = false;
+};
+
+// Genera assets pequenos en workDirectory, construye packs v1 y v2 y mide la lectura de todos ellos
+class MANTRAXCORE_API MantraxCorePackBenchmark {
+public:
+    static CorePackBenchmarkResult Run(const std::string& workDirectory, size_t assetCount = 10000, size_t assetSize = 1024);
+    static void Print(const CorePackBenchmarkResult& result);
+};
@@ -1,7 +1,19 @@
 #include "MantraxCorePackBuilder.h"
+#include "MantraxCorePackReader.h"
+#include "CorePackCodec.h"
+#include "../core/MappedFile.h"
 #include <fstream>
+#include <sstream>
 #include <cstring>
 #include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_set>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 const int FNAME_SIZE = 100;
 
@@ -11,7 +23,487 @@ struct CorePackEntry {
     uint64_t size;
 };
 
+namespace {
+    namespace fs = std::filesystem;
+
+    // Agrupa las escrituras en bloques grandes; las entradas mayores que el buffer van directas
+    class PackWriter {
+    public:
+        PackWriter(std::ofstream& out, size_t bufferSize) : out(out) {
+            buffer.reserve(std::max<size_t>(bufferSize, 64 * 1024));
+        }
+
+        bool write(const char* data, uint64_t size) {
+            if (size == 0) return true;
+            if (buffer.size() + size > buffer.capacity()) {
+                if (!flush()) return false;
+            }
+            if (size >= buffer.capacity()) {
+                out.write(data, static_cast<std::streamsize>(size));
+            } else {
+                buffer.insert(buffer.end(), data, data + size);
+            }
+            offset += size;
+            return static_cast<bool>(out);
+        }
+
+        bool padTo(uint64_t target) {
+            static const char zeros[4096] = {};
+            while (offset < target) {
+                uint64_t chunk = std::min<uint64_t>(sizeof(zeros), target - offset);
+                if (!write(zeros, chunk)) return false;
+            }
+            return true;
+        }
+
+        bool flush() {
+            if (!buffer.empty()) {
+                out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+            return static_cast<bool>(out);
+        }
+
+        uint64_t position() const { return offset; }
+
+    private:
+        std::ofstream& out;
+        std::vector<char> buffer;
+        uint64_t offset = 0;
+    };
+
+    struct BuildCacheRecord {
+        uint64_t size = 0;
+        int64_t modified = 0;
+        uint32_t crc = 0;
+        uint64_t hash = 0;
+    };
+
+    struct PackInput {
+        std::string name;
+        std::string source;
+        uint64_t size = 0;
+        int64_t modified = 0;
+        uint32_t crc = 0;
+        uint64_t hash = 0;
+
+        bool reused = false;                // Datos copiados tal cual del pack anterior
+        CorePackView previousData;
+        CorePackFileInfo previousInfo;
+
+        size_t dataIndex = 0;
+        bool failed = false;
+    };
+
+    // Bloque de datos unico dentro del pack (varias entradas pueden apuntar al mismo)
+    struct PackData {
+        size_t input = 0;                   // Entrada de la que salen los datos
+        uint64_t offset = 0;
+        uint64_t storedSize = 0;
+        CorePackCompression compression = CorePackCompression::None;
+    };
+
+    template <typename Function>
+    void parallelFor(size_t count, uint32_t threadCount, Function&& function) {
+        std::atomic<size_t> next{ 0 };
+        auto worker = [&]() {
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                function(i);
+            }
+        };
+
+        size_t extraThreads = std::min<size_t>(threadCount > 0 ? threadCount - 1 : 0, count > 0 ? count - 1 : 0);
+        std::vector<std::thread> threads;
+        threads.reserve(extraThreads);
+        for (size_t i = 0; i < extraThreads; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    int64_t modifiedTime(const std::string& path) {
+        std::error_code error;
+        auto time = fs::last_write_time(path, error);
+        return error ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    std::string buildCachePath(const std::string& corePack) {
+        return corePack + ".cache";
+    }
+
+    std::unordered_map<std::string, BuildCacheRecord> loadBuildCache(const std::string& path) {
+        std::unordered_map<std::string, BuildCacheRecord> records;
+        std::ifstream in(path);
+        std::string line;
+        if (!in || !std::getline(in, line) || line != "MCPCACHE 1") {
+            return records;
+        }
+
+        // size modified crc hash nombre
+        while (std::getline(in, line)) {
+            std::istringstream stream(line);
+            BuildCacheRecord record;
+            std::string name;
+            if (!(stream >> record.size >> record.modified >> record.crc >> record.hash)) continue;
+            stream.get();
+            std::getline(stream, name);
+            if (!name.empty()) {
+                records[name] = record;
+            }
+        }
+        return records;
+    }
+
+    void saveBuildCache(const std::string& path, const std::vector<PackInput>& inputs) {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) return;
+
+        out << "MCPCACHE 1\n";
+        for (const auto& input : inputs) {
+            out << input.size << ' ' << input.modified << ' ' << input.crc << ' ' << input.hash << ' ' << input.name << '\n';
+        }
+    }
+
+    // Los datos guardados en el pack anterior solo sirven si respetan la compresion pedida
+    bool canReuseStored(const CorePackFileInfo& info, const CorePackBuildOptions& options) {
+        if (info.compression == CorePackCompression::None) return true;
+        return info.compression == options.compression;
+    }
+
+    struct DataKey {
+        uint64_t size;
+        uint32_t crc;
+        uint64_t hash;
+
+        bool operator==(const DataKey& other) const {
+            return size == other.size && crc == other.crc && hash == other.hash;
+        }
+    };
+
+    struct DataKeyHash {
+        size_t operator()(const DataKey& key) const {
+            return static_cast<size_t>(key.hash ^ (key.size * 0x9E3779B97F4A7C15ull) ^ key.crc);
+        }
+    };
+}
+
 bool MantraxCorePackBuilder::Build(const std::vector<std::string>& files, const std::string& outCorePack) {
+    return Build(files, outCorePack, CorePackBuildOptions());
+}
+
+bool MantraxCorePackBuilder::Build(const std::vector<std::string>& files, const std::string& outCorePack, const CorePackBuildOptions& options) {
+    CorePackBuildStats stats;
+    return Build(files, outCorePack, options, stats);
+}
+
+std::string MantraxCorePackBuilder::MakeEntryName(const std::string& file, const CorePackBuildOptions& options) {
+    if (options.baseDirectory.empty()) {
+        return CorePack::NormalizeName(file);
+    }
+    std::filesystem::path relative = std::filesystem::path(file).lexically_relative(options.baseDirectory);
+    if (relative.empty()) {
+        return CorePack::NormalizeName(file);
+    }
+    return relative.generic_string();
+}
+
+std::vector<std::string> MantraxCorePackBuilder::CollectFiles(const std::string& directory) {
+    std::vector<std::string> files;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file(error)) {
+            files.push_back(it->path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+bool MantraxCorePackBuilder::Build(const std::vector<std::string>& files, const std::string& outCorePack,
+                                   const CorePackBuildOptions& options, CorePackBuildStats& outStats) {
+    outStats = CorePackBuildStats();
+    if (options.version == 1) {
+        return BuildLegacy(files, outCorePack, options);
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    uint32_t alignment = std::max<uint32_t>(1, options.alignment);
+    uint32_t threadCount = options.threadCount > 0 ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+    // Nombres y tabla de strings
+    std::vector<PackInput> inputs;
+    std::unordered_set<std::string> seenNames;
+    std::string stringTable;
+    inputs.reserve(files.size());
+
+    for (const auto& file : files) {
+        std::string name = MakeEntryName(file, options);
+        if (!seenNames.insert(name).second) {
+            std::cerr << "Entrada duplicada, se ignora: " << name << std::endl;
+            continue;
+        }
+        PackInput input;
+        input.name = name;
+        input.source = file;
+        inputs.push_back(std::move(input));
+    }
+
+    // Pack anterior + cache de fuentes para el build incremental
+    std::unique_ptr<MantraxCorePackReader> previous;
+    std::unordered_map<std::string, BuildCacheRecord> cache;
+    if (options.incremental && fs::exists(outCorePack)) {
+        cache = loadBuildCache(buildCachePath(outCorePack));
+        if (!cache.empty()) {
+            previous = std::make_unique<MantraxCorePackReader>(outCorePack);
+            if (!previous->IsValid() || previous->GetVersion() != CORE_PACK_VERSION) {
+                previous.reset();
+            }
+        }
+    }
+
+    // Fase 1 (paralela): tamano, fecha y hash de contenido de cada fuente
+    std::atomic<uint64_t> bytesHashed{ 0 };
+    parallelFor(inputs.size(), threadCount, [&](size_t i) {
+        PackInput& input = inputs[i];
+        std::error_code error;
+        input.size = fs::file_size(input.source, error);
+        if (error) {
+            std::cerr << "No se puede abrir: " << input.source << std::endl;
+            input.failed = true;
+            return;
+        }
+        input.modified = modifiedTime(input.source);
+
+        if (previous) {
+            auto cached = cache.find(input.name);
+            if (cached != cache.end() && cached->second.size == input.size && cached->second.modified == input.modified &&
+                previous->GetStoredView(input.name, input.previousData, input.previousInfo) &&
+                input.previousInfo.crc == cached->second.crc && input.previousInfo.size == input.size &&
+                canReuseStored(input.previousInfo, options)) {
+                input.crc = cached->second.crc;
+                input.hash = cached->second.hash;
+                input.reused = true;
+                return;
+            }
+        }
+
+        MappedFile file;
+        if (!file.open(input.source)) {
+            input.failed = true;
+            return;
+        }
+        input.size = file.getSize();
+        input.crc = CorePackCodec::Crc32(file.getData(), file.getSize());
+        input.hash = CorePackCodec::Hash64(file.getData(), file.getSize());
+        bytesHashed += file.getSize();
+    });
+
+    for (const auto& input : inputs) {
+        if (input.failed) return false;
+    }
+
+    // Deduplicacion: mismo tamano + CRC32 + hash de 64 bits => mismos datos
+    std::vector<PackData> blocks;
+    std::unordered_map<DataKey, size_t, DataKeyHash> blockByContent;
+    blocks.reserve(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        PackInput& input = inputs[i];
+        if (options.deduplicate) {
+            DataKey key{ input.size, input.crc, input.hash };
+            auto found = blockByContent.find(key);
+            if (found != blockByContent.end()) {
+                input.dataIndex = found->second;
+                outStats.deduplicatedCount++;
+                continue;
+            }
+            blockByContent.emplace(key, blocks.size());
+        }
+        input.dataIndex = blocks.size();
+        PackData block;
+        block.input = i;
+        blocks.push_back(block);
+    }
+
+    for (const auto& input : inputs) {
+        stringTable += input.name;
+    }
+
+    CorePackHeaderV2 header = {};
+    std::memcpy(header.magic, CORE_PACK_MAGIC, sizeof(header.magic));
+    header.version = CORE_PACK_VERSION;
+    header.entryCount = static_cast<uint32_t>(inputs.size());
+    header.alignment = alignment;
+    header.tocOffset = sizeof(CorePackHeaderV2);
+    header.stringTableOffset = header.tocOffset + inputs.size() * sizeof(CorePackEntryV2);
+    header.stringTableSize = stringTable.size();
+
+    // Se escribe a un temporal: el pack anterior sigue mapeado para copiar entradas
+    std::string tempPack = outCorePack + ".tmp";
+    std::ofstream out(tempPack, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "No se puede crear: " << tempPack << std::endl;
+        return false;
+    }
+
+    size_t bufferSize = static_cast<size_t>(CorePack::AlignUp(std::max<size_t>(options.writeBufferSize, alignment), alignment));
+    PackWriter writer(out, bufferSize);
+
+    // Reservar espacio para cabecera + TOC; se reescriben al final con los offsets reales
+    writer.padTo(CorePack::AlignUp(header.stringTableOffset + header.stringTableSize, alignment));
+
+    // Fase 2: compresion en paralelo por lotes y escritura secuencial en orden
+    size_t batchSize = static_cast<size_t>(threadCount) * 4;
+    bool failed = false;
+    for (size_t first = 0; first < blocks.size() && !failed; first += batchSize) {
+        size_t count = std::min(batchSize, blocks.size() - first);
+        std::vector<MappedFile> sources(count);
+        std::vector<std::vector<char>> compressed(count);
+        std::vector<char> batchFailed(count, 0);
+
+        parallelFor(count, threadCount, [&](size_t k) {
+            PackData& block = blocks[first + k];
+            const PackInput& input = inputs[block.input];
+            if (input.reused) {
+                block.compression = input.previousInfo.compression;
+                return;
+            }
+
+            if (!sources[k].open(input.source) || sources[k].getSize() != input.size) {
+                std::cerr << "La fuente cambio durante el build: " << input.source << std::endl;
+                batchFailed[k] = 1;
+                return;
+            }
+
+            block.compression = CorePackCompression::None;
+            if (options.compression == CorePackCompression::LZ4 && input.size > 0 &&
+                CorePackCodec::LZ4Compress(sources[k].getData(), sources[k].getSize(), compressed[k]) &&
+                compressed[k].size() <= static_cast<size_t>(input.size * options.maxCompressedRatio)) {
+                block.compression = CorePackCompression::LZ4;
+            } else {
+                compressed[k].clear();
+            }
+        });
+
+        for (size_t k = 0; k < count; ++k) {
+            if (batchFailed[k]) {
+                failed = true;
+                break;
+            }
+
+            PackData& block = blocks[first + k];
+            const PackInput& input = inputs[block.input];
+
+            const char* payload;
+            uint64_t payloadSize;
+            if (input.reused) {
+                payload = input.previousData.data;
+                payloadSize = input.previousData.size;
+            } else if (block.compression == CorePackCompression::LZ4) {
+                payload = compressed[k].data();
+                payloadSize = compressed[k].size();
+            } else {
+                payload = sources[k].getData();
+                payloadSize = sources[k].getSize();
+            }
+
+            uint64_t alignedOffset = CorePack::AlignUp(writer.position(), alignment);
+            if (!writer.padTo(alignedOffset) || !writer.write(payload, payloadSize)) {
+                std::cerr << "Error escribiendo: " << tempPack << std::endl;
+                failed = true;
+                break;
+            }
+            block.offset = alignedOffset;
+            block.storedSize = payloadSize;
+        }
+    }
+
+    if (failed || !writer.flush()) {
+        out.close();
+        std::error_code error;
+        fs::remove(tempPack, error);
+        return false;
+    }
+
+    // TOC ordenada por hash para busqueda binaria en el lector
+    std::vector<CorePackEntryV2> entries(inputs.size());
+    uint32_t nameOffset = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const PackInput& input = inputs[i];
+        const PackData& block = blocks[input.dataIndex];
+        CorePackEntryV2& entry = entries[i];
+        entry = {};
+        entry.nameHash = CorePack::HashName(input.name);
+        entry.offset = block.offset;
+        entry.storedSize = block.storedSize;
+        entry.size = input.size;
+        entry.nameOffset = nameOffset;
+        entry.nameLength = static_cast<uint32_t>(input.name.size());
+        entry.crc = input.crc;
+        entry.compression = static_cast<uint32_t>(block.compression);
+        nameOffset += entry.nameLength;
+
+        if (options.verbose) {
+            const char* action = input.reused ? "Reutilizado" : "Empaquetado";
+            if (block.input != i) action = "Duplicado";
+            std::cout << action << ": " << input.name << " (" << input.size << " bytes";
+            if (block.compression != CorePackCompression::None) {
+                std::cout << ", " << block.storedSize << " comprimido";
+            }
+            std::cout << ")\n";
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const CorePackEntryV2& a, const CorePackEntryV2& b) {
+        return a.nameHash < b.nameHash;
+    });
+
+    uint32_t tocCrc = CorePackCodec::Crc32(entries.data(), entries.size() * sizeof(CorePackEntryV2));
+    header.tocCrc = CorePackCodec::Crc32(stringTable.data(), stringTable.size(), tocCrc);
+
+    uint64_t packSize = writer.position();
+    out.seekp(0, std::ios::beg);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(CorePackEntryV2)));
+    out.write(stringTable.data(), static_cast<std::streamsize>(stringTable.size()));
+
+    out.close();
+    if (!out) {
+        std::cerr << "Error finalizando: " << tempPack << std::endl;
+        return false;
+    }
+
+    // Soltar el mapeo del pack anterior antes de reemplazarlo
+    previous.reset();
+    std::error_code error;
+    fs::rename(tempPack, outCorePack, error);
+    if (error) {
+        std::cerr << "No se puede reemplazar " << outCorePack << ": " << error.message() << std::endl;
+        return false;
+    }
+    saveBuildCache(buildCachePath(outCorePack), inputs);
+
+    for (const auto& block : blocks) {
+        if (inputs[block.input].reused) outStats.reusedCount++;
+        if (block.compression != CorePackCompression::None) outStats.compressedCount++;
+    }
+    outStats.entryCount = inputs.size();
+    outStats.uniqueDataCount = blocks.size();
+    outStats.bytesHashed = bytesHashed;
+    outStats.bytesWritten = packSize;
+    outStats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (options.verbose) {
+        std::cout << "CorePack creado: " << outCorePack << " (" << inputs.size() << " entradas, "
+                  << blocks.size() << " bloques de datos, " << outStats.reusedCount << " reutilizados, "
+                  << outStats.deduplicatedCount << " duplicados)" << std::endl;
+    }
+    return true;
+}
+
+bool MantraxCorePackBuilder::BuildLegacy(const std::vector<std::string>& files, const std::string& outCorePack, const CorePackBuildOptions& options) {
     std::ofstream out(outCorePack, std::ios::binary);
     if (!out) return false;
 
@@ -23,7 +515,8 @@ bool MantraxCorePackBuilder::Build(const std::vector<std::string>& files, const
     size_t dataOffset = headerSize;
 
     for (size_t i = 0; i < files.size(); ++i) {
-        strncpy_s(entries[i].name, files[i].c_str(), FNAME_SIZE - 1);
+        std::string name = options.baseDirectory.empty() ? files[i] : MakeEntryName(files[i], options);
+        std::strncpy(entries[i].name, name.c_str(), FNAME_SIZE - 1);
         entries[i].name[FNAME_SIZE - 1] = '\0';
         std::ifstream in(files[i], std::ios::binary | std::ios::ate);
         if (!in) {
@@ -44,10 +537,14 @@ bool MantraxCorePackBuilder::Build(const std::vector<std::string>& files, const
         std::vector<char> buffer(entries[i].size);
         in.read(buffer.data(), entries[i].size);
         out.write(buffer.data(), entries[i].size);
-        std::cout << "Empaquetado: " << files[i] << " (" << entries[i].size << " bytes)\n";
+        if (options.verbose) {
+            std::cout << "Empaquetado: " << files[i] << " (" << entries[i].size << " bytes)\n";
+        }
     }
 
     out.close();
-    std::cout << "CorePack creado: " << outCorePack << std::endl;
+    if (options.verbose) {
+        std::cout << "CorePack creado: " << outCorePack << std::endl;
+    }
     return true;
 }
@@ -1,9 +1,47 @@
 #pragma once
 #include "../core/CoreExporter.h"
+#include "CorePackFormat.h"
 #include <string>
 #include <vector>
 
+struct MANTRAXCORE_API CorePackBuildOptions {
+    uint32_t version = CORE_PACK_VERSION;                      // 1 = formato legacy
+    CorePackCompression compression = CorePackCompression::None;
+    uint32_t alignment = CORE_PACK_DEFAULT_ALIGNMENT;
+    float maxCompressedRatio = 0.9f;                           // Solo se comprime si ahorra al menos un 10%
+    std::string baseDirectory;                                 // Si no esta vacio, los nombres se guardan relativos a esta carpeta
+    bool verbose = true;
+
+    uint32_t threadCount = 0;                                  // 0 = std::thread::hardware_concurrency()
+    bool deduplicate = true;                                   // Entradas con el mismo contenido comparten los datos
+    bool incremental = true;                                   // Reutiliza del pack anterior las entradas sin cambios
+    size_t writeBufferSize = 4 * 1024 * 1024;                  // Escrituras en bloques grandes (multiplo de alignment)
+};
+
+struct MANTRAXCORE_API CorePackBuildStats {
+    size_t entryCount = 0;
+    size_t uniqueDataCount = 0;        // Bloques de datos escritos
+    size_t reusedCount = 0;            // Copiados del pack anterior sin releer la fuente
+    size_t deduplicatedCount = 0;      // Entradas que apuntan a datos de otra entrada
+    size_t compressedCount = 0;
+    uint64_t bytesHashed = 0;
+    uint64_t bytesWritten = 0;
+    double milliseconds = 0.0;
+};
+
+// Construye packs v2 en dos fases: hash de las fuentes en paralelo (con deduplicacion y reutilizacion
+// de las entradas sin cambios del pack anterior) y escritura secuencial con compresion en paralelo.
+// Junto al pack se guarda "<pack>.cache" con tamano/fecha/CRC de cada fuente para el build incremental.
 class MANTRAXCORE_API MantraxCorePackBuilder {
 public:
     static bool Build(const std::vector<std::string>& files, const std::string& outCorePack);
+    static bool Build(const std::vector<std::string>& files, const std::string& outCorePack, const CorePackBuildOptions& options);
+    static bool Build(const std::vector<std::string>& files, const std::string& outCorePack, const CorePackBuildOptions& options, CorePackBuildStats& outStats);
+
+    // Lista recursiva de archivos regulares de una carpeta, en orden estable
+    static std::vector<std::string> CollectFiles(const std::string& directory);
+
+private:
+    static bool BuildLegacy(const std::vector<std::string>& files, const std::string& outCorePack, const CorePackBuildOptions& options);
+    static std::string MakeEntryName(const std::string& file, const CorePackBuildOptions& options);
 };
@@ -1,38 +1,215 @@
 #include "MantraxCorePackReader.h"
+#include "CorePackCodec.h"
 #include <fstream>
 #include <cstring>
+#include <iostream>
+#include <algorithm>
 
 MantraxCorePackReader::MantraxCorePackReader(const std::string& corePackFile)
     : corePackPath(corePackFile), valid(false)
 {
-    std::ifstream in(corePackFile, std::ios::binary);
-    if (!in) return;
+    char magic[4] = {};
+    {
+        std::ifstream in(corePackFile, std::ios::binary);
+        if (!in) return;
+        in.read(magic, sizeof(magic));
+    }
+
+    if (std::memcmp(magic, CORE_PACK_MAGIC, sizeof(magic)) == 0) {
+        valid = OpenV2();
+    } else {
+        valid = OpenLegacy();
+    }
+}
+
+bool MantraxCorePackReader::OpenV2() {
+    if (!mappedPack.open(corePackPath)) return false;
+
+    const char* base = mappedPack.getData();
+    size_t fileSize = mappedPack.getSize();
+    if (fileSize < sizeof(CorePackHeaderV2)) return false;
+
+    header = reinterpret_cast<const CorePackHeaderV2*>(base);
+    if (header->version != CORE_PACK_VERSION) {
+        std::cerr << "CorePack: version no soportada (" << header->version << "): " << corePackPath << std::endl;
+        return false;
+    }
+
+    uint64_t tocSize = static_cast<uint64_t>(header->entryCount) * sizeof(CorePackEntryV2);
+    if (header->tocOffset + tocSize > fileSize ||
+        header->stringTableOffset + header->stringTableSize > fileSize) {
+        std::cerr << "CorePack: TOC fuera de rango: " << corePackPath << std::endl;
+        return false;
+    }
+
+    toc = reinterpret_cast<const CorePackEntryV2*>(base + header->tocOffset);
+    stringTable = base + header->stringTableOffset;
+
+    uint32_t crc = CorePackCodec::Crc32(toc, static_cast<size_t>(tocSize));
+    crc = CorePackCodec::Crc32(stringTable, static_cast<size_t>(header->stringTableSize), crc);
+    if (crc != header->tocCrc) {
+        std::cerr << "CorePack: CRC de la TOC no coincide: " << corePackPath << std::endl;
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const CorePackEntryV2& entry = toc[i];
+        if (entry.storedSize > fileSize || entry.offset > fileSize - entry.storedSize ||
+            static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header->stringTableSize) {
+            std::cerr << "CorePack: entrada fuera de rango: " << corePackPath << std::endl;
+            return false;
+        }
+        // Sin comprimir se copia y se expone entry.size bytes del mapeo: tiene que ser lo guardado
+        if (static_cast<CorePackCompression>(entry.compression) == CorePackCompression::None &&
+            entry.size != entry.storedSize) {
+            std::cerr << "CorePack: tamano de entrada sin comprimir incoherente: " << corePackPath << std::endl;
+            return false;
+        }
+    }
+
+    version = CORE_PACK_VERSION;
+    return true;
+}
+
+bool MantraxCorePackReader::OpenLegacy() {
+    std::ifstream in(corePackPath, std::ios::binary);
+    if (!in) return false;
 
     uint32_t fileCount = 0;
     in.read((char*)&fileCount, sizeof(fileCount));
-    if (!fileCount) return;
+    if (!fileCount) return false;
 
     entries.resize(fileCount);
     for (uint32_t i = 0; i < fileCount; ++i) {
         in.read((char*)&entries[i], sizeof(CorePackEntry));
     }
 
-    valid = true;
+    version = 1;
+    return true;
 }
 
 bool MantraxCorePackReader::IsValid() const {
     return valid;
 }
 
+size_t MantraxCorePackReader::GetFileCount() const {
+    if (version == CORE_PACK_VERSION) return header->entryCount;
+    return entries.size();
+}
+
+std::string MantraxCorePackReader::EntryName(const CorePackEntryV2& entry) const {
+    return std::string(stringTable + entry.nameOffset, entry.nameLength);
+}
+
 std::vector<std::string> MantraxCorePackReader::ListFiles() const {
     std::vector<std::string> names;
+    if (version == CORE_PACK_VERSION) {
+        names.reserve(header->entryCount);
+        for (uint32_t i = 0; i < header->entryCount; ++i) {
+            names.push_back(EntryName(toc[i]));
+        }
+        return names;
+    }
+
     for (const auto& e : entries) {
         names.push_back(std::string(e.name));
     }
     return names;
 }
 
+const CorePackEntryV2* MantraxCorePackReader::FindEntry(const std::string& fileName) const {
+    if (!valid || version != CORE_PACK_VERSION) return nullptr;
+
+    uint64_t hash = CorePack::HashName(fileName);
+    const CorePackEntryV2* first = toc;
+    const CorePackEntryV2* last = toc + header->entryCount;
+    const CorePackEntryV2* it = std::lower_bound(first, last, hash, [](const CorePackEntryV2& entry, uint64_t value) {
+        return entry.nameHash < value;
+    });
+
+    // Colisiones de hash: comparar el nombre dentro del rango con el mismo hash
+    for (; it != last && it->nameHash == hash; ++it) {
+        if (it->nameLength != fileName.size()) continue;
+
+        const char* name = stringTable + it->nameOffset;
+        bool equal = true;
+        for (size_t i = 0; i < fileName.size(); ++i) {
+            char c = fileName[i] == '\\' ? '/' : fileName[i];
+            if (name[i] != c) {
+                equal = false;
+                break;
+            }
+        }
+        if (equal) return it;
+    }
+    return nullptr;
+}
+
+bool MantraxCorePackReader::Contains(const std::string& fileName) const {
+    if (version == CORE_PACK_VERSION) {
+        return FindEntry(fileName) != nullptr;
+    }
+    for (const auto& e : entries) {
+        if (fileName == std::string(e.name)) return true;
+    }
+    return false;
+}
+
+bool MantraxCorePackReader::GetFileInfo(const std::string& fileName, CorePackFileInfo& outInfo) const {
+    if (version == CORE_PACK_VERSION) {
+        const CorePackEntryV2* entry = FindEntry(fileName);
+        if (!entry) return false;
+        outInfo.name = EntryName(*entry);
+        outInfo.size = entry->size;
+        outInfo.storedSize = entry->storedSize;
+        outInfo.crc = entry->crc;
+        outInfo.compression = static_cast<CorePackCompression>(entry->compression);
+        return true;
+    }
+
+    for (const auto& e : entries) {
+        if (fileName == std::string(e.name)) {
+            outInfo.name = e.name;
+            outInfo.size = e.size;
+            outInfo.storedSize = e.size;
+            outInfo.crc = 0;
+            outInfo.compression = CorePackCompression::None;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MantraxCorePackReader::ReadEntry(const CorePackEntryV2& entry, std::vector<char>& outData) const {
+    const char* stored = mappedPack.getData() + entry.offset;
+    outData.resize(static_cast<size_t>(entry.size));
+
+    switch (static_cast<CorePackCompression>(entry.compression)) {
+        case CorePackCompression::None:
+            if (entry.size > 0) {
+                std::memcpy(outData.data(), stored, static_cast<size_t>(entry.size));
+            }
+            return true;
+        case CorePackCompression::LZ4:
+            if (!CorePackCodec::LZ4Decompress(stored, static_cast<size_t>(entry.storedSize), outData.data(), outData.size())) {
+                std::cerr << "CorePack: datos LZ4 corruptos en: " << EntryName(entry) << std::endl;
+                outData.clear();
+                return false;
+            }
+            return true;
+    }
+
+    std::cerr << "CorePack: compresion desconocida en: " << EntryName(entry) << std::endl;
+    outData.clear();
+    return false;
+}
+
 bool MantraxCorePackReader::ReadFile(const std::string& fileName, std::vector<char>& outData) const {
+    if (version == CORE_PACK_VERSION) {
+        const CorePackEntryV2* entry = FindEntry(fileName);
+        return entry && ReadEntry(*entry, outData);
+    }
+
     for (const auto& e : entries) {
         if (fileName == std::string(e.name)) {
             std::ifstream in(corePackPath, std::ios::binary);
@@ -45,3 +222,42 @@ bool MantraxCorePackReader::ReadFile(const std::string& fileName, std::vector<ch
     }
     return false;
 }
+
+bool MantraxCorePackReader::GetFileView(const std::string& fileName, CorePackView& outView) const {
+    const CorePackEntryV2* entry = FindEntry(fileName);
+    if (!entry || entry->compression != static_cast<uint32_t>(CorePackCompression::None)) {
+        return false;
+    }
+
+    outView.data = mappedPack.getData() + entry->offset;
+    outView.size = static_cast<size_t>(entry->size);
+    return true;
+}
+
+bool MantraxCorePackReader::GetStoredView(const std::string& fileName, CorePackView& outView, CorePackFileInfo& outInfo) const {
+    const CorePackEntryV2* entry = FindEntry(fileName);
+    if (!entry) return false;
+
+    outView.data = mappedPack.getData() + entry->offset;
+    outView.size = static_cast<size_t>(entry->storedSize);
+    outInfo.name = EntryName(*entry);
+    outInfo.size = entry->size;
+    outInfo.storedSize = entry->storedSize;
+    outInfo.crc = entry->crc;
+    outInfo.compression = static_cast<CorePackCompression>(entry->compression);
+    return true;
+}
+
+bool MantraxCorePackReader::VerifyFile(const std::string& fileName) const {
+    const CorePackEntryV2* entry = FindEntry(fileName);
+    if (!entry) return false;
+
+    if (entry->compression == static_cast<uint32_t>(CorePackCompression::None)) {
+        const char* data = mappedPack.getData() + entry->offset;
+        return CorePackCodec::Crc32(data, static_cast<size_t>(entry->size)) == entry->crc;
+    }
+
+    std::vector<char> data;
+    if (!ReadEntry(*entry, data)) return false;
+    return CorePackCodec::Crc32(data.data(), data.size()) == entry->crc;
+}
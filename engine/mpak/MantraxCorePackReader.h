@@ -3,17 +3,48 @@
 #include <vector>
 #include <cstdint>
 #include "../core/CoreExporter.h"
+#include "../core/MappedFile.h"
+#include "CorePackFormat.h"
 
+struct MANTRAXCORE_API CorePackFileInfo {
+    std::string name;
+    uint64_t size = 0;
+    uint64_t storedSize = 0;
+    uint32_t crc = 0;
+    CorePackCompression compression = CorePackCompression::None;
+};
+
+// Lee packs v2 (mapeados en memoria una sola vez) y v1 (legacy, por ifstream).
 class MANTRAXCORE_API MantraxCorePackReader {
 public:
     MantraxCorePackReader(const std::string& corePackFile);
 
+    MantraxCorePackReader(const MantraxCorePackReader&) = delete;
+    MantraxCorePackReader& operator=(const MantraxCorePackReader&) = delete;
+    MantraxCorePackReader(MantraxCorePackReader&&) = default;
+    MantraxCorePackReader& operator=(MantraxCorePackReader&&) = default;
+
     bool IsValid() const;
+    uint32_t GetVersion() const { return version; }
+    const std::string& GetPath() const { return corePackPath; }
 
     std::vector<std::string> ListFiles() const;
+    size_t GetFileCount() const;
+    bool Contains(const std::string& fileName) const;
+    bool GetFileInfo(const std::string& fileName, CorePackFileInfo& outInfo) const;
 
     bool ReadFile(const std::string& fileName, std::vector<char>& outData) const;
 
+    // Sin copia: solo para entradas v2 guardadas sin compresion. La vista es valida mientras viva el reader.
+    bool GetFileView(const std::string& fileName, CorePackView& outView) const;
+
+    // Bytes tal como estan guardados (comprimidos o no), para copiar entradas entre packs sin
+    // descomprimir. Solo v2.
+    bool GetStoredView(const std::string& fileName, CorePackView& outView, CorePackFileInfo& outInfo) const;
+
+    // Comprueba el CRC de la entrada
+    bool VerifyFile(const std::string& fileName) const;
+
 private:
     struct CorePackEntry {
         char name[100];
@@ -21,7 +52,22 @@ private:
         uint64_t size;
     };
 
+    bool OpenV2();
+    bool OpenLegacy();
+    const CorePackEntryV2* FindEntry(const std::string& fileName) const;
+    std::string EntryName(const CorePackEntryV2& entry) const;
+    bool ReadEntry(const CorePackEntryV2& entry, std::vector<char>& outData) const;
+
     std::string corePackPath;
+    uint32_t version = 0;
+
+    // v2
+    MappedFile mappedPack;
+    const CorePackHeaderV2* header = nullptr;
+    const CorePackEntryV2* toc = nullptr;
+    const char* stringTable = nullptr;
+
+    // v1
     std::vector<CorePackEntry> entries;
     bool valid;
 };
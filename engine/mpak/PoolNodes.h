@@ -0,0 +1,66 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <glm/glm.hpp>
+#include "MNodeEngine.h"
+#include "../components/ObjectPool.h"
+
+class PoolNodes
+{
+public:
+    void RegisterNodes(MNodeEngine &engine, ImVec2 position = ImVec2(300, 100))
+    {
+        // ----------- CREATE POOL -----------
+        PremakeNode createPoolNode(
+            "Pool", "Create Pool",
+            [](CustomNode *node)
+            {
+                std::string name = node->GetInputValue<std::string>(1, "");
+                std::string prefab = node->GetInputValue<std::string>(2, "");
+                int prewarm = node->GetInputValue<int>(3, 0);
+
+                ObjectPoolManager::getInstance().createPool(name, prefab, prewarm > 0 ? static_cast<size_t>(prewarm) : 0);
+            },
+            SCRIPT, true, true,
+            {{"Pool", std::string("Bullets")}, {"Prefab", std::string("Prefabs/Bullet.prefab")}, {"Prewarm", 32}},
+            {},
+            position);
+
+        // ----------- SPAWN -----------
+        PremakeNode spawnNode(
+            "Pool", "Spawn From Pool",
+            [](CustomNode *node)
+            {
+                std::string name = node->GetInputValue<std::string>(1, "");
+                glm::vec3 spawnPosition = node->GetInputValue<glm::vec3>(2, glm::vec3(0.0f));
+                glm::vec3 spawnRotation = node->GetInputValue<glm::vec3>(3, glm::vec3(0.0f));
+
+                node->SetOutputValue<GameObject *>(1, ObjectPoolManager::getInstance().spawn(name, spawnPosition, spawnRotation));
+            },
+            SCRIPT, true, true,
+            {{"Pool", std::string("Bullets")}, {"Position", glm::vec3(0.0f)}, {"Rotation", glm::vec3(0.0f)}},
+            {{"Object", (GameObject *)nullptr}},
+            position);
+
+        // ----------- DESPAWN -----------
+        PremakeNode despawnNode(
+            "Pool", "Despawn",
+            [](CustomNode *node)
+            {
+                GameObject *object = node->GetInputValue<GameObject *>(1, nullptr);
+
+                if (object != nullptr && !ObjectPoolManager::getInstance().despawn(object))
+                {
+                    std::cout << "Despawn: " << object->Name << " does not belong to a pool" << std::endl;
+                }
+            },
+            SCRIPT, true, true,
+            {{"Object", (GameObject *)nullptr}},
+            {},
+            position);
+
+        engine.PrefabNodes.push_back(createPoolNode);
+        engine.PrefabNodes.push_back(spawnNode);
+        engine.PrefabNodes.push_back(despawnNode);
+    }
+};
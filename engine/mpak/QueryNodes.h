@@ -0,0 +1,89 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "MNodeEngine.h"
+#include "../core/RaycastSystem.h"
+
+class QueryNodes
+{
+public:
+    void RegisterNodes(MNodeEngine &engine, ImVec2 position = ImVec2(300, 100))
+    {
+        // ----------- RAYCAST -----------
+        PremakeNode raycastNode(
+            "Physics", "Raycast",
+            [](CustomNode *node)
+            {
+                RaycastQuery query;
+                query.origin = node->GetInputValue<glm::vec3>(1, glm::vec3(0.0f));
+                query.direction = node->GetInputValue<glm::vec3>(2, glm::vec3(0.0f, 0.0f, 1.0f));
+                query.maxDistance = node->GetInputValue<float>(3, 100.0f);
+                query.layerMask = static_cast<physx::PxU32>(node->GetInputValue<int>(4, 0));
+
+                RaycastHit hit;
+                RaycastSystem::getInstance().raycastBatch(&query, 1, &hit);
+
+                node->SetOutputValue<bool>(1, hit.hit);
+                node->SetOutputValue<GameObject *>(2, RaycastSystem::getHitObject(hit));
+                node->SetOutputValue<glm::vec3>(3, hit.hit ? hit.position : glm::vec3(0.0f));
+                node->SetOutputValue<float>(4, hit.hit ? hit.distance : 0.0f);
+            },
+            SCRIPT, true, true,
+            {{"Origin", glm::vec3(0.0f)}, {"Direction", glm::vec3(0.0f, 0.0f, 1.0f)}, {"Distance", 100.0f}, {"Layers", 0}},
+            {{"Hit", false}, {"Object", (GameObject *)nullptr}, {"Point", glm::vec3(0.0f)}, {"Distance", 0.0f}},
+            position);
+
+        // ----------- RAYCAST FAN -----------
+        // Abanico horizontal de rayos en un solo lote (vision de IA, sensores)
+        PremakeNode raycastFanNode(
+            "Physics", "Raycast Fan",
+            [](CustomNode *node)
+            {
+                glm::vec3 origin = node->GetInputValue<glm::vec3>(1, glm::vec3(0.0f));
+                glm::vec3 forward = node->GetInputValue<glm::vec3>(2, glm::vec3(0.0f, 0.0f, 1.0f));
+                int rayCount = glm::clamp(node->GetInputValue<int>(3, 8), 1, 256);
+                float spread = node->GetInputValue<float>(4, 90.0f);
+                float distance = node->GetInputValue<float>(5, 100.0f);
+                physx::PxU32 layers = static_cast<physx::PxU32>(node->GetInputValue<int>(6, 0));
+
+                std::vector<RaycastQuery> queries(rayCount);
+                for (int i = 0; i < rayCount; i++)
+                {
+                    float t = rayCount > 1 ? static_cast<float>(i) / static_cast<float>(rayCount - 1) - 0.5f : 0.0f;
+                    glm::quat turn = glm::angleAxis(glm::radians(spread * t), glm::vec3(0.0f, 1.0f, 0.0f));
+                    queries[i].origin = origin;
+                    queries[i].direction = turn * forward;
+                    queries[i].maxDistance = distance;
+                    queries[i].layerMask = layers;
+                }
+
+                std::vector<RaycastHit> hits(rayCount);
+                RaycastSystem::getInstance().raycastBatch(queries.data(), queries.size(), hits.data());
+
+                int hitCount = 0;
+                const RaycastHit *closest = nullptr;
+                for (const RaycastHit &hit : hits)
+                {
+                    if (!hit.hit)
+                        continue;
+
+                    hitCount++;
+                    if (!closest || hit.distance < closest->distance)
+                        closest = &hit;
+                }
+
+                node->SetOutputValue<int>(1, hitCount);
+                node->SetOutputValue<GameObject *>(2, closest ? RaycastSystem::getHitObject(*closest) : nullptr);
+                node->SetOutputValue<float>(3, closest ? closest->distance : 0.0f);
+            },
+            SCRIPT, true, true,
+            {{"Origin", glm::vec3(0.0f)}, {"Forward", glm::vec3(0.0f, 0.0f, 1.0f)}, {"Rays", 8}, {"Spread", 90.0f}, {"Distance", 100.0f}, {"Layers", 0}},
+            {{"Hits", 0}, {"Closest", (GameObject *)nullptr}, {"Closest Distance", 0.0f}},
+            position);
+
+        engine.PrefabNodes.push_back(raycastNode);
+        engine.PrefabNodes.push_back(raycastFanNode);
+    }
+};
@@ -1,7 +1,82 @@
 #include "AssimpGeometry.h"
+#include "../core/FileSystem.h"
 #include <iostream>
 #include <limits>
+#include <cstring>
+#include <algorithm>
 #include <glm/gtc/type_ptr.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/IOStream.hpp>
+
+namespace {
+    // Stream de solo lectura sobre un asset ya leido del VFS
+    class VfsIOStream : public Assimp::IOStream {
+    public:
+        explicit VfsIOStream(FileData&& fileData) : data(std::move(fileData)) {}
+
+        size_t Read(void* buffer, size_t size, size_t count) override {
+            if (size == 0 || count == 0) return 0;
+            size_t available = (data.size() - position) / size;
+            size_t items = std::min(count, available);
+            std::memcpy(buffer, data.data() + position, items * size);
+            position += items * size;
+            return items;
+        }
+
+        size_t Write(const void*, size_t, size_t) override {
+            return 0;
+        }
+
+        aiReturn Seek(size_t offset, aiOrigin origin) override {
+            size_t target;
+            switch (origin) {
+            case aiOrigin_SET: target = offset; break;
+            case aiOrigin_CUR: target = position + offset; break;
+            case aiOrigin_END: target = data.size() - offset; break;
+            default: return aiReturn_FAILURE;
+            }
+            if (target > data.size()) return aiReturn_FAILURE;
+            position = target;
+            return aiReturn_SUCCESS;
+        }
+
+        size_t Tell() const override { return position; }
+        size_t FileSize() const override { return data.size(); }
+        void Flush() override {}
+
+    private:
+        FileData data;
+        size_t position = 0;
+    };
+
+    // Resuelve el modelo y sus archivos externos (.mtl, .bin, texturas embebidas) por el VFS
+    class VfsIOSystem : public Assimp::IOSystem {
+    public:
+        bool Exists(const char* file) const override {
+            return FileSystem::assetExists(file);
+        }
+
+        char getOsSeparator() const override {
+            return '/';
+        }
+
+        Assimp::IOStream* Open(const char* file, const char* mode) override {
+            // El VFS es de solo lectura
+            if (std::strchr(mode, 'w') || std::strchr(mode, 'a')) {
+                return nullptr;
+            }
+            FileData fileData;
+            if (!FileSystem::readAsset(file, fileData)) {
+                return nullptr;
+            }
+            return new VfsIOStream(std::move(fileData));
+        }
+
+        void Close(Assimp::IOStream* stream) override {
+            delete stream;
+        }
+    };
+}
 
 AssimpGeometry::AssimpGeometry(const std::string& path)
     : modelPath(path), loaded(false), EBO(0),
@@ -56,6 +131,7 @@ AssimpGeometry::~AssimpGeometry() {
 
 void AssimpGeometry::loadModel(const std::string& path) {
     Assimp::Importer importer;
+    importer.SetIOHandler(new VfsIOSystem());   // El importer se queda con el IOSystem
 
     unsigned int flags = aiProcess_Triangulate
         | aiProcess_FlipUVs
@@ -247,8 +323,8 @@ void AssimpGeometry::draw() const {
     glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
 }
 
-void AssimpGeometry::drawInstanced(const std::vector<glm::mat4>& modelMatrices) const {
-    if (!loaded || indices.empty() || modelMatrices.empty() || vao == 0) {
+void AssimpGeometry::drawInstanced(size_t instanceCount) const {
+    if (!loaded || indices.empty() || instanceCount == 0 || vao == 0) {
         if (!loaded || vao == 0) {
             std::cerr << "WARNING: Attempting to draw invalid AssimpGeometry in instanced mode (loaded: " << loaded
                 << ", vao: " << vao << ")" << std::endl;
@@ -267,10 +343,10 @@ void AssimpGeometry::drawInstanced(const std::vector<glm::mat4>& modelMatrices)
     }
 
     glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(indices.size()),
-        GL_UNSIGNED_INT, 0, static_cast<GLsizei>(modelMatrices.size()));
+        GL_UNSIGNED_INT, 0, static_cast<GLsizei>(instanceCount));
 }
 
-void AssimpGeometry::updateInstanceBuffer(const std::vector<glm::mat4>& modelMatrices) {
+void AssimpGeometry::updateInstanceBuffer(const glm::mat4* modelMatrices, size_t count) {
     if (!loaded || vao == 0 || instanceVBO == 0) {
         std::cerr << "WARNING: Attempting to update instance buffer of invalid AssimpGeometry (loaded: " << loaded
             << ", vao: " << vao << ", instanceVBO: " << instanceVBO << ")" << std::endl;
@@ -278,7 +354,7 @@ void AssimpGeometry::updateInstanceBuffer(const std::vector<glm::mat4>& modelMat
     }
 
     // Verificar que las matrices sean válidas
-    for (size_t i = 0; i < modelMatrices.size(); i++) {
+    for (size_t i = 0; i < count; i++) {
         const auto& matrix = modelMatrices[i];
 
         // Verificar manualmente si la matriz contiene NaN o Inf
@@ -309,8 +385,8 @@ void AssimpGeometry::updateInstanceBuffer(const std::vector<glm::mat4>& modelMat
 
     // Update instance buffer with new matrices
     glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-    glBufferData(GL_ARRAY_BUFFER, modelMatrices.size() * sizeof(glm::mat4),
-        modelMatrices.data(), GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(glm::mat4),
+        modelMatrices, GL_DYNAMIC_DRAW);
 
     // Unbind VAO
     glBindVertexArray(0);
@@ -22,8 +22,11 @@ public:
     ~AssimpGeometry();
 
     void draw() const;
-    void drawInstanced(const std::vector<glm::mat4>& modelMatrices) const;
-    void updateInstanceBuffer(const std::vector<glm::mat4>& modelMatrices);
+    void drawInstanced(size_t instanceCount) const;
+    void drawInstanced(const std::vector<glm::mat4>& modelMatrices) const { drawInstanced(modelMatrices.size()); }
+    // Acepta cualquier almacenamiento contiguo (p.ej. un FrameVector) sin copiarlo a un std::vector
+    void updateInstanceBuffer(const glm::mat4* modelMatrices, size_t count);
+    void updateInstanceBuffer(const std::vector<glm::mat4>& modelMatrices) { updateInstanceBuffer(modelMatrices.data(), modelMatrices.size()); }
     
     // Para modelos 3D cargados
     bool usesModelNormals() const { return true; }
@@ -36,6 +39,10 @@ public:
     size_t getVertexCount() const { return vertices.size(); }
     size_t getIndexCount() const { return indices.size(); }
 
+    // Datos en CPU (p.ej. para cocinar las mallas de colision)
+    const std::vector<Vertex>& getVertices() const { return vertices; }
+    const std::vector<unsigned int>& getIndices() const { return indices; }
+
 private:
     std::string modelPath;
     std::vector<Vertex> vertices;
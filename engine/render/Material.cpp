@@ -52,7 +52,7 @@ void Material::setNormalStrength(float strength) {
 }
 
 void Material::setAlbedoTexture(const std::string& filePath) {
-    albedoTexture = std::make_shared<Texture>(filePath);
+    albedoTexture = std::make_shared<Texture>(filePath, true);
     if (!albedoTexture->getID()) {
         std::cerr << "Error al cargar textura de albedo: " << filePath << std::endl;
         albedoTexture = nullptr;
@@ -63,7 +63,7 @@ void Material::setAlbedoTexture(const std::string& filePath) {
 }
 
 void Material::setNormalTexture(const std::string& filePath) {
-    normalTexture = std::make_shared<Texture>(filePath);
+    normalTexture = std::make_shared<Texture>(filePath, true);
     if (!normalTexture->getID()) {
         std::cerr << "Error al cargar textura normal: " << filePath << std::endl;
         normalTexture = nullptr;
@@ -74,7 +74,7 @@ void Material::setNormalTexture(const std::string& filePath) {
 }
 
 void Material::setMetallicTexture(const std::string& filePath) {
-    metallicTexture = std::make_shared<Texture>(filePath);
+    metallicTexture = std::make_shared<Texture>(filePath, true);
     if (!metallicTexture->getID()) {
         std::cerr << "Error al cargar textura metallic: " << filePath << std::endl;
         metallicTexture = nullptr;
@@ -85,7 +85,7 @@ void Material::setMetallicTexture(const std::string& filePath) {
 }
 
 void Material::setRoughnessTexture(const std::string& filePath) {
-    roughnessTexture = std::make_shared<Texture>(filePath);
+    roughnessTexture = std::make_shared<Texture>(filePath, true);
     if (!roughnessTexture->getID()) {
         std::cerr << "Error al cargar textura roughness: " << filePath << std::endl;
         roughnessTexture = nullptr;
@@ -96,7 +96,7 @@ void Material::setRoughnessTexture(const std::string& filePath) {
 }
 
 void Material::setEmissiveTexture(const std::string& filePath) {
-    emissiveTexture = std::make_shared<Texture>(filePath);
+    emissiveTexture = std::make_shared<Texture>(filePath, true);
     if (!emissiveTexture->getID()) {
         std::cerr << "Error al cargar textura emissive: " << filePath << std::endl;
         emissiveTexture = nullptr;
@@ -107,7 +107,7 @@ void Material::setEmissiveTexture(const std::string& filePath) {
 }
 
 void Material::setAOTexture(const std::string& filePath) {
-    aoTexture = std::make_shared<Texture>(filePath);
+    aoTexture = std::make_shared<Texture>(filePath, true);
     if (!aoTexture->getID()) {
         std::cerr << "Error al cargar textura AO: " << filePath << std::endl;
         aoTexture = nullptr;
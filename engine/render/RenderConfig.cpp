@@ -1,4 +1,6 @@
 #include "RenderConfig.h"
+#include "../core/JobSystem.h"
+#include "../core/FileSystem.h"
 #include <GL/glew.h>
 #include <iostream>
 #include <stdexcept>
@@ -34,6 +36,9 @@ RenderConfig::RenderConfig(int width, int height, float fov)
 }
 
 RenderConfig::~RenderConfig() {
+    // Despues de esto los trabajos (tambien los de PhysX) corren en linea
+    JobSystem::getInstance().shutdown();
+    FileSystem::shutdownAsyncIO();
     if (renderer) SDL_DestroyRenderer(renderer);
     if (glContext) SDL_GL_DestroyContext(glContext);
     if (window) SDL_DestroyWindow(window);
@@ -158,6 +163,10 @@ bool RenderConfig::initContext() {
     }
 
     std::cout << "OpenGL context created successfully!" << std::endl;
+
+    // Hilos de trabajo del motor; este, el del contexto GL, queda como hilo principal. Antes de
+    // la fisica para que PhysX use los mismos hilos
+    JobSystem::getInstance().initialize();
     return true;
 }
 
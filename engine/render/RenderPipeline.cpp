@@ -10,8 +10,10 @@
 #include "AssimpGeometry.h"
 #include "RenderConfig.h"
 #include "ShadowManager.h"
+#include "TextureStreamer.h"
 
 #include "../components/GameObject.h"
+#include "../core/JobSystem.h"
 #include <GL/glew.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -69,13 +71,28 @@ RenderPipeline::~RenderPipeline() {
 }
 
 void RenderPipeline::AddGameObject(GameObject* object) {
+    object->renderIndex = sceneObjects.size();
     sceneObjects.push_back(object);
 }
 
 void RenderPipeline::RemoveGameObject(GameObject* object) {
-    if (object) {
-        sceneObjects.erase(std::remove(sceneObjects.begin(), sceneObjects.end(), object), sceneObjects.end());
+    if (!object) return;
+
+    // El indice puede haber quedado viejo tras clearGameObjects(); entonces se busca
+    size_t index = object->renderIndex;
+    if (index >= sceneObjects.size() || sceneObjects[index] != object) {
+        auto it = std::find(sceneObjects.begin(), sceneObjects.end(), object);
+        if (it == sceneObjects.end()) return;
+        index = static_cast<size_t>(it - sceneObjects.begin());
     }
+
+    // Swap-and-pop: el orden de sceneObjects no importa, el render agrupa por material
+    if (index != sceneObjects.size() - 1) {
+        sceneObjects[index] = sceneObjects.back();
+        sceneObjects[index]->renderIndex = index;
+    }
+    sceneObjects.pop_back();
+    object->renderIndex = SIZE_MAX;
 }
 
 void RenderPipeline::AddLight(std::shared_ptr<Light> light) {
@@ -124,7 +141,47 @@ int RenderPipeline::getVisibleObjectsCount() const {
     return visibleObjectsCount;
 }
 
+namespace {
+    // Nombres de un array de uniforms ("base[0]", "base[1]", ...)
+    template <size_t N>
+    struct IndexedUniform {
+        std::string names[N];
+
+        explicit IndexedUniform(const char* base) {
+            for (size_t i = 0; i < N; i++) {
+                names[i] = std::string(base) + "[" + std::to_string(i) + "]";
+            }
+        }
+
+        const std::string& operator[](size_t i) const { return names[i]; }
+    };
+}
+
+void RenderPipeline::collectFrameLights() {
+    frameDirectionalLight = nullptr;
+    frameSpotLights.clear();
+    framePointLights.clear();
+
+    for (const auto& light : lights) {
+        if (!light->isEnabled()) continue;
+
+        switch (light->getType()) {
+            case LightType::Directional:
+                if (!frameDirectionalLight) frameDirectionalLight = light;
+                break;
+            case LightType::Point:
+                if (framePointLights.size() < 4) framePointLights.push_back(light);
+                break;
+            case LightType::Spot:
+                if (frameSpotLights.size() < 2) frameSpotLights.push_back(light);
+                break;
+        }
+    }
+}
+
 void RenderPipeline::renderFrame() {
+    collectFrameLights();
+
     // 1. Shadow pass - render to shadow maps first
     if (shadowsEnabled) {
         renderShadowPass();
@@ -169,25 +226,10 @@ void RenderPipeline::renderFrame() {
         shadowManager->bindShadowMap(shaders->getProgram()->getID());
         shadowManager->setupShadowUniforms(shaders->getProgram()->getID());
         
-        // Configurar shadow maps avanzados para spot y point lights
-        std::vector<std::shared_ptr<Light>> spotLightsForShadows;
-        std::vector<std::shared_ptr<Light>> pointLightsForShadows;
-        
-        // Recopilar spot y point lights para sombras
-        for (auto& light : lights) {
-            if (!light->isEnabled()) continue;
-            
-            if (light->getType() == LightType::Spot && spotLightsForShadows.size() < 2) {
-                spotLightsForShadows.push_back(light);
-            } else if (light->getType() == LightType::Point && pointLightsForShadows.size() < 4) {
-                pointLightsForShadows.push_back(light);
-            }
-        }
-        
         // Configurar shadow maps avanzados si tenemos luces spot o point
-        if (!spotLightsForShadows.empty() || !pointLightsForShadows.empty()) {
+        if (!frameSpotLights.empty() || !framePointLights.empty()) {
             shadowManager->bindAllShadowMaps(shaders->getProgram()->getID());
-            shadowManager->setupAllShadowUniforms(shaders->getProgram()->getID(), spotLightsForShadows, pointLightsForShadows);
+            shadowManager->setupAllShadowUniforms(shaders->getProgram()->getID(), frameSpotLights, framePointLights);
         }
         
         // Enable shadows in shader
@@ -199,11 +241,11 @@ void RenderPipeline::renderFrame() {
         GLint enablePointShadowsLoc = glGetUniformLocation(shaders->getProgram()->getID(), "uEnablePointShadows");
         
         // Solo habilitar spot shadows si tenemos spot lights con shadow maps
-        int spotShadowsEnabled = !spotLightsForShadows.empty() ? 1 : 0;
+        int spotShadowsEnabled = !frameSpotLights.empty() ? 1 : 0;
         glUniform1i(enableSpotShadowsLoc, spotShadowsEnabled);
         
         // Habilitar point shadows si hay point lights
-        int pointShadowsEnabled = !pointLightsForShadows.empty() ? 1 : 0;
+        int pointShadowsEnabled = !framePointLights.empty() ? 1 : 0;
         glUniform1i(enablePointShadowsLoc, pointShadowsEnabled);
     } else {
         GLint enableShadowsLoc = shaders->getProgram()->getInt("uEnableShadows");
@@ -247,30 +289,29 @@ void RenderPipeline::configureLighting() {
     glm::vec3 finalAmbient = baseAmbient * ambientIntensity;
     shaders->getProgram()->setVec3("uAmbientLight", finalAmbient);
     
-    // Separar luces por tipo
-    std::vector<std::shared_ptr<Light>> directionalLights;
-    std::vector<std::shared_ptr<Light>> pointLights;
-    std::vector<std::shared_ptr<Light>> spotLights;
+    // Nombres "uX[i]" formateados una sola vez, no en cada frame
+    static const IndexedUniform<4> uPointLightPositions("uPointLightPositions");
+    static const IndexedUniform<4> uPointLightColors("uPointLightColors");
+    static const IndexedUniform<4> uPointLightIntensities("uPointLightIntensities");
+    static const IndexedUniform<4> uPointLightAttenuations("uPointLightAttenuations");
+    static const IndexedUniform<4> uPointLightMinDistances("uPointLightMinDistances");
+    static const IndexedUniform<4> uPointLightMaxDistances("uPointLightMaxDistances");
+    static const IndexedUniform<2> uSpotLightPositions("uSpotLightPositions");
+    static const IndexedUniform<2> uSpotLightDirections("uSpotLightDirections");
+    static const IndexedUniform<2> uSpotLightColors("uSpotLightColors");
+    static const IndexedUniform<2> uSpotLightIntensities("uSpotLightIntensities");
+    static const IndexedUniform<2> uSpotLightCutOffs("uSpotLightCutOffs");
+    static const IndexedUniform<2> uSpotLightOuterCutOffs("uSpotLightOuterCutOffs");
+    static const IndexedUniform<2> uSpotLightRanges("uSpotLightRanges");
+    static const IndexedUniform<2> uSpotLightMatrices("uSpotLightMatrices");
     
-    for (auto& light : lights) {
-        if (!light->isEnabled()) continue;
-        
-        switch (light->getType()) {
-            case LightType::Directional:
-                directionalLights.push_back(light);
-                break;
-            case LightType::Point:
-                if (pointLights.size() < 4) pointLights.push_back(light);
-                break;
-            case LightType::Spot:
-                if (spotLights.size() < 2) spotLights.push_back(light);
-                break;
-        }
-    }
+    // Luces separadas por tipo en collectFrameLights()
+    const auto& pointLights = framePointLights;
+    const auto& spotLights = frameSpotLights;
     
     // Configurar luz direccional
-    if (!directionalLights.empty()) {
-        auto& dirLight = directionalLights[0];
+    if (frameDirectionalLight) {
+        auto& dirLight = frameDirectionalLight;
         shaders->getProgram()->setInt("uHasDirLight", 1);
         shaders->getProgram()->setVec3("uDirLightDirection", dirLight->getDirection());
         shaders->getProgram()->setVec3("uDirLightColor", dirLight->getColor());
@@ -286,12 +327,12 @@ void RenderPipeline::configureLighting() {
     for (int i = 0; i < pointLights.size(); i++) {
         auto& light = pointLights[i];
 
-        shaders->getProgram()->setVec3("uPointLightPositions[" + std::to_string(i) + "]", light->getPosition());
-        shaders->getProgram()->setVec3("uPointLightColors[" + std::to_string(i) + "]", light->getColor());
-        shaders->getProgram()->setFloat("uPointLightIntensities[" + std::to_string(i) + "]", light->getIntensity());
-        shaders->getProgram()->setVec3("uPointLightAttenuations[" + std::to_string(i) + "]", light->getAttenuation());
-        shaders->getProgram()->setFloat("uPointLightMinDistances[" + std::to_string(i) + "]", light->getMinDistance());
-        shaders->getProgram()->setFloat("uPointLightMaxDistances[" + std::to_string(i) + "]", light->getMaxDistance());
+        shaders->getProgram()->setVec3(uPointLightPositions[i], light->getPosition());
+        shaders->getProgram()->setVec3(uPointLightColors[i], light->getColor());
+        shaders->getProgram()->setFloat(uPointLightIntensities[i], light->getIntensity());
+        shaders->getProgram()->setVec3(uPointLightAttenuations[i], light->getAttenuation());
+        shaders->getProgram()->setFloat(uPointLightMinDistances[i], light->getMinDistance());
+        shaders->getProgram()->setFloat(uPointLightMaxDistances[i], light->getMaxDistance());
     }
     
     shaders->getProgram()->setInt("uNumSpotLights", static_cast<int>(spotLights.size()));
@@ -299,10 +340,10 @@ void RenderPipeline::configureLighting() {
     for (int i = 0; i < spotLights.size(); i++) {
         auto& light = spotLights[i];
 
-        shaders->getProgram()->setVec3("uSpotLightPositions[" + std::to_string(i) + "]", light->getPosition());
-        shaders->getProgram()->setVec3("uSpotLightDirections[" + std::to_string(i) + "]", light->getDirection());
-        shaders->getProgram()->setVec3("uSpotLightColors[" + std::to_string(i) + "]", light->getColor());
-        shaders->getProgram()->setFloat("uSpotLightIntensities[" + std::to_string(i) + "]", light->getIntensity());
+        shaders->getProgram()->setVec3(uSpotLightPositions[i], light->getPosition());
+        shaders->getProgram()->setVec3(uSpotLightDirections[i], light->getDirection());
+        shaders->getProgram()->setVec3(uSpotLightColors[i], light->getColor());
+        shaders->getProgram()->setFloat(uSpotLightIntensities[i], light->getIntensity());
 
         // Ángulos
         float cutOff = light->getCutOffAngle();
@@ -312,15 +353,15 @@ void RenderPipeline::configureLighting() {
             outerCutOff = cutOff + 0.1f;
         }
 
-        shaders->getProgram()->setFloat("uSpotLightCutOffs[" + std::to_string(i) + "]", cutOff);
-        shaders->getProgram()->setFloat("uSpotLightOuterCutOffs[" + std::to_string(i) + "]", outerCutOff);
-        shaders->getProgram()->setFloat("uSpotLightRanges[" + std::to_string(i) + "]", light->getSpotRange());
+        shaders->getProgram()->setFloat(uSpotLightCutOffs[i], cutOff);
+        shaders->getProgram()->setFloat(uSpotLightOuterCutOffs[i], outerCutOff);
+        shaders->getProgram()->setFloat(uSpotLightRanges[i], light->getSpotRange());
 
         // Sombras
         if (shadowsEnabled && shadowManager) {
             const auto& spotMatrices = shadowManager->getSpotLightSpaceMatrices();
             if (i < spotMatrices.size()) {
-                shaders->getProgram()->setMat4("uSpotLightMatrices[" + std::to_string(i) + "]", spotMatrices[i]);
+                shaders->getProgram()->setMat4(uSpotLightMatrices[i], spotMatrices[i]);
             }
         }
     }
@@ -342,17 +383,36 @@ void RenderPipeline::renderInstanced() {
         cameraFrustum = camera->getFrustum();
     }
     
-    // Agrupar objetos por material y geometría (solo objetos visibles)
-    std::map<MaterialGeometryKey, std::vector<GameObject*>> materialGeometryGroups;
+    // Streaming de mips: los materiales visibles piden resolución según su tamaño en pantalla
+    TextureStreamer& textureStreamer = TextureStreamer::getInstance();
+    textureStreamer.beginFrame();
+    float viewportHeight = static_cast<float>(getViewportHeight());
     
-    for (GameObject* obj : sceneObjects) {
-        // Skip objects without geometry
-        if (!obj->hasGeometry()) {
+    // Agrupar objetos por material y geometría (solo objetos visibles): se ordenan por la clave
+    // y cada tramo con la misma clave es un grupo. Todo en memoria del frame
+    FrameVector<DrawItem> drawItems;
+    drawItems.reserve(sceneObjects.size());
+    
+    // Culling en paralelo: primero las transforms por arboles y despues el test de cada objeto,
+    // que ya solo lee. Materiales y streaming siguen en serie y en el orden de sceneObjects
+    GameObject::updateWorldTransforms(sceneObjects);
+    FrameVector<uint8_t> visible(sceneObjects.size(), 0);
+    JobSystem::getInstance().parallelFor(sceneObjects.size(), 256, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            GameObject* obj = sceneObjects[i];
+            visible[i] = obj->hasGeometry() && obj->isActive() && isObjectVisible(obj, cameraFrustum);
+        }
+    });
+    
+    for (size_t i = 0; i < sceneObjects.size(); i++) {
+        // Skip objects without geometry (o desactivados, p.ej. en un pool) y fuera del frustum
+        GameObject* obj = sceneObjects[i];
+        if (!visible[i]) {
             continue;
         }
         
         // Validar que el objeto tenga un material válido
-        auto material = obj->getMaterial();
+        Material* material = obj->getMaterial().get();
         if (!material) {
             continue;
         }
@@ -361,31 +421,46 @@ void RenderPipeline::renderInstanced() {
             continue;
         }
         
-        // Realizar frustum culling
-        if (isObjectVisible(obj, cameraFrustum)) {
-            visibleObjectsCount++;
-            
-            MaterialGeometryKey key;
-            key.material = obj->getMaterial();
-            key.geometry = obj->getGeometry();
-            materialGeometryGroups[key].push_back(obj);
+        visibleObjectsCount++;
+        
+        DrawItem item;
+        item.key.material = material;
+        item.key.geometry = obj->getGeometry();
+        item.object = obj;
+        drawItems.push_back(item);
+        
+        if (textureStreamer.isEnabled()) {
+            textureStreamer.requestMaterial(material, estimateScreenSize(obj, viewportHeight));
         }
     }
     
+    textureStreamer.endFrame();
+    
+    std::sort(drawItems.begin(), drawItems.end(), [](const DrawItem& a, const DrawItem& b) {
+        return a.key < b.key;
+    });
+    
+    // Matrices de todos los grupos seguidas; cada grupo sube su tramo
+    FrameVector<glm::mat4> modelMatrices;
+    modelMatrices.reserve(drawItems.size());
+    for (const DrawItem& item : drawItems) {
+        modelMatrices.push_back(item.object->getWorldModelMatrix());
+    }
+    
     // Renderizar cada grupo con instanced rendering optimizado
-    for (auto& group : materialGeometryGroups) {
-        const MaterialGeometryKey& key = group.first;
-        std::vector<GameObject*>& objects = group.second;
-        
-        // Skip empty groups
-        if (objects.empty()) continue;
+    for (size_t first = 0; first < drawItems.size();) {
+        const MaterialGeometryKey& key = drawItems[first].key;
+        size_t count = 1;
+        while (first + count < drawItems.size() && drawItems[first + count].key == key) {
+            count++;
+        }
         
         // Configurar material y shadow maps en el orden correcto
         GLuint program = shaders->getProgram()->getID();
         
         // 1. Configurar material primero - ALWAYS configure material to ensure fresh state
         if (key.material) {
-            configureMaterial(key.material.get());
+            configureMaterial(key.material);
         } else {
             configureDefaultMaterial();
         }
@@ -393,22 +468,7 @@ void RenderPipeline::renderInstanced() {
         // 2. Configurar shadow maps después del material
         if (shadowsEnabled && shadowManager) {
             shadowManager->bindAllShadowMaps(program);
-            
-            // Recopilar luces para shadow maps
-            std::vector<std::shared_ptr<Light>> spotLightsForShadows;
-            std::vector<std::shared_ptr<Light>> pointLightsForShadows;
-            
-            for (auto& light : lights) {
-                if (!light->isEnabled()) continue;
-                
-                if (light->getType() == LightType::Spot && spotLightsForShadows.size() < 2) {
-                    spotLightsForShadows.push_back(light);
-                } else if (light->getType() == LightType::Point && pointLightsForShadows.size() < 4) {
-                    pointLightsForShadows.push_back(light);
-                }
-            }
-            
-            shadowManager->setupAllShadowUniforms(program, spotLightsForShadows, pointLightsForShadows);
+            shadowManager->setupAllShadowUniforms(program, frameSpotLights, framePointLights);
         }
         
         AssimpGeometry* geometry = key.geometry;
@@ -416,37 +476,16 @@ void RenderPipeline::renderInstanced() {
         // Configurar si usa normales de modelo
         glUniform1i(glGetUniformLocation(program, "uUseModelNormals"), geometry->usesModelNormals() ? 1 : 0);
         
-        // Optimización: usar instanced rendering para grupos grandes
-        if (objects.size() >= 2) {
-            // Batch render múltiples objetos
-            std::vector<glm::mat4> modelMatrices;
-            modelMatrices.reserve(objects.size());
-            
-            for (GameObject* obj : objects) {
-                modelMatrices.push_back(obj->getWorldModelMatrix());
-            }
-            
-            // CORREGIDO: Asegurar que las texturas estén correctamente vinculadas antes del renderizado instanciado
-            if (key.material && key.material->hasAnyValidTextures()) {
-                key.material->bindTextures();
-            }
-            
-            geometry->updateInstanceBuffer(modelMatrices);
-            geometry->drawInstanced(modelMatrices);
-        } else {
-            // Renderizar individualmente si solo hay un objeto
-            GameObject* obj = objects[0];
-            glm::mat4 model = obj->getWorldModelMatrix();
-            
-            // CORREGIDO: Asegurar que las texturas estén correctamente vinculadas antes del renderizado instanciado
-            if (key.material && key.material->hasAnyValidTextures()) {
-                key.material->bindTextures();
-            }
-            
-            std::vector<glm::mat4> singleInstance = { model };
-            geometry->updateInstanceBuffer(singleInstance);
-            geometry->drawInstanced(singleInstance);
+        // CORREGIDO: Asegurar que las texturas estén correctamente vinculadas antes del renderizado instanciado
+        if (key.material && key.material->hasAnyValidTextures()) {
+            key.material->bindTextures();
         }
+        
+        // Un solo objeto también va por el camino instanciado, con una instancia
+        geometry->updateInstanceBuffer(modelMatrices.data() + first, count);
+        geometry->drawInstanced(count);
+        
+        first += count;
     }
 }
 
@@ -546,23 +585,9 @@ void RenderPipeline::rebindShadowMapsAfterMaterial(GLuint program) {
     
     std::cout << "RenderPipeline: CRÍTICO - Rebindeando shadow maps después de configurar material..." << std::endl;
     
-    // Recopilar luces para shadow maps avanzados
-    std::vector<std::shared_ptr<Light>> spotLightsForShadows;
-    std::vector<std::shared_ptr<Light>> pointLightsForShadows;
-    
-    for (auto& light : lights) {
-        if (!light->isEnabled()) continue;
-        
-        if (light->getType() == LightType::Spot && spotLightsForShadows.size() < 2) {
-            spotLightsForShadows.push_back(light);
-        } else if (light->getType() == LightType::Point && pointLightsForShadows.size() < 4) {
-            pointLightsForShadows.push_back(light);
-        }
-    }
-    
     // ESTRATEGIA AGRESIVA: Siempre rebindear TODOS los shadow maps Y uniforms
     shadowManager->bindAllShadowMaps(program);
-    shadowManager->setupAllShadowUniforms(program, spotLightsForShadows, pointLightsForShadows);
+    shadowManager->setupAllShadowUniforms(program, frameSpotLights, framePointLights);
     
     // También rebindear el shadow map básico por seguridad
     shadowManager->bindShadowMap(program);
@@ -575,7 +600,7 @@ void RenderPipeline::renderNonInstanced() {
     auto shader = shaders->getProgram();
 
     for (GameObject* obj : sceneObjects) {
-        if (!obj->hasGeometry()) continue;
+        if (!obj->hasGeometry() || !obj->isActive()) continue;
 
         glm::mat4 model = obj->getWorldModelMatrix();
         shader->setMat4("model", model); // Reemplaza glUniformMatrix4fv
@@ -650,6 +675,37 @@ bool RenderPipeline::isObjectVisible(GameObject* object, const Frustum& cameraFr
     return result != CullResult::OUTSIDE;
 }
 
+int RenderPipeline::getViewportHeight() const {
+    if (camera && camera->isFramebufferEnabled() && camera->getBufferHeight() > 0) {
+        return camera->getBufferHeight();
+    }
+    if (RenderConfig::getInstance().getWindow()) {
+        int w, h;
+        SDL_GetWindowSize(RenderConfig::getInstance().getWindow(), &w, &h);
+        if (h > 0) {
+            return h;
+        }
+    }
+    return RenderConfig::getInstance().getHeight();
+}
+
+// Diámetro aproximado en píxeles de la bounding sphere del objeto
+float RenderPipeline::estimateScreenSize(GameObject* object, float viewportHeight) const {
+    BoundingSphere worldSphere = object->getWorldBoundingSphere();
+    
+    if (camera->getProjectionType() == ProjectionType::Orthographic) {
+        return worldSphere.radius * viewportHeight / std::max(camera->getOrthographicSize(), 0.0001f);
+    }
+    
+    float distance = glm::length(worldSphere.center - camera->getPosition());
+    if (distance <= worldSphere.radius) {
+        return viewportHeight; // La cámara está dentro del objeto
+    }
+    
+    float tanHalfFov = std::tan(glm::radians(camera->getFOV()) * 0.5f);
+    return worldSphere.radius * viewportHeight / (distance * tanHalfFov);
+}
+
 // Resource Management Implementation
 
 std::shared_ptr<AssimpGeometry> RenderPipeline::loadModel(const std::string& path) {
@@ -846,33 +902,19 @@ void RenderPipeline::renderShadowPass() {
         return;
     }
     
-    // Find directional light for shadow casting (opcional)
-    std::shared_ptr<Light> directionalLight = nullptr;
-    for (const auto& light : lights) {
-        if (light->isEnabled() && light->getType() == LightType::Directional) {
-            directionalLight = light;
-            break;
-        }
-    }
-
-    // Recopilar luces spot y point para shadow rendering
-    std::vector<std::shared_ptr<Light>> spotLightsForShadows;
-    std::vector<std::shared_ptr<Light>> pointLightsForShadows;
-    
-    for (const auto& light : lights) {
-        if (!light->isEnabled()) continue;
-        
-        if (light->getType() == LightType::Spot && spotLightsForShadows.size() < 2) {
-            spotLightsForShadows.push_back(light);
-        } else if (light->getType() == LightType::Point && pointLightsForShadows.size() < 4) {
-            pointLightsForShadows.push_back(light);
-        }
-    }
+    // Luces recopiladas en collectFrameLights(); la direccional es opcional
+    const std::shared_ptr<Light>& directionalLight = frameDirectionalLight;
+    const auto& spotLightsForShadows = frameSpotLights;
+    const auto& pointLightsForShadows = framePointLights;
     
     // Preparar spot y point shadow passes (calcular matrices) solo si hay luces
     bool hasSpotLights = !spotLightsForShadows.empty();
     bool hasPointLights = !pointLightsForShadows.empty();
     
+    if (!directionalLight && !hasSpotLights && !hasPointLights) {
+        return;
+    }
+    
     if (hasSpotLights) {
         shadowManager->beginSpotShadowPass(spotLightsForShadows, camera);
     }
@@ -881,21 +923,49 @@ void RenderPipeline::renderShadowPass() {
         shadowManager->beginPointShadowPass(pointLightsForShadows, camera);
     }
     
+    // Los objetos y sus matrices son los mismos en todas las pasadas (hasta 1 + 2 + 4 * 6):
+    // se agrupan por geometría una sola vez y cada pasada solo dibuja
+    FrameVector<DrawItem> casters;
+    casters.reserve(sceneObjects.size());
+    for (GameObject* obj : sceneObjects) {
+        if (!obj->hasGeometry() || !obj->isActive()) continue;
+        
+        DrawItem item;
+        item.key.material = nullptr;
+        item.key.geometry = obj->getGeometry();
+        item.object = obj;
+        casters.push_back(item);
+    }
+    
+    std::sort(casters.begin(), casters.end(), [](const DrawItem& a, const DrawItem& b) {
+        return a.key.geometry < b.key.geometry;
+    });
+    
+    FrameVector<glm::mat4> casterMatrices;
+    casterMatrices.reserve(casters.size());
+    FrameVector<ShadowBatch> batches;
+    for (const DrawItem& item : casters) {
+        if (batches.empty() || batches.back().geometry != item.key.geometry) {
+            batches.push_back({ item.key.geometry, casterMatrices.size(), 0 });
+        }
+        casterMatrices.push_back(item.object->getWorldModelMatrix());
+        batches.back().count++;
+    }
+    
     // 1. Render directional light shadow map (solo si hay directional light)
     if (directionalLight) {
         shadowManager->beginShadowPass(directionalLight, camera);
-        renderShadowGeometry();
+        renderShadowGeometry(batches, casterMatrices);
         shadowManager->endShadowPass();
     }
     
     // 2. Render spot light shadow maps (solo si hay spot lights)
     if (!spotLightsForShadows.empty()) {
         for (size_t i = 0; i < spotLightsForShadows.size() && i < 2; i++) {
-            auto& light = spotLightsForShadows[i];
             glm::mat4 spotMatrix = shadowManager->getSpotLightSpaceMatrices()[i];
             
             shadowManager->beginSingleSpotShadowRender(i, spotMatrix);
-            renderShadowGeometry();
+            renderShadowGeometry(batches, casterMatrices);
             shadowManager->endSingleSpotShadowRender();
         }
     }
@@ -908,12 +978,13 @@ void RenderPipeline::renderShadowPass() {
             float farPlane = light->getMaxDistance();
             
             // Renderizar las 6 caras del cube map
-            std::vector<glm::mat4> viewMatrices = shadowManager->calculatePointLightViewMatrices(lightPos);
+            glm::mat4 faceProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, farPlane);
+            std::array<glm::mat4, 6> viewMatrices = shadowManager->calculatePointLightViewMatrices(lightPos);
             for (int face = 0; face < 6; face++) {
-                glm::mat4 lightSpaceMatrix = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, farPlane) * viewMatrices[face];
+                glm::mat4 lightSpaceMatrix = faceProjection * viewMatrices[face];
                 
                 shadowManager->beginSinglePointShadowRender(i, face, lightSpaceMatrix);
-                renderShadowGeometry();
+                renderShadowGeometry(batches, casterMatrices);
                 shadowManager->endSinglePointShadowRender();
             }
         }
@@ -929,47 +1000,11 @@ void RenderPipeline::renderShadowPass() {
 }
 
 // Helper method for rendering geometry during shadow passes
-void RenderPipeline::renderShadowGeometry() {
-    // Render all objects from light's perspective
-    std::map<MaterialGeometryKey, std::vector<GameObject*>> geometryGroups;
-    int validObjects = 0;
-    
-    for (GameObject* obj : sceneObjects) {
-        if (!obj->hasGeometry()) continue;
-        
-        MaterialGeometryKey key;
-        key.material = obj->getMaterial();
-        key.geometry = obj->getGeometry();
-        
-        geometryGroups[key].push_back(obj);
-        validObjects++;
-    }
-    
-    // Shadow pass rendering objects in groups
-    
+void RenderPipeline::renderShadowGeometry(const FrameVector<ShadowBatch>& batches, const FrameVector<glm::mat4>& matrices) {
     // Render each geometry group with instanced rendering
-    for (auto& group : geometryGroups) {
-        auto& objects = group.second;
-        AssimpGeometry* geometry = group.first.geometry;
-        
-        if (objects.size() > 1) {
-            // Prepare model matrices for instanced rendering
-            std::vector<glm::mat4> modelMatrices;
-            for (GameObject* obj : objects) {
-                modelMatrices.push_back(obj->getWorldModelMatrix());
-            }
-            
-            geometry->updateInstanceBuffer(modelMatrices);
-            geometry->drawInstanced(modelMatrices);
-        } else if (!objects.empty()) {
-            // Single object
-            GameObject* obj = objects[0];
-            glm::mat4 model = obj->getWorldModelMatrix();
-            
-            std::vector<glm::mat4> singleInstance = { model };
-            geometry->updateInstanceBuffer(singleInstance);
-            geometry->drawInstanced(singleInstance);
-        }
+    for (const ShadowBatch& batch : batches) {
+        batch.geometry->updateInstanceBuffer(matrices.data() + batch.firstMatrix, batch.count);
+        batch.geometry->drawInstanced(batch.count);
     }
 }
 
@@ -7,6 +7,7 @@
 #include <string>
 #include <glm/glm.hpp>
 #include "../core/CoreExporter.h"
+#include "../core/FrameAllocator.h"
 #include "../ui/Canvas.h"
 
 class Camera;
@@ -28,6 +29,7 @@ public:
 
     void AddGameObject(GameObject* object);
     void RemoveGameObject(GameObject* object);
+    void ReserveGameObjects(size_t additional) { sceneObjects.reserve(sceneObjects.size() + additional); }
     void AddLight(std::shared_ptr<Light> light);
     void RemoveLight(std::shared_ptr<Light> light);
     void renderFrame();
@@ -143,18 +145,28 @@ private:
     
     void renderInstanced();
     void renderNonInstanced();
+    // Objetos con sombra agrupados por geometria; matrices contiguas en el FrameAllocator
+    struct ShadowBatch {
+        AssimpGeometry* geometry;
+        size_t firstMatrix;
+        size_t count;
+    };
+
+    void collectFrameLights(); // Una vez por frame, para shadow pass, iluminacion y materiales
     void renderShadowPass(); // New method for shadow rendering
-    void renderShadowGeometry(); // Helper method for rendering geometry during shadow passes
+    void renderShadowGeometry(const FrameVector<ShadowBatch>& batches, const FrameVector<glm::mat4>& matrices); // Helper method for rendering geometry during shadow passes
     void configureMaterial(Material* material);
     void configureDefaultMaterial();
     void rebindShadowMapsAfterMaterial(GLuint program);
     void configureLighting();
     bool isObjectVisible(GameObject* object, const Frustum& cameraFrustum) const;
+    float estimateScreenSize(GameObject* object, float viewportHeight) const;
+    int getViewportHeight() const;
     
-    // Estructura para agrupar objetos por material y geometría
+    // Estructura para agrupar objetos por material y geometría (se ordenan por la clave)
     struct MaterialGeometryKey {
-        std::shared_ptr<Material> material;
-        		AssimpGeometry* geometry;
+        Material* material;
+        AssimpGeometry* geometry;
         
         bool operator<(const MaterialGeometryKey& other) const {
             if (material != other.material) {
@@ -162,6 +174,19 @@ private:
             }
             return geometry < other.geometry;
         }
+        bool operator==(const MaterialGeometryKey& other) const {
+            return material == other.material && geometry == other.geometry;
+        }
     };
 
+    struct DrawItem {
+        MaterialGeometryKey key;
+        GameObject* object;
+    };
+
+    // Luces activas del frame; los vectores conservan su capacidad entre frames
+    std::shared_ptr<Light> frameDirectionalLight;
+    std::vector<std::shared_ptr<Light>> frameSpotLights;    // Hasta 2
+    std::vector<std::shared_ptr<Light>> framePointLights;   // Hasta 4
+
 };
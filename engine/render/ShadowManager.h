@@ -3,6 +3,7 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <array>
 #include <memory>
 #include <vector>
 #include "../core/CoreExporter.h"
@@ -63,7 +64,7 @@ public:
     // Light space matrix calculations (public access needed for rendering)
     glm::mat4 calculateDirectionalLightSpaceMatrix(std::shared_ptr<Light> light, Camera* camera);
     glm::mat4 calculateSpotLightSpaceMatrix(std::shared_ptr<Light> light);
-    std::vector<glm::mat4> calculatePointLightViewMatrices(glm::vec3 lightPos);
+    std::array<glm::mat4, 6> calculatePointLightViewMatrices(glm::vec3 lightPos);
     
 private:
     bool initialized;
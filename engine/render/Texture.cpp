@@ -2,52 +2,107 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include "../core/FileSystem.h"
+#include "../core/JobSystem.h"
+#include "TextureStreamer.h"
+
+namespace {
+    // Reduce una imagen RGBA a la mitad con un filtro de caja 2x2
+    void downsampleRGBA(const unsigned char* src, int srcW, int srcH, std::vector<unsigned char>& dst, int& dstW, int& dstH) {
+        dstW = std::max(1, srcW / 2);
+        dstH = std::max(1, srcH / 2);
+        dst.resize(static_cast<size_t>(dstW) * dstH * 4);
+
+        for (int y = 0; y < dstH; y++) {
+            int y0 = std::min(y * 2, srcH - 1);
+            int y1 = std::min(y * 2 + 1, srcH - 1);
+            for (int x = 0; x < dstW; x++) {
+                int x0 = std::min(x * 2, srcW - 1);
+                int x1 = std::min(x * 2 + 1, srcW - 1);
+                for (int c = 0; c < 4; c++) {
+                    int sum = src[(static_cast<size_t>(y0) * srcW + x0) * 4 + c]
+                            + src[(static_cast<size_t>(y0) * srcW + x1) * 4 + c]
+                            + src[(static_cast<size_t>(y1) * srcW + x0) * 4 + c]
+                            + src[(static_cast<size_t>(y1) * srcW + x1) * 4 + c];
+                    dst[(static_cast<size_t>(y) * dstW + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+}
+
+// Resultado de la decodificacion en segundo plano; el trabajo tiene su propia referencia por si
+// la textura se destruye antes de que termine
+struct Texture::PendingDecode {
+    std::future<FileData> read;          // Lectura en el hilo de IO del VFS
+    bool decodeScheduled = false;
+    std::atomic<bool> ready{false};
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+
+    ~PendingDecode() {
+        if (pixels) {
+            stbi_image_free(pixels);
+        }
+    }
+};
 
 Texture::Texture()
-    : rendererID(0), localBuffer(nullptr), width(0), height(0), BPP(0) {
+    : rendererID(0), localBuffer(nullptr), width(0), height(0), BPP(0),
+      mipCount(0), residentMip(0), streamable(false), isDataTexture(false), raiseFailed(false) {
 }
 
-Texture::Texture(const std::string& filePath)
-    : rendererID(0), localBuffer(nullptr), width(0), height(0), BPP(0) {
-    loadFromFile(filePath);
+Texture::Texture(const std::string& filePath, bool streamable)
+    : rendererID(0), localBuffer(nullptr), width(0), height(0), BPP(0),
+      mipCount(0), residentMip(0), streamable(false), isDataTexture(false), raiseFailed(false) {
+    loadFromFile(filePath, streamable);
 }
 
 Texture::~Texture() {
+    if (streamable) {
+        TextureStreamer::getInstance().unregisterTexture(this);
+    }
     if (rendererID != 0) {
         glDeleteTextures(1, &rendererID);
     }
 }
 
-bool Texture::loadFromFile(const std::string& filePath) {
-    this->filePath = FileSystem::getProjectPath() + "\\Content\\" + filePath;
+bool Texture::loadFromFile(const std::string& filePath, bool streamable) {
+    assetPath = FileSystem::normalizeAssetPath(filePath);
+    this->filePath = FileSystem::getContentPath(filePath);
+    raiseFailed = false;
     
     std::cout << "Texture::loadFromFile: Attempting to load texture from: " << this->filePath << std::endl;
     
     //stbi_set_flip_vertically_on_load(1);
     
     // Determinar si es una textura de datos o color
-    bool isDataTexture = (this->filePath.find("Normal") != std::string::npos ||
+    isDataTexture = (this->filePath.find("Normal") != std::string::npos ||
                           this->filePath.find("Metalness") != std::string::npos ||
                           this->filePath.find("Roughness") != std::string::npos ||
                           this->filePath.find("AO") != std::string::npos ||
                           this->filePath.find("Height") != std::string::npos);
     
+    // Leer por el VFS (pack montado, overlay o Content) y decodificar desde memoria
+    FileData data;
+    if (!FileSystem::readAsset(assetPath, data) || data.empty()) {
+        std::cerr << "Error: No se pudo cargar la textura: " << this->filePath << std::endl;
+        std::cerr << "File does not exist or is not accessible" << std::endl;
+        return false;
+    }
+
     // Cargar con 4 canales (RGBA) para asegurar que siempre tengamos un canal alfa
-    localBuffer = stbi_load(this->filePath.c_str(), &width, &height, &BPP, 4);
+    localBuffer = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data.data()), static_cast<int>(data.size()),
+                                        &width, &height, &BPP, 4);
     if (!localBuffer) {
         std::cerr << "Error: No se pudo cargar la textura: " << this->filePath << std::endl;
         std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
-        
-        // Check if file exists
-        std::ifstream fileCheck(this->filePath);
-        if (!fileCheck.good()) {
-            std::cerr << "File does not exist or is not accessible" << std::endl;
-        } else {
-            std::cerr << "File exists but STB failed to load it" << std::endl;
-            fileCheck.close();
-        }
-        
+        std::cerr << "File exists but STB failed to load it" << std::endl;
         return false;
     }
     
@@ -83,12 +138,16 @@ bool Texture::loadFromFile(const std::string& filePath) {
     glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(maxAnisotropy, 16.0f));
 
-    // Cargar la imagen en la textura
-    GLenum internalFormat = isDataTexture ? GL_RGBA8 : GL_SRGB8_ALPHA8; // sRGB para texturas de color
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, localBuffer);
-    
-    // Generar mipmaps para mejor calidad a distancia
-    glGenerateMipmap(GL_TEXTURE_2D);
+    // Cargar la imagen en la textura. Con streaming solo se sube el mip inicial; TextureStreamer
+    // sube los mips finos cuando el objeto ocupa suficiente pantalla
+    if (this->streamable && !streamable) {
+        TextureStreamer::getInstance().unregisterTexture(this);
+    }
+    this->streamable = streamable;
+    pendingDecode.reset();
+    mipCount = calculateMipCount(width, height);
+    int initialMip = streamable ? TextureStreamer::getInstance().getInitialMip(width, height) : 0;
+    uploadFromMip(localBuffer, width, height, 0, initialMip);
     
     glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -105,6 +164,7 @@ bool Texture::loadFromFile(const std::string& filePath) {
 
 bool Texture::loadIconFromFile(const std::string& filePath) {
     this->filePath = filePath; // Usa la ruta tal cual
+    assetPath = filePath;
     localBuffer = stbi_load(this->filePath.c_str(), &width, &height, &BPP, 4);
     if (!localBuffer) {
         std::cerr << "Error: No se pudo cargar el icono: " << this->filePath << std::endl;
@@ -135,6 +195,140 @@ bool Texture::loadIconFromFile(const std::string& filePath) {
     return true;
 }
 
+int Texture::calculateMipCount(int w, int h) {
+    int levels = 1;
+    int size = std::max(w, h);
+    while (size > 1) {
+        size /= 2;
+        levels++;
+    }
+    return levels;
+}
+
+size_t Texture::calculateMipChainBytes(int w, int h, int firstMip) {
+    size_t bytes = 0;
+    int levels = calculateMipCount(w, h);
+    for (int level = firstMip; level < levels; level++) {
+        size_t mipW = static_cast<size_t>(std::max(1, w >> level));
+        size_t mipH = static_cast<size_t>(std::max(1, h >> level));
+        bytes += mipW * mipH * 4;
+    }
+    return bytes;
+}
+
+size_t Texture::getResidentBytes() const {
+    if (rendererID == 0) return 0;
+    return calculateMipChainBytes(width, height, residentMip);
+}
+
+// Sube la cadena de mips empezando en targetMip. pixels contiene la imagen en srcMip
+// (srcWidth x srcHeight); se reduce en CPU hasta targetMip y GL genera el resto.
+// Se reutiliza el mismo nombre de textura para que los IDs cacheados sigan siendo validos.
+void Texture::uploadFromMip(const unsigned char* pixels, int srcWidth, int srcHeight, int srcMip, int targetMip) {
+    targetMip = std::clamp(targetMip, srcMip, std::max(srcMip, mipCount - 1));
+
+    std::vector<unsigned char> scratch;
+    std::vector<unsigned char> reduced;
+    const unsigned char* data = pixels;
+    int dataW = srcWidth;
+    int dataH = srcHeight;
+
+    for (int level = srcMip; level < targetMip; level++) {
+        int newW, newH;
+        downsampleRGBA(data, dataW, dataH, reduced, newW, newH);
+        scratch.swap(reduced);
+        data = scratch.data();
+        dataW = newW;
+        dataH = newH;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, rendererID);
+    GLenum internalFormat = isDataTexture ? GL_RGBA8 : GL_SRGB8_ALPHA8; // sRGB para texturas de color
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipCount - 1 - targetMip);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, dataW, dataH, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+    // Generar mipmaps para mejor calidad a distancia
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    residentMip = targetMip;
+}
+
+bool Texture::setResidentMip(int mip) {
+    if (!streamable || rendererID == 0) return false;
+
+    mip = std::clamp(mip, 0, mipCount - 1);
+    if (mip == residentMip) return true;
+
+    if (mip > residentMip) {
+        // Bajar resolucion: el mip pedido ya esta en GPU, se lee de vuelta sin tocar disco
+        int level = mip - residentMip;
+        int mipW = std::max(1, width >> mip);
+        int mipH = std::max(1, height >> mip);
+        std::vector<unsigned char> pixels(static_cast<size_t>(mipW) * mipH * 4);
+
+        glBindTexture(GL_TEXTURE_2D, rendererID);
+        glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        uploadFromMip(pixels.data(), mipW, mipH, mip, mip);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return true;
+    }
+
+    // Subir resolucion: hace falta la imagen original. Se lee en el hilo de IO, se decodifica en un
+    // trabajador y aqui solo se sube cuando esta lista; mientras tanto devuelve false
+    if (raiseFailed) return false;
+    if (!pendingDecode) {
+        pendingDecode = std::make_shared<PendingDecode>();
+        pendingDecode->read = FileSystem::readAssetAsync(assetPath);
+    }
+    if (!pendingDecode->decodeScheduled) {
+        if (pendingDecode->read.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+        pendingDecode->decodeScheduled = true;
+
+        auto file = std::make_shared<FileData>();
+        try {
+            *file = pendingDecode->read.get();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Texture::setResidentMip: Error leyendo " << filePath << ": " << e.what() << std::endl;
+        }
+        JobSystem::getInstance().schedule([decode = pendingDecode, file]() {
+            if (file->isValid() && !file->empty()) {
+                int fileBPP;
+                decode->pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file->data()), static_cast<int>(file->size()),
+                                                       &decode->width, &decode->height, &fileBPP, 4);
+                if (decode->pixels) {
+                    for (int i = 0; i < decode->width * decode->height; i++) {
+                        decode->pixels[i * 4 + 3] = 255;
+                    }
+                }
+            }
+            decode->ready.store(true, std::memory_order_release);
+        }, nullptr, JobAffinity::Worker);
+    }
+    if (!pendingDecode->ready.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    std::shared_ptr<PendingDecode> decode = std::move(pendingDecode);
+    if (!decode->pixels) {
+        std::cerr << "Texture::setResidentMip: No se pudo recargar: " << filePath << std::endl;
+        raiseFailed = true;
+        return false;
+    }
+    if (decode->width != width || decode->height != height) {
+        std::cerr << "Texture::setResidentMip: El archivo cambio de tamano: " << filePath << std::endl;
+        raiseFailed = true;
+        return false;
+    }
+
+    uploadFromMip(decode->pixels, decode->width, decode->height, 0, mip);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
 void Texture::bind(unsigned int slot) const {
     glActiveTexture(GL_TEXTURE0 + slot);
     glBindTexture(GL_TEXTURE_2D, rendererID);
@@ -1,16 +1,19 @@
 #pragma once
 #include <GL/glew.h>
 #include <string>
+#include <memory>
 #include "../core/CoreExporter.h"
 
 
 class MANTRAXCORE_API Texture {
 public:
     Texture();
-    Texture(const std::string& filePath);
+    Texture(const std::string& filePath, bool streamable = false);
     ~Texture();
 
-    bool loadFromFile(const std::string& filePath);
+    // streamable: solo se sube el mip inicial y TextureStreamer sube el resto segun el tamano en
+    // pantalla. Solo para texturas de Material: las demas nunca se piden y se quedarian en baja
+    bool loadFromFile(const std::string& filePath, bool streamable = false);
     bool loadIconFromFile(const std::string& filePath); // New method for loading icons
     void bind(unsigned int slot = 0) const;
     void unbind() const;
@@ -19,10 +22,39 @@ public:
     inline int getHeight() const { return height; }
     inline GLuint getID() const { return rendererID; }
     inline std::string getFilePath() const { return filePath; }
+    inline const std::string& getAssetPath() const { return assetPath; }
+
+    // Mip streaming (ver TextureStreamer). width/height siempre son los del archivo original
+    inline int getMipCount() const { return mipCount; }
+    inline int getResidentMip() const { return residentMip; }
+    inline bool isStreamable() const { return streamable; }
+    size_t getResidentBytes() const;
+    // Bajar es inmediato (se lee de la GPU). Subir decodifica el archivo en un trabajador y
+    // devuelve false hasta que esta listo; TextureStreamer lo vuelve a pedir en los frames siguientes
+    bool setResidentMip(int mip);
+    bool isDecodePending() const { return pendingDecode != nullptr; }
+    // La ultima subida fallo (archivo ilegible o con otro tamano): no se reintenta hasta que
+    // loadFromFile vuelva a cargar el archivo
+    bool hasRaiseFailed() const { return raiseFailed; }
+
+    static int calculateMipCount(int width, int height);
+    static size_t calculateMipChainBytes(int width, int height, int firstMip);
 
 private:
+    struct PendingDecode;
+
+    void uploadFromMip(const unsigned char* pixels, int srcWidth, int srcHeight, int srcMip, int targetMip);
+
     GLuint rendererID;
-    std::string filePath;
+    std::string filePath;       // Ruta en disco (para mostrar)
+    std::string assetPath;      // Ruta virtual con la que se lee del VFS
     unsigned char* localBuffer;
     int width, height, BPP;
+
+    int mipCount;
+    int residentMip;
+    bool streamable;
+    bool isDataTexture;
+    bool raiseFailed;
+    std::shared_ptr<PendingDecode> pendingDecode;    // Imagen original decodificandose para subir de mip
 }; 
\ No newline at end of file
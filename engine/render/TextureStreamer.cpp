@@ -0,0 +1,172 @@
+#include "TextureStreamer.h"
+#include "Texture.h"
+#include "Material.h"
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+TextureStreamer& TextureStreamer::getInstance() {
+    static TextureStreamer instance;
+    return instance;
+}
+
+int TextureStreamer::getInitialMip(int width, int height) const {
+    if (!enabled || initialResidentSize <= 0) {
+        return 0;
+    }
+
+    int mip = 0;
+    int size = std::max(width, height);
+    while ((size >> mip) > initialResidentSize) {
+        mip++;
+    }
+    return std::min(mip, Texture::calculateMipCount(width, height) - 1);
+}
+
+int TextureStreamer::coarsestMip(const Texture* texture) const {
+    return std::max(0, texture->getMipCount() - 1);
+}
+
+void TextureStreamer::beginFrame() {
+    frameIndex++;
+}
+
+void TextureStreamer::requestMaterial(const Material* material, float screenPixels) {
+    if (!enabled || !material) return;
+
+    glm::vec2 tilingVec = material->getTiling();
+    float tiling = std::max(std::abs(tilingVec.x), std::abs(tilingVec.y));
+
+    requestTexture(material->getAlbedoTexture().get(), screenPixels, tiling);
+    requestTexture(material->getNormalTexture().get(), screenPixels, tiling);
+    requestTexture(material->getMetallicTexture().get(), screenPixels, tiling);
+    requestTexture(material->getRoughnessTexture().get(), screenPixels, tiling);
+    requestTexture(material->getEmissiveTexture().get(), screenPixels, tiling);
+    requestTexture(material->getAOTexture().get(), screenPixels, tiling);
+}
+
+void TextureStreamer::requestTexture(Texture* texture, float screenPixels, float tiling) {
+    if (!enabled || !texture || !texture->isStreamable() || texture->getID() == 0) return;
+
+    // Texels del mip 0 que cubren el objeto frente a los pixeles que ocupa en pantalla
+    float texels = static_cast<float>(std::max(texture->getWidth(), texture->getHeight())) * std::max(tiling, 0.001f);
+    float ratio = texels / std::max(screenPixels, 1.0f);
+    int mip = static_cast<int>(std::floor(std::log2(std::max(ratio, 1.0f)) + mipBias));
+    mip = std::clamp(mip, 0, coarsestMip(texture));
+
+    auto result = textures.try_emplace(texture);
+    StreamState& state = result.first->second;
+    if (result.second) {
+        state.requestedMip = mip;
+        state.targetMip = texture->getResidentMip();
+    }
+
+    if (state.lastRequestFrame != frameIndex) {
+        state.requestedMip = mip;
+        state.screenPixels = screenPixels;
+        state.lastRequestFrame = frameIndex;
+    } else {
+        state.requestedMip = std::min(state.requestedMip, mip);
+        state.screenPixels = std::max(state.screenPixels, screenPixels);
+    }
+}
+
+void TextureStreamer::endFrame() {
+    if (!enabled || textures.empty()) return;
+
+    // 1. Mip deseado con histeresis: subir es inmediato, bajar espera dropDelayFrames
+    size_t totalBytes = 0;
+    for (auto& [texture, state] : textures) {
+        int resident = texture->getResidentMip();
+        uint64_t framesSinceRequest = frameIndex - state.lastRequestFrame;
+
+        int wanted = state.requestedMip;
+        if (framesSinceRequest > static_cast<uint64_t>(evictAfterFrames)) {
+            // Material no visible hace tiempo: volver a la resolucion inicial
+            wanted = std::max(wanted, getInitialMip(texture->getWidth(), texture->getHeight()));
+        }
+
+        if (wanted < resident) {
+            state.framesWantingCoarser = 0;
+            state.targetMip = wanted;
+        } else if (wanted > resident) {
+            state.framesWantingCoarser++;
+            state.targetMip = state.framesWantingCoarser >= dropDelayFrames ? wanted : resident;
+        } else {
+            state.framesWantingCoarser = 0;
+            state.targetMip = resident;
+        }
+
+        totalBytes += Texture::calculateMipChainBytes(texture->getWidth(), texture->getHeight(), state.targetMip);
+    }
+
+    // 2. Presupuesto: quitar mips empezando por lo menos prioritario (no visto / mas pequeno en pantalla)
+    if (totalBytes > budgetBytes) {
+        std::vector<std::pair<Texture*, StreamState*>> byPriority;
+        byPriority.reserve(textures.size());
+        for (auto& [texture, state] : textures) {
+            byPriority.emplace_back(texture, &state);
+        }
+        std::sort(byPriority.begin(), byPriority.end(), [](const auto& a, const auto& b) {
+            if (a.second->lastRequestFrame != b.second->lastRequestFrame) {
+                return a.second->lastRequestFrame < b.second->lastRequestFrame;
+            }
+            return a.second->screenPixels < b.second->screenPixels;
+        });
+
+        bool reduced = true;
+        while (totalBytes > budgetBytes && reduced) {
+            reduced = false;
+            for (auto& [texture, state] : byPriority) {
+                if (totalBytes <= budgetBytes) break;
+                if (state->targetMip >= coarsestMip(texture)) continue;
+
+                int w = texture->getWidth();
+                int h = texture->getHeight();
+                totalBytes -= Texture::calculateMipChainBytes(w, h, state->targetMip);
+                state->targetMip++;
+                totalBytes += Texture::calculateMipChainBytes(w, h, state->targetMip);
+                reduced = true;
+            }
+        }
+    }
+
+    // 3. Aplicar cambios: primero liberar memoria, luego subir lo mas grande en pantalla
+    std::vector<std::pair<Texture*, StreamState*>> changes;
+    for (auto& [texture, state] : textures) {
+        // Una subida que ya fallo no gasta el cupo del frame
+        if (state.targetMip < texture->getResidentMip() && texture->hasRaiseFailed()) continue;
+        if (state.targetMip != texture->getResidentMip()) {
+            changes.emplace_back(texture, &state);
+        }
+    }
+    if (changes.empty()) return;
+
+    std::sort(changes.begin(), changes.end(), [](const auto& a, const auto& b) {
+        bool aDrops = a.second->targetMip > a.first->getResidentMip();
+        bool bDrops = b.second->targetMip > b.first->getResidentMip();
+        if (aDrops != bDrops) {
+            return aDrops;
+        }
+        return a.second->screenPixels > b.second->screenPixels;
+    });
+
+    int applied = 0;
+    for (auto& [texture, state] : changes) {
+        if (applied >= maxMipChangesPerFrame) break;
+        texture->setResidentMip(state->targetMip);
+        applied++;
+    }
+}
+
+void TextureStreamer::unregisterTexture(Texture* texture) {
+    textures.erase(texture);
+}
+
+size_t TextureStreamer::getResidentBytes() const {
+    size_t bytes = 0;
+    for (const auto& [texture, state] : textures) {
+        bytes += texture->getResidentBytes();
+    }
+    return bytes;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "../core/CoreExporter.h"
+
+class Texture;
+class Material;
+
+// Gestiona que mips de cada textura estan residentes en GPU.
+// RenderPipeline pide por material el tamano en pantalla de los objetos visibles;
+// al final del frame se decide el mip de cada textura respetando un presupuesto global.
+class MANTRAXCORE_API TextureStreamer {
+public:
+    static TextureStreamer& getInstance();
+
+    // Configuracion
+    void setEnabled(bool enabled) { this->enabled = enabled; }
+    bool isEnabled() const { return enabled; }
+    void setBudgetBytes(size_t bytes) { budgetBytes = bytes; }
+    size_t getBudgetBytes() const { return budgetBytes; }
+    void setInitialResidentSize(int size) { initialResidentSize = size; }
+    int getInitialResidentSize() const { return initialResidentSize; }
+    void setMipBias(float bias) { mipBias = bias; }
+    float getMipBias() const { return mipBias; }
+    void setDropDelayFrames(int frames) { dropDelayFrames = frames; }
+    int getDropDelayFrames() const { return dropDelayFrames; }
+    void setEvictAfterFrames(int frames) { evictAfterFrames = frames; }
+    int getEvictAfterFrames() const { return evictAfterFrames; }
+    void setMaxMipChangesPerFrame(int changes) { maxMipChangesPerFrame = changes; }
+    int getMaxMipChangesPerFrame() const { return maxMipChangesPerFrame; }
+
+    // Mip con el que se sube una textura recien cargada (0 si el streaming esta desactivado)
+    int getInitialMip(int width, int height) const;
+
+    // Ciclo por frame (llamado desde RenderPipeline)
+    void beginFrame();
+    void requestMaterial(const Material* material, float screenPixels);
+    void requestTexture(Texture* texture, float screenPixels, float tiling = 1.0f);
+    void endFrame();
+
+    void unregisterTexture(Texture* texture);
+
+    // Estadisticas
+    size_t getResidentBytes() const;
+    size_t getStreamedTextureCount() const { return textures.size(); }
+
+private:
+    TextureStreamer() = default;
+    ~TextureStreamer() = default;
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    struct StreamState {
+        int requestedMip = 0;
+        float screenPixels = 0.0f;       // Mayor tamano en pantalla visto en el ultimo frame pedido
+        uint64_t lastRequestFrame = 0;
+        int framesWantingCoarser = 0;    // Histeresis antes de soltar mips finos
+        int targetMip = 0;
+    };
+
+    int coarsestMip(const Texture* texture) const;
+
+    std::unordered_map<Texture*, StreamState> textures;
+    uint64_t frameIndex = 0;
+
+    bool enabled = true;
+    size_t budgetBytes = 512ull * 1024ull * 1024ull;
+    int initialResidentSize = 128;
+    float mipBias = 0.0f;
+    int dropDelayFrames = 30;
+    int evictAfterFrames = 120;
+    int maxMipChangesPerFrame = 4;
+};
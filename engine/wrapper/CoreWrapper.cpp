@@ -16,6 +16,9 @@
 #include "../components/ScriptExecutor.h"
 #include "../components/Rigidbody.h"
 #include "../components/Collider.h"
+#include "../components/Prefab.h"
+#include "../components/ObjectPool.h"
+#include "../core/RaycastSystem.h"
 #include "../render/Light.h"
 #include "../render/Camera.h"
 
@@ -31,6 +34,10 @@ void CoreWrapper::Register(sol::state& lua) {
     RegisterScriptExecutor(lua);
     RegisterSpriteAnimator(lua);
     RegisterCamera(lua);
+    RegisterPrefab(lua);
+    RegisterObjectPool(lua);
+    RegisterSceneQueries(lua);
+    RegisterWorldPartition(lua);
 }
 
 void CoreWrapper::RegisterMaths(sol::state& lua) {
@@ -141,9 +148,10 @@ void CoreWrapper::RegisterGameObject(sol::state& lua) {
     // ===== GAMEOBJECT REGISTRATION =====
     lua.new_usertype<GameObject>("GameObject",
         // --- Basic Properties ---
-        "Name", &GameObject::Name,
-        "Tag", &GameObject::Tag,
+        "Name", sol::property([](GameObject& self) { return self.Name; }, &GameObject::setName),
+        "Tag", sol::property([](GameObject& self) { return self.Tag; }, &GameObject::setTag),
         "ObjectID", sol::readonly(&GameObject::ObjectID),
+        "getHandle", [](GameObject& self) { return static_cast<int64_t>(self.getHandle().value); },
         "ModelPath", sol::readonly(&GameObject::ModelPath),
 
         // --- Transform ---
@@ -186,6 +194,8 @@ void CoreWrapper::RegisterGameObject(sol::state& lua) {
         "setRenderEnabled", &GameObject::setRenderEnabled,
         "isTransformUpdateEnabled", &GameObject::isTransformUpdateEnabled,
         "setTransformUpdateEnabled", &GameObject::setTransformUpdateEnabled,
+        "isActive", &GameObject::isActive,
+        "setActive", &GameObject::setActive,
 
         // --- Physics Layers ---
         "getLayer", &GameObject::getLayer,
@@ -195,9 +205,43 @@ void CoreWrapper::RegisterGameObject(sol::state& lua) {
 
         // --- Misc ---
         "isValid", &GameObject::isValid,
-        "destroy", &GameObject::destroy
+        "destroy", [](GameObject* self) { SceneManager::getInstance().destroyGameObject(self); }
     );
 
+    // ===== BUSQUEDAS (indices de la escena activa) =====
+    lua.set_function("findObject", [](const std::string& name) -> GameObject* {
+        Scene* scene = SceneManager::getInstance().getActiveScene();
+        return scene ? scene->findByName(name) : nullptr;
+    });
+
+    lua.set_function("findObjectByTag", [](const std::string& tag) -> GameObject* {
+        Scene* scene = SceneManager::getInstance().getActiveScene();
+        return scene ? scene->findByTag(tag) : nullptr;
+    });
+
+    lua.set_function("findObjectsByTag", [](const std::string& tag, sol::this_state state) {
+        sol::state_view lua(state);
+        sol::table result = lua.create_table();
+        Scene* scene = SceneManager::getInstance().getActiveScene();
+        if (scene) {
+            int i = 1;
+            for (GameObject* obj : scene->findAllByTag(tag)) {
+                result[i++] = obj;
+            }
+        }
+        return result;
+    });
+
+    lua.set_function("findObjectByID", [](const std::string& objectID) -> GameObject* {
+        Scene* scene = SceneManager::getInstance().getActiveScene();
+        return scene ? scene->findByID(objectID) : nullptr;
+    });
+
+    // Guardar obj:getHandle() en lugar del objeto: getObject devuelve nil si ya se destruyo
+    lua.set_function("getObject", [](int64_t handle) -> GameObject* {
+        return ObjectHandle(static_cast<uint64_t>(handle)).get();
+    });
+
     std::cout << "[Lua] GameObject system registered successfully" << std::endl;
 }
 
@@ -214,7 +258,9 @@ void CoreWrapper::RegisterPhysicalObject(sol::state& lua) {
         {"Box",     ShapeType::Box},
         {"Sphere",  ShapeType::Sphere},
         {"Capsule", ShapeType::Capsule},
-        {"Plane",   ShapeType::Plane}
+        {"Plane",   ShapeType::Plane},
+        {"TriangleMesh", ShapeType::TriangleMesh},
+        {"ConvexMesh",   ShapeType::ConvexMesh}
     });
 
     lua.new_enum<physx::PxForceMode::Enum>("ForceMode", {
@@ -533,6 +579,8 @@ void CoreWrapper::RegisterCharacterController(sol::state& lua) {
         "getGravity", &CharacterController::getGravity,
         "setAirControl", &CharacterController::setAirControl,
         "getAirControl", &CharacterController::getAirControl,
+        "setCrowdMode", &CharacterController::setCrowdMode,
+        "isCrowdMode", &CharacterController::isCrowdMode,
 
         // ===== STATE GETTERS =====
         "isGroundedState", &CharacterController::isGroundedState,
@@ -1090,4 +1138,200 @@ void CoreWrapper::RegisterCamera(sol::state& lua) {
     });
 
     std::cout << "[Lua] Camera system registered successfully" << std::endl;
-}
\ No newline at end of file
+}
+
+void CoreWrapper::RegisterPrefab(sol::state& lua) {
+    // instantiatePrefab("Prefabs/Enemy.prefab", vector3.new(0, 0, 0) [, rotacion])
+    lua.set_function("instantiatePrefab", [](const std::string& path, const glm::vec3& position, sol::optional<glm::vec3> rotation) -> GameObject* {
+        Scene* scene = SceneManager::getInstance().getActiveScene();
+        auto prefab = Prefab::load(path);
+        if (!scene || !prefab) {
+            return nullptr;
+        }
+
+        PrefabTransform transform;
+        transform.position = position;
+        transform.rotation = rotation.value_or(glm::vec3(0.0f));
+        return prefab->instantiate(scene, transform);
+    });
+
+    // instantiatePrefabBatch("Prefabs/Tree.prefab", { vector3.new(...), ... }) -> tabla de GameObjects
+    lua.set_function("instantiatePrefabBatch", [](const std::string& path, sol::table positions) {
+        std::vector<GameObject*> instances;
+        Scene* scene = SceneManager::getInstance().getActiveScene();
+        auto prefab = Prefab::load(path);
+        if (!scene || !prefab) {
+            return sol::as_table(instances);
+        }
+
+        std::vector<PrefabTransform> transforms(positions.size());
+        for (size_t i = 0; i < transforms.size(); i++) {
+            transforms[i].position = positions.get<glm::vec3>(i + 1);
+        }
+        instances = prefab->instantiate(scene, transforms);
+        return sol::as_table(instances);
+    });
+
+    std::cout << "[Lua] Prefab system registered successfully" << std::endl;
+}
+
+void CoreWrapper::RegisterObjectPool(sol::state& lua) {
+    // createPool("Bullets", "Prefabs/Bullet.prefab", 256): crea la reserva una vez (en OnStart)
+    lua.set_function("createPool", [](const std::string& name, const std::string& prefabPath, sol::optional<int> prewarm) {
+        int count = prewarm.value_or(0);
+        return ObjectPoolManager::getInstance().createPool(name, prefabPath, count > 0 ? static_cast<size_t>(count) : 0) != nullptr;
+    });
+
+    // spawnFromPool("Bullets", vector3.new(0, 1, 0) [, rotacion]) -> GameObject reciclado
+    lua.set_function("spawnFromPool", [](const std::string& name, const glm::vec3& position, sol::optional<glm::vec3> rotation) -> GameObject* {
+        return ObjectPoolManager::getInstance().spawn(name, position, rotation.value_or(glm::vec3(0.0f)));
+    });
+
+    // despawn(obj): lo devuelve a su pool; si no es de ningun pool equivale a obj:destroy()
+    lua.set_function("despawn", [](GameObject* obj) {
+        SceneManager::getInstance().destroyGameObject(obj);
+    });
+
+    std::cout << "[Lua] Object pool system registered successfully" << std::endl;
+}
+
+namespace {
+    sol::table hitToTable(sol::state_view lua, const RaycastHit& hit) {
+        sol::table result = lua.create_table();
+        result["hit"] = hit.hit;
+        if (hit.hit) {
+            result["position"] = hit.position;
+            result["normal"] = hit.normal;
+            result["distance"] = hit.distance;
+            result["object"] = RaycastSystem::getHitObject(hit);
+        }
+        return result;
+    }
+
+    glm::vec3 vec3Of(const sol::table& query, const char* key, const glm::vec3& fallback) {
+        sol::optional<glm::vec3> value = query[key];
+        return value.value_or(fallback);
+    }
+
+    physx::PxU32 layersOf(const sol::table& query) {
+        return static_cast<physx::PxU32>(query.get_or("layers", 0));
+    }
+}
+
+void CoreWrapper::RegisterSceneQueries(sol::state& lua) {
+    // raycastBatch({ {origin = vector3, direction = vector3 [, distance = 100] [, layers = LAYER_ENEMY]}, ... })
+    // -> { {hit = true, position, normal, distance, object}, ... } en el mismo orden
+    lua.set_function("raycastBatch", [](sol::table queries, sol::this_state state) {
+        sol::state_view lua(state);
+        std::vector<RaycastQuery> batch(queries.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            sol::table query = queries[i + 1];
+            batch[i].origin = vec3Of(query, "origin", glm::vec3(0.0f));
+            batch[i].direction = vec3Of(query, "direction", glm::vec3(0.0f, 0.0f, 1.0f));
+            batch[i].maxDistance = query.get_or("distance", 1000.0f);
+            batch[i].layerMask = layersOf(query);
+        }
+
+        std::vector<RaycastHit> hits(batch.size());
+        RaycastSystem::getInstance().raycastBatch(batch.data(), batch.size(), hits.data());
+
+        sol::table results = lua.create_table(static_cast<int>(hits.size()), 0);
+        for (size_t i = 0; i < hits.size(); i++) {
+            results[i + 1] = hitToTable(lua, hits[i]);
+        }
+        return results;
+    });
+
+    // sweepBatch({ {origin, direction, radius = 0.5 | halfExtents = vector3 [, distance] [, layers]}, ... })
+    lua.set_function("sweepBatch", [](sol::table queries, sol::this_state state) {
+        sol::state_view lua(state);
+        std::vector<SweepQuery> batch(queries.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            sol::table query = queries[i + 1];
+            sol::optional<glm::vec3> halfExtents = query["halfExtents"];
+            batch[i].shape = halfExtents ? QueryShape::Box : QueryShape::Sphere;
+            batch[i].halfExtents = halfExtents.value_or(glm::vec3(0.5f));
+            batch[i].radius = query.get_or("radius", 0.5f);
+            batch[i].origin = vec3Of(query, "origin", glm::vec3(0.0f));
+            batch[i].direction = vec3Of(query, "direction", glm::vec3(0.0f, 0.0f, 1.0f));
+            batch[i].maxDistance = query.get_or("distance", 1000.0f);
+            batch[i].layerMask = layersOf(query);
+        }
+
+        std::vector<RaycastHit> hits(batch.size());
+        RaycastSystem::getInstance().sweepBatch(batch.data(), batch.size(), hits.data());
+
+        sol::table results = lua.create_table(static_cast<int>(hits.size()), 0);
+        for (size_t i = 0; i < hits.size(); i++) {
+            results[i + 1] = hitToTable(lua, hits[i]);
+        }
+        return results;
+    });
+
+    // overlapBatch({ {center = vector3, radius = 2 | halfExtents = vector3 [, layers]}, ... } [, maxHits = 16])
+    // -> { {GameObject, ...}, ... }: los objetos que toca cada consulta
+    lua.set_function("overlapBatch", [](sol::table queries, sol::optional<int> maxHits, sol::this_state state) {
+        sol::state_view lua(state);
+        std::vector<OverlapQuery> batch(queries.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            sol::table query = queries[i + 1];
+            sol::optional<glm::vec3> halfExtents = query["halfExtents"];
+            batch[i].shape = halfExtents ? QueryShape::Box : QueryShape::Sphere;
+            batch[i].halfExtents = halfExtents.value_or(glm::vec3(0.5f));
+            batch[i].radius = query.get_or("radius", 0.5f);
+            batch[i].center = vec3Of(query, "center", glm::vec3(0.0f));
+            batch[i].layerMask = layersOf(query);
+        }
+
+        size_t maxHitsPerQuery = static_cast<size_t>(std::max(1, maxHits.value_or(16)));
+        std::vector<RaycastHit> hits(batch.size() * maxHitsPerQuery);
+        std::vector<uint32_t> hitCounts(batch.size());
+        RaycastSystem::getInstance().overlapBatch(batch.data(), batch.size(), hits.data(), maxHitsPerQuery, hitCounts.data());
+
+        sol::table results = lua.create_table(static_cast<int>(batch.size()), 0);
+        for (size_t i = 0; i < batch.size(); i++) {
+            sol::table objects = lua.create_table();
+            int index = 1;
+            for (uint32_t h = 0; h < hitCounts[i]; h++) {
+                if (GameObject* object = RaycastSystem::getHitObject(hits[i * maxHitsPerQuery + h])) {
+                    objects[index++] = object;
+                }
+            }
+            results[i + 1] = objects;
+        }
+        return results;
+    });
+
+    std::cout << "[Lua] Scene query batches registered successfully" << std::endl;
+}
+
+void CoreWrapper::RegisterWorldPartition(sol::state& lua) {
+    // openWorld("Scenes/Level.scene.world"): carpeta exportada con "Export World Partition Cells";
+    // las celdas se cargan sobre la escena activa alrededor de la camara y de las fuentes
+    lua.set_function("openWorld", [](const std::string& directory) {
+        SceneManager& sceneManager = SceneManager::getInstance();
+        return sceneManager.getWorldPartition().open(sceneManager.getActiveScene(), directory);
+    });
+
+    // closeWorld(): descarga todas las celdas
+    lua.set_function("closeWorld", []() {
+        SceneManager::getInstance().getWorldPartition().close();
+    });
+
+    // addWorldSource(player): carga tambien alrededor de este objeto (ademas de la camara)
+    lua.set_function("addWorldSource", [](GameObject* source) {
+        SceneManager::getInstance().getWorldPartition().addStreamingSource(source);
+    });
+
+    lua.set_function("removeWorldSource", [](GameObject* source) {
+        SceneManager::getInstance().getWorldPartition().removeStreamingSource(source);
+    });
+
+    // isWorldLoadedAt(vector3.new(x, 0, z)): la celda de esa posicion ya esta en la escena
+    lua.set_function("isWorldLoadedAt", [](const glm::vec3& position) {
+        WorldPartition& worldPartition = SceneManager::getInstance().getWorldPartition();
+        return worldPartition.isOpen() && worldPartition.isCellLoaded(worldPartition.cellAt(position));
+    });
+
+    std::cout << "[Lua] World partition registered successfully" << std::endl;
+}
@@ -18,4 +18,8 @@ public:
 	void RegisterScriptExecutor(sol::state& lua);
 	void RegisterSpriteAnimator(sol::state& lua);
 	void RegisterCamera(sol::state& lua);
+	void RegisterPrefab(sol::state& lua);
+	void RegisterObjectPool(sol::state& lua);
+	void RegisterSceneQueries(sol::state& lua);
+	void RegisterWorldPartition(sol::state& lua);
 };
\ No newline at end of file
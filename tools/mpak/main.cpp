@@ -0,0 +1,188 @@
+// MantraxPack: construye y comprueba CorePacks desde la linea de comandos (sin editor ni GPU).
+//
+//   MantraxPack build <carpeta|archivo>... -o <salida.mpak> [opciones]
+//   MantraxPack list <pack.mpak>
+//   MantraxPack verify <pack.mpak>
+#include <mpak/MantraxCorePackBuilder.h>
+#include <mpak/MantraxCorePackReader.h>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    void printUsage() {
+        std::cout <<
+            "Uso:\n"
+            "  MantraxPack build <carpeta|archivo>... -o <salida.mpak> [opciones]\n"
+            "  MantraxPack list <pack.mpak>\n"
+            "  MantraxPack verify <pack.mpak>\n"
+            "\n"
+            "Opciones de build:\n"
+            "  --lz4             Comprimir las entradas con LZ4\n"
+            "  --threads <n>     Hilos de trabajo (por defecto: todos los nucleos)\n"
+            "  --align <bytes>   Alineacion de cada entrada (por defecto 4096)\n"
+            "  --base <carpeta>  Los nombres se guardan relativos a esta carpeta\n"
+            "  --no-dedup        No compartir datos entre entradas identicas\n"
+            "  --full            Ignorar el pack anterior y reconstruir todo\n"
+            "  --v1              Formato legacy\n"
+            "  --quiet           Solo el resumen final\n";
+    }
+
+    bool parseUnsigned(const std::string& text, uint32_t& outValue) {
+        try {
+            size_t used = 0;
+            unsigned long value = std::stoul(text, &used);
+            if (used != text.size()) return false;
+            outValue = static_cast<uint32_t>(value);
+            return true;
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    int runBuild(const std::vector<std::string>& args) {
+        CorePackBuildOptions options;
+        std::vector<std::string> inputs;
+        std::string output;
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            const std::string& arg = args[i];
+            bool hasValue = i + 1 < args.size();
+
+            if (arg == "-o" && hasValue) {
+                output = args[++i];
+            } else if (arg == "--lz4") {
+                options.compression = CorePackCompression::LZ4;
+            } else if (arg == "--threads" && hasValue) {
+                if (!parseUnsigned(args[++i], options.threadCount)) {
+                    std::cerr << "Valor invalido para --threads: " << args[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--align" && hasValue) {
+                if (!parseUnsigned(args[++i], options.alignment)) {
+                    std::cerr << "Valor invalido para --align: " << args[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--base" && hasValue) {
+                options.baseDirectory = args[++i];
+            } else if (arg == "--no-dedup") {
+                options.deduplicate = false;
+            } else if (arg == "--full") {
+                options.incremental = false;
+            } else if (arg == "--v1") {
+                options.version = 1;
+            } else if (arg == "--quiet") {
+                options.verbose = false;
+            } else if (!arg.empty() && arg[0] == '-') {
+                std::cerr << "Opcion desconocida: " << arg << std::endl;
+                return 1;
+            } else {
+                inputs.push_back(arg);
+            }
+        }
+
+        if (inputs.empty() || output.empty()) {
+            printUsage();
+            return 1;
+        }
+
+        // Con una sola carpeta de entrada los nombres quedan relativos a ella ("Models/Cube.fbx")
+        std::vector<std::string> files;
+        for (const auto& input : inputs) {
+            if (std::filesystem::is_directory(input)) {
+                if (options.baseDirectory.empty() && inputs.size() == 1) {
+                    options.baseDirectory = input;
+                }
+                std::vector<std::string> collected = MantraxCorePackBuilder::CollectFiles(input);
+                files.insert(files.end(), collected.begin(), collected.end());
+            } else if (std::filesystem::is_regular_file(input)) {
+                files.push_back(input);
+            } else {
+                std::cerr << "No existe: " << input << std::endl;
+                return 1;
+            }
+        }
+
+        CorePackBuildStats stats;
+        if (!MantraxCorePackBuilder::Build(files, output, options, stats)) {
+            std::cerr << "Error construyendo " << output << std::endl;
+            return 1;
+        }
+
+        if (options.version != 1) {
+            std::cout << stats.entryCount << " entradas, " << stats.uniqueDataCount << " bloques de datos ("
+                      << stats.reusedCount << " reutilizados, " << stats.deduplicatedCount << " duplicados, "
+                      << stats.compressedCount << " comprimidos), " << stats.bytesHashed << " bytes leidos, "
+                      << stats.bytesWritten << " bytes escritos, " << stats.milliseconds << " ms" << std::endl;
+        }
+        return 0;
+    }
+
+    int runList(const std::string& packPath) {
+        MantraxCorePackReader reader(packPath);
+        if (!reader.IsValid()) {
+            std::cerr << "Pack invalido: " << packPath << std::endl;
+            return 1;
+        }
+
+        for (const auto& name : reader.ListFiles()) {
+            CorePackFileInfo info;
+            reader.GetFileInfo(name, info);
+            std::cout << name << "  " << info.size << " bytes";
+            if (info.compression == CorePackCompression::LZ4) {
+                std::cout << " (" << info.storedSize << " LZ4)";
+            }
+            std::cout << "\n";
+        }
+        std::cout << reader.GetFileCount() << " entradas (v" << reader.GetVersion() << ")" << std::endl;
+        return 0;
+    }
+
+    int runVerify(const std::string& packPath) {
+        MantraxCorePackReader reader(packPath);
+        if (!reader.IsValid()) {
+            std::cerr << "Pack invalido: " << packPath << std::endl;
+            return 1;
+        }
+        if (reader.GetVersion() != CORE_PACK_VERSION) {
+            std::cerr << "Los packs v1 no guardan CRC" << std::endl;
+            return 1;
+        }
+
+        size_t failures = 0;
+        for (const auto& name : reader.ListFiles()) {
+            if (!reader.VerifyFile(name)) {
+                std::cerr << "CRC incorrecto: " << name << std::endl;
+                failures++;
+            }
+        }
+        std::cout << reader.GetFileCount() - failures << "/" << reader.GetFileCount() << " entradas correctas" << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::string command = args[0];
+    args.erase(args.begin());
+
+    if (command == "build") {
+        return runBuild(args);
+    }
+    if (command == "list" && args.size() == 1) {
+        return runList(args[0]);
+    }
+    if (command == "verify" && args.size() == 1) {
+        return runVerify(args[0]);
+    }
+
+    printUsage();
+    return 1;
+}